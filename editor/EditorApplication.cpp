@@ -5,6 +5,7 @@
 #include "engine/Camera.hpp"
 #include "engine/EngineSystems.hpp"
 #include "engine/KeyMapping.hpp"
+#include "engine/ResourceManager.hpp"
 #include "engine/Serializer.hpp"
 #include "engine/Settings.hpp"
 #include "engine/UserInput.hpp"
@@ -22,7 +23,7 @@ namespace sage
         SetExitKey(KEY_NULL);
         EnableCursor();
 
-        serializer::LoadAssetBinFile(registry.get(), "resources/assets.bin");
+        serializer::LoadAssetBinFile("resources/assets.bin");
         systems = std::make_unique<EngineSystems>(registry.get(), keyMapping.get(), settings.get(), audioManager.get());
         scene = std::make_unique<EditorScene>(systems.get());
     }
@@ -112,6 +113,7 @@ namespace sage
                     exitWindowRequested = false;
             }
 
+            sage::ResourceManager::GetInstance().PumpUploads();
             scene->Update();
             draw();
             handleScreenUpdate();
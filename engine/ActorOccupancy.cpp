@@ -0,0 +1,120 @@
+#include "ActorOccupancy.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace sage
+{
+    bool ActorOccupancy::clampToGrid(Rect& rect) const
+    {
+        if (rect.min.row > rect.max.row) std::swap(rect.min.row, rect.max.row);
+        if (rect.min.col > rect.max.col) std::swap(rect.min.col, rect.max.col);
+        if (rect.max.row < 0 || rect.max.col < 0 || rect.min.row >= rows || rect.min.col >= cols) return false;
+
+        rect.min.row = std::max(rect.min.row, 0);
+        rect.min.col = std::max(rect.min.col, 0);
+        rect.max.row = std::min(rect.max.row, rows - 1);
+        rect.max.col = std::min(rect.max.col, cols - 1);
+        return true;
+    }
+
+    void ActorOccupancy::apply(const Rect& rect, const Rect* except, const int delta)
+    {
+        for (int row = rect.min.row; row <= rect.max.row; ++row)
+        {
+            for (int col = rect.min.col; col <= rect.max.col; ++col)
+            {
+                if (except && except->Contains(row, col)) continue;
+                auto& count = counts[row * cols + col];
+                assert(delta > 0 || count > 0);
+                count = static_cast<std::uint16_t>(count + delta);
+                ++stats.squaresTouched;
+            }
+        }
+    }
+
+    void ActorOccupancy::Reset(const int _rows, const int _cols)
+    {
+        rows = _rows;
+        cols = _cols;
+        counts.assign(static_cast<std::size_t>(rows) * cols, 0);
+        stamps.clear();
+    }
+
+    void ActorOccupancy::Stamp(const entt::entity entity, Rect rect)
+    {
+        ++stats.stamps;
+        if (!clampToGrid(rect))
+        {
+            Unstamp(entity);
+            return;
+        }
+
+        auto [it, inserted] = stamps.try_emplace(entity, rect);
+        if (inserted)
+        {
+            apply(rect, nullptr, 1);
+            return;
+        }
+
+        const Rect previous = it->second;
+        if (previous == rect)
+        {
+            ++stats.unchanged;
+            return;
+        }
+        apply(previous, &rect, -1);
+        apply(rect, &previous, 1);
+        it->second = rect;
+    }
+
+    void ActorOccupancy::Unstamp(const entt::entity entity)
+    {
+        const auto it = stamps.find(entity);
+        if (it == stamps.end()) return;
+        apply(it->second, nullptr, -1);
+        stamps.erase(it);
+    }
+
+    bool ActorOccupancy::IsStamped(const entt::entity entity) const
+    {
+        return stamps.contains(entity);
+    }
+
+    int ActorOccupancy::GetCount(const int row, const int col) const
+    {
+        if (row < 0 || row >= rows || col < 0 || col >= cols) return 0;
+        return counts[row * cols + col];
+    }
+
+    bool ActorOccupancy::IsOccupied(const int row, const int col) const
+    {
+        return GetCount(row, col) > 0;
+    }
+
+    bool ActorOccupancy::Validate() const
+    {
+        std::vector<std::uint16_t> expected(counts.size(), 0);
+        for (const auto& [entity, rect] : stamps)
+        {
+            for (int row = rect.min.row; row <= rect.max.row; ++row)
+            {
+                for (int col = rect.min.col; col <= rect.max.col; ++col)
+                {
+                    ++expected[row * cols + col];
+                }
+            }
+        }
+        return expected == counts;
+    }
+
+    const ActorOccupancy::Stats& ActorOccupancy::GetStats() const
+    {
+        return stats;
+    }
+
+    void ActorOccupancy::ResetStats()
+    {
+        stats = {};
+    }
+} // namespace sage
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "components/NavigationGridSquare.hpp"
+
+#include "entt/entt.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sage
+{
+    /*
+     * How many actors stand on each navigation square. Every actor remembers the rectangle of
+     * squares it was last stamped over; restamping leaves the squares it still covers alone and
+     * only adjusts the ones it entered or left, so an actor moving within a square costs nothing.
+     * Counts rather than a single occupant mean overlapping actors do not clear each other out.
+     * Pure data, so it can be exercised headless.
+     */
+    class ActorOccupancy
+    {
+      public:
+        // Inclusive on both ends.
+        struct Rect
+        {
+            GridSquare min{};
+            GridSquare max{};
+
+            [[nodiscard]] bool Contains(const int row, const int col) const
+            {
+                return row >= min.row && row <= max.row && col >= min.col && col <= max.col;
+            }
+
+            bool operator==(const Rect& other) const = default;
+        };
+
+        struct Stats
+        {
+            unsigned long stamps = 0;
+            unsigned long unchanged = 0; // Stamps that kept the previous rectangle
+            unsigned long squaresTouched = 0;
+        };
+
+      private:
+        int rows = 0;
+        int cols = 0;
+        std::vector<std::uint16_t> counts;
+        std::unordered_map<entt::entity, Rect> stamps;
+        Stats stats;
+
+        [[nodiscard]] bool clampToGrid(Rect& rect) const;
+        // Adds delta to every square of rect that is not also in except.
+        void apply(const Rect& rect, const Rect* except, int delta);
+
+      public:
+        // Sizes the grid and drops every stamp.
+        void Reset(int _rows, int _cols);
+        // Places the entity over rect, replacing its previous stamp. A rect entirely off the grid
+        // removes the stamp.
+        void Stamp(entt::entity entity, Rect rect);
+        void Unstamp(entt::entity entity);
+        [[nodiscard]] bool IsStamped(entt::entity entity) const;
+        [[nodiscard]] int GetCount(int row, int col) const;
+        [[nodiscard]] bool IsOccupied(int row, int col) const;
+        // Rebuilds the counts from the stamps alone and compares them with the maintained ones.
+        [[nodiscard]] bool Validate() const;
+        [[nodiscard]] const Stats& GetStats() const;
+        void ResetStats();
+    };
+} // namespace sage
@@ -0,0 +1,265 @@
+#include "AnimationClip.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+
+namespace sage
+{
+    namespace
+    {
+        constexpr float SMALLEST_THREE_RANGE = 0.70710678f; // Non-largest components lie in [-1/sqrt2, 1/sqrt2]
+        constexpr float PACKED_COMPONENT_MAX = 32767.0f;    // 15 bits
+
+        Quaternion NlerpShortest(Quaternion a, Quaternion b, float t)
+        {
+            if (Vector4DotProduct(a, b) < 0.0f) b = QuaternionScale(b, -1.0f);
+            return QuaternionNlerp(a, b, t);
+        }
+
+        float RotationError(Quaternion a, Quaternion b)
+        {
+            const float dot = std::min(std::abs(Vector4DotProduct(a, b)), 1.0f);
+            return 2.0f * std::acos(dot);
+        }
+
+        /* Greedy key reduction: extends each segment while every frame inside it is reproduced,
+        within tolerance, by interpolating the segment's end keys. Returns the kept frames; a
+        single key if the whole track is constant. */
+        template <typename T>
+        std::vector<int> ReduceKeys(
+            const std::vector<T>& values,
+            const std::function<T(const T&, const T&, float)>& interpolate,
+            const std::function<float(const T&, const T&)>& error,
+            float tolerance)
+        {
+            const int count = static_cast<int>(values.size());
+            const bool constant = std::ranges::all_of(
+                values, [&](const T& value) { return error(value, values.front()) <= tolerance; });
+            if (constant) return {0};
+
+            std::vector<int> keys{0};
+            int start = 0;
+            for (int end = start + 2; end < count; ++end)
+            {
+                for (int i = start + 1; i < end; ++i)
+                {
+                    const float t = static_cast<float>(i - start) / static_cast<float>(end - start);
+                    if (error(interpolate(values[start], values[end], t), values[i]) > tolerance)
+                    {
+                        start = end - 1;
+                        keys.push_back(start);
+                        break;
+                    }
+                }
+            }
+            if (keys.back() != count - 1) keys.push_back(count - 1);
+            return keys;
+        }
+    } // namespace
+
+    PackedQuaternion PackQuaternion(Quaternion q)
+    {
+        q = QuaternionNormalize(q);
+        const float components[4] = {q.x, q.y, q.z, q.w};
+        int largest = 0;
+        for (int i = 1; i < 4; ++i)
+        {
+            if (std::abs(components[i]) > std::abs(components[largest])) largest = i;
+        }
+        // q and -q are the same rotation, so make the dropped component positive.
+        const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+        std::uint64_t packed = static_cast<std::uint64_t>(largest) << 45;
+        int shift = 30;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (i == largest) continue;
+            const float normalized = (components[i] * sign / SMALLEST_THREE_RANGE + 1.0f) * 0.5f;
+            const auto value =
+                static_cast<std::uint64_t>(std::lround(std::clamp(normalized, 0.0f, 1.0f) * PACKED_COMPONENT_MAX));
+            packed |= value << shift;
+            shift -= 15;
+        }
+
+        PackedQuaternion out;
+        out.bits[0] = static_cast<std::uint16_t>(packed >> 32);
+        out.bits[1] = static_cast<std::uint16_t>(packed >> 16);
+        out.bits[2] = static_cast<std::uint16_t>(packed);
+        return out;
+    }
+
+    Quaternion UnpackQuaternion(PackedQuaternion packed)
+    {
+        const std::uint64_t bits = static_cast<std::uint64_t>(packed.bits[0]) << 32 |
+                                   static_cast<std::uint64_t>(packed.bits[1]) << 16 | packed.bits[2];
+        const int largest = static_cast<int>((bits >> 45) & 0x3u);
+
+        float components[4]{};
+        float sumSquares = 0;
+        int shift = 30;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (i == largest) continue;
+            const float normalized = static_cast<float>((bits >> shift) & 0x7fffu) / PACKED_COMPONENT_MAX;
+            components[i] = (normalized * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+            sumSquares += components[i] * components[i];
+            shift -= 15;
+        }
+        components[largest] = std::sqrt(std::max(1.0f - sumSquares, 0.0f));
+        return QuaternionNormalize({components[0], components[1], components[2], components[3]});
+    }
+
+    const std::string& AnimationClip::GetName() const
+    {
+        return name;
+    }
+
+    int AnimationClip::GetFrameCount() const
+    {
+        return frameCount;
+    }
+
+    int AnimationClip::GetBoneCount() const
+    {
+        return static_cast<int>(bones.size());
+    }
+
+    const std::vector<BoneInfo>& AnimationClip::GetBones() const
+    {
+        return bones;
+    }
+
+    std::size_t AnimationClip::GetKeyCount() const
+    {
+        return translations.size() + rotations.size() + scales.size();
+    }
+
+    std::size_t AnimationClip::GetMemoryUsage() const
+    {
+        return bones.size() * sizeof(BoneInfo) +
+               (translationTracks.size() + rotationTracks.size() + scaleTracks.size()) * sizeof(Track) +
+               (translationFrames.size() + rotationFrames.size() + scaleFrames.size()) * sizeof(std::uint16_t) +
+               translations.size() * sizeof(Vector3) + rotations.size() * sizeof(PackedQuaternion) +
+               scales.size() * sizeof(Vector3);
+    }
+
+    std::uint32_t AnimationClip::findKey(
+        const Track& track, const std::vector<std::uint16_t>& frames, int frame, float& t)
+    {
+        t = 0;
+        if (track.count == 1) return track.first;
+
+        const auto begin = frames.begin() + track.first;
+        const auto end = begin + track.count;
+        const auto next = std::upper_bound(begin, end, static_cast<std::uint16_t>(frame));
+        const auto key = static_cast<std::uint32_t>(next - frames.begin()) - 1;
+        if (next != end)
+        {
+            const float from = frames[key];
+            t = (static_cast<float>(frame) - from) / (static_cast<float>(*next) - from);
+        }
+        return key;
+    }
+
+    void AnimationClip::SamplePose(int frame, Transform* pose) const
+    {
+        if (frameCount <= 0) return;
+        frame %= frameCount;
+
+        float t = 0;
+        for (std::size_t bone = 0; bone < bones.size(); ++bone)
+        {
+            auto& out = pose[bone];
+
+            std::uint32_t key = findKey(translationTracks[bone], translationFrames, frame, t);
+            out.translation = t > 0 ? Vector3Lerp(translations[key], translations[key + 1], t) : translations[key];
+
+            key = findKey(rotationTracks[bone], rotationFrames, frame, t);
+            out.rotation = t > 0
+                               ? NlerpShortest(UnpackQuaternion(rotations[key]), UnpackQuaternion(rotations[key + 1]), t)
+                               : UnpackQuaternion(rotations[key]);
+
+            const Track& scaleTrack = scaleTracks[bone];
+            if (scaleTrack.count == 0)
+            {
+                out.scale = Vector3One();
+                continue;
+            }
+            key = findKey(scaleTrack, scaleFrames, frame, t);
+            out.scale = t > 0 ? Vector3Lerp(scales[key], scales[key + 1], t) : scales[key];
+        }
+    }
+
+    AnimationClip AnimationClip::Compress(const ModelAnimation& animation, const AnimationCompressionSettings& settings)
+    {
+        assert(animation.frameCount <= UINT16_MAX);
+
+        AnimationClip clip;
+        clip.name = animation.name;
+        clip.frameCount = animation.frameCount;
+        clip.bones.assign(animation.bones, animation.bones + animation.boneCount);
+        if (animation.frameCount <= 0) return clip;
+
+        const std::function lerp3 = [](const Vector3& a, const Vector3& b, float t) { return Vector3Lerp(a, b, t); };
+        const std::function distance3 = [](const Vector3& a, const Vector3& b) { return Vector3Distance(a, b); };
+        const std::function slerpish = [](const Quaternion& a, const Quaternion& b, float t) {
+            return NlerpShortest(a, b, t);
+        };
+        const std::function angle = [](const Quaternion& a, const Quaternion& b) { return RotationError(a, b); };
+
+        std::vector<Vector3> translations(animation.frameCount);
+        std::vector<Quaternion> rotations(animation.frameCount);
+        std::vector<PackedQuaternion> packed(animation.frameCount);
+        std::vector<Vector3> scales(animation.frameCount);
+
+        for (int bone = 0; bone < animation.boneCount; ++bone)
+        {
+            for (int frame = 0; frame < animation.frameCount; ++frame)
+            {
+                const Transform& transform = animation.framePoses[frame][bone];
+                translations[frame] = transform.translation;
+                // Reduce against what the sampler will actually decode.
+                packed[frame] = PackQuaternion(transform.rotation);
+                rotations[frame] = UnpackQuaternion(packed[frame]);
+                scales[frame] = transform.scale;
+            }
+
+            Track track{static_cast<std::uint32_t>(clip.translations.size()), 0};
+            for (const int frame : ReduceKeys(translations, lerp3, distance3, settings.translationTolerance))
+            {
+                clip.translationFrames.push_back(static_cast<std::uint16_t>(frame));
+                clip.translations.push_back(translations[frame]);
+                ++track.count;
+            }
+            clip.translationTracks.push_back(track);
+
+            track = {static_cast<std::uint32_t>(clip.rotations.size()), 0};
+            for (const int frame : ReduceKeys(rotations, slerpish, angle, settings.rotationTolerance))
+            {
+                clip.rotationFrames.push_back(static_cast<std::uint16_t>(frame));
+                clip.rotations.push_back(packed[frame]);
+                ++track.count;
+            }
+            clip.rotationTracks.push_back(track);
+
+            track = {static_cast<std::uint32_t>(clip.scales.size()), 0};
+            const auto scaleKeys = ReduceKeys(scales, lerp3, distance3, settings.scaleTolerance);
+            // A constant unit scale track is dropped altogether.
+            if (scaleKeys.size() > 1 || Vector3Distance(scales[0], Vector3One()) > settings.scaleTolerance)
+            {
+                for (const int frame : scaleKeys)
+                {
+                    clip.scaleFrames.push_back(static_cast<std::uint16_t>(frame));
+                    clip.scales.push_back(scales[frame]);
+                    ++track.count;
+                }
+            }
+            clip.scaleTracks.push_back(track);
+        }
+        return clip;
+    }
+} // namespace sage
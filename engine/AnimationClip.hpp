@@ -0,0 +1,108 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sage
+{
+    // Largest error a removed key may introduce when reconstructed by interpolating its neighbours.
+    struct AnimationCompressionSettings
+    {
+        float translationTolerance = 0.0005f; // Model units
+        float rotationTolerance = 0.001f;     // Radians
+        float scaleTolerance = 0.0005f;
+    };
+
+    // A rotation quantised with the smallest-three scheme: the largest component is dropped (and
+    // rebuilt from the unit length), the other three take 15 bits each, its index 2 bits.
+    struct PackedQuaternion
+    {
+        std::uint16_t bits[3]{};
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(bits[0], bits[1], bits[2]);
+        }
+    };
+
+    [[nodiscard]] PackedQuaternion PackQuaternion(Quaternion q);
+    [[nodiscard]] Quaternion UnpackQuaternion(PackedQuaternion packed);
+
+    /*
+     * A skeletal animation with per-bone translation, rotation and scale tracks, each keeping only
+     * the keys that can't be rebuilt (within tolerance) by interpolating their neighbours. A track
+     * that never changes holds a single key. Replaces raylib's ModelAnimation at runtime, which
+     * stores a full Transform per bone per frame.
+     */
+    class AnimationClip
+    {
+        // A bone's keys for one channel: [first, first + count) of that channel's key arrays.
+        struct Track
+        {
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+
+            template <class Archive>
+            void serialize(Archive& archive)
+            {
+                archive(first, count);
+            }
+        };
+
+        std::string name;
+        int frameCount = 0;
+        std::vector<BoneInfo> bones;
+
+        std::vector<Track> translationTracks; // One per bone
+        std::vector<std::uint16_t> translationFrames;
+        std::vector<Vector3> translations;
+
+        std::vector<Track> rotationTracks;
+        std::vector<std::uint16_t> rotationFrames;
+        std::vector<PackedQuaternion> rotations;
+
+        std::vector<Track> scaleTracks;
+        std::vector<std::uint16_t> scaleFrames;
+        std::vector<Vector3> scales;
+
+        // Key index within the track at or before frame, and the interpolation weight to the next.
+        static std::uint32_t findKey(const Track& track, const std::vector<std::uint16_t>& frames, int frame, float& t);
+
+      public:
+        [[nodiscard]] const std::string& GetName() const;
+        [[nodiscard]] int GetFrameCount() const;
+        [[nodiscard]] int GetBoneCount() const;
+        [[nodiscard]] const std::vector<BoneInfo>& GetBones() const;
+        [[nodiscard]] std::size_t GetKeyCount() const;
+        // Bytes held by the clip's key data and bone table.
+        [[nodiscard]] std::size_t GetMemoryUsage() const;
+
+        // Decodes the pose at frame (wrapped to the clip length) into pose[0..boneCount).
+        void SamplePose(int frame, Transform* pose) const;
+
+        [[nodiscard]] static AnimationClip Compress(
+            const ModelAnimation& animation, const AnimationCompressionSettings& settings = {});
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(
+                name,
+                frameCount,
+                bones,
+                translationTracks,
+                translationFrames,
+                translations,
+                rotationTracks,
+                rotationFrames,
+                rotations,
+                scaleTracks,
+                scaleFrames,
+                scales);
+        }
+    };
+} // namespace sage
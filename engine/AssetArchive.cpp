@@ -0,0 +1,208 @@
+#include "AssetArchive.hpp"
+
+#include "raylib.h"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <ranges>
+
+namespace sage
+{
+    std::unordered_map<std::string, AssetTocEntry>& AssetToc::Section(AssetType type)
+    {
+        switch (type)
+        {
+        case AssetType::Image:
+            return images;
+        case AssetType::Model:
+            return models;
+        case AssetType::Material:
+            return materials;
+        case AssetType::Animation:
+            return animations;
+        case AssetType::Script:
+            return scripts;
+        }
+        return images;
+    }
+
+    const std::unordered_map<std::string, AssetTocEntry>& AssetToc::Section(AssetType type) const
+    {
+        return const_cast<AssetToc*>(this)->Section(type);
+    }
+
+    bool AssetArchiveReader::readBlob(
+        const AssetTocEntry& entry, const std::function<void(cereal::BinaryInputArchive&)>& readFn)
+    {
+        std::uint64_t position = entry.offset;
+        const std::uint64_t end = entry.offset + entry.compressedSize;
+        InflateStreamBuf inflate([this, &position, end](char* dst, std::size_t n) {
+            if (position + n > end) return false;
+            std::lock_guard lock(fileMutex);
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(position));
+            file.read(dst, static_cast<std::streamsize>(n));
+            position += n;
+            return static_cast<bool>(file);
+        });
+
+        std::istream in(&inflate);
+        try
+        {
+            cereal::BinaryInputArchive input(in);
+            readFn(input);
+        }
+        catch (const std::exception& e) // cereal::Exception, or bad_alloc from a corrupt length
+        {
+            std::cerr << "ERROR: AssetArchive -> Unreadable blob at offset " << entry.offset << " in " << path
+                      << ": " << e.what() << std::endl;
+            return false;
+        }
+
+        if (inflate.Failed())
+        {
+            std::cerr << "ERROR: AssetArchive -> Corrupt blob at offset " << entry.offset << " in " << path
+                      << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetArchiveReader::Open(const char* _path)
+    {
+        Close();
+        file.open(_path, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "ERROR: AssetArchive -> Unable to open " << _path << " for reading." << std::endl;
+            return false;
+        }
+
+        char fileMagic[4]{};
+        AssetTocEntry tocEntry;
+        file.read(fileMagic, sizeof(fileMagic));
+        file.read(reinterpret_cast<char*>(&tocEntry.offset), sizeof(tocEntry.offset));
+        file.read(reinterpret_cast<char*>(&tocEntry.compressedSize), sizeof(tocEntry.compressedSize));
+        file.read(reinterpret_cast<char*>(&tocEntry.uncompressedSize), sizeof(tocEntry.uncompressedSize));
+
+        if (std::memcmp(fileMagic, kAssetArchiveMagic, sizeof(kAssetArchiveMagic)) != 0)
+        {
+            std::cerr << "ERROR: AssetArchive -> File magic mismatch at " << _path << " (got '"
+                      << std::string(fileMagic, 4) << "', expected '" << std::string(kAssetArchiveMagic, 4)
+                      << "')." << std::endl;
+            file.close();
+            return false;
+        }
+
+        path = _path;
+        if (!readBlob(tocEntry, [this](cereal::BinaryInputArchive& input) { input(toc); }))
+        {
+            file.close();
+            return false;
+        }
+        return true;
+    }
+
+    void AssetArchiveReader::Close()
+    {
+        if (file.is_open()) file.close();
+        toc = {};
+        path.clear();
+    }
+
+    bool AssetArchiveReader::IsOpen() const
+    {
+        return file.is_open();
+    }
+
+    bool AssetArchiveReader::Contains(AssetType type, const std::string& key) const
+    {
+        return toc.Section(type).contains(key);
+    }
+
+    std::vector<std::string> AssetArchiveReader::Keys(AssetType type) const
+    {
+        std::vector<std::string> keys;
+        const auto& section = toc.Section(type);
+        keys.reserve(section.size());
+        for (const auto& key : section | std::views::keys)
+        {
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    const std::string& AssetArchiveReader::GetPath() const
+    {
+        return path;
+    }
+
+    void AssetArchiveWriter::writeBlob(const AssetBlob& blob, AssetTocEntry& entry)
+    {
+        entry.offset = static_cast<std::uint64_t>(file.tellp());
+        entry.compressedSize = static_cast<std::uint64_t>(blob.data.size());
+        entry.uncompressedSize = blob.uncompressedSize;
+        file.write(reinterpret_cast<const char*>(blob.data.data()), static_cast<std::streamsize>(blob.data.size()));
+
+        rawTotal += entry.uncompressedSize;
+        compressedTotal += entry.compressedSize;
+    }
+
+    AssetArchiveWriter::AssetArchiveWriter(const char* path) : file(path, std::ios::binary)
+    {
+        if (!file.is_open())
+        {
+            std::cerr << "ERROR: AssetArchive -> Unable to open " << path << " for writing." << std::endl;
+            return;
+        }
+
+        // Header placeholder; patched with the TOC location in Finish().
+        const AssetTocEntry placeholder;
+        file.write(kAssetArchiveMagic, sizeof(kAssetArchiveMagic));
+        file.write(reinterpret_cast<const char*>(&placeholder.offset), sizeof(placeholder.offset));
+        file.write(reinterpret_cast<const char*>(&placeholder.compressedSize), sizeof(placeholder.compressedSize));
+        file.write(
+            reinterpret_cast<const char*>(&placeholder.uncompressedSize), sizeof(placeholder.uncompressedSize));
+    }
+
+    bool AssetArchiveWriter::IsOpen() const
+    {
+        return file.is_open();
+    }
+
+    bool AssetArchiveWriter::Contains(AssetType type, const std::string& key) const
+    {
+        return toc.Section(type).contains(key);
+    }
+
+    void AssetArchiveWriter::AddBlob(AssetType type, const std::string& key, const AssetBlob& blob)
+    {
+        AssetTocEntry entry;
+        writeBlob(blob, entry);
+        toc.Section(type)[key] = entry;
+    }
+
+    void AssetArchiveWriter::Finish()
+    {
+        AssetBlob tocBlob;
+        AssetTocEntry tocEntry;
+        if (!EncodeAssetBlob(toc, tocBlob))
+        {
+            std::cerr << "ERROR: AssetArchive -> Failed to write table of contents; aborting save." << std::endl;
+            exit(1);
+        }
+        writeBlob(tocBlob, tocEntry);
+
+        file.seekp(sizeof(kAssetArchiveMagic));
+        file.write(reinterpret_cast<const char*>(&tocEntry.offset), sizeof(tocEntry.offset));
+        file.write(reinterpret_cast<const char*>(&tocEntry.compressedSize), sizeof(tocEntry.compressedSize));
+        file.write(reinterpret_cast<const char*>(&tocEntry.uncompressedSize), sizeof(tocEntry.uncompressedSize));
+        file.close();
+
+        std::cout << "  (assets=" << toc.images.size() + toc.models.size() + toc.materials.size() +
+                         toc.animations.size() + toc.scripts.size()
+                  << " raw=" << rawTotal << "B compressed=" << compressedTotal << "B ratio="
+                  << (rawTotal > 0 ? (static_cast<double>(compressedTotal) / rawTotal) : 0.0) << ")" << std::endl;
+    }
+} // namespace sage
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CompressedStream.hpp"
+
+#include "cereal/archives/binary.hpp"
+#include "cereal/cereal.hpp"
+#include "cereal/types/string.hpp"
+#include "cereal/types/unordered_map.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sage
+{
+    enum class AssetType : std::uint8_t
+    {
+        Image,
+        Model,
+        Material,
+        Animation,
+        Script // Game scripts; read whole by the game, never streamed
+    };
+
+    // Location of one asset's DEFLATE-compressed cereal blob within the archive file.
+    struct AssetTocEntry
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t compressedSize = 0;
+        std::uint64_t uncompressedSize = 0;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(offset, compressedSize, uncompressedSize);
+        }
+    };
+
+    // Keys are only unique per asset type (e.g. "mdl_goblin" is both a model and an animation set).
+    struct AssetToc
+    {
+        std::unordered_map<std::string, AssetTocEntry> images;
+        std::unordered_map<std::string, AssetTocEntry> models;
+        std::unordered_map<std::string, AssetTocEntry> materials;
+        std::unordered_map<std::string, AssetTocEntry> animations;
+        std::unordered_map<std::string, AssetTocEntry> scripts;
+
+        [[nodiscard]] std::unordered_map<std::string, AssetTocEntry>& Section(AssetType type);
+        [[nodiscard]] const std::unordered_map<std::string, AssetTocEntry>& Section(AssetType type) const;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(images, models, materials, animations, scripts);
+        }
+    };
+
+    // One asset's compressed cereal blob (chunked DEFLATE, see CompressedStream.hpp), exactly as
+    // it is stored in the archive.
+    struct AssetBlob
+    {
+        std::vector<unsigned char> data;
+        std::uint64_t uncompressedSize = 0;
+    };
+
+    template <typename T>
+    bool EncodeAssetBlob(const T& asset, AssetBlob& out)
+    {
+        std::ostringstream buf(std::ios::binary);
+        DeflateStreamBuf deflate(buf);
+        {
+            std::ostream stream(&deflate);
+            cereal::BinaryOutputArchive output{stream};
+            output(asset);
+        }
+        if (!deflate.Finish()) return false;
+
+        const std::string compressed = buf.str();
+        out.data.assign(compressed.begin(), compressed.end());
+        out.uncompressedSize = deflate.GetRawSize();
+        return true;
+    }
+
+    // On-disk layout: magic, TOC entry (pointing at the TOC blob), asset blobs..., TOC blob.
+    // The TOC is written last so the packer can stream blobs without knowing their sizes up front.
+    inline constexpr char kAssetArchiveMagic[4] = {'L', 'Q', 'B', '6'};
+
+    /*
+     * Read side of the archive. Open() only reads the header and TOC; individual assets are
+     * inflated and deserialised on request via Read(), one chunk at a time, so memory stays
+     * bounded whatever the asset's size. Read() may be called from streaming worker threads:
+     * only the file access is serialised, inflate/deserialise run concurrently.
+     */
+    class AssetArchiveReader
+    {
+        std::string path;
+        std::ifstream file;
+        std::mutex fileMutex;
+        AssetToc toc;
+
+        bool readBlob(const AssetTocEntry& entry, const std::function<void(cereal::BinaryInputArchive&)>& readFn);
+
+      public:
+        bool Open(const char* _path);
+        void Close();
+        [[nodiscard]] bool IsOpen() const;
+        [[nodiscard]] bool Contains(AssetType type, const std::string& key) const;
+        [[nodiscard]] std::vector<std::string> Keys(AssetType type) const;
+        [[nodiscard]] const std::string& GetPath() const;
+
+        template <typename T>
+        bool Read(AssetType type, const std::string& key, T& out)
+        {
+            const auto& section = toc.Section(type);
+            const auto it = section.find(key);
+            if (it == section.end()) return false;
+
+            return readBlob(it->second, [&out](cereal::BinaryInputArchive& input) { input(out); });
+        }
+    };
+
+    /*
+     * Write side of the archive. Each Add() serialises and compresses one asset into its own
+     * blob (AddBlob() takes one that was encoded earlier, e.g. from the packer's build cache);
+     * Finish() appends the TOC and patches the header.
+     */
+    class AssetArchiveWriter
+    {
+        std::ofstream file;
+        AssetToc toc;
+        std::uint64_t rawTotal = 0;
+        std::uint64_t compressedTotal = 0;
+
+        void writeBlob(const AssetBlob& blob, AssetTocEntry& entry);
+
+      public:
+        explicit AssetArchiveWriter(const char* path);
+        [[nodiscard]] bool IsOpen() const;
+        [[nodiscard]] bool Contains(AssetType type, const std::string& key) const;
+
+        template <typename T>
+        void Add(AssetType type, const std::string& key, const T& asset)
+        {
+            AssetBlob blob;
+            if (EncodeAssetBlob(asset, blob))
+            {
+                AddBlob(type, key, blob);
+            }
+        }
+
+        void AddBlob(AssetType type, const std::string& key, const AssetBlob& blob);
+        void Finish();
+    };
+} // namespace sage
@@ -0,0 +1,219 @@
+#include "AssetStreamer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+namespace sage
+{
+    bool AssetHandle::IsValid() const
+    {
+        return state != nullptr;
+    }
+
+    bool AssetHandle::IsReady() const
+    {
+        return GetStatus() == AssetStreamStatus::Ready;
+    }
+
+    bool AssetHandle::IsDone() const
+    {
+        const auto status = GetStatus();
+        return status == AssetStreamStatus::Ready || status == AssetStreamStatus::Failed;
+    }
+
+    AssetStreamStatus AssetHandle::GetStatus() const
+    {
+        assert(state);
+        return state->status.load(std::memory_order_acquire);
+    }
+
+    AssetType AssetHandle::GetType() const
+    {
+        assert(state);
+        return state->type;
+    }
+
+    const std::string& AssetHandle::GetKey() const
+    {
+        assert(state);
+        return state->key;
+    }
+
+    AssetHandle::AssetHandle(std::shared_ptr<AssetStreamState> _state) : state(std::move(_state))
+    {
+    }
+
+    void DiscardDecodedAsset(DecodedAsset& asset)
+    {
+        if (auto* image = std::get_if<Image>(&asset.payload))
+        {
+            UnloadImage(*image);
+        }
+        else if (auto* info = std::get_if<DeferredModelInfo>(&asset.payload))
+        {
+            UnloadDeferredModel(info->model.model);
+        }
+        else if (auto* material = std::get_if<DeferredMaterial>(&asset.payload))
+        {
+            UnloadDeferredMaterial(*material);
+        }
+        asset.payload = std::monostate{};
+    }
+
+    void AssetStreamer::decode(DecodedAsset& out) const
+    {
+        const auto& key = out.state->key;
+        try
+        {
+            switch (out.state->type)
+            {
+            case AssetType::Image: {
+                Image image{};
+                if (!archive->Read(AssetType::Image, key, image)) break;
+                out.bytes = GetPixelDataSize(image.width, image.height, image.format);
+                out.payload = image;
+                break;
+            }
+            case AssetType::Model: {
+                DeferredModelInfo info;
+                if (!archive->Read(AssetType::Model, key, info)) break;
+                const Model& model = info.model.model;
+                for (int i = 0; i < model.meshCount; ++i)
+                {
+                    const Mesh& mesh = model.meshes[i];
+                    // Positions, normals, uvs, tangents + indices; close enough for budgeting.
+                    out.bytes += mesh.vertexCount * (3 + 3 + 2 + 4) * sizeof(float) +
+                                 mesh.triangleCount * 3 * sizeof(unsigned short);
+                }
+                out.payload = std::move(info);
+                break;
+            }
+            case AssetType::Material: {
+                DeferredMaterial material;
+                if (!archive->Read(AssetType::Material, key, material)) break;
+                for (const auto& map : material.maps)
+                {
+                    if (map.image.data)
+                        out.bytes += GetPixelDataSize(map.image.width, map.image.height, map.image.format);
+                }
+                out.payload = std::move(material);
+                break;
+            }
+            case AssetType::Animation: {
+                std::vector<AnimationClip> animations;
+                if (!archive->Read(AssetType::Animation, key, animations)) break;
+                for (const auto& anim : animations)
+                {
+                    out.bytes += anim.GetMemoryUsage();
+                }
+                out.payload = std::move(animations);
+                break;
+            }
+            case AssetType::Script:
+                break; // Read directly with ResourceManager::ReadScript
+            }
+        }
+        catch (const cereal::Exception& e)
+        {
+            std::cerr << "ERROR: AssetStreamer -> Failed to decode '" << key << "': " << e.what() << std::endl;
+            DiscardDecodedAsset(out);
+        }
+    }
+
+    void AssetStreamer::workerLoop()
+    {
+        while (true)
+        {
+            std::shared_ptr<AssetStreamState> state;
+            {
+                std::unique_lock lock(mutex);
+                jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                state = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            DecodedAsset result;
+            result.state = state;
+            decode(result);
+            state->status.store(
+                std::holds_alternative<std::monostate>(result.payload) ? AssetStreamStatus::Failed
+                                                                       : AssetStreamStatus::Decoded,
+                std::memory_order_release);
+
+            std::lock_guard lock(mutex);
+            decoded.push_back(std::move(result));
+        }
+    }
+
+    void AssetStreamer::Start(AssetArchiveReader* _archive, unsigned int workerCount)
+    {
+        assert(_archive != nullptr);
+        Stop();
+        archive = _archive;
+        stopping = false;
+        for (unsigned int i = 0; i < std::max(workerCount, 1u); ++i)
+        {
+            workers.emplace_back(&AssetStreamer::workerLoop, this);
+        }
+    }
+
+    // Joins the workers. Queued jobs are dropped and decoded-but-uninstalled data is freed; their
+    // handles are marked failed.
+    void AssetStreamer::Stop()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+
+        for (const auto& state : jobs)
+        {
+            state->status.store(AssetStreamStatus::Failed, std::memory_order_release);
+        }
+        jobs.clear();
+        for (auto& asset : decoded)
+        {
+            DiscardDecodedAsset(asset);
+            asset.state->status.store(AssetStreamStatus::Failed, std::memory_order_release);
+        }
+        decoded.clear();
+        archive = nullptr;
+    }
+
+    bool AssetStreamer::IsRunning() const
+    {
+        return !workers.empty();
+    }
+
+    void AssetStreamer::Enqueue(std::shared_ptr<AssetStreamState> state)
+    {
+        assert(IsRunning());
+        {
+            std::lock_guard lock(mutex);
+            jobs.push_back(std::move(state));
+        }
+        jobAvailable.notify_one();
+    }
+
+    bool AssetStreamer::PopDecoded(DecodedAsset& out)
+    {
+        std::lock_guard lock(mutex);
+        if (decoded.empty()) return false;
+        out = std::move(decoded.front());
+        decoded.pop_front();
+        return true;
+    }
+
+    AssetStreamer::~AssetStreamer()
+    {
+        Stop();
+    }
+} // namespace sage
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "AnimationClip.hpp"
+#include "AssetArchive.hpp"
+#include "raylib-cereal.hpp"
+
+#include "raylib.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace sage
+{
+    enum class AssetStreamStatus : std::uint8_t
+    {
+        Pending, // Queued or being decoded on a worker
+        Decoded, // CPU data ready, waiting for the main thread to upload it
+        Ready,   // Resident in ResourceManager
+        Failed   // Not in the archive, or the blob could not be decoded
+    };
+
+    struct AssetStreamState
+    {
+        const AssetType type;
+        const std::string key;
+        std::atomic<AssetStreamStatus> status;
+
+        AssetStreamState(AssetType _type, std::string _key, AssetStreamStatus _status = AssetStreamStatus::Pending)
+            : type(_type), key(std::move(_key)), status(_status)
+        {
+        }
+    };
+
+    /**
+     * Copyable handle to an asset streaming in from the archive. Poll it from the main thread;
+     * once IsReady() the asset can be fetched through the usual ResourceManager getters without
+     * touching the disk.
+     */
+    class AssetHandle
+    {
+        std::shared_ptr<AssetStreamState> state;
+
+      public:
+        [[nodiscard]] bool IsValid() const;
+        [[nodiscard]] bool IsReady() const;
+        // Ready or failed; either way, nothing further will happen to this asset.
+        [[nodiscard]] bool IsDone() const;
+        [[nodiscard]] AssetStreamStatus GetStatus() const;
+        [[nodiscard]] AssetType GetType() const;
+        [[nodiscard]] const std::string& GetKey() const;
+
+        AssetHandle() = default;
+        explicit AssetHandle(std::shared_ptr<AssetStreamState> _state);
+    };
+
+    // Same wire format as ModelInfo, decoded without touching the GPU.
+    struct DeferredModelInfo
+    {
+        DeferredModel model;
+        std::vector<std::string> materialNames;
+        std::string sourcePath;
+        // Set once the model's missing materials have been queued for streaming.
+        bool materialsRequested = false;
+
+        template <class Archive>
+        void load(Archive& archive)
+        {
+            archive(model, materialNames, sourcePath);
+        }
+    };
+
+    // CPU-side result of a streaming job, waiting for the main thread to upload it.
+    struct DecodedAsset
+    {
+        std::shared_ptr<AssetStreamState> state;
+        std::variant<std::monostate, Image, DeferredModelInfo, DeferredMaterial, std::vector<AnimationClip>>
+            payload;
+        // Approximate size of the data to be uploaded/installed, used for the per-frame budget.
+        std::size_t bytes = 0;
+    };
+
+    // Frees a decoded payload that will not be installed. Safe off the main thread.
+    void DiscardDecodedAsset(DecodedAsset& asset);
+
+    /*
+     * Worker pool that reads, inflates and deserialises archive blobs off the main thread
+     * (PNG decode, mesh deserialisation). Nothing here touches the GPU or ResourceManager's
+     * maps; results are handed back through PopDecoded for the main thread to install.
+     */
+    class AssetStreamer
+    {
+        AssetArchiveReader* archive = nullptr;
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable jobAvailable;
+        std::deque<std::shared_ptr<AssetStreamState>> jobs;
+        std::deque<DecodedAsset> decoded;
+        bool stopping = false;
+
+        void workerLoop();
+        void decode(DecodedAsset& out) const;
+
+      public:
+        void Start(AssetArchiveReader* _archive, unsigned int workerCount);
+        void Stop();
+        [[nodiscard]] bool IsRunning() const;
+        void Enqueue(std::shared_ptr<AssetStreamState> state);
+        bool PopDecoded(DecodedAsset& out);
+
+        AssetStreamer() = default;
+        ~AssetStreamer();
+        AssetStreamer(const AssetStreamer&) = delete;
+        AssetStreamer& operator=(const AssetStreamer&) = delete;
+    };
+} // namespace sage
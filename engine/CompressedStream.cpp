@@ -0,0 +1,162 @@
+#include "CompressedStream.hpp"
+
+#include "raylib/src/external/sdefl.h"
+#include "raylib/src/external/sinfl.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace sage
+{
+    namespace
+    {
+        // Same level raylib's CompressData uses.
+        constexpr int DEFLATE_LEVEL = 8;
+        // Sanity limit on a chunk header, so a corrupt file can't request an absurd allocation.
+        constexpr std::uint32_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+    } // namespace
+
+    bool DeflateStreamBuf::writeChunk()
+    {
+        const auto chunkSize = static_cast<std::uint32_t>(pptr() - pbase());
+        if (chunkSize == 0) return true;
+
+        compressed.resize(static_cast<std::size_t>(sdefl_bound(static_cast<int>(chunkSize))));
+        const int compSize =
+            sdeflate(deflater.get(), compressed.data(), pbase(), static_cast<int>(chunkSize), DEFLATE_LEVEL);
+        if (compSize <= 0)
+        {
+            std::cerr << "ERROR: DeflateStreamBuf -> Compression failed." << std::endl;
+            failed = true;
+            return false;
+        }
+
+        const auto compSize32 = static_cast<std::uint32_t>(compSize);
+        sink.write(reinterpret_cast<const char*>(&chunkSize), sizeof(chunkSize));
+        sink.write(reinterpret_cast<const char*>(&compSize32), sizeof(compSize32));
+        sink.write(reinterpret_cast<const char*>(compressed.data()), compSize);
+        if (!sink) failed = true;
+
+        rawSize += chunkSize;
+        compressedSize += sizeof(chunkSize) + sizeof(compSize32) + compSize32;
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return !failed;
+    }
+
+    DeflateStreamBuf::int_type DeflateStreamBuf::overflow(int_type ch)
+    {
+        if (finished || !writeChunk()) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int DeflateStreamBuf::sync()
+    {
+        // Chunks are only cut when full (or at Finish) to keep the ratio up; nothing to do here.
+        return failed ? -1 : 0;
+    }
+
+    bool DeflateStreamBuf::Finish()
+    {
+        if (finished) return !failed;
+        writeChunk();
+        constexpr std::uint32_t endMarker = 0;
+        sink.write(reinterpret_cast<const char*>(&endMarker), sizeof(endMarker));
+        compressedSize += sizeof(endMarker);
+        finished = true;
+        if (!sink) failed = true;
+        return !failed;
+    }
+
+    std::uint64_t DeflateStreamBuf::GetRawSize() const
+    {
+        return rawSize;
+    }
+
+    std::uint64_t DeflateStreamBuf::GetCompressedSize() const
+    {
+        return compressedSize;
+    }
+
+    DeflateStreamBuf::DeflateStreamBuf(std::ostream& _sink, std::uint32_t chunkSize)
+        : sink(_sink), deflater(std::make_unique<sdefl>()), buffer(chunkSize)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    DeflateStreamBuf::~DeflateStreamBuf()
+    {
+        Finish();
+    }
+
+    InflateStreamBuf::int_type InflateStreamBuf::underflow()
+    {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+        if (ended || failed) return traits_type::eof();
+
+        std::uint32_t chunkSize = 0;
+        std::uint32_t compSize = 0;
+        if (!read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize)))
+        {
+            failed = true;
+            return traits_type::eof();
+        }
+        if (chunkSize == 0)
+        {
+            ended = true;
+            return traits_type::eof();
+        }
+        if (chunkSize > MAX_CHUNK_SIZE || !read(reinterpret_cast<char*>(&compSize), sizeof(compSize)) ||
+            compSize > MAX_CHUNK_SIZE)
+        {
+            failed = true;
+            return traits_type::eof();
+        }
+
+        compressed.resize(compSize);
+        buffer.resize(chunkSize);
+        if (!read(reinterpret_cast<char*>(compressed.data()), compSize) ||
+            sinflate(buffer.data(), static_cast<int>(chunkSize), compressed.data(), static_cast<int>(compSize)) !=
+                static_cast<int>(chunkSize))
+        {
+            std::cerr << "ERROR: InflateStreamBuf -> Corrupt or truncated chunk." << std::endl;
+            failed = true;
+            return traits_type::eof();
+        }
+
+        rawSize += chunkSize;
+        setg(buffer.data(), buffer.data(), buffer.data() + chunkSize);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    bool InflateStreamBuf::IsEnded() const
+    {
+        return ended;
+    }
+
+    bool InflateStreamBuf::Failed() const
+    {
+        return failed;
+    }
+
+    std::uint64_t InflateStreamBuf::GetRawSize() const
+    {
+        return rawSize;
+    }
+
+    InflateStreamBuf::InflateStreamBuf(ReadFn _read) : read(std::move(_read))
+    {
+    }
+
+    InflateStreamBuf::InflateStreamBuf(std::istream& source)
+        : InflateStreamBuf([&source](char* dst, std::size_t n) {
+              source.read(dst, static_cast<std::streamsize>(n));
+              return static_cast<std::size_t>(source.gcount()) == n;
+          })
+    {
+    }
+} // namespace sage
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+/*
+ * Chunked DEFLATE streams. The payload is split into chunks that are compressed independently:
+ *
+ *   [uint32 rawSize][uint32 compressedSize][compressed bytes] ... [uint32 0]
+ *
+ * so a reader only ever needs one chunk (compressed + inflated) in memory, whatever the total
+ * size. Used under cereal's binary archives for the asset archive and map bins.
+ */
+
+struct sdefl;
+
+namespace sage
+{
+    // Raw bytes per chunk written by DeflateStreamBuf.
+    inline constexpr std::uint32_t COMPRESSED_CHUNK_SIZE = 256 * 1024;
+
+    class DeflateStreamBuf : public std::streambuf
+    {
+        std::ostream& sink;
+        std::unique_ptr<sdefl> deflater; // ~1 MiB of match tables, reused for every chunk
+        std::vector<char> buffer;
+        std::vector<unsigned char> compressed;
+        std::uint64_t rawSize = 0;
+        std::uint64_t compressedSize = 0;
+        bool finished = false;
+        bool failed = false;
+
+        bool writeChunk();
+
+      protected:
+        int_type overflow(int_type ch) override;
+        int sync() override;
+
+      public:
+        // Flushes the last chunk and writes the end marker. Returns false if anything failed.
+        bool Finish();
+        [[nodiscard]] std::uint64_t GetRawSize() const;
+        [[nodiscard]] std::uint64_t GetCompressedSize() const;
+
+        explicit DeflateStreamBuf(std::ostream& _sink, std::uint32_t chunkSize = COMPRESSED_CHUNK_SIZE);
+        ~DeflateStreamBuf() override;
+        DeflateStreamBuf(const DeflateStreamBuf&) = delete;
+        DeflateStreamBuf& operator=(const DeflateStreamBuf&) = delete;
+    };
+
+    class InflateStreamBuf : public std::streambuf
+    {
+      public:
+        // Fills dst with exactly n bytes of the compressed stream; returns false on a short read.
+        using ReadFn = std::function<bool(char* dst, std::size_t n)>;
+
+      private:
+        ReadFn read;
+        std::vector<unsigned char> compressed;
+        std::vector<char> buffer;
+        std::uint64_t rawSize = 0;
+        bool ended = false;
+        bool failed = false;
+
+      protected:
+        int_type underflow() override;
+
+      public:
+        // True once the end marker has been reached.
+        [[nodiscard]] bool IsEnded() const;
+        // True if the stream was truncated or a chunk did not inflate cleanly.
+        [[nodiscard]] bool Failed() const;
+        [[nodiscard]] std::uint64_t GetRawSize() const;
+
+        explicit InflateStreamBuf(ReadFn _read);
+        explicit InflateStreamBuf(std::istream& source);
+        InflateStreamBuf(const InflateStreamBuf&) = delete;
+        InflateStreamBuf& operator=(const InflateStreamBuf&) = delete;
+    };
+} // namespace sage
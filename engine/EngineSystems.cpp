@@ -12,6 +12,7 @@
 #include "GameUiEngine.hpp"
 #include "LightManager.hpp"
 #include "MousePicker.hpp"
+#include "SpatialQuery.hpp"
 #include "systems/ActorMovementSystem.hpp"
 #include "systems/AnimationSystem.hpp"
 #include "systems/CollisionSystem.hpp"
@@ -20,6 +21,8 @@
 #include "systems/SpatialAudioSystem.hpp"
 #include "systems/TransformSystem.hpp"
 #include "systems/UberShaderSystem.hpp"
+#include "systems/VisibilitySystem.hpp"
+#include "TimerWheel.hpp"
 #include "UserInput.hpp"
 
 #include <cassert>
@@ -36,10 +39,14 @@ namespace sage
           picker(std::make_unique<MousePicker>(_registry, this)),
           cursor(std::make_unique<Cursor>(_registry, this)),
           lightSubSystem(std::make_unique<LightManager>(_registry, camera.get())),
+          timerWheel(std::make_unique<TimerWheel>()),
           transformSystem(std::make_unique<TransformSystem>(_registry)),
           renderSystem(std::make_unique<RenderSystem>(_registry)),
           collisionSystem(std::make_unique<CollisionSystem>(_registry)),
           navigationGridSystem(std::make_unique<NavigationGridSystem>(_registry, collisionSystem.get())),
+          spatialQuery(std::make_unique<SpatialQuery>(
+              _registry, transformSystem.get(), navigationGridSystem.get())),
+          visibilitySystem(std::make_unique<VisibilitySystem>(_registry, navigationGridSystem.get())),
           actorMovementSystem(std::make_unique<ActorMovementSystem>(_registry, this)),
           animationSystem(std::make_unique<AnimationSystem>(_registry)),
           uberShaderSystem(std::make_unique<UberShaderSystem>(_registry, this)),
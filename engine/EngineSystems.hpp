@@ -22,18 +22,21 @@ namespace sage
     class Camera;
     class LightManager;
     class GameUIEngine;
+    class TimerWheel;
 
     // Systems group
     class TransformSystem;
     class RenderSystem;
     class CollisionSystem;
     class NavigationGridSystem;
+    class SpatialQuery;
     class ActorMovementSystem;
     class ControllableActorSystem;
     class AnimationSystem;
     class UberShaderSystem;
     class FullscreenTextOverlayManager;
     class SpatialAudioSystem;
+    class VisibilitySystem;
 
     class EngineSystems
     {
@@ -48,11 +51,14 @@ namespace sage
         std::unique_ptr<MousePicker> picker;
         std::unique_ptr<Cursor> cursor;
         std::unique_ptr<LightManager> lightSubSystem;
+        std::unique_ptr<TimerWheel> timerWheel;
 
         std::unique_ptr<TransformSystem> transformSystem;
         std::unique_ptr<RenderSystem> renderSystem;
         std::unique_ptr<CollisionSystem> collisionSystem;
         std::unique_ptr<NavigationGridSystem> navigationGridSystem;
+        std::unique_ptr<SpatialQuery> spatialQuery;
+        std::unique_ptr<VisibilitySystem> visibilitySystem;
         std::unique_ptr<ActorMovementSystem> actorMovementSystem;
         std::unique_ptr<AnimationSystem> animationSystem;
         std::unique_ptr<UberShaderSystem> uberShaderSystem;
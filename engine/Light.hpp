@@ -9,6 +9,35 @@
 
 namespace sage
 {
+    // Uniform locations of one lights[] slot in a lighting shader. Look up once per shader.
+    struct LightUniformLocs
+    {
+        int enabled = -1;
+        int type = -1;
+        int position = -1;
+        int target = -1;
+        int color = -1;
+        int brightness = -1;
+        int constant = -1;
+        int linear = -1;
+        int quadratic = -1;
+
+        LightUniformLocs() = default;
+        LightUniformLocs(const Shader shader, const int slot)
+        {
+            // NOTE: Lighting shader naming must be the provided ones
+            enabled = GetShaderLocation(shader, TextFormat("lights[%i].enabled", slot));
+            type = GetShaderLocation(shader, TextFormat("lights[%i].type", slot));
+            position = GetShaderLocation(shader, TextFormat("lights[%i].position", slot));
+            target = GetShaderLocation(shader, TextFormat("lights[%i].target", slot));
+            color = GetShaderLocation(shader, TextFormat("lights[%i].color", slot));
+            brightness = GetShaderLocation(shader, TextFormat("lights[%i].brightness", slot));
+            constant = GetShaderLocation(shader, TextFormat("lights[%i].constant", slot));
+            linear = GetShaderLocation(shader, TextFormat("lights[%i].linear", slot));
+            quadratic = GetShaderLocation(shader, TextFormat("lights[%i].quadratic", slot));
+        }
+    };
+
     struct Light
     {
         int type;
@@ -22,20 +51,9 @@ namespace sage
         float linear = 1.0;
         float quadratic = 0.5;
 
-        void LinkShader(const Shader shader, const int lightsCount) const
+        // Uploads this light into the lights[] slot whose locations are given.
+        void Upload(const Shader shader, const LightUniformLocs& locs) const
         {
-            // NOTE: Lighting shader naming must be the provided ones
-            int enabledLoc = GetShaderLocation(shader, TextFormat("lights[%i].enabled", lightsCount));
-            int typeLoc = GetShaderLocation(shader, TextFormat("lights[%i].type", lightsCount));
-            int positionLoc = GetShaderLocation(shader, TextFormat("lights[%i].position", lightsCount));
-            int targetLoc = GetShaderLocation(shader, TextFormat("lights[%i].target", lightsCount));
-            int colorLoc = GetShaderLocation(shader, TextFormat("lights[%i].color", lightsCount));
-            int brightnessLoc = GetShaderLocation(shader, TextFormat("lights[%i].brightness", lightsCount));
-            int constantLoc = GetShaderLocation(shader, TextFormat("lights[%i].constant", lightsCount));
-            int linearLoc = GetShaderLocation(shader, TextFormat("lights[%i].linear", lightsCount));
-            int quadraticLoc = GetShaderLocation(shader, TextFormat("lights[%i].quadratic", lightsCount));
-
-            // UpdateLightValues(shader, *this);
             float _position[3] = {position.x, position.y, position.z};
             float _target[3] = {target.x, target.y, target.z};
             float _color[4] = {
@@ -43,15 +61,16 @@ namespace sage
                 static_cast<float>(color.g) / static_cast<float>(255),
                 static_cast<float>(color.b) / static_cast<float>(255),
                 static_cast<float>(color.a) / static_cast<float>(255)};
-            SetShaderValue(shader, enabledLoc, &enabled, SHADER_UNIFORM_INT);
-            SetShaderValue(shader, typeLoc, &type, SHADER_UNIFORM_INT);
-            SetShaderValue(shader, positionLoc, _position, SHADER_UNIFORM_VEC3);
-            SetShaderValue(shader, targetLoc, _target, SHADER_UNIFORM_VEC3);
-            SetShaderValue(shader, colorLoc, _color, SHADER_UNIFORM_VEC4);
-            SetShaderValue(shader, brightnessLoc, &brightness, SHADER_UNIFORM_FLOAT);
-            SetShaderValue(shader, constantLoc, &constant, SHADER_UNIFORM_FLOAT);
-            SetShaderValue(shader, linearLoc, &linear, SHADER_UNIFORM_FLOAT);
-            SetShaderValue(shader, quadraticLoc, &quadratic, SHADER_UNIFORM_FLOAT);
+            int _enabled = enabled;
+            SetShaderValue(shader, locs.enabled, &_enabled, SHADER_UNIFORM_INT);
+            SetShaderValue(shader, locs.type, &type, SHADER_UNIFORM_INT);
+            SetShaderValue(shader, locs.position, _position, SHADER_UNIFORM_VEC3);
+            SetShaderValue(shader, locs.target, _target, SHADER_UNIFORM_VEC3);
+            SetShaderValue(shader, locs.color, _color, SHADER_UNIFORM_VEC4);
+            SetShaderValue(shader, locs.brightness, &brightness, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, locs.constant, &constant, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, locs.linear, &linear, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, locs.quadratic, &quadratic, SHADER_UNIFORM_FLOAT);
         }
 
         template <typename Archive>
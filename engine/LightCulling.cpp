@@ -0,0 +1,139 @@
+#include "LightCulling.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sage
+{
+    std::uint64_t LightGrid::cellKey(int x, int z)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(z);
+    }
+
+    int LightGrid::cellCoord(float v) const
+    {
+        return static_cast<int>(std::floor(v / cellSize));
+    }
+
+    void LightGrid::consider(int index, const BoundingBox& bounds, Vector3 centre) const
+    {
+        if (visited[index] == queryStamp) return;
+        visited[index] = queryStamp;
+
+        const auto& light = lights[index];
+        const Vector3 closest = Vector3Clamp(light.position, bounds.min, bounds.max);
+        if (Vector3DistanceSqr(closest, light.position) > light.radius * light.radius) return;
+
+        // Rank by brightness over distance to the centre, the dominant terms of the falloff.
+        const float distance = std::max(Vector3Distance(centre, light.position), 0.001f);
+        candidates.emplace_back(light.brightness / distance, index);
+    }
+
+    void LightGrid::Build(std::vector<LightCullSource> _lights)
+    {
+        lights = std::move(_lights);
+        directionalLights.clear();
+        unboundedLights.clear();
+        cells.clear();
+        visited.assign(lights.size(), 0);
+        queryStamp = 0;
+
+        for (int i = 0; i < static_cast<int>(lights.size()); ++i)
+        {
+            const auto& light = lights[i];
+            if (light.directional)
+            {
+                directionalLights.push_back(i);
+                continue;
+            }
+            if (!std::isfinite(light.radius) || light.radius > cellSize * 64)
+            {
+                unboundedLights.push_back(i);
+                continue;
+            }
+            const int minX = cellCoord(light.position.x - light.radius);
+            const int maxX = cellCoord(light.position.x + light.radius);
+            const int minZ = cellCoord(light.position.z - light.radius);
+            const int maxZ = cellCoord(light.position.z + light.radius);
+            for (int x = minX; x <= maxX; ++x)
+            {
+                for (int z = minZ; z <= maxZ; ++z)
+                {
+                    cells[cellKey(x, z)].push_back(i);
+                }
+            }
+        }
+    }
+
+    int LightGrid::Query(const BoundingBox& bounds, int* out, int maxLights) const
+    {
+        int count = 0;
+        for (const int i : directionalLights)
+        {
+            if (count == maxLights) return count;
+            out[count++] = i;
+        }
+
+        if (++queryStamp == 0)
+        {
+            std::ranges::fill(visited, 0);
+            queryStamp = 1;
+        }
+
+        const Vector3 centre = Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f);
+        candidates.clear();
+        for (const int i : unboundedLights)
+        {
+            consider(i, bounds, centre);
+        }
+        for (int x = cellCoord(bounds.min.x); x <= cellCoord(bounds.max.x); ++x)
+        {
+            for (int z = cellCoord(bounds.min.z); z <= cellCoord(bounds.max.z); ++z)
+            {
+                const auto it = cells.find(cellKey(x, z));
+                if (it == cells.end()) continue;
+                for (const int i : it->second)
+                {
+                    consider(i, bounds, centre);
+                }
+            }
+        }
+
+        const int take = std::min(maxLights - count, static_cast<int>(candidates.size()));
+        std::partial_sort(
+            candidates.begin(), candidates.begin() + take, candidates.end(), [](const auto& a, const auto& b) {
+                return a.first > b.first;
+            });
+        for (int i = 0; i < take; ++i)
+        {
+            out[count++] = candidates[i].second;
+        }
+        return count;
+    }
+
+    std::size_t LightGrid::GetLightCount() const
+    {
+        return lights.size();
+    }
+
+    std::size_t LightGrid::GetCellCount() const
+    {
+        return cells.size();
+    }
+
+    LightGrid::LightGrid(float _cellSize) : cellSize(_cellSize)
+    {
+    }
+
+    float LightRadius(float brightness, float constant, float linear, float quadratic, float cutoff)
+    {
+        // Solves brightness * (constant + linear / d + quadratic * 100 / d^2) = cutoff for d.
+        if (brightness <= 0) return 0;
+        const float c = cutoff / brightness - constant;
+        if (c <= 0) return std::numeric_limits<float>::infinity(); // Never falls below cutoff
+        return (linear + std::sqrt(linear * linear + 400.0f * quadratic * c)) / (2.0f * c);
+    }
+} // namespace sage
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// CPU light culling. Pure data in, indices out: no GPU or registry access, so it can be
+// exercised headless.
+
+namespace sage
+{
+    struct LightCullSource
+    {
+        Vector3 position{};
+        float radius = 0;     // Distance past which the light's contribution is negligible
+        float brightness = 0; // Used to rank lights that reach the same object
+        bool directional = false;
+    };
+
+    /*
+     * Buckets point lights into a uniform grid of cells on the XZ plane, each cell listing
+     * every light whose radius reaches it. Objects then only test the lights in the cells
+     * they overlap, and keep the strongest few.
+     */
+    class LightGrid
+    {
+        float cellSize;
+        std::vector<LightCullSource> lights;
+        std::vector<int> directionalLights;
+        // Point lights reaching too many cells to bucket (e.g. with a constant falloff term).
+        std::vector<int> unboundedLights;
+        std::unordered_map<std::uint64_t, std::vector<int>> cells;
+        // Scratch for Query: stamp per light so a light spanning several cells is tested once.
+        mutable std::vector<std::uint32_t> visited;
+        mutable std::uint32_t queryStamp = 0;
+        mutable std::vector<std::pair<float, int>> candidates;
+
+        void consider(int index, const BoundingBox& bounds, Vector3 centre) const;
+
+        [[nodiscard]] static std::uint64_t cellKey(int x, int z);
+        [[nodiscard]] int cellCoord(float v) const;
+
+      public:
+        void Build(std::vector<LightCullSource> _lights);
+        /* Writes up to maxLights indices (into the list given to Build) of the lights that reach
+        bounds, directional lights first, then point lights by estimated contribution at the
+        centre of bounds. Returns the number written. */
+        int Query(const BoundingBox& bounds, int* out, int maxLights) const;
+        [[nodiscard]] std::size_t GetLightCount() const;
+        [[nodiscard]] std::size_t GetCellCount() const;
+
+        explicit LightGrid(float _cellSize = 16.0f);
+    };
+
+    // Distance at which a light with the shader's falloff drops below cutoff.
+    [[nodiscard]] float LightRadius(float brightness, float constant, float linear, float quadratic, float cutoff);
+} // namespace sage
@@ -3,44 +3,119 @@
 #include "LightManager.hpp"
 
 #include "Camera.hpp"
+#include "components/Collideable.hpp"
 #include "components/Renderable.hpp"
-#include "Light.hpp"
+#include "components/sgTransform.hpp"
+#include "components/StaticInstanceGroup.hpp"
+#include "components/StaticMeshBatch.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 namespace sage
 {
-    void LightManager::updateShaderLights(Shader& _shader)
+    namespace
     {
-        updateAmbientLight(_shader);
-        lightsCount = 0;
+        // Contribution below which a point light is treated as not reaching an object.
+        constexpr float LIGHT_CUTOFF = 0.05f;
+
+        bool SameBounds(const BoundingBox& a, const BoundingBox& b)
+        {
+            return std::memcmp(&a, &b, sizeof(BoundingBox)) == 0;
+        }
+    } // namespace
+
+    // Rebuilds the light list and culling grid. Assignments made against the old list are dropped.
+    void LightManager::rebuildLights()
+    {
+        lightEntities.clear();
+        std::vector<LightCullSource> sources;
         for (const auto view = registry->view<Light>(); auto& entity : view)
         {
             auto& light = registry->get<Light>(entity);
-            if (lightsCount < MAX_LIGHTS)
+            light.enabled = true;
+            lightEntities.push_back(entity);
+            sources.push_back(
+                {light.position,
+                 LightRadius(light.brightness, light.constant, light.linear, light.quadratic, LIGHT_CUTOFF),
+                 light.brightness,
+                 light.type == LIGHT_DIRECTIONAL});
+        }
+        grid.Build(std::move(sources));
+        lightsDirty = false;
+
+        for (auto [entity, assignment] : registry->view<LightAssignment>().each())
+        {
+            assignment.valid = false;
+        }
+        for (auto& binding : shaders)
+        {
+            binding.uploadedCount = -1;
+            updateShaderGlobals(binding);
+        }
+    }
+
+    void LightManager::updateShaderGlobals(const ShaderLightBinding& binding) const
+    {
+        float ambientValue[4] = {ambient[0], ambient[1], ambient[2], ambient[3]};
+        SetShaderValue(binding.shader, binding.ambientLoc, ambientValue, SHADER_UNIFORM_VEC4);
+        SetShaderValue(binding.shader, binding.gammaLoc, &gamma, SHADER_UNIFORM_FLOAT);
+    }
+
+    BoundingBox LightManager::objectBounds(entt::entity entity) const
+    {
+        if (const auto* batch = registry->try_get<StaticMeshBatch>(entity)) return batch->bounds;
+        if (const auto* group = registry->try_get<StaticInstanceGroup>(entity)) return group->bounds;
+        if (const auto* col = registry->try_get<Collideable>(entity)) return col->worldBoundingBox;
+        const auto& pos = registry->get<sgTransform>(entity).GetWorldPos();
+        return {pos, pos};
+    }
+
+    // Called just before the entity is drawn: uploads its lights to the shaders it uses, unless
+    // the shader already holds exactly that list (neighbouring objects usually share one).
+    void LightManager::applyObjectLights(entt::entity entity)
+    {
+        if (lightsDirty) rebuildLights();
+
+        auto& assignment = registry->get<LightAssignment>(entity);
+        if (!assignment.valid && registry->all_of<sgTransform>(entity))
+        {
+            assignment.bounds = objectBounds(entity);
+            assignment.count = grid.Query(assignment.bounds, assignment.lights.data(), MAX_OBJECT_LIGHTS);
+            assignment.valid = true;
+        }
+
+        const auto* model = registry->get<Renderable>(entity).GetModel();
+        if (!model) return;
+        for (auto& binding : shaders)
+        {
+            bool used = false;
+            for (int i = 0; i < model->GetMaterialCount() && !used; ++i)
             {
-                light.enabled = true;
-                light.LinkShader(_shader, lightsCount);
-                lightsCount++;
+                used = model->GetShader(i).id == binding.shader.id;
             }
-            else
+            if (!used) continue;
+
+            if (binding.uploadedCount == assignment.count &&
+                std::equal(
+                    assignment.lights.begin(), assignment.lights.begin() + assignment.count, binding.uploaded.begin()))
             {
-                std::cout << "Scene: Max light sources reached. \n";
-                break;
+                continue;
             }
-        }
 
-        auto lightsCountLoc = GetShaderLocation(_shader, "lightsCount");
-        SetShaderValue(_shader, lightsCountLoc, &lightsCount, SHADER_UNIFORM_INT);
-        auto gammaLoc = GetShaderLocation(_shader, "gamma");
-        SetShaderValue(_shader, gammaLoc, &gamma, SHADER_UNIFORM_FLOAT);
+            for (int i = 0; i < assignment.count; ++i)
+            {
+                registry->get<Light>(lightEntities[assignment.lights[i]]).Upload(binding.shader, binding.lights[i]);
+            }
+            SetShaderValue(binding.shader, binding.lightsCountLoc, &assignment.count, SHADER_UNIFORM_INT);
+            binding.uploaded = assignment.lights;
+            binding.uploadedCount = assignment.count;
+        }
     }
 
-    void LightManager::updateAmbientLight(Shader& _shader) const
+    void LightManager::onLightChanged(entt::entity)
     {
-        auto ambientLoc = GetShaderLocation(_shader, "ambient");
-        float ambientValue[4] = {ambient[0], ambient[1], ambient[2], ambient[3]};
-        SetShaderValue(_shader, ambientLoc, ambientValue, SHADER_UNIFORM_VEC4);
+        lightsDirty = true;
     }
 
     void LightManager::RemoveLight(entt::entity light)
@@ -52,63 +127,88 @@ namespace sage
     entt::entity LightManager::CreateLight(
         int type, Vector3 position, Vector3 target, Color color, float intensity)
     {
-        if (lightsCount < MAX_LIGHTS)
-        {
-            auto entity = registry->create();
-            auto& light = registry->emplace<Light>(entity);
-            light.type = type;
-            light.position = position;
-            light.target = target;
-            light.color = color;
-            light.brightness = intensity;
-            RefreshLights();
-            return entity;
-        }
-        std::cout << "Scene: Max light sources reached. Ignoring. \n";
-        return entt::null;
+        auto entity = registry->create();
+        auto& light = registry->emplace<Light>(entity);
+        light.type = type;
+        light.position = position;
+        light.target = target;
+        light.color = color;
+        light.brightness = intensity;
+        RefreshLights();
+        return entity;
     }
 
     void LightManager::LinkShaderToLights(Shader& _shader)
     {
-        auto it = std::find_if(shaders.begin(), shaders.end(), [&_shader](const Shader& existingShader) {
-            return existingShader.id == _shader.id;
+        auto it = std::find_if(shaders.begin(), shaders.end(), [&_shader](const ShaderLightBinding& existing) {
+            return existing.shader.id == _shader.id;
         });
 
         if (it == shaders.end())
         {
-            shaders.push_back(_shader);
+            ShaderLightBinding binding;
+            binding.shader = _shader;
+            for (int i = 0; i < MAX_OBJECT_LIGHTS; ++i)
+            {
+                binding.lights[i] = LightUniformLocs(_shader, i);
+            }
+            binding.lightsCountLoc = GetShaderLocation(_shader, "lightsCount");
+            binding.gammaLoc = GetShaderLocation(_shader, "gamma");
+            binding.ambientLoc = GetShaderLocation(_shader, "ambient");
+            shaders.push_back(binding);
+            it = shaders.end() - 1;
         }
-        updateAmbientLight(_shader);
-        updateShaderLights(_shader);
+        updateShaderGlobals(*it);
+        // No lights until an object using the shader is drawn.
+        const int none = 0;
+        SetShaderValue(it->shader, it->lightsCountLoc, &none, SHADER_UNIFORM_INT);
+        it->uploadedCount = 0;
     }
 
     void LightManager::SetAmbientLight(float r, float g, float b, float a)
     {
         ambient = {r, g, b, a};
-        RefreshLights();
+        for (const auto& binding : shaders)
+        {
+            updateShaderGlobals(binding);
+        }
     }
 
     void LightManager::SetGamma(float g)
     {
         gamma = g;
-        RefreshLights();
+        for (const auto& binding : shaders)
+        {
+            updateShaderGlobals(binding);
+        }
     }
 
+    // Call after editing Light components in place; creation/removal is picked up automatically.
     void LightManager::RefreshLights()
     {
-        for (auto& _shader : shaders)
-        {
-            updateShaderLights(_shader);
-        }
+        rebuildLights();
     }
 
-    void LightManager::LinkRenderableToLight(entt::entity entity) const
+    void LightManager::LinkRenderableToLight(entt::entity entity)
     {
         auto& renderable = registry->get<Renderable>(entity);
         for (int i = 0; i < renderable.GetModel()->GetMaterialCount(); ++i)
         {
             renderable.GetModel()->SetShader(defaultShader, i);
         }
+        TrackRenderable(entity);
+    }
+
+    void LightManager::TrackRenderable(entt::entity entity)
+    {
+        if (registry->all_of<LightAssignment>(entity)) return;
+        registry->emplace<LightAssignment>(entity);
+
+        auto& renderable = registry->get<Renderable>(entity);
+        renderable.reqShaderUpdate = [this, previous = std::move(renderable.reqShaderUpdate)](entt::entity e) {
+            applyObjectLights(e);
+            if (previous) previous(e);
+        };
     }
 
     void LightManager::DrawDebugLights() const
@@ -123,18 +223,35 @@ namespace sage
         }
     }
 
-    void LightManager::Update() const
+    void LightManager::Update()
     {
         auto [x, y, z] = camera->GetPosition();
         const float cameraPos[3] = {x, y, z};
-        for (auto& shader : shaders)
+        for (auto& binding : shaders)
         {
-            SetShaderValue(shader, shader.locs[SHADER_LOC_VECTOR_VIEW], cameraPos, SHADER_UNIFORM_VEC3);
+            SetShaderValue(
+                binding.shader, binding.shader.locs[SHADER_LOC_VECTOR_VIEW], cameraPos, SHADER_UNIFORM_VEC3);
+        }
+
+        if (lightsDirty) rebuildLights();
+
+        // Re-cull only objects that moved since their lights were assigned.
+        for (const auto view = registry->view<LightAssignment, sgTransform>(); auto entity : view)
+        {
+            auto& assignment = view.get<LightAssignment>(entity);
+            const BoundingBox bounds = objectBounds(entity);
+            if (assignment.valid && SameBounds(bounds, assignment.bounds)) continue;
+            assignment.bounds = bounds;
+            assignment.count = grid.Query(bounds, assignment.lights.data(), MAX_OBJECT_LIGHTS);
+            assignment.valid = true;
         }
     }
 
     LightManager::LightManager(entt::registry* _registry, Camera* _camera) : registry(_registry), camera(_camera)
     {
+        registry->on_construct<Light>().connect<&LightManager::onLightChanged>(this);
+        registry->on_destroy<Light>().connect<&LightManager::onLightChanged>(this);
+
         defaultShader = ResourceManager::GetInstance().ShaderLoad(
             "resources/shaders/custom/lighting.vs", "resources/shaders/custom/lighting.fs");
 
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "Light.hpp"
+#include "LightCulling.hpp"
+
 #include "entt/entt.hpp"
 #include "raylib.h"
 
-#define MAX_LIGHTS 50 // Max dynamic lights supported by shader
+#include <array>
+#include <vector>
+
+#define MAX_OBJECT_LIGHTS 8 // Lights per object supported by shader (see include/lighting.fs)
 
 namespace sage
 {
     class Camera;
-    struct Light;
 
     enum LightType
     {
@@ -16,17 +21,43 @@ namespace sage
         LIGHT_POINT
     };
 
+    // The lights assigned to a lit renderable this frame, as indices into LightManager's light list.
+    struct LightAssignment
+    {
+        std::array<int, MAX_OBJECT_LIGHTS> lights{};
+        int count = 0;
+        BoundingBox bounds{}; // Bounds the assignment was made for
+        bool valid = false;
+    };
+
     class LightManager
     {
+        // Uniform locations of a linked shader, looked up once, plus what it currently holds.
+        struct ShaderLightBinding
+        {
+            Shader shader{};
+            std::array<LightUniformLocs, MAX_OBJECT_LIGHTS> lights{};
+            int lightsCountLoc = -1;
+            int gammaLoc = -1;
+            int ambientLoc = -1;
+            std::array<int, MAX_OBJECT_LIGHTS> uploaded{};
+            int uploadedCount = -1; // -1: nothing uploaded since the lights last changed
+        };
+
         entt::registry* registry;
         Camera* camera;
         Shader defaultShader{};
-        std::vector<Shader> shaders;
-        int lightsCount = 0;
+        std::vector<ShaderLightBinding> shaders;
+        std::vector<entt::entity> lightEntities; // Index space of LightAssignment/LightGrid
+        LightGrid grid;
+        bool lightsDirty = true;
         float gamma = 1.9;
         std::array<float, 4> ambient{};
-        void updateShaderLights(Shader& _shader);
-        void updateAmbientLight(Shader& _shader) const;
+        void rebuildLights();
+        void updateShaderGlobals(const ShaderLightBinding& binding) const;
+        void applyObjectLights(entt::entity entity);
+        void onLightChanged(entt::entity);
+        [[nodiscard]] BoundingBox objectBounds(entt::entity entity) const;
 
       public:
         void RemoveLight(entt::entity light);
@@ -40,9 +71,11 @@ namespace sage
         void SetAmbientLight(float r, float g, float b, float a);
         void SetGamma(float g);
         void RefreshLights();
-        void LinkRenderableToLight(entt::entity entity) const;
+        void LinkRenderableToLight(entt::entity entity);
+        // Gives a renderable drawn with a linked shader its own nearest-lights list.
+        void TrackRenderable(entt::entity entity);
         void DrawDebugLights() const;
-        void Update() const;
+        void Update();
         explicit LightManager(entt::registry* _registry, Camera* _camera);
     };
 } // namespace sage
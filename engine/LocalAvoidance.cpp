@@ -0,0 +1,376 @@
+#include "LocalAvoidance.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace sage
+{
+    namespace
+    {
+        constexpr float PARALLEL_EPSILON = 0.00001f;
+        constexpr std::uint32_t MIN_BUCKETS = 64;
+        // Turns the preferred velocity slightly (clockwise seen from above) whenever neighbours constrain it,
+        // so everyone sidesteps the same way. Without it, exactly opposed agents brake head-on forever.
+        constexpr float SIDESTEP_BIAS = 0.05f;
+
+        float det(const Vector2 a, const Vector2 b)
+        {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        template <typename Line>
+        bool linearProgram1(
+            const std::vector<Line>& lines,
+            const std::size_t lineNo,
+            const float radius,
+            const Vector2 optVelocity,
+            const bool directionOpt,
+            Vector2& result)
+        {
+            const auto& line = lines[lineNo];
+            const float dot = Vector2DotProduct(line.point, line.direction);
+            const float discriminant = dot * dot + radius * radius - Vector2LengthSqr(line.point);
+            // Max speed circle fully invalidates this line.
+            if (discriminant < 0) return false;
+
+            const float sqrtDiscriminant = std::sqrt(discriminant);
+            float tLeft = -dot - sqrtDiscriminant;
+            float tRight = -dot + sqrtDiscriminant;
+
+            for (std::size_t i = 0; i < lineNo; ++i)
+            {
+                const float denominator = det(line.direction, lines[i].direction);
+                const float numerator = det(lines[i].direction, Vector2Subtract(line.point, lines[i].point));
+
+                if (std::fabs(denominator) <= PARALLEL_EPSILON)
+                {
+                    // Parallel lines; either this one is fully invalid or the other adds nothing.
+                    if (numerator < 0) return false;
+                    continue;
+                }
+
+                const float t = numerator / denominator;
+                if (denominator >= 0)
+                {
+                    tRight = std::min(tRight, t);
+                }
+                else
+                {
+                    tLeft = std::max(tLeft, t);
+                }
+                if (tLeft > tRight) return false;
+            }
+
+            float t;
+            if (directionOpt)
+            {
+                t = Vector2DotProduct(optVelocity, line.direction) > 0 ? tRight : tLeft;
+            }
+            else
+            {
+                t = std::clamp(Vector2DotProduct(line.direction, Vector2Subtract(optVelocity, line.point)), tLeft, tRight);
+            }
+            result = Vector2Add(line.point, Vector2Scale(line.direction, t));
+            return true;
+        }
+
+        // Returns the number of lines satisfied before one failed (lines.size() on success).
+        template <typename Line>
+        std::size_t linearProgram2(
+            const std::vector<Line>& lines,
+            const float radius,
+            const Vector2 optVelocity,
+            const bool directionOpt,
+            Vector2& result)
+        {
+            if (directionOpt)
+            {
+                // optVelocity is a unit direction here.
+                result = Vector2Scale(optVelocity, radius);
+            }
+            else if (Vector2LengthSqr(optVelocity) > radius * radius)
+            {
+                result = Vector2Scale(Vector2Normalize(optVelocity), radius);
+            }
+            else
+            {
+                result = optVelocity;
+            }
+
+            for (std::size_t i = 0; i < lines.size(); ++i)
+            {
+                if (det(lines[i].direction, Vector2Subtract(lines[i].point, result)) <= 0) continue;
+                const Vector2 previous = result;
+                if (!linearProgram1(lines, i, radius, optVelocity, directionOpt, result))
+                {
+                    result = previous;
+                    return i;
+                }
+            }
+            return lines.size();
+        }
+
+        // Infeasible: minimise the largest penetration into any half-plane, starting at beginLine.
+        template <typename Line>
+        void linearProgram3(
+            const std::vector<Line>& lines,
+            std::vector<Line>& projectedLines,
+            const std::size_t beginLine,
+            const float radius,
+            Vector2& result)
+        {
+            float distance = 0;
+            for (std::size_t i = beginLine; i < lines.size(); ++i)
+            {
+                if (det(lines[i].direction, Vector2Subtract(lines[i].point, result)) <= distance) continue;
+
+                projectedLines.clear();
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    Line projected{};
+                    const float determinant = det(lines[i].direction, lines[j].direction);
+                    if (std::fabs(determinant) <= PARALLEL_EPSILON)
+                    {
+                        // Same direction: nothing to project. Opposite: meet halfway.
+                        if (Vector2DotProduct(lines[i].direction, lines[j].direction) > 0) continue;
+                        projected.point = Vector2Scale(Vector2Add(lines[i].point, lines[j].point), 0.5f);
+                    }
+                    else
+                    {
+                        const float t =
+                            det(lines[j].direction, Vector2Subtract(lines[i].point, lines[j].point)) / determinant;
+                        projected.point = Vector2Add(lines[i].point, Vector2Scale(lines[i].direction, t));
+                    }
+                    projected.direction = Vector2Normalize(Vector2Subtract(lines[j].direction, lines[i].direction));
+                    projectedLines.push_back(projected);
+                }
+
+                const Vector2 previous = result;
+                if (linearProgram2(
+                        projectedLines, radius, {-lines[i].direction.y, lines[i].direction.x}, true, result) <
+                    projectedLines.size())
+                {
+                    // Can only fail through floating point error; keep the last good result.
+                    result = previous;
+                }
+                distance = det(lines[i].direction, Vector2Subtract(lines[i].point, result));
+            }
+        }
+    } // namespace
+
+    int LocalAvoidance::cellCoord(const float v) const
+    {
+        return static_cast<int>(std::floor(v / config.neighbourDistance));
+    }
+
+    std::uint32_t LocalAvoidance::bucketOf(const int x, const int z) const
+    {
+        const auto h = static_cast<std::uint32_t>(x) * 73856093u ^ static_cast<std::uint32_t>(z) * 19349663u;
+        return h & bucketMask;
+    }
+
+    void LocalAvoidance::buildBuckets()
+    {
+        const auto count = static_cast<std::uint32_t>(agents.size());
+        const std::uint32_t bucketCount = std::max(MIN_BUCKETS, std::bit_ceil(count * 2));
+        bucketMask = bucketCount - 1;
+
+        bucketStart.assign(bucketCount + 1, 0);
+        for (const auto& agent : agents)
+        {
+            ++bucketStart[bucketOf(cellCoord(agent.position.x), cellCoord(agent.position.y)) + 1];
+        }
+        for (std::uint32_t b = 0; b < bucketCount; ++b)
+        {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        bucketCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+        sortedAgents.resize(count);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const auto& position = agents[i].position;
+            sortedAgents[bucketCursor[bucketOf(cellCoord(position.x), cellCoord(position.y))]++] = i;
+        }
+    }
+
+    // Closest first, ties broken by index, so the result does not depend on bucket order.
+    std::size_t LocalAvoidance::findNeighbours(
+        const std::uint32_t index, std::array<Neighbour, MAX_NEIGHBOURS>& out) const
+    {
+        const Vector2 position = agents[index].position;
+        const float rangeSq = config.neighbourDistance * config.neighbourDistance;
+        const int cx = cellCoord(position.x);
+        const int cz = cellCoord(position.y);
+
+        auto closer = [](const Neighbour& a, const Neighbour& b) {
+            return a.distanceSq < b.distanceSq || (a.distanceSq == b.distanceSq && a.index < b.index);
+        };
+
+        std::size_t found = 0;
+        std::array<std::uint32_t, 9> visited{};
+        std::size_t visitedCount = 0;
+        for (int x = cx - 1; x <= cx + 1; ++x)
+        {
+            for (int z = cz - 1; z <= cz + 1; ++z)
+            {
+                // Distinct cells can hash to the same bucket; scan each bucket once.
+                const auto bucket = bucketOf(x, z);
+                const auto visitedEnd = visited.begin() + static_cast<std::ptrdiff_t>(visitedCount);
+                if (std::find(visited.begin(), visitedEnd, bucket) != visitedEnd) continue;
+                visited[visitedCount++] = bucket;
+
+                for (auto k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k)
+                {
+                    const auto other = sortedAgents[k];
+                    if (other == index) continue;
+                    const float distanceSq = Vector2DistanceSqr(position, agents[other].position);
+                    if (distanceSq >= rangeSq) continue;
+
+                    const Neighbour candidate{distanceSq, other};
+                    if (found == MAX_NEIGHBOURS && !closer(candidate, out[found - 1])) continue;
+                    std::size_t slot = found < MAX_NEIGHBOURS ? found++ : found - 1;
+                    while (slot > 0 && closer(candidate, out[slot - 1]))
+                    {
+                        out[slot] = out[slot - 1];
+                        --slot;
+                    }
+                    out[slot] = candidate;
+                }
+            }
+        }
+        return found;
+    }
+
+    Vector2 LocalAvoidance::solveAgent(const std::uint32_t index)
+    {
+        const auto& agent = agents[index];
+        std::array<Neighbour, MAX_NEIGHBOURS> neighbours{};
+        const std::size_t neighbourCount = findNeighbours(index, neighbours);
+        const float invTimeHorizon = 1.0f / config.timeHorizon;
+
+        lines.clear();
+        for (std::size_t n = 0; n < neighbourCount; ++n)
+        {
+            const auto& other = agents[neighbours[n].index];
+            const Vector2 relativePosition = Vector2Subtract(other.position, agent.position);
+            const Vector2 relativeVelocity = Vector2Subtract(agent.velocity, other.velocity);
+            const float distanceSq = Vector2LengthSqr(relativePosition);
+            const float combinedRadius = agent.radius + other.radius;
+            const float combinedRadiusSq = combinedRadius * combinedRadius;
+
+            Line line{};
+            Vector2 u{};
+            if (distanceSq > combinedRadiusSq)
+            {
+                // Vector from the cut-off circle's centre to the relative velocity.
+                const Vector2 w = Vector2Subtract(relativeVelocity, Vector2Scale(relativePosition, invTimeHorizon));
+                const float wLengthSq = Vector2LengthSqr(w);
+                const float dot = Vector2DotProduct(w, relativePosition);
+
+                if (dot < 0 && dot * dot > combinedRadiusSq * wLengthSq)
+                {
+                    // Closest boundary point is on the cut-off circle.
+                    const float wLength = std::sqrt(wLengthSq);
+                    const Vector2 unitW = Vector2Scale(w, 1.0f / wLength);
+                    line.direction = {unitW.y, -unitW.x};
+                    u = Vector2Scale(unitW, combinedRadius * invTimeHorizon - wLength);
+                }
+                else
+                {
+                    // Closest boundary point is on one of the cone's legs.
+                    const float leg = std::sqrt(distanceSq - combinedRadiusSq);
+                    if (det(relativePosition, w) > 0)
+                    {
+                        line.direction = Vector2Scale(
+                            {relativePosition.x * leg - relativePosition.y * combinedRadius,
+                             relativePosition.x * combinedRadius + relativePosition.y * leg},
+                            1.0f / distanceSq);
+                    }
+                    else
+                    {
+                        line.direction = Vector2Scale(
+                            {relativePosition.x * leg + relativePosition.y * combinedRadius,
+                             -relativePosition.x * combinedRadius + relativePosition.y * leg},
+                            -1.0f / distanceSq);
+                    }
+                    u = Vector2Subtract(
+                        Vector2Scale(line.direction, Vector2DotProduct(relativeVelocity, line.direction)),
+                        relativeVelocity);
+                }
+            }
+            else
+            {
+                // Already overlapping: resolve within a single step.
+                const Vector2 w = Vector2Subtract(relativeVelocity, relativePosition);
+                const float wLength = Vector2Length(w);
+                // Coincident and moving together; push the pair apart along x by index.
+                const Vector2 unitW = wLength > PARALLEL_EPSILON ? Vector2Scale(w, 1.0f / wLength)
+                                                        : Vector2{index < neighbours[n].index ? -1.0f : 1.0f, 0};
+                line.direction = {unitW.y, -unitW.x};
+                u = Vector2Scale(unitW, combinedRadius - wLength);
+            }
+
+            const float responsibility = other.responsive ? 0.5f : 1.0f;
+            line.point = Vector2Add(agent.velocity, Vector2Scale(u, responsibility));
+            lines.push_back(line);
+        }
+
+        const Vector2 preferred =
+            lines.empty() ? agent.preferredVelocity : Vector2Rotate(agent.preferredVelocity, -SIDESTEP_BIAS);
+        Vector2 result{};
+        const std::size_t failed = linearProgram2(lines, agent.maxSpeed, preferred, false, result);
+        if (failed < lines.size())
+        {
+            linearProgram3(lines, projectedLines, failed, agent.maxSpeed, result);
+        }
+        return result;
+    }
+
+    void LocalAvoidance::Clear()
+    {
+        agents.clear();
+    }
+
+    std::size_t LocalAvoidance::AddAgent(const Agent& agent)
+    {
+        agents.push_back(agent);
+        return agents.size() - 1;
+    }
+
+    void LocalAvoidance::Solve()
+    {
+        velocities.resize(agents.size());
+        if (agents.empty()) return;
+
+        buildBuckets();
+        // Every agent is solved against last step's velocities, so the order of solving is irrelevant.
+        for (std::uint32_t i = 0; i < agents.size(); ++i)
+        {
+            velocities[i] = agents[i].responsive ? solveAgent(i) : agents[i].preferredVelocity;
+        }
+    }
+
+    Vector2 LocalAvoidance::GetVelocity(const std::size_t index) const
+    {
+        return velocities[index];
+    }
+
+    std::size_t LocalAvoidance::GetAgentCount() const
+    {
+        return agents.size();
+    }
+
+    LocalAvoidance::LocalAvoidance() : LocalAvoidance(Config{})
+    {
+    }
+
+    LocalAvoidance::LocalAvoidance(const Config _config) : config(_config)
+    {
+        lines.reserve(MAX_NEIGHBOURS);
+        projectedLines.reserve(MAX_NEIGHBOURS);
+    }
+} // namespace sage
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace sage
+{
+    /*
+     * Optimal reciprocal collision avoidance (ORCA, van den Berg et al.) on the XZ plane. Every
+     * neighbour contributes a half-plane of velocities that keep the pair apart for timeHorizon
+     * steps; an agent takes the velocity closest to its preferred one inside all of them, or the
+     * one that violates them least when they cannot all be met. Two responsive agents split the
+     * avoidance between them; an unresponsive one (e.g. an actor standing still) keeps its
+     * preferred velocity and is avoided entirely by the others.
+     *
+     * Velocities are in units per step. Agents are re-added each step and buffers are kept between
+     * steps, so a steady-state Solve does not allocate. The result depends only on the agents and
+     * the order they were added in.
+     */
+    class LocalAvoidance
+    {
+      public:
+        struct Config
+        {
+            float timeHorizon = 15.0f; // Steps ahead to stay collision-free for
+            float neighbourDistance = 10.0f;
+        };
+
+        struct Agent
+        {
+            Vector2 position{};
+            Vector2 velocity{}; // Velocity applied last step
+            Vector2 preferredVelocity{};
+            float radius = 0.5f;
+            float maxSpeed = 0;
+            bool responsive = true;
+        };
+
+        static constexpr std::size_t MAX_NEIGHBOURS = 10;
+
+      private:
+        struct Line
+        {
+            Vector2 point;
+            Vector2 direction;
+        };
+
+        struct Neighbour
+        {
+            float distanceSq;
+            std::uint32_t index;
+        };
+
+        Config config;
+        std::vector<Agent> agents;
+        std::vector<Vector2> velocities;
+        // Agents bucketed by hashed cell (counting sort); a cell is neighbourDistance wide.
+        std::vector<std::uint32_t> bucketStart;
+        std::vector<std::uint32_t> bucketCursor;
+        std::vector<std::uint32_t> sortedAgents;
+        std::vector<Line> lines;
+        std::vector<Line> projectedLines;
+        std::uint32_t bucketMask = 0;
+
+        [[nodiscard]] int cellCoord(float v) const;
+        [[nodiscard]] std::uint32_t bucketOf(int x, int z) const;
+        void buildBuckets();
+        std::size_t findNeighbours(std::uint32_t index, std::array<Neighbour, MAX_NEIGHBOURS>& out) const;
+        [[nodiscard]] Vector2 solveAgent(std::uint32_t index);
+
+      public:
+        void Clear();
+        // Returns the agent's index, used with GetVelocity after Solve.
+        std::size_t AddAgent(const Agent& agent);
+        void Solve();
+        [[nodiscard]] Vector2 GetVelocity(std::size_t index) const;
+        [[nodiscard]] std::size_t GetAgentCount() const;
+
+        LocalAvoidance();
+        explicit LocalAvoidance(Config _config);
+    };
+} // namespace sage
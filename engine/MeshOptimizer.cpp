@@ -0,0 +1,314 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace sage
+{
+    namespace
+    {
+        constexpr int MAX_INDEXED_VERTICES = 65535;
+
+        // Calls fn(array, components) for every per-vertex attribute array the mesh has.
+        template <typename Fn>
+        void ForEachStream(Mesh& mesh, Fn&& fn)
+        {
+            if (mesh.vertices) fn(mesh.vertices, 3);
+            if (mesh.texcoords) fn(mesh.texcoords, 2);
+            if (mesh.texcoords2) fn(mesh.texcoords2, 2);
+            if (mesh.normals) fn(mesh.normals, 3);
+            if (mesh.tangents) fn(mesh.tangents, 4);
+            if (mesh.colors) fn(mesh.colors, 4);
+            if (mesh.boneIds) fn(mesh.boneIds, 4);
+            if (mesh.boneWeights) fn(mesh.boneWeights, 4);
+            if (mesh.animVertices) fn(mesh.animVertices, 3);
+            if (mesh.animNormals) fn(mesh.animNormals, 3);
+        }
+
+        // Rebuilds every attribute array so new vertex i is old vertex source[i].
+        void GatherVertices(Mesh& mesh, const std::vector<int>& source)
+        {
+            const int count = static_cast<int>(source.size());
+            ForEachStream(mesh, [&source, count](auto*& data, int components) {
+                using T = std::remove_reference_t<decltype(*data)>;
+                auto* gathered = static_cast<T*>(RL_MALLOC(static_cast<std::size_t>(count) * components * sizeof(T)));
+                for (int i = 0; i < count; ++i)
+                {
+                    std::memcpy(
+                        gathered + static_cast<std::size_t>(i) * components,
+                        data + static_cast<std::size_t>(source[i]) * components,
+                        components * sizeof(T));
+                }
+                RL_FREE(data);
+                data = gathered;
+            });
+            mesh.vertexCount = count;
+        }
+
+        // Returns false if the welded mesh would need more vertices than 16-bit indices allow.
+        bool WeldVertices(Mesh& mesh)
+        {
+            const int indexCount = mesh.indices ? mesh.triangleCount * 3 : mesh.vertexCount;
+
+            int vertexSize = 0;
+            ForEachStream(mesh, [&vertexSize](auto* data, int components) {
+                vertexSize += components * static_cast<int>(sizeof(*data));
+            });
+
+            std::vector<char> bytes(static_cast<std::size_t>(mesh.vertexCount) * vertexSize);
+            int offset = 0;
+            ForEachStream(mesh, [&](auto* data, int components) {
+                const int size = components * static_cast<int>(sizeof(*data));
+                for (int v = 0; v < mesh.vertexCount; ++v)
+                {
+                    std::memcpy(
+                        bytes.data() + static_cast<std::size_t>(v) * vertexSize + offset,
+                        data + static_cast<std::size_t>(v) * components,
+                        size);
+                }
+                offset += size;
+            });
+
+            std::unordered_map<std::string_view, int> unique;
+            unique.reserve(mesh.vertexCount);
+            std::vector<int> remap(mesh.vertexCount);
+            std::vector<int> source;
+            for (int v = 0; v < mesh.vertexCount; ++v)
+            {
+                const std::string_view key(bytes.data() + static_cast<std::size_t>(v) * vertexSize, vertexSize);
+                const auto [it, inserted] = unique.try_emplace(key, static_cast<int>(source.size()));
+                if (inserted) source.push_back(v);
+                remap[v] = it->second;
+            }
+            if (static_cast<int>(source.size()) > MAX_INDEXED_VERTICES) return false;
+
+            auto* indices =
+                static_cast<unsigned short*>(RL_MALLOC(static_cast<std::size_t>(indexCount) * sizeof(unsigned short)));
+            for (int i = 0; i < indexCount; ++i)
+            {
+                indices[i] = static_cast<unsigned short>(remap[mesh.indices ? mesh.indices[i] : i]);
+            }
+            RL_FREE(mesh.indices);
+            mesh.indices = indices;
+            mesh.triangleCount = indexCount / 3;
+
+            if (static_cast<int>(source.size()) != mesh.vertexCount) GatherVertices(mesh, source);
+            return true;
+        }
+
+        // Orders vertices by first use in the index buffer, dropping unreferenced ones.
+        void OptimizeVertexFetch(Mesh& mesh)
+        {
+            const int indexCount = mesh.triangleCount * 3;
+            std::vector<int> remap(mesh.vertexCount, -1);
+            std::vector<int> source;
+            source.reserve(mesh.vertexCount);
+            for (int i = 0; i < indexCount; ++i)
+            {
+                int& mapped = remap[mesh.indices[i]];
+                if (mapped < 0)
+                {
+                    mapped = static_cast<int>(source.size());
+                    source.push_back(mesh.indices[i]);
+                }
+                mesh.indices[i] = static_cast<unsigned short>(mapped);
+            }
+            GatherVertices(mesh, source);
+        }
+
+        float VertexScore(int cachePosition, int remainingTriangles)
+        {
+            if (remainingTriangles == 0) return -1.0f;
+
+            float score = 0;
+            if (cachePosition >= 0)
+            {
+                // The last triangle's vertices score the same, so the next one isn't forced to reuse them.
+                if (cachePosition < 3)
+                {
+                    score = 0.75f;
+                }
+                else
+                {
+                    const float scaler = 1.0f / static_cast<float>(MESH_OPTIMIZER_CACHE_SIZE - 3);
+                    score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, 1.5f);
+                }
+            }
+            // Favour vertices with few triangles left, so no stragglers are left behind.
+            score += 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+            return score;
+        }
+    } // namespace
+
+    std::vector<unsigned short> OptimizeVertexCacheOrder(const unsigned short* indices, int indexCount, int vertexCount)
+    {
+        const int triangleCount = indexCount / 3;
+
+        // Triangles using each vertex (CSR). The first remaining[v] of a vertex's slice are the
+        // ones not yet emitted.
+        std::vector<int> remaining(vertexCount, 0);
+        for (int i = 0; i < indexCount; ++i)
+        {
+            ++remaining[indices[i]];
+        }
+        std::vector<int> offsets(vertexCount + 1, 0);
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            offsets[v + 1] = offsets[v] + remaining[v];
+        }
+        std::vector<int> adjacency(indexCount);
+        std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+        for (int i = 0; i < indexCount; ++i)
+        {
+            adjacency[fill[indices[i]]++] = i / 3;
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            vertexScore[v] = VertexScore(-1, remaining[v]);
+        }
+        std::vector<float> triangleScore(triangleCount);
+        for (int t = 0; t < triangleCount; ++t)
+        {
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                               vertexScore[indices[t * 3 + 2]];
+        }
+        std::vector<bool> emitted(triangleCount, false);
+
+        std::vector<unsigned short> out;
+        out.reserve(indexCount);
+        std::vector<int> cache;
+        std::vector<int> nextCache;
+        cache.reserve(MESH_OPTIMIZER_CACHE_SIZE + 3);
+        nextCache.reserve(MESH_OPTIMIZER_CACHE_SIZE + 3);
+
+        int best = -1;
+        int cursor = 0;
+        for (int emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+        {
+            if (best < 0)
+            {
+                // Nothing left near the cache (e.g. a new connected component): take the next unused triangle.
+                while (emitted[cursor])
+                {
+                    ++cursor;
+                }
+                best = cursor;
+            }
+
+            emitted[best] = true;
+            nextCache.clear();
+            for (int k = 0; k < 3; ++k)
+            {
+                const int v = indices[best * 3 + k];
+                out.push_back(static_cast<unsigned short>(v));
+                nextCache.push_back(v);
+
+                // Remove the triangle from the vertex's live slice.
+                const int begin = offsets[v];
+                const int end = begin + remaining[v];
+                const auto it = std::find(adjacency.begin() + begin, adjacency.begin() + end, best);
+                std::iter_swap(it, adjacency.begin() + end - 1);
+                --remaining[v];
+            }
+            for (const int v : cache)
+            {
+                if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) nextCache.push_back(v);
+            }
+
+            for (int i = 0; i < static_cast<int>(nextCache.size()); ++i)
+            {
+                const int v = nextCache[i];
+                cachePosition[v] = i < MESH_OPTIMIZER_CACHE_SIZE ? i : -1;
+                vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+            }
+
+            // Only triangles touching a vertex whose score changed need rescoring.
+            best = -1;
+            float bestScore = -1.0f;
+            for (const int v : nextCache)
+            {
+                for (int a = offsets[v]; a < offsets[v] + remaining[v]; ++a)
+                {
+                    const int t = adjacency[a];
+                    triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                                       vertexScore[indices[t * 3 + 2]];
+                    if (triangleScore[t] > bestScore)
+                    {
+                        bestScore = triangleScore[t];
+                        best = t;
+                    }
+                }
+            }
+
+            if (static_cast<int>(nextCache.size()) > MESH_OPTIMIZER_CACHE_SIZE)
+            {
+                nextCache.resize(MESH_OPTIMIZER_CACHE_SIZE);
+            }
+            std::swap(cache, nextCache);
+        }
+        return out;
+    }
+
+    float AverageCacheMissRatio(const unsigned short* indices, int indexCount, int vertexCount, int cacheSize)
+    {
+        if (indexCount < 3) return 0;
+        std::vector<bool> cached(vertexCount, false);
+        std::deque<int> fifo;
+        int misses = 0;
+        for (int i = 0; i < indexCount; ++i)
+        {
+            const int v = indices[i];
+            if (cached[v]) continue;
+            ++misses;
+            cached[v] = true;
+            fifo.push_back(v);
+            if (static_cast<int>(fifo.size()) > cacheSize)
+            {
+                cached[fifo.front()] = false;
+                fifo.pop_front();
+            }
+        }
+        return static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    }
+
+    MeshOptimizeStats OptimizeMesh(Mesh& mesh)
+    {
+        MeshOptimizeStats stats;
+        stats.verticesBefore = mesh.vertexCount;
+        stats.verticesAfter = mesh.vertexCount;
+        if (mesh.vertices == nullptr || mesh.vertexCount < 3) return stats;
+
+        if (mesh.indices)
+        {
+            stats.acmrBefore =
+                AverageCacheMissRatio(mesh.indices, mesh.triangleCount * 3, mesh.vertexCount);
+        }
+        else
+        {
+            stats.acmrBefore = 3.0f; // Every vertex is transformed once per triangle
+        }
+
+        if (!WeldVertices(mesh))
+        {
+            stats.acmrAfter = stats.acmrBefore;
+            return stats;
+        }
+
+        const int indexCount = mesh.triangleCount * 3;
+        const auto ordered = OptimizeVertexCacheOrder(mesh.indices, indexCount, mesh.vertexCount);
+        std::ranges::copy(ordered, mesh.indices);
+        OptimizeVertexFetch(mesh);
+
+        stats.verticesAfter = mesh.vertexCount;
+        stats.acmrAfter = AverageCacheMissRatio(mesh.indices, indexCount, mesh.vertexCount);
+        return stats;
+    }
+} // namespace sage
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <vector>
+
+// Packer-time mesh clean-up: welding, vertex cache and vertex fetch ordering. Works on the
+// CPU-side arrays only; a mesh that was already uploaded keeps its old GPU buffers.
+
+namespace sage
+{
+    // Vertices the post-transform cache is modelled with when ordering triangles.
+    inline constexpr int MESH_OPTIMIZER_CACHE_SIZE = 32;
+
+    struct MeshOptimizeStats
+    {
+        int verticesBefore = 0;
+        int verticesAfter = 0;
+        float acmrBefore = 0; // Average cache misses per triangle (16-entry FIFO), lower is better
+        float acmrAfter = 0;
+    };
+
+    /* Merges vertices whose attributes are bit-identical (indexing the mesh if it wasn't), then
+    reorders triangles for the post-transform cache (Forsyth's linear-speed algorithm) and
+    vertices in order of first use, dropping any that are unreferenced. Meshes whose welded
+    vertex count would not fit 16-bit indices are left as they are. */
+    MeshOptimizeStats OptimizeMesh(Mesh& mesh);
+
+    // Triangle order for indices that minimises post-transform cache misses.
+    [[nodiscard]] std::vector<unsigned short> OptimizeVertexCacheOrder(
+        const unsigned short* indices, int indexCount, int vertexCount);
+
+    // Simulated misses of a FIFO vertex cache, per triangle.
+    [[nodiscard]] float AverageCacheMissRatio(
+        const unsigned short* indices, int indexCount, int vertexCount, int cacheSize = 16);
+} // namespace sage
@@ -0,0 +1,250 @@
+#include "MeshQuantization.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace sage
+{
+    namespace
+    {
+        constexpr float UNORM16_MAX = 65535.0f;
+        constexpr float SNORM16_MAX = 32767.0f;
+
+        std::int16_t ToSnorm16(float value)
+        {
+            return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * SNORM16_MAX));
+        }
+
+        float FromSnorm16(std::int16_t value)
+        {
+            return std::max(static_cast<float>(value) / SNORM16_MAX, -1.0f);
+        }
+
+        float SignNotZero(float value)
+        {
+            return value >= 0.0f ? 1.0f : -1.0f;
+        }
+
+        // Maps a unit vector onto the octahedron, unfolded into [-1, 1]^2.
+        Vector2 OctEncode(float x, float y, float z)
+        {
+            const float l1 = std::abs(x) + std::abs(y) + std::abs(z);
+            if (l1 == 0.0f) return {0.0f, 0.0f};
+            x /= l1;
+            y /= l1;
+            if (z < 0.0f)
+            {
+                const float ox = (1.0f - std::abs(y)) * SignNotZero(x);
+                const float oy = (1.0f - std::abs(x)) * SignNotZero(y);
+                return {ox, oy};
+            }
+            return {x, y};
+        }
+
+        Vector3 OctDecode(float x, float y)
+        {
+            Vector3 n{x, y, 1.0f - std::abs(x) - std::abs(y)};
+            const float t = std::max(-n.z, 0.0f);
+            n.x += n.x >= 0.0f ? -t : t;
+            n.y += n.y >= 0.0f ? -t : t;
+            const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+            return {n.x / length, n.y / length, n.z / length};
+        }
+
+        void QuantizeHalfs(const float* source, int count, std::vector<std::uint16_t>& out)
+        {
+            if (source == nullptr) return;
+            out.resize(count);
+            for (int i = 0; i < count; ++i)
+            {
+                out[i] = FloatToHalf(source[i]);
+            }
+        }
+
+        void DequantizeHalfs(const std::vector<std::uint16_t>& source, std::vector<float>& out)
+        {
+            out.resize(source.size());
+            for (std::size_t i = 0; i < source.size(); ++i)
+            {
+                out[i] = HalfToFloat(source[i]);
+            }
+        }
+    } // namespace
+
+    MeshEncodeOptions& GetMeshEncodeOptions()
+    {
+        static MeshEncodeOptions options;
+        return options;
+    }
+
+    std::uint16_t FloatToHalf(float value)
+    {
+        const auto bits = std::bit_cast<std::uint32_t>(value);
+        const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+        const int exponent = static_cast<int>((bits >> 23) & 0xffu) - 127 + 15;
+        std::uint32_t mantissa = bits & 0x7fffffu;
+
+        if (((bits >> 23) & 0xffu) == 0xffu) // Inf/NaN
+        {
+            return static_cast<std::uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+        }
+        if (exponent >= 31) return static_cast<std::uint16_t>(sign | 0x7c00u); // Overflow to inf
+        if (exponent <= 0)
+        {
+            if (exponent < -10) return sign; // Too small even for a subnormal
+            mantissa |= 0x800000u;
+            const int shift = 14 - exponent;
+            std::uint32_t half = mantissa >> shift;
+            // Round to nearest, ties to even
+            const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const std::uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (half & 1u))) ++half;
+            return static_cast<std::uint16_t>(sign | half);
+        }
+
+        std::uint32_t half = (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13);
+        const std::uint32_t remainder = mantissa & 0x1fffu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) ++half; // May carry into inf; fine
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    float HalfToFloat(std::uint16_t half)
+    {
+        const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+        const std::uint32_t exponent = (half >> 10) & 0x1fu;
+        const std::uint32_t mantissa = half & 0x3ffu;
+
+        if (exponent == 0)
+        {
+            // Zero or subnormal: mantissa * 2^-24
+            const float value = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -value : value;
+        }
+        if (exponent == 31)
+        {
+            return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+        }
+        return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+    }
+
+    QuantizedMesh QuantizeMesh(const Mesh& mesh)
+    {
+        QuantizedMesh q;
+        q.vertexCount = mesh.vertexCount;
+        q.triangleCount = mesh.triangleCount;
+        q.boneCount = mesh.boneCount;
+
+        Vector3 min{INFINITY, INFINITY, INFINITY};
+        Vector3 max{-INFINITY, -INFINITY, -INFINITY};
+        for (int v = 0; v < mesh.vertexCount; ++v)
+        {
+            min.x = std::min(min.x, mesh.vertices[v * 3]);
+            min.y = std::min(min.y, mesh.vertices[v * 3 + 1]);
+            min.z = std::min(min.z, mesh.vertices[v * 3 + 2]);
+            max.x = std::max(max.x, mesh.vertices[v * 3]);
+            max.y = std::max(max.y, mesh.vertices[v * 3 + 1]);
+            max.z = std::max(max.z, mesh.vertices[v * 3 + 2]);
+        }
+        if (mesh.vertexCount > 0)
+        {
+            q.boundsMin = min;
+            q.boundsExtent = {max.x - min.x, max.y - min.y, max.z - min.z};
+        }
+
+        const float origin[3] = {q.boundsMin.x, q.boundsMin.y, q.boundsMin.z};
+        const float extent[3] = {q.boundsExtent.x, q.boundsExtent.y, q.boundsExtent.z};
+        q.positions.resize(static_cast<std::size_t>(mesh.vertexCount) * 3);
+        for (int i = 0; i < mesh.vertexCount * 3; ++i)
+        {
+            const int axis = i % 3;
+            const float t = extent[axis] > 0.0f ? (mesh.vertices[i] - origin[axis]) / extent[axis] : 0.0f;
+            q.positions[i] = static_cast<std::uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * UNORM16_MAX));
+        }
+
+        QuantizeHalfs(mesh.texcoords, mesh.vertexCount * 2, q.texcoords);
+        QuantizeHalfs(mesh.texcoords2, mesh.vertexCount * 2, q.texcoords2);
+
+        if (mesh.normals)
+        {
+            q.normals.resize(static_cast<std::size_t>(mesh.vertexCount) * 2);
+            for (int v = 0; v < mesh.vertexCount; ++v)
+            {
+                const float* n = mesh.normals + v * 3;
+                const Vector2 oct = OctEncode(n[0], n[1], n[2]);
+                q.normals[v * 2] = ToSnorm16(oct.x);
+                q.normals[v * 2 + 1] = ToSnorm16(oct.y);
+            }
+        }
+        if (mesh.tangents)
+        {
+            q.tangents.resize(static_cast<std::size_t>(mesh.vertexCount) * 3);
+            for (int v = 0; v < mesh.vertexCount; ++v)
+            {
+                const float* t = mesh.tangents + v * 4;
+                const Vector2 oct = OctEncode(t[0], t[1], t[2]);
+                q.tangents[v * 3] = ToSnorm16(oct.x);
+                q.tangents[v * 3 + 1] = ToSnorm16(oct.y);
+                q.tangents[v * 3 + 2] = ToSnorm16(SignNotZero(t[3]));
+            }
+        }
+
+        if (mesh.colors) q.colors.assign(mesh.colors, mesh.colors + mesh.vertexCount * 4);
+        if (mesh.indices) q.indices.assign(mesh.indices, mesh.indices + mesh.triangleCount * 3);
+        if (mesh.boneIds) q.boneIds.assign(mesh.boneIds, mesh.boneIds + mesh.vertexCount * 4);
+        // Weights stay full precision: skinning error is visible long before position error is.
+        if (mesh.boneWeights) q.boneWeights.assign(mesh.boneWeights, mesh.boneWeights + mesh.vertexCount * 4);
+        return q;
+    }
+
+    void DequantizeMesh(
+        const QuantizedMesh& quantized,
+        std::vector<float>& vertices,
+        std::vector<float>& texcoords,
+        std::vector<float>& texcoords2,
+        std::vector<float>& normals,
+        std::vector<float>& tangents)
+    {
+        const int count = quantized.vertexCount;
+        const float origin[3] = {quantized.boundsMin.x, quantized.boundsMin.y, quantized.boundsMin.z};
+        const float extent[3] = {quantized.boundsExtent.x, quantized.boundsExtent.y, quantized.boundsExtent.z};
+        vertices.resize(static_cast<std::size_t>(count) * 3);
+        for (int i = 0; i < count * 3; ++i)
+        {
+            const int axis = i % 3;
+            vertices[i] = origin[axis] + static_cast<float>(quantized.positions[i]) / UNORM16_MAX * extent[axis];
+        }
+
+        DequantizeHalfs(quantized.texcoords, texcoords);
+        DequantizeHalfs(quantized.texcoords2, texcoords2);
+
+        normals.clear();
+        if (!quantized.normals.empty())
+        {
+            normals.resize(static_cast<std::size_t>(count) * 3);
+            for (int v = 0; v < count; ++v)
+            {
+                const Vector3 n =
+                    OctDecode(FromSnorm16(quantized.normals[v * 2]), FromSnorm16(quantized.normals[v * 2 + 1]));
+                normals[v * 3] = n.x;
+                normals[v * 3 + 1] = n.y;
+                normals[v * 3 + 2] = n.z;
+            }
+        }
+
+        tangents.clear();
+        if (!quantized.tangents.empty())
+        {
+            tangents.resize(static_cast<std::size_t>(count) * 4);
+            for (int v = 0; v < count; ++v)
+            {
+                const Vector3 t =
+                    OctDecode(FromSnorm16(quantized.tangents[v * 3]), FromSnorm16(quantized.tangents[v * 3 + 1]));
+                tangents[v * 4] = t.x;
+                tangents[v * 4 + 1] = t.y;
+                tangents[v * 4 + 2] = t.z;
+                tangents[v * 4 + 3] = quantized.tangents[v * 3 + 2] < 0 ? -1.0f : 1.0f;
+            }
+        }
+    }
+} // namespace sage
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * Compact mesh encoding for the asset archive. Positions are stored as 16-bit fractions of the
+ * mesh bounds, normals and tangents octahedrally encoded in two snorm16s, and texcoords as
+ * half floats. Colours, indices and skinning data are stored as-is. Dequantised to the usual
+ * float arrays at load, so nothing past deserialisation sees the difference.
+ */
+
+namespace sage
+{
+    // Leading byte of a serialised Mesh.
+    enum class MeshFormat : std::uint8_t
+    {
+        Raw = 0,
+        Quantized = 1
+    };
+
+    struct MeshEncodeOptions
+    {
+        bool quantize = false;
+    };
+
+    // Applied whenever a Mesh is serialised. Only the packer changes these (before encoding).
+    MeshEncodeOptions& GetMeshEncodeOptions();
+
+    struct QuantizedMesh
+    {
+        int vertexCount = 0;
+        int triangleCount = 0;
+        int boneCount = 0;
+        Vector3 boundsMin{};
+        Vector3 boundsExtent{};
+        std::vector<std::uint16_t> positions;  // 3 per vertex, unorm16 within the bounds
+        std::vector<std::uint16_t> texcoords;  // 2 per vertex, half float
+        std::vector<std::uint16_t> texcoords2; // 2 per vertex, half float
+        std::vector<std::int16_t> normals;     // 2 per vertex, octahedral snorm16
+        std::vector<std::int16_t> tangents;    // 3 per vertex, octahedral snorm16 + handedness
+        std::vector<unsigned char> colors;
+        std::vector<unsigned short> indices;
+        std::vector<unsigned char> boneIds;
+        std::vector<float> boneWeights;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(
+                vertexCount,
+                triangleCount,
+                boneCount,
+                boundsMin,
+                boundsExtent,
+                positions,
+                texcoords,
+                texcoords2,
+                normals,
+                tangents,
+                colors,
+                indices,
+                boneIds,
+                boneWeights);
+        }
+    };
+
+    [[nodiscard]] QuantizedMesh QuantizeMesh(const Mesh& mesh);
+
+    // Expands the quantised attributes into float arrays laid out as in Mesh (empty if absent).
+    void DequantizeMesh(
+        const QuantizedMesh& quantized,
+        std::vector<float>& vertices,
+        std::vector<float>& texcoords,
+        std::vector<float>& texcoords2,
+        std::vector<float>& normals,
+        std::vector<float>& tangents);
+
+    [[nodiscard]] std::uint16_t FloatToHalf(float value);
+    [[nodiscard]] float HalfToFloat(std::uint16_t half);
+} // namespace sage
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Fork/join helpers for CPU-bound batch work (asset packing, grid baking). Not meant for
+// per-frame use: threads are spawned per call.
+
+namespace sage
+{
+    inline unsigned int HardwareWorkerCount()
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    /*
+     * Calls fn(i) for every i in [0, count), spread across workerCount threads (the caller
+     * included). Indices are handed out one at a time, so items of uneven cost balance out.
+     * fn must be safe to call concurrently for different indices.
+     */
+    template <typename Fn>
+    void ParallelFor(std::size_t count, Fn&& fn, unsigned int workerCount = HardwareWorkerCount())
+    {
+        const auto threads = static_cast<unsigned int>(std::min<std::size_t>(workerCount, count));
+        if (threads <= 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                fn(i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        auto work = [&] {
+            for (std::size_t i = next++; i < count; i = next++)
+            {
+                fn(i);
+            }
+        };
+
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned int i = 1; i < threads; ++i)
+        {
+            workers.emplace_back(work);
+        }
+        work();
+    }
+
+    /*
+     * Splits [0, rows) into contiguous bands and calls fn(begin, end) for each band in
+     * parallel. Use when the work for a row range should be done by one thread (e.g. writes
+     * to a row-major grid).
+     */
+    template <typename Fn>
+    void ParallelForBands(int rows, Fn&& fn, unsigned int workerCount = HardwareWorkerCount())
+    {
+        if (rows <= 0) return;
+        // A few bands per worker so a slow band doesn't leave the others idle.
+        const int bandCount = std::min(rows, static_cast<int>(workerCount) * 4);
+        const int bandSize = (rows + bandCount - 1) / bandCount;
+        ParallelFor(
+            static_cast<std::size_t>(bandCount),
+            [&](std::size_t band) {
+                const int begin = static_cast<int>(band) * bandSize;
+                const int end = std::min(rows, begin + bandSize);
+                if (begin < end) fn(begin, end);
+            },
+            workerCount);
+    }
+} // namespace sage
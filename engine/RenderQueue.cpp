@@ -0,0 +1,103 @@
+#include "RenderQueue.hpp"
+
+#include "raylib/src/config.h"
+
+#include <array>
+
+namespace sage
+{
+    std::uint32_t MaterialIdentity(const Material& material)
+    {
+        // FNV-1a over the state a draw binds.
+        std::uint32_t hash = 2166136261u;
+        auto mix = [&hash](const void* data, const std::size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 16777619u;
+            }
+        };
+        mix(&material.shader.id, sizeof(material.shader.id));
+        if (material.maps == nullptr) return hash;
+        for (int i = 0; i < MAX_MATERIAL_MAPS; ++i)
+        {
+            const auto& map = material.maps[i];
+            mix(&map.texture.id, sizeof(map.texture.id));
+            mix(&map.color, sizeof(map.color));
+            mix(&map.value, sizeof(map.value));
+        }
+        return hash;
+    }
+
+    std::uint64_t MakeSortKey(const RenderLayer layer, const std::uint32_t uberFlags, const Material& material)
+    {
+        const unsigned int shaderId = material.shader.id;
+        const unsigned int textureId = material.maps ? material.maps[MATERIAL_MAP_DIFFUSE].texture.id : 0;
+        const std::uint64_t materialHash = MaterialIdentity(material);
+        return (static_cast<std::uint64_t>(layer) << 62) | (static_cast<std::uint64_t>(shaderId & 0x3FFF) << 48) |
+               (static_cast<std::uint64_t>(uberFlags & 0xFF) << 40) |
+               (static_cast<std::uint64_t>(textureId & 0xFFFFFF) << 16) | (materialHash & 0xFFFF);
+    }
+
+    void RenderQueue::Clear()
+    {
+        packets.clear();
+        order.clear();
+    }
+
+    void RenderQueue::Push(const DrawPacket& packet)
+    {
+        order.emplace_back(packet.key, static_cast<std::uint32_t>(packets.size()));
+        packets.push_back(packet);
+    }
+
+    void RenderQueue::Sort()
+    {
+        // LSD radix sort, one byte per pass. Passes where every key has the same byte are skipped,
+        // which is most of them: keys are dominated by a handful of shaders and layers.
+        scratch.resize(order.size());
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            std::array<std::uint32_t, 257> offsets{};
+            for (const auto& [key, index] : order)
+            {
+                ++offsets[((key >> shift) & 0xFF) + 1];
+            }
+            bool trivial = false;
+            for (int b = 1; b <= 256; ++b)
+            {
+                if (offsets[b] == order.size())
+                {
+                    trivial = true;
+                    break;
+                }
+            }
+            if (trivial) continue;
+
+            for (int b = 1; b <= 256; ++b)
+            {
+                offsets[b] += offsets[b - 1];
+            }
+            for (const auto& entry : order)
+            {
+                scratch[offsets[(entry.first >> shift) & 0xFF]++] = entry;
+            }
+            order.swap(scratch);
+        }
+    }
+
+    std::size_t RenderQueue::Size() const
+    {
+        return packets.size();
+    }
+
+    unsigned int RenderQueue::CountKeyChanges() const
+    {
+        unsigned int changes = 0;
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            if (i == 0 || order[i].first != order[i - 1].first) ++changes;
+        }
+        return changes;
+    }
+} // namespace sage
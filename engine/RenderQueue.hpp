@@ -0,0 +1,79 @@
+#pragma once
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace sage
+{
+    struct UberShaderComponent;
+
+    // Coarsest part of the sort key: every Opaque packet is drawn before any Deferred one.
+    enum class RenderLayer : std::uint8_t
+    {
+        Opaque = 0,
+        Deferred = 1
+    };
+
+    /* Identity of a material's draw state: its shader and every map's texture, colour and value.
+    Computed from content rather than the maps pointer, so the private material copies of mutable
+    model instances match their source (until one is actually changed). */
+    [[nodiscard]] std::uint32_t MaterialIdentity(const Material& material);
+
+    /*
+     * Sort key, most significant first:
+     *   [63..62] layer  [61..48] shader id  [47..40] uber flags  [39..16] diffuse texture id
+     *   [15..0]  MaterialIdentity, so materials sharing a texture stay apart
+     */
+    [[nodiscard]] std::uint64_t MakeSortKey(RenderLayer layer, std::uint32_t uberFlags, const Material& material);
+
+    // Everything needed to draw one mesh. Pointers borrow from the drawn component for one frame.
+    struct DrawPacket
+    {
+        std::uint64_t key = 0;
+        entt::entity entity = entt::null;
+        const Model* model = nullptr;
+        int mesh = 0;
+        Matrix transform{};
+        Color tint = WHITE;
+        UberShaderComponent* uber = nullptr; // Null for plain shaders
+        // Set for instance groups: one instanced draw with these world transforms (transform unused).
+        const Matrix* instances = nullptr;
+        int instanceCount = 0;
+        // The entity's reqShaderUpdate, run before the first of its packets in a run.
+        const std::function<void(entt::entity)>* shaderUpdate = nullptr;
+    };
+
+    /*
+     * Per-frame list of draw packets, ordered by key with a stable LSD radix sort so draws that
+     * share state are adjacent. Sorting only touches (key, index) pairs; the packets themselves
+     * stay where they were pushed. Pure CPU: no GPU or registry access.
+     */
+    class RenderQueue
+    {
+        std::vector<DrawPacket> packets;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> order;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> scratch;
+
+      public:
+        void Clear();
+        void Push(const DrawPacket& packet);
+        void Sort();
+        // Packets in sorted order (valid after Sort).
+        template <typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            for (const auto& [key, index] : order)
+            {
+                fn(packets[index]);
+            }
+        }
+        [[nodiscard]] std::size_t Size() const;
+        // Number of adjacent sorted packets whose key differs, i.e. state changes when drawn.
+        [[nodiscard]] unsigned int CountKeyChanges() const;
+    };
+} // namespace sage
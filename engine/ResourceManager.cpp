@@ -5,6 +5,7 @@
 #include "ResourceManager.hpp"
 
 #include "components/Renderable.hpp"
+#include "ShaderUniformCache.hpp"
 
 #include "raylib/src/config.h"
 #include "raymath.h"
@@ -21,9 +22,12 @@ extern "C"
 }
 #include <stb_include.h>
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <iostream>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 
 namespace sage
@@ -355,7 +359,7 @@ namespace sage
         //  from QUEST_BONE.obj)
         if (!nonModelTextures.contains(key))
         {
-            if (!images.contains(key))
+            if (!faultImage(key))
             {
                 images.emplace(key, LoadImage(path.c_str()));
             }
@@ -388,15 +392,384 @@ namespace sage
     {
         if (images.contains(key))
         {
+            forgetImage(key);
             UnloadImage(images.at(key));
             images.erase(key);
         }
     }
 
+    /* Non-owning view onto the CPU-side image. Archive-backed images live in an LRU cache;
+    the view pins its image, so faulting in others cannot evict it while the view lives. */
     ImageSafe ResourceManager::GetImage(const std::string& key)
     {
+        faultImage(key);
         assert(images.contains(key));
-        return ImageSafe(images[key], false);
+        if (!imageLruPos.contains(key)) return ImageSafe(images[key], false);
+
+        ++imagePins[key];
+        return ImageSafe(images[key], std::shared_ptr<void>(nullptr, [this, key](void*) { unpinImage(key); }));
+    }
+
+    void ResourceManager::unpinImage(const std::string& key)
+    {
+        const auto it = imagePins.find(key);
+        if (it == imagePins.end()) return;
+        if (--it->second == 0) imagePins.erase(it);
+    }
+
+    void ResourceManager::touchImage(const std::string& key)
+    {
+        const auto it = imageLruPos.find(key);
+        if (it == imageLruPos.end()) return;
+        imageLru.splice(imageLru.begin(), imageLru, it->second);
+    }
+
+    void ResourceManager::forgetImage(const std::string& key)
+    {
+        const auto it = imageLruPos.find(key);
+        if (it == imageLruPos.end()) return;
+        const auto& image = images.at(key);
+        imageCacheBytes -= GetPixelDataSize(image.width, image.height, image.format);
+        imageLru.erase(it->second);
+        imageLruPos.erase(it);
+    }
+
+    // Evicts least recently used archive-backed images until the cache fits its budget.
+    // "keep" is the image that triggered the trim; it and any image with a live view are skipped,
+    // so the cache can stay over budget while views are held.
+    void ResourceManager::trimImageCache(const std::string& keep)
+    {
+        auto it = imageLru.end();
+        while (imageCacheBytes > imageCacheBudget && it != imageLru.begin())
+        {
+            const auto victim = std::prev(it);
+            if (*victim == keep || imagePins.contains(*victim))
+            {
+                it = victim;
+                continue;
+            }
+            ImageUnload(std::string(*victim)); // Erases victim; it stays valid
+        }
+    }
+
+    bool ResourceManager::faultImage(const std::string& key)
+    {
+        if (images.contains(key))
+        {
+            touchImage(key);
+            return true;
+        }
+
+        Image image{};
+        if (!archive.IsOpen() || !archive.Read(AssetType::Image, key, image)) return false;
+
+        storeArchivedImage(key, image);
+        return true;
+    }
+
+    void ResourceManager::storeArchivedImage(const std::string& key, const Image& image)
+    {
+        images.emplace(key, image);
+        imageLru.push_front(key);
+        imageLruPos.emplace(key, imageLru.begin());
+        imageCacheBytes += GetPixelDataSize(image.width, image.height, image.format);
+        trimImageCache(key);
+    }
+
+    bool ResourceManager::faultMaterial(const std::string& name)
+    {
+        if (materialMap.contains(name)) return true;
+
+        Material material{};
+        if (!archive.IsOpen() || !archive.Read(AssetType::Material, name, material)) return false;
+
+        materialMap.emplace(name, material);
+        return true;
+    }
+
+    bool ResourceManager::faultModel(const std::string& key)
+    {
+        if (modelCopies.contains(key)) return true;
+
+        ModelInfo info;
+        if (!archive.IsOpen() || !archive.Read(AssetType::Model, key, info)) return false;
+
+        NormalizeMaterialNames(info.model, info.materialNames, info.sourcePath);
+        for (const auto& name : info.materialNames)
+        {
+            faultMaterial(name);
+        }
+        storeArchivedModel(key, std::move(info));
+        return true;
+    }
+
+    // Materials are pooled separately from models; resolves the model's slots against the pool.
+    void ResourceManager::storeArchivedModel(const std::string& key, ModelInfo info)
+    {
+        for (int i = 0; i < info.model.materialCount; ++i)
+        {
+            info.model.materials[i] = materialMap[info.materialNames[i]];
+        }
+        modelCopies.emplace(key, std::move(info));
+    }
+
+    bool ResourceManager::faultAnimation(const std::string& key)
+    {
+        if (modelAnimations.contains(key)) return true;
+
+        std::vector<AnimationClip> data;
+        if (!archive.IsOpen() || !archive.Read(AssetType::Animation, key, data)) return false;
+
+        storeAnimations(key, std::move(data));
+        return true;
+    }
+
+    void ResourceManager::storeAnimations(const std::string& key, std::vector<AnimationClip> data)
+    {
+        modelAnimations.emplace(key, std::move(data));
+    }
+
+    bool ResourceManager::isResident(AssetType type, const std::string& key) const
+    {
+        switch (type)
+        {
+        case AssetType::Image:
+            return images.contains(key);
+        case AssetType::Model:
+            return modelCopies.contains(key);
+        case AssetType::Material:
+            return materialMap.contains(key);
+        case AssetType::Animation:
+            return modelAnimations.contains(key);
+        case AssetType::Script:
+            return false;
+        }
+        return false;
+    }
+
+    /* Queues an archived asset for background decode. Resident assets return a ready handle,
+    unknown keys a failed one, and repeated requests share the in-flight handle. */
+    AssetHandle ResourceManager::stream(AssetType type, const std::string& key)
+    {
+        if (isResident(type, key))
+        {
+            return AssetHandle(std::make_shared<AssetStreamState>(type, key, AssetStreamStatus::Ready));
+        }
+
+        auto& pending = inFlight[static_cast<size_t>(type)];
+        if (const auto it = pending.find(key); it != pending.end())
+        {
+            return AssetHandle(it->second);
+        }
+
+        if (!archive.IsOpen() || !archive.Contains(type, key))
+        {
+            return AssetHandle(std::make_shared<AssetStreamState>(type, key, AssetStreamStatus::Failed));
+        }
+
+        if (!streamer.IsRunning())
+        {
+            const unsigned int hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+            streamer.Start(&archive, std::min(hardwareThreads - 1, 4u));
+        }
+
+        auto state = std::make_shared<AssetStreamState>(type, key);
+        pending.emplace(key, state);
+        streamer.Enqueue(state);
+        return AssetHandle(std::move(state));
+    }
+
+    AssetHandle ResourceManager::StreamModel(const std::string& key)
+    {
+        return stream(AssetType::Model, key);
+    }
+
+    AssetHandle ResourceManager::StreamImage(const std::string& key)
+    {
+        return stream(AssetType::Image, key);
+    }
+
+    AssetHandle ResourceManager::StreamAnimation(const std::string& key)
+    {
+        return stream(AssetType::Animation, key);
+    }
+
+    /* Background counterpart of Prefetch. Use to bring in the next map's assets while the
+    current one plays; poll the returned handles (or just keep calling PumpUploads). */
+    std::vector<AssetHandle> ResourceManager::StreamPrefetch(const std::vector<std::string>& keys)
+    {
+        std::vector<AssetHandle> handles;
+        for (const auto& key : keys)
+        {
+            for (const auto type : {AssetType::Model, AssetType::Animation, AssetType::Image})
+            {
+                if (!isResident(type, key) && !archive.Contains(type, key)) continue;
+                handles.push_back(stream(type, key));
+            }
+        }
+        return handles;
+    }
+
+    void ResourceManager::finishStream(AssetStreamState& state, AssetStreamStatus status)
+    {
+        state.status.store(status, std::memory_order_release);
+        inFlight[static_cast<size_t>(state.type)].erase(state.key);
+    }
+
+    // Returns false if the model has to wait for materials that are still streaming.
+    bool ResourceManager::installDecodedModel(DecodedAsset& asset)
+    {
+        auto& info = std::get<DeferredModelInfo>(asset.payload);
+        const auto& materialsInFlight = inFlight[static_cast<size_t>(AssetType::Material)];
+
+        if (!info.materialsRequested)
+        {
+            for (const auto& name : info.materialNames)
+            {
+                if (!materialMap.contains(name)) stream(AssetType::Material, name);
+            }
+            info.materialsRequested = true;
+        }
+        // Materials that failed to stream resolve to an empty slot, as on the synchronous path.
+        for (const auto& name : info.materialNames)
+        {
+            if (!materialMap.contains(name) && materialsInFlight.contains(name)) return false;
+        }
+
+        Model model = info.model.model;
+        UploadModelMeshes(model);
+        storeArchivedModel(
+            asset.state->key, ModelInfo{model, std::move(info.materialNames), std::move(info.sourcePath)});
+        asset.payload = std::monostate{};
+        return true;
+    }
+
+    void ResourceManager::installDecoded(DecodedAsset& asset)
+    {
+        auto& state = *asset.state;
+        if (std::holds_alternative<std::monostate>(asset.payload))
+        {
+            finishStream(state, AssetStreamStatus::Failed);
+            return;
+        }
+        if (isResident(state.type, state.key))
+        {
+            // A synchronous fault-in got there first.
+            DiscardDecodedAsset(asset);
+            finishStream(state, AssetStreamStatus::Ready);
+            return;
+        }
+
+        if (auto* image = std::get_if<Image>(&asset.payload))
+        {
+            storeArchivedImage(state.key, *image);
+        }
+        else if (auto* material = std::get_if<DeferredMaterial>(&asset.payload))
+        {
+            materialMap.emplace(state.key, UploadMaterial(*material));
+        }
+        else if (auto* animations = std::get_if<std::vector<AnimationClip>>(&asset.payload))
+        {
+            storeAnimations(state.key, std::move(*animations));
+        }
+        else if (auto* info = std::get_if<DeferredModelInfo>(&asset.payload))
+        {
+            NormalizeMaterialNames(info->model.model, info->materialNames, info->sourcePath);
+            if (!installDecodedModel(asset))
+            {
+                awaitingMaterials.push_back(std::move(asset));
+                return;
+            }
+        }
+        asset.payload = std::monostate{};
+        finishStream(state, AssetStreamStatus::Ready);
+    }
+
+    /* Main thread, once per frame. Installs decoded assets (texture and mesh uploads) until
+    roughly uploadBudget bytes have gone to the GPU; at least one asset is installed per call so
+    a single large asset cannot stall the queue. */
+    void ResourceManager::PumpUploads()
+    {
+        std::size_t uploaded = 0;
+
+        for (auto it = awaitingMaterials.begin(); it != awaitingMaterials.end();)
+        {
+            if (isResident(AssetType::Model, it->state->key))
+            {
+                DiscardDecodedAsset(*it);
+                finishStream(*it->state, AssetStreamStatus::Ready);
+                it = awaitingMaterials.erase(it);
+            }
+            else if (installDecodedModel(*it))
+            {
+                uploaded += it->bytes;
+                finishStream(*it->state, AssetStreamStatus::Ready);
+                it = awaitingMaterials.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        DecodedAsset asset;
+        while (uploaded < uploadBudget && streamer.PopDecoded(asset))
+        {
+            uploaded += asset.bytes;
+            installDecoded(asset);
+        }
+    }
+
+    void ResourceManager::SetUploadBudget(std::size_t bytesPerFrame)
+    {
+        uploadBudget = bytesPerFrame;
+    }
+
+    void ResourceManager::MountArchive(const char* path)
+    {
+        streamer.Stop();
+        if (!archive.Open(path))
+        {
+            TraceLog(LOG_FATAL, "ResourceManager::MountArchive: unable to mount asset archive '%s'.", path);
+        }
+    }
+
+    void ResourceManager::UnmountArchive()
+    {
+        streamer.Stop();
+        for (auto& asset : awaitingMaterials)
+        {
+            DiscardDecodedAsset(asset);
+            finishStream(*asset.state, AssetStreamStatus::Failed);
+        }
+        awaitingMaterials.clear();
+        for (auto& pending : inFlight)
+        {
+            pending.clear();
+        }
+        archive.Close();
+    }
+
+    /* Faults in every archived asset stored under each key (model and its materials, animation
+    set and image), e.g. ahead of a scene transition. Keys that are already resident or not in
+    the archive are ignored. */
+    void ResourceManager::Prefetch(const std::vector<std::string>& keys)
+    {
+        for (const auto& key : keys)
+        {
+            faultModel(key);
+            faultAnimation(key);
+            faultImage(key);
+        }
+    }
+
+    void ResourceManager::SetImageCacheBudget(std::size_t bytes)
+    {
+        imageCacheBudget = bytes;
+        if (!imageLru.empty())
+        {
+            trimImageCache(imageLru.front());
+        }
     }
 
     void ResourceManager::FontLoadFromFile(const std::string& path)
@@ -446,10 +819,25 @@ namespace sage
         if (modelCopies.contains(key)) return;
         assert(FileExists(path.c_str()));
 
+        ModelInfo info = importModel(path);
+        dedupeAndShareMaterials(info.model, info.materialNames, path);
+        modelCopies.emplace(key, std::move(info));
+    }
+
+    // Loads a model with its own (unpooled) materials and resolved material names.
+    ModelInfo ResourceManager::importModel(const std::string& path)
+    {
         auto materialNames = LoadMaterialNames(path.c_str());
         Model model = LoadModel(path.c_str());
-        dedupeAndShareMaterials(model, materialNames, path);
-        modelCopies.emplace(key, ModelInfo{model, std::move(materialNames), path});
+        NormalizeMaterialNames(model, materialNames, path);
+        return ModelInfo{model, std::move(materialNames), path};
+    }
+
+    ModelInfo ResourceManager::importModel(Model model)
+    {
+        std::vector<std::string> materialNames;
+        NormalizeMaterialNames(model, materialNames, "");
+        return ModelInfo{model, std::move(materialNames), ""};
     }
 
     void ResourceManager::StoreModel(const ModelInfo& modelInfo, const std::string& key)
@@ -459,71 +847,91 @@ namespace sage
 
     namespace
     {
-        // Registry of generators for primitives baked into the asset pack. CreateModelMutable
-        // uses these to regenerate a fresh mesh when the source asset has no on-disk file.
-        // Hardcoded list — raylib's GenMesh* functions, parameterized at canonical unit sizes
-        // (callers scale via the entity's transform).
-        using PrimitiveGenerator = Mesh (*)();
-
-        Mesh GenSphere()
+        template <typename T>
+        T* CloneArray(const T* source, int count)
         {
-            return GenMeshSphere(1.0f, 32, 32);
+            if (source == nullptr || count <= 0) return nullptr;
+            auto* copy = static_cast<T*>(RL_MALLOC(count * sizeof(T)));
+            std::memcpy(copy, source, count * sizeof(T));
+            return copy;
         }
-        Mesh GenHemiSphere()
-        {
-            return GenMeshHemiSphere(1.0f, 16, 32);
-        }
-        Mesh GenPlane()
-        {
-            return GenMeshPlane(1.0f, 1.0f, 1, 1);
-        }
-        Mesh GenCube()
-        {
-            return GenMeshCube(1.0f, 1.0f, 1.0f);
-        }
-        Mesh GenCylinder()
-        {
-            return GenMeshCylinder(1.0f, 1.0f, 32);
-        }
-        Mesh GenCone()
-        {
-            return GenMeshCone(1.0f, 1.0f, 32);
-        }
-        Mesh GenTorus()
-        {
-            return GenMeshTorus(0.25f, 1.0f, 16, 32);
-        }
-        Mesh GenKnot()
+
+        /* Clones a resident model without touching the disk. Vertex/index arrays and GPU buffers
+        are shared with the source; everything an instance can change is private: material map
+        arrays (textures themselves stay shared), the mesh-material table, bones, bind pose and
+        each mesh's bone matrix palette. Skinned vertices are not kept per instance: the palette
+        is skinned on the GPU, or into SkinningPool's scratch buffers when the shader can't. */
+        Model CloneModelShared(const Model& source)
         {
-            return GenMeshKnot(1.0f, 2.0f, 16, 128);
+            Model model = source;
+
+            model.meshes = CloneArray(source.meshes, source.meshCount);
+            for (int i = 0; i < model.meshCount; ++i)
+            {
+                Mesh& mesh = model.meshes[i];
+                mesh.boneMatrices = CloneArray(mesh.boneMatrices, mesh.boneCount);
+                mesh.animVertices = nullptr;
+                mesh.animNormals = nullptr;
+            }
+
+            model.materials = CloneArray(source.materials, source.materialCount);
+            for (int i = 0; i < model.materialCount; ++i)
+            {
+                model.materials[i].maps = CloneArray(source.materials[i].maps, MAX_MATERIAL_MAPS);
+            }
+
+            model.meshMaterial = CloneArray(source.meshMaterial, source.meshCount);
+            model.bones = CloneArray(source.bones, source.boneCount);
+            model.bindPose = CloneArray(source.bindPose, source.boneCount);
+            return model;
         }
-        Mesh GenPoly()
+
+        // Returns a pooled clone to the state CloneModelShared left it in, keeping its allocations.
+        void ResetModelClone(Model& clone, const Model& source)
         {
-            return GenMeshPoly(5, 1.0f);
+            clone.transform = source.transform;
+            for (int i = 0; i < clone.meshCount; ++i)
+            {
+                const Mesh& mesh = source.meshes[i];
+                if (mesh.boneMatrices == nullptr) continue;
+                std::memcpy(clone.meshes[i].boneMatrices, mesh.boneMatrices, mesh.boneCount * sizeof(Matrix));
+            }
+            for (int i = 0; i < clone.materialCount; ++i)
+            {
+                MaterialMap* maps = clone.materials[i].maps;
+                std::memcpy(maps, source.materials[i].maps, MAX_MATERIAL_MAPS * sizeof(MaterialMap));
+                clone.materials[i] = source.materials[i];
+                clone.materials[i].maps = maps;
+            }
+            std::memcpy(clone.meshMaterial, source.meshMaterial, clone.meshCount * sizeof(int));
         }
 
-        const std::unordered_map<std::string, PrimitiveGenerator>& PrimitiveGenerators()
+        // Frees what CloneModelShared allocated, leaving the shared mesh data alone.
+        void UnloadModelClone(const Model& model)
         {
-            static const std::unordered_map<std::string, PrimitiveGenerator> generators = {
-                {"primitive_sphere", &GenSphere},
-                {"primitive_hemisphere", &GenHemiSphere},
-                {"primitive_plane", &GenPlane},
-                {"primitive_cube", &GenCube},
-                {"primitive_cylinder", &GenCylinder},
-                {"primitive_cone", &GenCone},
-                {"primitive_torus", &GenTorus},
-                {"primitive_knot", &GenKnot},
-                {"primitive_poly", &GenPoly},
-            };
-            return generators;
+            for (int i = 0; i < model.meshCount; ++i)
+            {
+                RL_FREE(model.meshes[i].boneMatrices);
+            }
+            for (int i = 0; i < model.materialCount; ++i)
+            {
+                RL_FREE(model.materials[i].maps);
+            }
+            RL_FREE(model.meshes);
+            RL_FREE(model.materials);
+            RL_FREE(model.meshMaterial);
+            RL_FREE(model.bones);
+            RL_FREE(model.bindPose);
         }
     } // namespace
 
     /* Non-owning view onto the shared model entry stored under viewKey. Read-only API.
     The returned ModelView's lifetime is independent of RM: it just borrows; the
-    underlying entry stays alive until UnloadAll (i.e. scene tear-down). */
-    ModelView ResourceManager::GetModelView(const std::string& viewKey) const
+    underlying entry stays alive until UnloadAll (i.e. scene tear-down). The entry is
+    faulted in from the mounted archive on first use. */
+    ModelView ResourceManager::GetModelView(const std::string& viewKey)
     {
+        faultModel(viewKey);
         assert(modelCopies.contains(viewKey));
         ModelView view;
         view.rlmodel = modelCopies.at(viewKey).model;
@@ -531,49 +939,87 @@ namespace sage
         return view;
     }
 
-    /* Create a new deep-copy entry in the mutable pool from the asset stored under
-    viewKey, and returns a ModelMutable view onto it. The deep copy has private
-    materials, so mutations through the returned view are isolated. Lifetime of
-    the new entry is scene-tied (released at UnloadAll). For models loaded from
-    disk this re-loads via sourcePath; for baked primitives it regenerates via a
-    registered generator function. */
+    /* Returns a ModelMutable handle onto a private clone of the asset stored under viewKey.
+    The clone shares the source's vertex data and GPU buffers but has private materials and a
+    private bone palette, so mutations through the returned handle are isolated. A previously
+    released instance of the same asset is reset and reused if one is pooled; otherwise a new
+    one is cloned. The entry returns to the pool when the last copy of the handle is destroyed,
+    and is freed at UnloadAll. Works from memory only: spawning does not touch the filesystem. */
     ModelMutable ResourceManager::CreateModelMutable(const std::string& viewKey)
     {
+        faultModel(viewKey);
         assert(modelCopies.contains(viewKey));
         const auto& info = modelCopies.at(viewKey);
 
-        const std::string instanceKey = viewKey + "#mut_" + std::to_string(mutableInstanceCounter++);
-        assert(!modelCopies.contains(instanceKey) && "CreateModelMutable: instanceKey collision");
-
-        Model model;
-        const auto& generators = PrimitiveGenerators();
-        if (!info.sourcePath.empty())
+        std::string instanceKey;
+        auto& stats = mutablePoolStats[viewKey];
+        if (auto& freeList = mutableFreeList[viewKey]; !freeList.empty())
         {
-            // On-disk asset — re-load to get private mesh + material allocations.
-            assert(FileExists(info.sourcePath.c_str()) && "CreateModelMutable: source file missing at runtime");
-            model = LoadModel(info.sourcePath.c_str());
-        }
-        else if (const auto it = generators.find(viewKey); it != generators.end())
-        {
-            // Baked primitive — regenerate mesh, raylib allocates fresh default materials.
-            model = LoadModelFromMesh(it->second());
+            instanceKey = std::move(freeList.back());
+            freeList.pop_back();
+            --stats.pooled;
+            ResetModelClone(modelCopies.at(instanceKey).model, info.model);
         }
         else
         {
-            assert(false && "CreateModelMutable: asset has no sourcePath and is not a registered primitive");
-            return {};
+            instanceKey = viewKey + "#mut_" + std::to_string(mutableInstanceCounter++);
+            assert(!modelCopies.contains(instanceKey) && "CreateModelMutable: instanceKey collision");
+            modelCopies.emplace(
+                instanceKey,
+                ModelInfo{
+                    CloneModelShared(info.model), info.materialNames, info.sourcePath, /*privateMaterials=*/true});
         }
-
-        modelCopies.emplace(
-            instanceKey, ModelInfo{model, info.materialNames, info.sourcePath, /*privateMaterials=*/true});
+        ++stats.live;
 
         ModelMutable mut;
         mut.rlmodel = modelCopies.at(instanceKey).model;
         mut.assetKey = viewKey;
         mut.instanceKey = instanceKey;
+        mut.lease = std::shared_ptr<void>(
+            nullptr, [viewKey, instanceKey, generation = mutablePoolGeneration](void*) {
+                GetInstance().releaseModelMutable(viewKey, instanceKey, generation);
+            });
         return mut;
     }
 
+    /* Takes ownership of a model built at runtime (mesh already uploaded) and returns a view onto
+    it. Its materials array is owned by the entry, but the maps inside are expected to come from
+    the material pool. Freed at UnloadAll; never saved. */
+    ModelView ResourceManager::StoreGeneratedModel(const std::string& key, Model model)
+    {
+        assert(!modelCopies.contains(key) && "StoreGeneratedModel: key collision");
+        ModelInfo info{model, {}, "", /*privateMaterials=*/false};
+        info.transient = true;
+        modelCopies.emplace(key, std::move(info));
+        return GetModelView(key);
+    }
+
+    void ResourceManager::releaseModelMutable(
+        const std::string& assetKey, const std::string& instanceKey, std::uint64_t generation)
+    {
+        // The entry was already freed by UnloadAll.
+        if (generation != mutablePoolGeneration) return;
+        assert(modelCopies.contains(instanceKey));
+
+        auto& stats = mutablePoolStats[assetKey];
+        assert(stats.live > 0);
+        --stats.live;
+        ++stats.pooled;
+        mutableFreeList[assetKey].push_back(instanceKey);
+    }
+
+    ModelPoolStats ResourceManager::GetModelPoolStats(const std::string& viewKey) const
+    {
+        const auto it = mutablePoolStats.find(viewKey);
+        return it != mutablePoolStats.end() ? it->second : ModelPoolStats{};
+    }
+
+    // Per source asset, for memory dashboards.
+    const std::unordered_map<std::string, ModelPoolStats>& ResourceManager::GetModelPoolStats() const
+    {
+        return mutablePoolStats;
+    }
+
     void ResourceManager::ModelAnimationLoadFromFile(const std::string& path)
     {
         auto key = StripPath(path); // Will either be a mesh alias (MDL_GOBLIN) or a mesh name (e.g., QUEST_BONE
@@ -588,21 +1034,30 @@ namespace sage
                              "Aborting... \n";
                 return;
             }
-            modelAnimations[key] = std::make_pair(animations, animsCount);
+            std::vector<AnimationClip> clips;
+            clips.reserve(animsCount);
+            for (int i = 0; i < animsCount; ++i)
+            {
+                clips.push_back(AnimationClip::Compress(animations[i]));
+            }
+            UnloadModelAnimations(animations, animsCount);
+            modelAnimations[key] = std::move(clips);
         }
     }
 
-    ModelAnimation* ResourceManager::GetModelAnimation(const std::string& key, int* animsCount) const
+    const AnimationClip* ResourceManager::GetModelAnimation(const std::string& key, int* animsCount)
     {
-        if (!modelAnimations.contains(key))
+        if (!faultAnimation(key))
         {
             TraceLog(
-                LOG_FATAL, "ResourceManager::GetModelAnimation: animation '%s' was not pre-loaded.", key.c_str());
+                LOG_FATAL,
+                "ResourceManager::GetModelAnimation: animation '%s' is neither loaded nor archived.",
+                key.c_str());
             assert(false && "missing model animation");
         }
-        const auto& pair = modelAnimations.at(key);
-        *animsCount = pair.second;
-        return pair.first;
+        const auto& clips = modelAnimations.at(key);
+        *animsCount = static_cast<int>(clips.size());
+        return clips.data();
     }
 
     void ResourceManager::UnloadImages()
@@ -612,6 +1067,9 @@ namespace sage
             UnloadImage(image);
         }
         images.clear();
+        imageLru.clear();
+        imageLruPos.clear();
+        imageCacheBytes = 0;
     }
 
     void ResourceManager::UnloadShaderFileText()
@@ -671,23 +1129,9 @@ namespace sage
         {
             if (info.privateMaterials)
             {
-                // Deep-copy entry: free the per-material maps allocations, but don't
-                // UnloadMaterial — textures and shaders inside are RM-cached and still
-                // in use by other entries.
-                Model& m = info.model;
-                for (int i = 0; i < m.materialCount; ++i)
-                {
-                    RL_FREE(m.materials[i].maps);
-                }
-                for (int i = 0; i < m.meshCount; ++i)
-                {
-                    UnloadMesh(m.meshes[i]);
-                }
-                RL_FREE(m.meshes);
-                RL_FREE(m.materials);
-                RL_FREE(m.meshMaterial);
-                RL_FREE(m.bones);
-                RL_FREE(m.bindPose);
+                // Clone entry: free only its private arrays. Mesh data, textures and shaders
+                // are shared with the source entry and pooled materials.
+                UnloadModelClone(info.model);
             }
             else
             {
@@ -702,14 +1146,11 @@ namespace sage
         {
             UnloadImage(image);
         }
-        for (const auto& [fst, snd] : modelAnimations | std::views::values)
-        {
-            UnloadModelAnimations(fst, snd);
-        }
         for (const auto& shader : shaders | std::views::values)
         {
             UnloadShader(shader);
         }
+        ShaderUniformCache::GetInstance().Clear(); // Shader ids may be reused by the next scene
         for (const auto& text : vertShaderFileText | std::views::values)
         {
             UnloadFileText(text);
@@ -726,8 +1167,14 @@ namespace sage
         shaders.clear();
         materialMap.clear();
         images.clear();
+        imageLru.clear();
+        imageLruPos.clear();
+        imageCacheBytes = 0;
         nonModelTextures.clear();
         modelCopies.clear();
+        mutableFreeList.clear();
+        mutablePoolStats.clear();
+        ++mutablePoolGeneration;
         modelAnimations.clear();
         vertShaderFileText.clear();
         fragShaderFileText.clear();
@@ -751,6 +1198,7 @@ namespace sage
 
     ResourceManager::~ResourceManager()
     {
+        UnmountArchive();
         UnloadAll();
     }
 
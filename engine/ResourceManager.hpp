@@ -4,6 +4,9 @@
 #pragma once
 
 // #include "common_types.hpp"
+#include "AnimationClip.hpp"
+#include "AssetArchive.hpp"
+#include "AssetStreamer.hpp"
 #include "slib.hpp"
 
 #include "magic_enum/magic_enum.hpp"
@@ -18,6 +21,9 @@
 #include "cereal/types/vector.hpp"
 #include "raylib-cereal.hpp"
 
+#include <array>
+#include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -28,11 +34,13 @@ namespace sage
         Model model;
         std::vector<std::string>
             materialNames;      // names of this mesh's materials (at the same index in model.materials)
-        std::string sourcePath; // path used by raylib LoadModel; required by CreateModelMutable at runtime
-        // True when this entry's materials are private (i.e. it's a mutable-pool entry
-        // created by CreateModelMutable). UnloadAll frees the per-material
-        // maps allocations directly rather than going through the shared materialMap.
+        std::string sourcePath; // path used by raylib LoadModel at pack time (empty for primitives)
+        // True when this entry is a mutable-pool clone created by CreateModelMutable: it owns
+        // private material arrays and bone palette but shares mesh data with its source entry.
+        // UnloadAll frees only the private arrays.
         bool privateMaterials = false;
+        // Built at runtime from other entries (e.g. static mesh batches); never written to a bin.
+        bool transient = false;
 
         template <class Archive>
         void save(Archive& archive) const
@@ -50,6 +58,14 @@ namespace sage
         }
     };
 
+    // Mutable-pool occupancy for one asset: instances held by live handles, and released
+    // instances waiting in the free list to be recycled.
+    struct ModelPoolStats
+    {
+        std::size_t live = 0;
+        std::size_t pooled = 0;
+    };
+
     class ResourceManager
     {
         ResourceManager();
@@ -61,15 +77,57 @@ namespace sage
         std::unordered_map<std::string, Image> images{};             // Image (CPU) data
         std::unordered_map<std::string, Texture> nonModelTextures{}; // Textures loaded outside of model loading
         std::unordered_map<std::string, ModelInfo> modelCopies{};
-        std::unordered_map<std::string, std::pair<ModelAnimation*, int>> modelAnimations{};
+        std::unordered_map<std::string, std::vector<AnimationClip>> modelAnimations{}; // Compressed clips
         // Monotonic counter used to mint unique instance keys for mutable-pool entries
         // returned by CreateModelMutable. Not serialized.
         std::uint64_t mutableInstanceCounter = 0;
+        // Released mutable instances per source asset, reused before cloning a new one.
+        std::unordered_map<std::string, std::vector<std::string>> mutableFreeList{};
+        std::unordered_map<std::string, ModelPoolStats> mutablePoolStats{};
+        // Bumped by UnloadAll so handles outliving a scene don't return freed entries to the pool.
+        std::uint64_t mutablePoolGeneration = 0;
         std::unordered_map<std::string, char*> vertShaderFileText{};
         std::unordered_map<std::string, char*> fragShaderFileText{};
         std::unordered_map<std::string, Music> music;
         std::unordered_map<std::string, Sound> sfx;
 
+        // Packed asset bin. Images, models, materials and animations stay on disk until first
+        // requested, then are faulted in by key. Survives UnloadAll so a new scene can re-fault.
+        AssetArchiveReader archive;
+        // CPU-side images faulted in from the archive, most recently used at the front. Only
+        // archive-backed images are tracked (and evicted): they can always be faulted back in.
+        std::list<std::string> imageLru;
+        std::unordered_map<std::string, std::list<std::string>::iterator> imageLruPos;
+        std::size_t imageCacheBytes = 0;
+        // Outstanding GetImage views per cached image; pinned images are never evicted.
+        std::unordered_map<std::string, int> imagePins;
+        std::size_t imageCacheBudget = 64 * 1024 * 1024;
+
+        // Background decode of archived assets. Workers only produce CPU-side data; GPU uploads
+        // and insertion into the maps above happen on the main thread in PumpUploads.
+        AssetStreamer streamer;
+        std::array<std::unordered_map<std::string, std::shared_ptr<AssetStreamState>>, 4> inFlight{};
+        // Decoded models whose materials are still streaming.
+        std::vector<DecodedAsset> awaitingMaterials;
+        std::size_t uploadBudget = 8 * 1024 * 1024;
+
+        bool faultImage(const std::string& key);
+        bool faultMaterial(const std::string& name);
+        bool faultModel(const std::string& key);
+        bool faultAnimation(const std::string& key);
+        void storeArchivedImage(const std::string& key, const Image& image);
+        void storeArchivedModel(const std::string& key, ModelInfo info);
+        void storeAnimations(const std::string& key, std::vector<AnimationClip> data);
+        [[nodiscard]] bool isResident(AssetType type, const std::string& key) const;
+        AssetHandle stream(AssetType type, const std::string& key);
+        void finishStream(AssetStreamState& state, AssetStreamStatus status);
+        bool installDecodedModel(DecodedAsset& asset);
+        void installDecoded(DecodedAsset& asset);
+        void touchImage(const std::string& key);
+        void forgetImage(const std::string& key);
+        void trimImageCache(const std::string& keep);
+        void unpinImage(const std::string& key);
+
         Shader gpuShaderLoad(const char* vs, const char* fs);
         void dedupeAndShareMaterials(
             Model& model, std::vector<std::string>& materialNames, const std::string& sourcePath);
@@ -80,7 +138,10 @@ namespace sage
         void ModelLoadFromFile(const std::string& path);
         void ModelLoadFromFile(const std::string& path, const std::string& key);
         void StoreModel(const ModelInfo& modelInfo, const std::string& key);
+        static ModelInfo importModel(const std::string& path);
+        static ModelInfo importModel(Model model);
         void ModelAnimationLoadFromFile(const std::string& path);
+        void releaseModelMutable(const std::string& assetKey, const std::string& instanceKey, std::uint64_t generation);
 
       public:
         static ResourceManager& GetInstance()
@@ -97,9 +158,29 @@ namespace sage
         Font FontLoad(const std::string& path);
         void ImageUnload(const std::string& key);
         [[nodiscard]] ImageSafe GetImage(const std::string& key);
-        [[nodiscard]] ModelView GetModelView(const std::string& viewKey) const;
+        [[nodiscard]] ModelView GetModelView(const std::string& viewKey);
         [[nodiscard]] ModelMutable CreateModelMutable(const std::string& viewKey);
-        [[nodiscard]] ModelAnimation* GetModelAnimation(const std::string& key, int* animsCount) const;
+        ModelView StoreGeneratedModel(const std::string& key, Model model);
+        [[nodiscard]] ModelPoolStats GetModelPoolStats(const std::string& viewKey) const;
+        [[nodiscard]] const std::unordered_map<std::string, ModelPoolStats>& GetModelPoolStats() const;
+        [[nodiscard]] const AnimationClip* GetModelAnimation(const std::string& key, int* animsCount);
+        // Deserialises a compiled script stored in the mounted archive into out. Scripts are game data the
+        // engine does not interpret, so nothing is kept resident.
+        template <typename T>
+        bool ReadScript(const std::string& key, T& out)
+        {
+            return archive.IsOpen() && archive.Read(AssetType::Script, key, out);
+        }
+        void MountArchive(const char* path);
+        void UnmountArchive();
+        void Prefetch(const std::vector<std::string>& keys);
+        void SetImageCacheBudget(std::size_t bytes);
+        [[nodiscard]] AssetHandle StreamModel(const std::string& key);
+        [[nodiscard]] AssetHandle StreamImage(const std::string& key);
+        [[nodiscard]] AssetHandle StreamAnimation(const std::string& key);
+        std::vector<AssetHandle> StreamPrefetch(const std::vector<std::string>& keys);
+        void PumpUploads();
+        void SetUploadBudget(std::size_t bytesPerFrame);
         void UnloadImages();
         void UnloadShaderFileText();
 
@@ -113,19 +194,24 @@ namespace sage
         {
             std::vector<std::string> animatedModelKeys;
             std::vector<int> modelAnimCounts;
-            std::vector<std::vector<ModelAnimation>> modelAnimationsData;
+            std::vector<std::vector<AnimationClip>> modelAnimationsData;
 
-            for (const auto& [key, p] : GetInstance().modelAnimations)
+            for (const auto& [key, clips] : GetInstance().modelAnimations)
             {
-                const auto& [modelAnims, count] = p;
                 animatedModelKeys.push_back(key);
-                modelAnimCounts.push_back(count);
-                modelAnimationsData.emplace_back(modelAnims, modelAnims + count);
+                modelAnimCounts.push_back(static_cast<int>(clips.size()));
+                modelAnimationsData.push_back(clips);
+            }
+
+            std::unordered_map<std::string, ModelInfo> persistentModels;
+            for (const auto& [key, info] : GetInstance().modelCopies)
+            {
+                if (!info.transient) persistentModels.emplace(key, info);
             }
 
             archive(
                 GetInstance().images,
-                GetInstance().modelCopies,
+                persistentModels,
                 GetInstance().materialMap,
                 // GetInstance().music,
                 // GetInstance().sfx,
@@ -141,7 +227,7 @@ namespace sage
         {
             std::vector<std::string> animatedModelKeys;
             std::vector<int> modelAnimCounts;
-            std::vector<std::vector<ModelAnimation>> modelAnimationsData;
+            std::vector<std::vector<AnimationClip>> modelAnimationsData;
 
             // Copy necessary (I believe) so we can concat multiple calls of "load"
             std::unordered_map<std::string, Image> _images{};
@@ -202,16 +288,14 @@ namespace sage
                     }
 
                     const auto& mat = model.materialNames[i];
+                    faultMaterial(mat);
                     model.model.materials[i] = materialMap[mat];
                 }
             }
 
             for (int i = 0; i < animatedModelKeys.size(); ++i)
             {
-                auto count = modelAnimCounts[i];
-                auto* animations = static_cast<ModelAnimation*>(RL_MALLOC(count * sizeof(ModelAnimation)));
-                std::memcpy(animations, modelAnimationsData[i].data(), count * sizeof(ModelAnimation));
-                modelAnimations.emplace(animatedModelKeys[i], std::make_pair(animations, count));
+                modelAnimations.emplace(animatedModelKeys[i], std::move(modelAnimationsData[i]));
             }
         }
 
@@ -4,45 +4,18 @@
 
 #include "Serializer.hpp"
 
-#include "components/Collideable.hpp"
-#include "components/Renderable.hpp"
-#include "components/sgTransform.hpp"
+#include "ResourceManager.hpp"
 
 namespace sage::serializer
 {
     // ----------------------------------------------
 
-    void LoadAssetBinFile(entt::registry* destination, const char* path)
+    // Mounts the packed asset bin. Only the table of contents is read here; assets are
+    // faulted in by ResourceManager on first use (or via ResourceManager::Prefetch).
+    void LoadAssetBinFile(const char* path)
     {
-        assert(destination != nullptr);
         std::cout << "START: Loading asset bin." << std::endl;
-
-        ReadCompressedBinary(
-            path, kAssetBinMagic, [&](cereal::BinaryInputArchive& input, std::istream& stream) {
-                input(ResourceManager::GetInstance());
-
-                // Not necessary for asset bin?
-                while (stream.peek() != EOF)
-                {
-                    entity entityId{};
-                    auto entt = destination->create();
-                    auto& transform = destination->emplace<sgTransform>(entt);
-                    auto& collideable = destination->emplace<Collideable>(entt);
-                    destination->emplace<StaticCollideable>(entt);
-                    auto& renderable = destination->emplace<Renderable>(entt);
-
-                    try
-                    {
-                        input(entityId, transform, collideable, renderable);
-                    }
-                    catch (const cereal::Exception& e)
-                    {
-                        std::cerr << "ERROR: Serialization error: " << e.what() << std::endl;
-                        break;
-                    }
-                }
-            });
-
+        ResourceManager::GetInstance().MountArchive(path);
         std::cout << "FINISH: Loading asset bin." << std::endl;
     }
 } // namespace sage::serializer
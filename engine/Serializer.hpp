@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "CompressedStream.hpp"
 #include "ViewSerializer.hpp"
 
 #include "cereal/archives/binary.hpp"
@@ -35,7 +36,7 @@ namespace sage::serializer
         archive(entity.id);
     }
 
-    void LoadAssetBinFile(entt::registry* destination, const char* path);
+    void LoadAssetBinFile(const char* path);
 
     template <typename T>
     void SaveClassXML(const char* path, const T& toSave)
@@ -157,57 +158,55 @@ namespace sage::serializer
 
     // Per-file-type magic prefixes for compressed binaries. Bumped if on-disk layout changes.
     inline constexpr char kAssetBinMagic[4] = {'L', 'Q', 'B', '1'};
-    inline constexpr char kMapBinMagic[4] = {'L', 'Q', 'M', '1'};
+    inline constexpr char kMapBinMagic[4] = {'L', 'Q', 'M', '2'};
 
     // Writes a 20-byte header (magic + uncompressed size + compressed size) followed by a
-    // DEFLATE-compressed cereal binary payload. The lambda receives a BinaryOutputArchive and
-    // is free to call output(...) any number of times.
+    // chunked DEFLATE cereal binary payload (see CompressedStream.hpp). The payload is
+    // compressed as it is produced, so it is never held in memory as a whole. The lambda
+    // receives a BinaryOutputArchive and is free to call output(...) any number of times.
     template <typename ArchiveFn>
     void WriteCompressedBinary(const char* path, const char (&magic)[4], ArchiveFn&& archiveFn)
     {
-        std::ostringstream buf(std::ios::binary);
-        {
-            cereal::BinaryOutputArchive output{buf};
-            archiveFn(output);
-        }
-        const std::string raw = buf.str();
-        const int rawSize = static_cast<int>(raw.size());
-
-        int compSize = 0;
-        unsigned char* compData = CompressData(
-            reinterpret_cast<const unsigned char*>(raw.data()), rawSize, &compSize);
-        if (compData == nullptr || compSize <= 0)
-        {
-            std::cerr << "ERROR: CompressData failed; aborting save." << std::endl;
-            if (compData) MemFree(compData);
-            exit(1);
-        }
-
         std::ofstream storage(path, std::ios::binary);
         if (!storage.is_open())
         {
             std::cerr << "ERROR: Unable to open file for writing." << std::endl;
-            MemFree(compData);
             exit(1);
         }
 
-        const uint64_t uncompressedSize = static_cast<uint64_t>(rawSize);
-        const uint64_t compressedSize = static_cast<uint64_t>(compSize);
+        // Sizes are patched in once the payload has been written.
+        uint64_t uncompressedSize = 0;
+        uint64_t compressedSize = 0;
         storage.write(magic, sizeof(magic));
         storage.write(reinterpret_cast<const char*>(&uncompressedSize), sizeof(uncompressedSize));
         storage.write(reinterpret_cast<const char*>(&compressedSize), sizeof(compressedSize));
-        storage.write(reinterpret_cast<const char*>(compData), compSize);
 
-        MemFree(compData);
+        DeflateStreamBuf deflate(storage);
+        {
+            std::ostream payload(&deflate);
+            cereal::BinaryOutputArchive output{payload};
+            archiveFn(output);
+        }
+        if (!deflate.Finish())
+        {
+            std::cerr << "ERROR: Compression failed; aborting save." << std::endl;
+            exit(1);
+        }
+
+        uncompressedSize = deflate.GetRawSize();
+        compressedSize = deflate.GetCompressedSize();
+        storage.seekp(sizeof(magic));
+        storage.write(reinterpret_cast<const char*>(&uncompressedSize), sizeof(uncompressedSize));
+        storage.write(reinterpret_cast<const char*>(&compressedSize), sizeof(compressedSize));
         storage.close();
-        std::cout << "  (raw=" << rawSize << "B compressed=" << compSize
-                  << "B ratio=" << (rawSize > 0 ? (static_cast<double>(compSize) / rawSize) : 0.0) << ")"
-                  << std::endl;
+        std::cout << "  (raw=" << uncompressedSize << "B compressed=" << compressedSize << "B ratio="
+                  << (uncompressedSize > 0 ? (static_cast<double>(compressedSize) / uncompressedSize) : 0.0)
+                  << ")" << std::endl;
     }
 
-    // Reads a header-prefixed DEFLATE-compressed cereal payload, then invokes the lambda with
-    // both a BinaryInputArchive and the underlying istream (so callers that use peek-until-EOF
-    // loops still work).
+    // Reads a header-prefixed chunked DEFLATE cereal payload, inflating one chunk at a time as
+    // cereal consumes it. Invokes the lambda with both a BinaryInputArchive and the underlying
+    // istream (so callers that use peek-until-EOF loops still work).
     template <typename ArchiveFn>
     void ReadCompressedBinary(const char* path, const char (&magic)[4], ArchiveFn&& archiveFn)
     {
@@ -233,28 +232,18 @@ namespace sage::serializer
             exit(1);
         }
 
-        std::vector<unsigned char> compBuf(compressedSize);
-        storage.read(reinterpret_cast<char*>(compBuf.data()), static_cast<std::streamsize>(compressedSize));
-        storage.close();
-
-        int decompSize = 0;
-        unsigned char* decompData =
-            DecompressData(compBuf.data(), static_cast<int>(compressedSize), &decompSize);
-        if (decompData == nullptr || static_cast<uint64_t>(decompSize) != uncompressedSize)
+        InflateStreamBuf inflate(storage);
+        std::istream payload(&inflate);
         {
-            std::cerr << "ERROR: DecompressData failed (got " << decompSize << ", expected "
-                      << uncompressedSize << ")." << std::endl;
-            if (decompData) MemFree(decompData);
-            exit(1);
+            cereal::BinaryInputArchive input(payload);
+            archiveFn(input, payload);
         }
 
-        std::string decompStr(reinterpret_cast<const char*>(decompData), uncompressedSize);
-        MemFree(decompData);
-
-        std::istringstream inBuf(std::move(decompStr), std::ios::binary);
+        if (inflate.Failed())
         {
-            cereal::BinaryInputArchive input(inBuf);
-            archiveFn(input, inBuf);
+            std::cerr << "ERROR: Decompression failed after " << inflate.GetRawSize() << " of "
+                      << uncompressedSize << " bytes." << std::endl;
+            exit(1);
         }
     }
 
@@ -9,8 +9,21 @@
 #include "cereal/cereal.hpp"
 #include "raylib.h"
 
+#include <array>
+
 namespace sage
 {
+    // Update-rate LOD for AI state machines (see UpdateScheduler).
+    struct AiUpdateSettings
+    {
+        // When false, every entity ticks every frame.
+        bool enabled = true;
+        // Frames between ticks for each UpdateBucket: Critical, Near, Far, Dormant.
+        std::array<int, 4> intervals{1, 2, 6, 15};
+        float nearDistance = 25.0f;
+        float farDistance = 60.0f;
+    };
+
     struct Settings
     {
       private:
@@ -35,6 +48,7 @@ namespace sage
         static constexpr float TARGET_SCREEN_HEIGHT = 1080.0f;
 
         bool toggleFullScreenRequested = false;
+        AiUpdateSettings aiUpdate;
 
         void ExitProgram()
         {
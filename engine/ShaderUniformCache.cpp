@@ -0,0 +1,81 @@
+#include "ShaderUniformCache.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace sage
+{
+    namespace
+    {
+        int UniformSize(int uniformType)
+        {
+            switch (uniformType)
+            {
+            case SHADER_UNIFORM_FLOAT:
+                return sizeof(float);
+            case SHADER_UNIFORM_VEC2:
+                return 2 * sizeof(float);
+            case SHADER_UNIFORM_VEC3:
+                return 3 * sizeof(float);
+            case SHADER_UNIFORM_VEC4:
+                return 4 * sizeof(float);
+            case SHADER_UNIFORM_INT:
+            case SHADER_UNIFORM_SAMPLER2D:
+                return sizeof(int);
+            case SHADER_UNIFORM_IVEC2:
+                return 2 * sizeof(int);
+            case SHADER_UNIFORM_IVEC3:
+                return 3 * sizeof(int);
+            case SHADER_UNIFORM_IVEC4:
+                return 4 * sizeof(int);
+            default:
+                return 0;
+            }
+        }
+
+        std::uint64_t EntryKey(unsigned int shaderId, int loc)
+        {
+            return (static_cast<std::uint64_t>(shaderId) << 32) | static_cast<std::uint32_t>(loc);
+        }
+    } // namespace
+
+    bool ShaderUniformCache::SetValue(Shader shader, int loc, const void* value, int uniformType)
+    {
+        if (loc < 0) return false;
+        const int size = UniformSize(uniformType);
+        assert(size > 0 && "ShaderUniformCache: unsupported uniform type");
+
+        auto& entry = entries[EntryKey(shader.id, loc)];
+        if (entry.size == size && std::memcmp(entry.value.data(), value, size) == 0)
+        {
+            ++frame.avoided;
+            return false;
+        }
+        std::memcpy(entry.value.data(), value, size);
+        entry.size = size;
+        ++frame.uploads;
+        SetShaderValue(shader, loc, value, uniformType);
+        return true;
+    }
+
+    void ShaderUniformCache::Invalidate(unsigned int shaderId)
+    {
+        std::erase_if(entries, [shaderId](const auto& kv) { return (kv.first >> 32) == shaderId; });
+    }
+
+    void ShaderUniformCache::Clear()
+    {
+        entries.clear();
+    }
+
+    void ShaderUniformCache::BeginFrame()
+    {
+        lastFrame = frame;
+        frame = {};
+    }
+
+    const ShaderUniformCache::Stats& ShaderUniformCache::GetLastFrameStats() const
+    {
+        return lastFrame;
+    }
+} // namespace sage
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace sage
+{
+    /*
+     * Remembers the last value written to each (shader, uniform location) so repeated writes of
+     * the same value skip the GL call. Uniform values live in the program object, so the cache
+     * stays valid until something writes the location without going through it; only route
+     * uniforms that are always set through here.
+     */
+    class ShaderUniformCache
+    {
+      public:
+        struct Stats
+        {
+            unsigned int uploads = 0;
+            unsigned int avoided = 0;
+        };
+
+      private:
+        struct Entry
+        {
+            std::array<unsigned char, 16 * sizeof(float)> value{};
+            int size = 0;
+        };
+        std::unordered_map<std::uint64_t, Entry> entries;
+        Stats frame{};
+        Stats lastFrame{};
+
+        ShaderUniformCache() = default;
+
+      public:
+        static ShaderUniformCache& GetInstance()
+        {
+            static ShaderUniformCache instance;
+            return instance;
+        }
+
+        // Same contract as raylib's SetShaderValue. Returns true if the value was uploaded.
+        bool SetValue(Shader shader, int loc, const void* value, int uniformType);
+        // Forget everything known about shaderId (e.g. it was unloaded and the id may be reused).
+        void Invalidate(unsigned int shaderId);
+        void Clear();
+        // Starts a new counting window; the finished one becomes GetLastFrameStats().
+        void BeginFrame();
+        [[nodiscard]] const Stats& GetLastFrameStats() const;
+
+        ShaderUniformCache(const ShaderUniformCache&) = delete;
+        ShaderUniformCache& operator=(const ShaderUniformCache&) = delete;
+    };
+} // namespace sage
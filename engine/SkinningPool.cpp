@@ -0,0 +1,73 @@
+#include "SkinningPool.hpp"
+
+#include "raymath.h"
+#include "rlgl.h"
+
+namespace sage
+{
+    void SkinningPool::SkinAndUpload(const Mesh& mesh)
+    {
+        const auto valueCount = static_cast<size_t>(mesh.vertexCount) * 3;
+        if (vertices.size() < valueCount)
+        {
+            vertices.resize(valueCount);
+            normals.resize(valueCount);
+        }
+
+        for (size_t v = 0; v < valueCount; v += 3)
+        {
+            const Vector3 position{mesh.vertices[v], mesh.vertices[v + 1], mesh.vertices[v + 2]};
+            const Vector3 normal =
+                mesh.normals ? Vector3{mesh.normals[v], mesh.normals[v + 1], mesh.normals[v + 2]} : Vector3{};
+            Vector3 skinnedPos{};
+            Vector3 skinnedNormal{};
+
+            const size_t influence = (v / 3) * 4;
+            for (size_t j = 0; j < 4; ++j)
+            {
+                const float weight = mesh.boneWeights[influence + j];
+                if (weight == 0.0f) continue;
+                const Matrix& bone = mesh.boneMatrices[mesh.boneIds[influence + j]];
+                skinnedPos = Vector3Add(skinnedPos, Vector3Scale(Vector3Transform(position, bone), weight));
+                if (mesh.normals)
+                {
+                    skinnedNormal =
+                        Vector3Add(skinnedNormal, Vector3Scale(Vector3Transform(normal, bone), weight));
+                }
+            }
+
+            vertices[v] = skinnedPos.x;
+            vertices[v + 1] = skinnedPos.y;
+            vertices[v + 2] = skinnedPos.z;
+            normals[v] = skinnedNormal.x;
+            normals[v + 1] = skinnedNormal.y;
+            normals[v + 2] = skinnedNormal.z;
+        }
+
+        const auto bytes = static_cast<int>(valueCount * sizeof(float));
+        rlUpdateVertexBuffer(mesh.vboId[0], vertices.data(), bytes, 0);
+        if (mesh.normals) rlUpdateVertexBuffer(mesh.vboId[2], normals.data(), bytes, 0);
+        skinnedBuffers.insert(mesh.vboId[0]);
+    }
+
+    void SkinningPool::RestoreBindPose(const Mesh& mesh)
+    {
+        if (!skinnedBuffers.erase(mesh.vboId[0])) return;
+        const auto bytes = static_cast<int>(mesh.vertexCount * 3 * sizeof(float));
+        rlUpdateVertexBuffer(mesh.vboId[0], mesh.vertices, bytes, 0);
+        if (mesh.normals) rlUpdateVertexBuffer(mesh.vboId[2], mesh.normals, bytes, 0);
+    }
+
+    void SkinningPool::PrepareDraw(const Mesh& mesh, const Material& material)
+    {
+        if (mesh.boneCount == 0 || !mesh.boneMatrices || !mesh.boneIds || !mesh.boneWeights) return;
+
+        if (material.shader.locs[SHADER_LOC_BONE_MATRICES] != -1)
+        {
+            // DrawMesh uploads mesh.boneMatrices as the palette; the VBO must hold the bind pose.
+            RestoreBindPose(mesh);
+            return;
+        }
+        SkinAndUpload(mesh);
+    }
+} // namespace sage
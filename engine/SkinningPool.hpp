@@ -0,0 +1,43 @@
+#pragma once
+
+#include "raylib.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace sage
+{
+    /*
+     * CPU skinning fallback for meshes drawn with a shader that has no bone palette uniform.
+     * Instances of an asset share one mesh and VBO and own only their bone matrices, so rather
+     * than every instance keeping its own skinned vertex arrays, each one is skinned into this
+     * pool's scratch buffers and uploaded into the shared VBO immediately before it is drawn.
+     */
+    class SkinningPool
+    {
+        std::vector<float> vertices;
+        std::vector<float> normals;
+        // VBOs currently holding CPU-skinned data rather than the bind pose.
+        std::unordered_set<unsigned int> skinnedBuffers;
+
+        SkinningPool() = default;
+
+      public:
+        static SkinningPool& GetInstance()
+        {
+            static SkinningPool instance;
+            return instance;
+        }
+
+        // Skins mesh with its current bone palette and uploads the result to its vertex buffers.
+        void SkinAndUpload(const Mesh& mesh);
+        // Puts the bind pose back if the mesh's buffers were last written by SkinAndUpload, so
+        // GPU-skinned draws of the same shared mesh are not skinned twice.
+        void RestoreBindPose(const Mesh& mesh);
+        // Chooses the skinning path for mesh under material. Call right before DrawMesh.
+        void PrepareDraw(const Mesh& mesh, const Material& material);
+
+        SkinningPool(const SkinningPool&) = delete;
+        SkinningPool& operator=(const SkinningPool&) = delete;
+    };
+} // namespace sage
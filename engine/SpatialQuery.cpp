@@ -0,0 +1,349 @@
+#include "SpatialQuery.hpp"
+
+#include "components/Collideable.hpp"
+#include "components/sgTransform.hpp"
+#include "systems/NavigationGridSystem.hpp"
+#include "systems/TransformSystem.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sage
+{
+    namespace
+    {
+        // Navigation squares are ~1 unit; a few per cell keeps typical ability radii to a handful of cells.
+        constexpr float SQUARES_PER_CELL = 4.0f;
+        constexpr float DEFAULT_CELL_SIZE = 4.0f;
+        constexpr int MAX_CELLS_PER_ENTITY = 256;
+
+        bool accepts(const SpatialQuery::Filter& filter, const entt::entity entity)
+        {
+            return !filter || filter(entity);
+        }
+
+        BoundingBox areaAround(const Vector3 centre, const float radius)
+        {
+            return {
+                {centre.x - radius, centre.y - radius, centre.z - radius},
+                {centre.x + radius, centre.y + radius, centre.z + radius}};
+        }
+    } // namespace
+
+    // ====== SpatialGrid =============================================================
+
+    std::uint64_t SpatialGrid::cellKey(int x, int z)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(z);
+    }
+
+    int SpatialGrid::cellCoord(float v) const
+    {
+        return static_cast<int>(std::floor(v / cellSize));
+    }
+
+    void SpatialGrid::link(const entt::entity entity, const Entry& entry)
+    {
+        if (entry.oversized)
+        {
+            oversized.push_back(entity);
+            return;
+        }
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            for (int z = entry.minZ; z <= entry.maxZ; ++z)
+            {
+                cells[cellKey(x, z)].push_back(entity);
+            }
+        }
+    }
+
+    void SpatialGrid::unlink(const entt::entity entity, const Entry& entry)
+    {
+        auto erase = [entity](std::vector<entt::entity>& list) {
+            const auto it = std::ranges::find(list, entity);
+            if (it == list.end()) return;
+            *it = list.back();
+            list.pop_back();
+        };
+
+        if (entry.oversized)
+        {
+            erase(oversized);
+            return;
+        }
+        for (int x = entry.minX; x <= entry.maxX; ++x)
+        {
+            for (int z = entry.minZ; z <= entry.maxZ; ++z)
+            {
+                const auto it = cells.find(cellKey(x, z));
+                if (it == cells.end()) continue;
+                erase(it->second);
+                if (it->second.empty()) cells.erase(it);
+            }
+        }
+    }
+
+    void SpatialGrid::Insert(const entt::entity entity, const BoundingBox& bounds)
+    {
+        Entry entry;
+        entry.bounds = bounds;
+        entry.minX = cellCoord(bounds.min.x);
+        entry.maxX = cellCoord(bounds.max.x);
+        entry.minZ = cellCoord(bounds.min.z);
+        entry.maxZ = cellCoord(bounds.max.z);
+        const auto span = static_cast<long long>(entry.maxX - entry.minX + 1) * (entry.maxZ - entry.minZ + 1);
+        entry.oversized = !std::isfinite(bounds.min.x) || !std::isfinite(bounds.max.x) ||
+                          !std::isfinite(bounds.min.z) || !std::isfinite(bounds.max.z) ||
+                          span > MAX_CELLS_PER_ENTITY;
+
+        if (const auto it = entries.find(entity); it != entries.end())
+        {
+            auto& current = it->second;
+            const bool sameCells = current.oversized == entry.oversized &&
+                                   (entry.oversized || (current.minX == entry.minX && current.maxX == entry.maxX &&
+                                                        current.minZ == entry.minZ && current.maxZ == entry.maxZ));
+            if (sameCells)
+            {
+                current.bounds = bounds;
+                return;
+            }
+            unlink(entity, current);
+            entry.stamp = current.stamp;
+            current = entry;
+            link(entity, current);
+            return;
+        }
+
+        link(entity, entry);
+        entries.emplace(entity, entry);
+    }
+
+    void SpatialGrid::Remove(const entt::entity entity)
+    {
+        const auto it = entries.find(entity);
+        if (it == entries.end()) return;
+        unlink(entity, it->second);
+        entries.erase(it);
+    }
+
+    void SpatialGrid::Clear()
+    {
+        entries.clear();
+        cells.clear();
+        oversized.clear();
+        queryStamp = 0;
+    }
+
+    void SpatialGrid::Gather(
+        const BoundingBox& area, const std::function<void(entt::entity, const BoundingBox&)>& fn) const
+    {
+        ++stats.queries;
+        if (++queryStamp == 0)
+        {
+            // Stamp wrapped; reset so no entity looks already visited.
+            for (const auto& [entity, entry] : entries)
+            {
+                entry.stamp = 0;
+            }
+            queryStamp = 1;
+        }
+
+        auto visit = [&](const entt::entity entity) {
+            const auto& entry = entries.at(entity);
+            if (entry.stamp == queryStamp) return;
+            entry.stamp = queryStamp;
+            ++stats.candidatesTested;
+            fn(entity, entry.bounds);
+        };
+
+        for (const auto entity : oversized)
+        {
+            visit(entity);
+        }
+
+        const int minX = cellCoord(area.min.x);
+        const int maxX = cellCoord(area.max.x);
+        const int minZ = cellCoord(area.min.z);
+        const int maxZ = cellCoord(area.max.z);
+        for (int x = minX; x <= maxX; ++x)
+        {
+            for (int z = minZ; z <= maxZ; ++z)
+            {
+                ++stats.cellsVisited;
+                const auto it = cells.find(cellKey(x, z));
+                if (it == cells.end()) continue;
+                for (const auto entity : it->second)
+                {
+                    visit(entity);
+                }
+            }
+        }
+    }
+
+    bool SpatialGrid::Contains(const entt::entity entity) const
+    {
+        return entries.contains(entity);
+    }
+
+    std::size_t SpatialGrid::GetEntityCount() const
+    {
+        return entries.size();
+    }
+
+    float SpatialGrid::GetCellSize() const
+    {
+        return cellSize;
+    }
+
+    SpatialGrid::SpatialGrid(const float _cellSize) : cellSize(_cellSize)
+    {
+    }
+
+    // ====== SpatialQuery ============================================================
+
+    BoundingBox SpatialQuery::boundsOf(const entt::entity entity) const
+    {
+        const auto& collideable = registry->get<Collideable>(entity);
+        if (registry->any_of<StaticCollideable>(entity) || !registry->all_of<sgTransform>(entity))
+        {
+            return collideable.worldBoundingBox;
+        }
+        // Computed here rather than read back: position updates arrive before the owning
+        // system refreshes worldBoundingBox.
+        const auto& transform = registry->get<sgTransform>(entity);
+        return TransformBoundingBox(collideable.localBoundingBox, transform.GetMatrixNoRot());
+    }
+
+    float SpatialQuery::targetCellSize() const
+    {
+        const float spacing = navigationGridSystem->spacing;
+        return spacing > 0 ? spacing * SQUARES_PER_CELL : DEFAULT_CELL_SIZE;
+    }
+
+    void SpatialQuery::refreshCellSize()
+    {
+        if (targetCellSize() == grid.GetCellSize()) return;
+        Rebuild();
+    }
+
+    void SpatialQuery::onPositionUpdate(const entt::entity entity)
+    {
+        if (!registry->all_of<Collideable>(entity)) return;
+        refreshCellSize();
+        grid.Insert(entity, boundsOf(entity));
+    }
+
+    void SpatialQuery::onComponentAdded(const entt::entity entity)
+    {
+        refreshCellSize();
+        grid.Insert(entity, boundsOf(entity));
+    }
+
+    void SpatialQuery::onComponentUpdated(const entt::entity entity)
+    {
+        grid.Insert(entity, boundsOf(entity));
+    }
+
+    void SpatialQuery::onComponentRemoved(const entt::entity entity)
+    {
+        grid.Remove(entity);
+    }
+
+    std::vector<entt::entity> SpatialQuery::QueryRadius(
+        const Vector3 centre, const float radius, const Filter& filter) const
+    {
+        std::vector<entt::entity> out;
+        grid.Gather(areaAround(centre, radius), [&](const entt::entity entity, const BoundingBox& bounds) {
+            if (accepts(filter, entity) && CheckCollisionBoxSphere(bounds, centre, radius))
+            {
+                out.push_back(entity);
+            }
+        });
+        return out;
+    }
+
+    std::vector<entt::entity> SpatialQuery::QueryBox(const BoundingBox& box, const Filter& filter) const
+    {
+        std::vector<entt::entity> out;
+        grid.Gather(box, [&](const entt::entity entity, const BoundingBox& bounds) {
+            if (accepts(filter, entity) && CheckCollisionBoxes(bounds, box))
+            {
+                out.push_back(entity);
+            }
+        });
+        return out;
+    }
+
+    std::vector<entt::entity> SpatialQuery::QueryCone(
+        const Vector3 apex,
+        const Vector3 direction,
+        const float length,
+        const float halfAngleDeg,
+        const Filter& filter) const
+    {
+        std::vector<entt::entity> out;
+        const Vector2 forward = Vector2Normalize({direction.x, direction.z});
+        const float halfAngle = halfAngleDeg * DEG2RAD;
+
+        grid.Gather(areaAround(apex, length), [&](const entt::entity entity, const BoundingBox& bounds) {
+            if (!accepts(filter, entity)) return;
+            const Vector2 centre{(bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f};
+            const float extent = Vector2Length({bounds.max.x - centre.x, bounds.max.z - centre.y});
+            const Vector2 toCentre = Vector2Subtract(centre, {apex.x, apex.z});
+            const float distance = Vector2Length(toCentre);
+
+            if (distance <= extent)
+            {
+                out.push_back(entity);
+                return;
+            }
+            if (distance - extent > length) return;
+
+            // Widen the cone by the angle the entity's extent subtends from the apex.
+            const float cosAngle =
+                std::clamp(Vector2DotProduct(Vector2Scale(toCentre, 1.0f / distance), forward), -1.0f, 1.0f);
+            if (std::acos(cosAngle) <= halfAngle + std::asin(extent / distance))
+            {
+                out.push_back(entity);
+            }
+        });
+        return out;
+    }
+
+    void SpatialQuery::Rebuild()
+    {
+        const auto stats = grid.stats;
+        grid = SpatialGrid(targetCellSize());
+        grid.stats = stats;
+        for (const auto view = registry->view<Collideable>(); const auto entity : view)
+        {
+            grid.Insert(entity, boundsOf(entity));
+        }
+    }
+
+    const SpatialGrid::Stats& SpatialQuery::GetStats() const
+    {
+        return grid.stats;
+    }
+
+    void SpatialQuery::ResetStats() const
+    {
+        grid.stats = {};
+    }
+
+    SpatialQuery::SpatialQuery(
+        entt::registry* _registry, TransformSystem* _transformSystem, NavigationGridSystem* _navigationGridSystem)
+        : registry(_registry), navigationGridSystem(_navigationGridSystem), grid(DEFAULT_CELL_SIZE)
+    {
+        positionSub = _transformSystem->onPositionUpdate.Subscribe(
+            [this](const entt::entity entity) { onPositionUpdate(entity); });
+        registry->on_construct<Collideable>().connect<&SpatialQuery::onComponentAdded>(this);
+        registry->on_update<Collideable>().connect<&SpatialQuery::onComponentUpdated>(this);
+        registry->on_destroy<Collideable>().connect<&SpatialQuery::onComponentRemoved>(this);
+        // The map is loaded before the engine systems exist.
+        Rebuild();
+    }
+} // namespace sage
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Event.hpp"
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace sage
+{
+    class TransformSystem;
+    class NavigationGridSystem;
+
+    /*
+     * Uniform grid on the XZ plane holding entity bounds. An entity is listed in every cell its
+     * bounds overlap; Gather returns each entity overlapping an area once. Pure data: no registry
+     * access, so it can be exercised headless.
+     */
+    class SpatialGrid
+    {
+        struct Entry
+        {
+            BoundingBox bounds{};
+            int minX = 0, minZ = 0, maxX = 0, maxZ = 0;
+            bool oversized = false;
+            mutable std::uint32_t stamp = 0;
+        };
+
+        float cellSize;
+        std::unordered_map<entt::entity, Entry> entries;
+        std::unordered_map<std::uint64_t, std::vector<entt::entity>> cells;
+        // Entities spanning too many cells to bucket (e.g. terrain); tested by every query.
+        std::vector<entt::entity> oversized;
+        mutable std::uint32_t queryStamp = 0;
+
+        void link(entt::entity entity, const Entry& entry);
+        void unlink(entt::entity entity, const Entry& entry);
+
+        [[nodiscard]] static std::uint64_t cellKey(int x, int z);
+        [[nodiscard]] int cellCoord(float v) const;
+
+      public:
+        struct Stats
+        {
+            unsigned long queries = 0;
+            unsigned long cellsVisited = 0;
+            unsigned long candidatesTested = 0;
+        };
+
+        // Adds the entity, or moves it if already present. Cheap when it stays in the same cells.
+        void Insert(entt::entity entity, const BoundingBox& bounds);
+        void Remove(entt::entity entity);
+        void Clear();
+        // Calls fn(entity, bounds) once for every entity whose cells overlap area (in XZ).
+        void Gather(
+            const BoundingBox& area, const std::function<void(entt::entity, const BoundingBox&)>& fn) const;
+        [[nodiscard]] bool Contains(entt::entity entity) const;
+        [[nodiscard]] std::size_t GetEntityCount() const;
+        [[nodiscard]] float GetCellSize() const;
+
+        mutable Stats stats;
+
+        explicit SpatialGrid(float _cellSize);
+    };
+
+    /*
+     * Proximity queries over every entity with a Collideable, so gameplay code does not scan the
+     * whole registry to find what is near a point. Positions follow TransformSystem's position
+     * updates and Collideable patches; the grid's cell size is a multiple of the navigation grid's
+     * square size.
+     *
+     * The templated queries return only entities that have all of Components, e.g.
+     * QueryRadius<CombatableActor>(point, 5).
+     */
+    class SpatialQuery
+    {
+      public:
+        using Filter = std::function<bool(entt::entity)>;
+
+      private:
+        entt::registry* registry;
+        NavigationGridSystem* navigationGridSystem;
+        SpatialGrid grid;
+        Subscription positionSub;
+
+        [[nodiscard]] BoundingBox boundsOf(entt::entity entity) const;
+        [[nodiscard]] float targetCellSize() const;
+        void refreshCellSize();
+        void onPositionUpdate(entt::entity entity);
+        void onComponentAdded(entt::entity entity);
+        void onComponentUpdated(entt::entity entity);
+        void onComponentRemoved(entt::entity entity);
+
+        template <typename... Components>
+        [[nodiscard]] Filter hasAll() const
+        {
+            if constexpr (sizeof...(Components) == 0)
+            {
+                return {};
+            }
+            else
+            {
+                return [reg = registry](const entt::entity entity) { return reg->all_of<Components...>(entity); };
+            }
+        }
+
+      public:
+        // Entities whose bounds intersect the sphere.
+        [[nodiscard]] std::vector<entt::entity> QueryRadius(
+            Vector3 centre, float radius, const Filter& filter) const;
+        // Entities whose bounds intersect the box.
+        [[nodiscard]] std::vector<entt::entity> QueryBox(const BoundingBox& box, const Filter& filter) const;
+        // Entities whose bounds (as a circle in XZ) reach into the cone from apex along direction.
+        [[nodiscard]] std::vector<entt::entity> QueryCone(
+            Vector3 apex, Vector3 direction, float length, float halfAngleDeg, const Filter& filter) const;
+
+        template <typename... Components>
+        [[nodiscard]] std::vector<entt::entity> QueryRadius(const Vector3 centre, const float radius) const
+        {
+            return QueryRadius(centre, radius, hasAll<Components...>());
+        }
+
+        template <typename... Components>
+        [[nodiscard]] std::vector<entt::entity> QueryBox(const BoundingBox& box) const
+        {
+            return QueryBox(box, hasAll<Components...>());
+        }
+
+        template <typename... Components>
+        [[nodiscard]] std::vector<entt::entity> QueryCone(
+            const Vector3 apex, const Vector3 direction, const float length, const float halfAngleDeg) const
+        {
+            return QueryCone(apex, direction, length, halfAngleDeg, hasAll<Components...>());
+        }
+
+        // Re-indexes every Collideable. Done on construction; bounds changed in place must be announced
+        // with registry->patch<Collideable>, or followed by a Rebuild.
+        void Rebuild();
+
+        [[nodiscard]] const SpatialGrid::Stats& GetStats() const;
+        void ResetStats() const;
+
+        SpatialQuery(
+            entt::registry* _registry,
+            TransformSystem* _transformSystem,
+            NavigationGridSystem* _navigationGridSystem);
+    };
+} // namespace sage
@@ -0,0 +1,174 @@
+#include "StaticInstancer.hpp"
+
+#include "components/Collideable.hpp"
+#include "components/Renderable.hpp"
+#include "components/sgTransform.hpp"
+#include "components/StaticInstanceGroup.hpp"
+#include "ResourceManager.hpp"
+
+#include "raymath.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace sage
+{
+    namespace
+    {
+        // (model key, deferred, cell x, cell z)
+        using GroupKey = std::tuple<std::string, bool, int, int>;
+
+        constexpr Vector3 ROTATION_AXIS{0.0f, 1.0f, 0.0f};
+
+        bool IsInstanceable(const Model& model)
+        {
+            if (model.meshCount == 0) return false;
+            for (int i = 0; i < model.meshCount; ++i)
+            {
+                if (model.meshes[i].boneCount > 0 || model.meshes[i].vertexCount == 0) return false;
+            }
+            return true;
+        }
+
+        BoundingBox LocalBounds(const Model& model)
+        {
+            BoundingBox box = GetMeshBoundingBox(model.meshes[0]);
+            for (int i = 1; i < model.meshCount; ++i)
+            {
+                const BoundingBox meshBox = GetMeshBoundingBox(model.meshes[i]);
+                box.min = Vector3Min(box.min, meshBox.min);
+                box.max = Vector3Max(box.max, meshBox.max);
+            }
+            return box;
+        }
+
+        void ExtendBounds(BoundingBox& bounds, const BoundingBox& local, const Matrix& transform)
+        {
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                const Vector3 p = Vector3Transform(
+                    {corner & 1 ? local.max.x : local.min.x,
+                     corner & 2 ? local.max.y : local.min.y,
+                     corner & 4 ? local.max.z : local.min.z},
+                    transform);
+                bounds.min = Vector3Min(bounds.min, p);
+                bounds.max = Vector3Max(bounds.max, p);
+            }
+        }
+    } // namespace
+
+    StaticInstanceStats InstanceStaticProps(
+        entt::registry* registry,
+        const std::function<bool(entt::entity)>& canInstance,
+        unsigned int minInstances,
+        float cellSize)
+    {
+        std::cout << "START: Grouping static props for instancing" << std::endl;
+        StaticInstanceStats stats;
+
+        // Ordered so group creation (and draw order) is stable between runs.
+        std::map<GroupKey, std::vector<entt::entity>> candidates;
+        const auto view = registry->view<Renderable, sgTransform, StaticCollideable>(
+            entt::exclude<RenderableStreaming, StaticInstanced>);
+        for (auto entity : view)
+        {
+            auto& renderable = view.get<Renderable>(entity);
+            const auto* model = renderable.GetModel();
+            if (!model || renderable.GetMutable() || !IsInstanceable(model->GetRlModel()) || !canInstance(entity))
+            {
+                continue;
+            }
+
+            const Vector3 pos = view.get<sgTransform>(entity).GetWorldPos();
+            const int cellX = static_cast<int>(std::floor(pos.x / cellSize));
+            const int cellZ = static_cast<int>(std::floor(pos.z / cellSize));
+            candidates[{model->GetKey(), registry->all_of<RenderableDeferred>(entity), cellX, cellZ}].push_back(
+                entity);
+        }
+
+        auto& resourceManager = ResourceManager::GetInstance();
+        for (auto& [key, members] : candidates)
+        {
+            if (members.size() < minInstances) continue;
+            const auto& [modelKey, deferred, cellX, cellZ] = key;
+
+            const auto group = registry->create();
+            registry->emplace<sgTransform>(group);
+            auto& renderable =
+                registry->emplace<Renderable>(group, resourceManager.CreateModelMutable(modelKey), MatrixIdentity());
+            renderable.SetName("static_instances_" + std::to_string(stats.groups++));
+            renderable.serializable = false;
+            if (deferred) registry->emplace<RenderableDeferred>(group);
+
+            for (const auto member : members)
+            {
+                registry->emplace<StaticInstanced>(member, group);
+            }
+            stats.sourceEntities += static_cast<unsigned int>(members.size());
+            auto& instances = registry->emplace<StaticInstanceGroup>(group);
+            instances.members = std::move(members);
+            RefreshInstanceGroup(registry, group);
+        }
+
+        std::cout << "FINISH: Grouped " << stats.sourceEntities << " static props into " << stats.groups
+                  << " instance groups" << std::endl;
+        return stats;
+    }
+
+    void RefreshInstanceGroup(entt::registry* registry, entt::entity group)
+    {
+        auto& instances = registry->get<StaticInstanceGroup>(group);
+
+        // Drop members that were destroyed or taken out of the group.
+        const auto removed = std::erase_if(instances.members, [registry, group](entt::entity member) {
+            if (!registry->valid(member) || !registry->all_of<Renderable, sgTransform>(member)) return true;
+            const auto* instanced = registry->try_get<StaticInstanced>(member);
+            return !instanced || instanced->group != group;
+        });
+        if (removed > 0 || instances.transforms.size() != instances.members.size())
+        {
+            instances.dirty = true;
+            instances.transforms.resize(instances.members.size());
+        }
+
+        bool moved = false;
+        instances.visible.clear();
+        for (std::size_t i = 0; i < instances.members.size(); ++i)
+        {
+            const auto member = instances.members[i];
+            auto& instanced = registry->get<StaticInstanced>(member);
+            const auto& renderable = registry->get<Renderable>(member);
+            const auto& transform = registry->get<sgTransform>(member);
+            const Vector3 pos = transform.GetWorldPos();
+            const float rot = transform.GetWorldRot().y;
+            const Vector3 scale = transform.GetScale();
+            if (instances.dirty || !Vector3Equals(pos, instanced.position) || rot != instanced.rotation ||
+                !Vector3Equals(scale, instanced.scale))
+            {
+                instanced.position = pos;
+                instanced.rotation = rot;
+                instanced.scale = scale;
+                // The member's own view, as its local transform may differ from the asset's.
+                instances.transforms[i] = renderable.GetModel()->GetWorldTransform(pos, ROTATION_AXIS, rot, scale);
+                moved = true;
+            }
+            if (renderable.active) instances.visible.push_back(instances.transforms[i]);
+        }
+
+        if (moved || instances.dirty)
+        {
+            const BoundingBox local = LocalBounds(registry->get<Renderable>(group).GetModel()->GetRlModel());
+            instances.bounds = {
+                Vector3{INFINITY, INFINITY, INFINITY}, Vector3{-INFINITY, -INFINITY, -INFINITY}};
+            for (const auto& transform : instances.transforms)
+            {
+                ExtendBounds(instances.bounds, local, transform);
+            }
+        }
+        instances.dirty = false;
+    }
+} // namespace sage
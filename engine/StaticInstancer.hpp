@@ -0,0 +1,32 @@
+#pragma once
+
+#include "entt/entt.hpp"
+
+#include <functional>
+
+namespace sage
+{
+    struct StaticInstanceStats
+    {
+        unsigned int sourceEntities = 0;
+        unsigned int groups = 0;
+    };
+
+    /* Groups repeated static props for hardware instancing: StaticCollideable renderables with a
+    shared (non-mutable), unskinned model for which canInstance returns true are grouped by
+    (model key, deferred, cell x, cell z) on an XZ grid of cellSize. Groups with at least
+    minInstances members become a new entity with a StaticInstanceGroup and every member is tagged
+    StaticInstanced; smaller groups are left alone (e.g. for BatchStaticMeshes). Call once, after
+    the map is loaded and before batching. */
+    StaticInstanceStats InstanceStaticProps(
+        entt::registry* registry,
+        const std::function<bool(entt::entity)>& canInstance,
+        unsigned int minInstances = 8,
+        float cellSize = 32.0f);
+
+    /* Brings the group's cached transforms up to date and fills its visible list. Only members
+    whose transform changed since they were last drawn are recomposed; members that were
+    destroyed or lost StaticInstanced are dropped. Bounds are recomputed only when something
+    changed. */
+    void RefreshInstanceGroup(entt::registry* registry, entt::entity group);
+} // namespace sage
@@ -0,0 +1,264 @@
+#include "StaticMeshBatcher.hpp"
+
+#include "components/Collideable.hpp"
+#include "components/Renderable.hpp"
+#include "components/sgTransform.hpp"
+#include "components/StaticInstanceGroup.hpp"
+#include "components/StaticMeshBatch.hpp"
+#include "RenderQueue.hpp"
+#include "ResourceManager.hpp"
+
+#include "raymath.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <ranges>
+#include <string>
+#include <tuple>
+
+namespace sage
+{
+    namespace
+    {
+        struct BatchChunk
+        {
+            std::vector<std::pair<const Mesh*, Matrix>> meshes;
+            std::vector<entt::entity> sources;
+            int vertexCount = 0;
+            BoundingBox bounds{Vector3{INFINITY, INFINITY, INFINITY}, Vector3{-INFINITY, -INFINITY, -INFINITY}};
+        };
+
+        struct BatchGroup
+        {
+            Material material{};
+            std::vector<BatchChunk> chunks;
+        };
+
+        // (MaterialIdentity, shader id, cell x, cell z). Keyed on content rather than the maps
+        // pointer, so any copies of one material end up in the same batch.
+        using GroupKey = std::tuple<std::uint32_t, unsigned int, int, int>;
+
+        bool IsBatchable(const Mesh& mesh)
+        {
+            return mesh.vertices != nullptr && mesh.vertexCount > 0 && mesh.boneCount == 0 &&
+                   mesh.vertexCount <= STATIC_BATCH_MAX_VERTICES;
+        }
+
+        BoundingBox TransformedBounds(const Mesh& mesh, const Matrix& transform)
+        {
+            BoundingBox box{Vector3{INFINITY, INFINITY, INFINITY}, Vector3{-INFINITY, -INFINITY, -INFINITY}};
+            for (int v = 0; v < mesh.vertexCount; ++v)
+            {
+                const Vector3 p = Vector3Transform(
+                    {mesh.vertices[v * 3], mesh.vertices[v * 3 + 1], mesh.vertices[v * 3 + 2]}, transform);
+                box.min = Vector3Min(box.min, p);
+                box.max = Vector3Max(box.max, p);
+            }
+            return box;
+        }
+    } // namespace
+
+    Mesh MergeMeshes(const std::vector<std::pair<const Mesh*, Matrix>>& meshes)
+    {
+        Mesh merged{};
+        bool anyColors = false;
+        bool anyTangents = false;
+        bool anyTexcoords2 = false;
+        for (const auto& [mesh, transform] : meshes)
+        {
+            merged.vertexCount += mesh->vertexCount;
+            merged.triangleCount += mesh->indices ? mesh->triangleCount : mesh->vertexCount / 3;
+            anyColors |= mesh->colors != nullptr;
+            anyTangents |= mesh->tangents != nullptr;
+            anyTexcoords2 |= mesh->texcoords2 != nullptr;
+        }
+        assert(merged.vertexCount <= STATIC_BATCH_MAX_VERTICES);
+
+        merged.vertices = static_cast<float*>(RL_CALLOC(merged.vertexCount * 3, sizeof(float)));
+        merged.normals = static_cast<float*>(RL_CALLOC(merged.vertexCount * 3, sizeof(float)));
+        merged.texcoords = static_cast<float*>(RL_CALLOC(merged.vertexCount * 2, sizeof(float)));
+        merged.indices = static_cast<unsigned short*>(RL_CALLOC(merged.triangleCount * 3, sizeof(unsigned short)));
+        if (anyColors)
+        {
+            merged.colors = static_cast<unsigned char*>(RL_MALLOC(merged.vertexCount * 4));
+            std::memset(merged.colors, 255, merged.vertexCount * 4);
+        }
+        if (anyTangents)
+        {
+            merged.tangents = static_cast<float*>(RL_MALLOC(merged.vertexCount * 4 * sizeof(float)));
+            for (int v = 0; v < merged.vertexCount; ++v)
+            {
+                merged.tangents[v * 4] = 1.0f;
+                merged.tangents[v * 4 + 1] = 0.0f;
+                merged.tangents[v * 4 + 2] = 0.0f;
+                merged.tangents[v * 4 + 3] = 1.0f;
+            }
+        }
+        if (anyTexcoords2)
+        {
+            merged.texcoords2 = static_cast<float*>(RL_CALLOC(merged.vertexCount * 2, sizeof(float)));
+        }
+
+        int vertexBase = 0;
+        int indexBase = 0;
+        for (const auto& [mesh, transform] : meshes)
+        {
+            const Matrix normalMatrix = MatrixTranspose(MatrixInvert(transform));
+            const bool mirrored = MatrixDeterminant(transform) < 0; // Flips the tangent frame's handedness
+            for (int v = 0; v < mesh->vertexCount; ++v)
+            {
+                const int dst = vertexBase + v;
+                const Vector3 p = Vector3Transform(
+                    {mesh->vertices[v * 3], mesh->vertices[v * 3 + 1], mesh->vertices[v * 3 + 2]}, transform);
+                merged.vertices[dst * 3] = p.x;
+                merged.vertices[dst * 3 + 1] = p.y;
+                merged.vertices[dst * 3 + 2] = p.z;
+
+                if (mesh->normals)
+                {
+                    Vector3 n = {mesh->normals[v * 3], mesh->normals[v * 3 + 1], mesh->normals[v * 3 + 2]};
+                    n = Vector3Normalize(
+                        {normalMatrix.m0 * n.x + normalMatrix.m4 * n.y + normalMatrix.m8 * n.z,
+                         normalMatrix.m1 * n.x + normalMatrix.m5 * n.y + normalMatrix.m9 * n.z,
+                         normalMatrix.m2 * n.x + normalMatrix.m6 * n.y + normalMatrix.m10 * n.z});
+                    merged.normals[dst * 3] = n.x;
+                    merged.normals[dst * 3 + 1] = n.y;
+                    merged.normals[dst * 3 + 2] = n.z;
+                }
+                if (mesh->tangents)
+                {
+                    // Tangents lie in the surface, so they take the model matrix (as positions do)
+                    // rather than the normal matrix; w is the bitangent sign and is kept.
+                    const float* t = mesh->tangents + v * 4;
+                    const Vector3 tangent = Vector3Normalize(
+                        {transform.m0 * t[0] + transform.m4 * t[1] + transform.m8 * t[2],
+                         transform.m1 * t[0] + transform.m5 * t[1] + transform.m9 * t[2],
+                         transform.m2 * t[0] + transform.m6 * t[1] + transform.m10 * t[2]});
+                    merged.tangents[dst * 4] = tangent.x;
+                    merged.tangents[dst * 4 + 1] = tangent.y;
+                    merged.tangents[dst * 4 + 2] = tangent.z;
+                    merged.tangents[dst * 4 + 3] = mirrored ? -t[3] : t[3];
+                }
+                if (mesh->texcoords)
+                {
+                    merged.texcoords[dst * 2] = mesh->texcoords[v * 2];
+                    merged.texcoords[dst * 2 + 1] = mesh->texcoords[v * 2 + 1];
+                }
+                if (mesh->texcoords2)
+                {
+                    merged.texcoords2[dst * 2] = mesh->texcoords2[v * 2];
+                    merged.texcoords2[dst * 2 + 1] = mesh->texcoords2[v * 2 + 1];
+                }
+                if (mesh->colors)
+                {
+                    std::memcpy(merged.colors + dst * 4, mesh->colors + v * 4, 4);
+                }
+            }
+
+            const int indexCount = mesh->indices ? mesh->triangleCount * 3 : mesh->vertexCount;
+            for (int i = 0; i < indexCount; ++i)
+            {
+                const int index = mesh->indices ? mesh->indices[i] : i;
+                merged.indices[indexBase + i] = static_cast<unsigned short>(vertexBase + index);
+            }
+            vertexBase += mesh->vertexCount;
+            indexBase += indexCount;
+        }
+        return merged;
+    }
+
+    StaticBatchStats BatchStaticMeshes(
+        entt::registry* registry, const std::function<bool(entt::entity)>& canBatch, float cellSize)
+    {
+        std::cout << "START: Batching static meshes" << std::endl;
+        StaticBatchStats stats;
+
+        // Ordered so batch keys (and draw order) are stable between runs.
+        std::map<GroupKey, BatchGroup> groups;
+        const auto view = registry->view<Renderable, sgTransform, StaticCollideable>(
+            entt::exclude<RenderableStreaming, StaticMeshBatched, StaticInstanced>);
+        for (auto entity : view)
+        {
+            auto& renderable = view.get<Renderable>(entity);
+            const auto* model = renderable.GetModel();
+            if (!renderable.active || !model || renderable.GetMutable() || !canBatch(entity)) continue;
+
+            const auto& rlmodel = model->GetRlModel();
+            bool batchable = rlmodel.meshCount > 0;
+            for (int i = 0; i < rlmodel.meshCount && batchable; ++i)
+            {
+                batchable = IsBatchable(rlmodel.meshes[i]);
+            }
+            if (!batchable) continue;
+
+            const auto& transform = view.get<sgTransform>(entity);
+            const Vector3 pos = transform.GetWorldPos();
+            const Matrix world = model->GetWorldTransform(pos, {0, 1, 0}, transform.GetWorldRot().y, transform.GetScale());
+            const int cellX = static_cast<int>(std::floor(pos.x / cellSize));
+            const int cellZ = static_cast<int>(std::floor(pos.z / cellSize));
+
+            for (int i = 0; i < rlmodel.meshCount; ++i)
+            {
+                const Mesh& mesh = rlmodel.meshes[i];
+                const Material& material = rlmodel.materials[rlmodel.meshMaterial[i]];
+                auto& group = groups[{MaterialIdentity(material), material.shader.id, cellX, cellZ}];
+                if (group.chunks.empty() ||
+                    group.chunks.back().vertexCount + mesh.vertexCount > STATIC_BATCH_MAX_VERTICES)
+                {
+                    group.material = material;
+                    group.chunks.emplace_back();
+                }
+                auto& chunk = group.chunks.back();
+                chunk.meshes.emplace_back(&mesh, world);
+                chunk.vertexCount += mesh.vertexCount;
+                if (chunk.sources.empty() || chunk.sources.back() != entity) chunk.sources.push_back(entity);
+                const BoundingBox meshBounds = TransformedBounds(mesh, world);
+                chunk.bounds.min = Vector3Min(chunk.bounds.min, meshBounds.min);
+                chunk.bounds.max = Vector3Max(chunk.bounds.max, meshBounds.max);
+                ++stats.sourceMeshes;
+            }
+            registry->emplace<StaticMeshBatched>(entity);
+            ++stats.sourceEntities;
+        }
+
+        auto& resourceManager = ResourceManager::GetInstance();
+        for (auto& group : groups | std::views::values)
+        {
+            for (auto& chunk : group.chunks)
+            {
+                Model model{};
+                model.transform = MatrixIdentity();
+                model.meshCount = 1;
+                model.meshes = static_cast<Mesh*>(RL_CALLOC(1, sizeof(Mesh)));
+                model.meshes[0] = MergeMeshes(chunk.meshes);
+                UploadMesh(&model.meshes[0], false);
+                model.materialCount = 1;
+                model.materials = static_cast<Material*>(RL_MALLOC(sizeof(Material)));
+                model.materials[0] = group.material; // Maps stay owned by the material pool
+                model.meshMaterial = static_cast<int*>(RL_CALLOC(1, sizeof(int)));
+
+                const std::string key = "static_batch_" + std::to_string(stats.batches++);
+                const auto batch = registry->create();
+                registry->emplace<sgTransform>(batch);
+                auto& renderable = registry->emplace<Renderable>(
+                    batch, resourceManager.StoreGeneratedModel(key, model), MatrixIdentity());
+                renderable.SetName(key);
+                renderable.serializable = false;
+                registry->emplace<StaticMeshBatch>(batch, chunk.bounds);
+
+                for (const auto source : chunk.sources)
+                {
+                    registry->get<StaticMeshBatched>(source).batch = batch;
+                }
+            }
+        }
+
+        std::cout << "FINISH: Batched " << stats.sourceMeshes << " meshes from " << stats.sourceEntities
+                  << " static entities into " << stats.batches << " batches" << std::endl;
+        return stats;
+    }
+} // namespace sage
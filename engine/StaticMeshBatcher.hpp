@@ -0,0 +1,35 @@
+#pragma once
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace sage
+{
+    struct StaticBatchStats
+    {
+        unsigned int sourceEntities = 0;
+        unsigned int sourceMeshes = 0;
+        unsigned int batches = 0;
+    };
+
+    // Most vertices a merged mesh can hold, as raylib meshes use 16-bit indices.
+    inline constexpr int STATIC_BATCH_MAX_VERTICES = 65535;
+
+    /* Merges meshes into one CPU-side mesh in world space (no GPU upload). Positions, normals and
+    tangents are transformed; both texcoord sets and colours are carried over. An attribute is
+    present if any source has it; sources lacking it get zero UVs, white, or a +X tangent. The
+    total vertex count must not exceed STATIC_BATCH_MAX_VERTICES. */
+    [[nodiscard]] Mesh MergeMeshes(const std::vector<std::pair<const Mesh*, Matrix>>& meshes);
+
+    /* Bakes static map geometry into combined meshes, one per (material, cell) on an XZ grid of
+    cellSize, so each batch stays local enough for per-object light culling. Candidates are
+    StaticCollideable renderables with a shared (non-mutable) model and no skinned meshes, for
+    which canBatch returns true. Each source is tagged StaticMeshBatched and each batch becomes
+    a new entity with a StaticMeshBatch. Call once, after the map is loaded. */
+    StaticBatchStats BatchStaticMeshes(
+        entt::registry* registry, const std::function<bool(entt::entity)>& canBatch, float cellSize = 32.0f);
+} // namespace sage
@@ -0,0 +1,281 @@
+#include "TimerWheel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace sage
+{
+    const TimerWheel::Node* TimerWheel::find(const TimerHandle handle) const
+    {
+        if (handle.index >= nodes.size()) return nullptr;
+        const auto& node = nodes[handle.index];
+        if (!node.live || node.generation != handle.generation) return nullptr;
+        return &node;
+    }
+
+    std::uint32_t TimerWheel::allocate()
+    {
+        if (freeList == TimerHandle::NONE)
+        {
+            nodes.emplace_back();
+            return static_cast<std::uint32_t>(nodes.size() - 1);
+        }
+        const auto index = freeList;
+        freeList = nodes[index].next;
+        return index;
+    }
+
+    void TimerWheel::release(const std::uint32_t index)
+    {
+        auto& node = nodes[index];
+        node.callback = nullptr;
+        node.live = false;
+        ++node.generation;
+        node.level = UNLINKED;
+        node.prev = TimerHandle::NONE;
+        node.next = freeList;
+        freeList = index;
+        --pending;
+    }
+
+    void TimerWheel::link(const std::uint32_t index, const std::uint64_t base)
+    {
+        auto& node = nodes[index];
+        assert(node.expiry >= base);
+        const std::uint64_t delta = std::min(node.expiry - base, MAX_DELTA);
+        const unsigned int level = delta == 0 ? 0 : (std::bit_width(delta) - 1) / SLOT_BITS;
+        // Out-of-range deadlines are filed at the far edge of the top level and re-filed from there.
+        const std::uint64_t placed = base + delta;
+        const auto slot = static_cast<std::uint8_t>((placed >> (level * SLOT_BITS)) & (SLOTS - 1));
+
+        auto& lvl = levels[level];
+        node.level = static_cast<std::uint8_t>(level);
+        node.slot = slot;
+        node.prev = TimerHandle::NONE;
+        node.next = lvl.heads[slot];
+        if (node.next != TimerHandle::NONE) nodes[node.next].prev = index;
+        lvl.heads[slot] = index;
+        lvl.occupied |= std::uint64_t{1} << slot;
+    }
+
+    void TimerWheel::unlink(const std::uint32_t index)
+    {
+        auto& node = nodes[index];
+        if (node.level == UNLINKED) return;
+        auto& lvl = levels[node.level];
+        if (node.prev != TimerHandle::NONE)
+        {
+            nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            lvl.heads[node.slot] = node.next;
+            if (node.next == TimerHandle::NONE) lvl.occupied &= ~(std::uint64_t{1} << node.slot);
+        }
+        if (node.next != TimerHandle::NONE) nodes[node.next].prev = node.prev;
+        node.level = UNLINKED;
+        node.prev = TimerHandle::NONE;
+        node.next = TimerHandle::NONE;
+    }
+
+    void TimerWheel::cascade(const unsigned int level, const std::uint64_t tick)
+    {
+        auto& lvl = levels[level];
+        const auto slot = static_cast<std::uint8_t>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+        auto index = lvl.heads[slot];
+        lvl.heads[slot] = TimerHandle::NONE;
+        lvl.occupied &= ~(std::uint64_t{1} << slot);
+        while (index != TimerHandle::NONE)
+        {
+            const auto next = nodes[index].next;
+            link(index, tick);
+            ++stats.cascaded;
+            index = next;
+        }
+    }
+
+    std::uint64_t TimerWheel::nextTickWithWork() const
+    {
+        auto best = std::numeric_limits<std::uint64_t>::max();
+        for (unsigned int level = 0; level < LEVELS; ++level)
+        {
+            const auto& lvl = levels[level];
+            if (lvl.occupied == 0) continue;
+            const unsigned int shift = level * SLOT_BITS;
+            // Level 0 slots are due on their own tick; higher slots when the clock reaches the
+            // boundary that starts them.
+            const std::uint64_t first = level == 0 ? now + 1 : ((now >> shift) + 1) << shift;
+            const auto rotated = std::rotr(lvl.occupied, static_cast<int>((first >> shift) & (SLOTS - 1)));
+            const std::uint64_t tick = first + (static_cast<std::uint64_t>(std::countr_zero(rotated)) << shift);
+            best = std::min(best, tick);
+        }
+        return best;
+    }
+
+    void TimerWheel::processTick(const std::uint64_t tick)
+    {
+        now = tick;
+        if ((tick & (SLOTS - 1)) == 0)
+        {
+            unsigned int top = 1;
+            while (top + 1 < LEVELS && (tick & ((std::uint64_t{1} << ((top + 1) * SLOT_BITS)) - 1)) == 0)
+            {
+                ++top;
+            }
+            for (unsigned int level = top; level >= 1; --level)
+            {
+                cascade(level, tick);
+            }
+        }
+
+        auto& lvl = levels[0];
+        const auto slot = static_cast<std::uint8_t>(tick & (SLOTS - 1));
+        due.clear();
+        for (auto index = lvl.heads[slot]; index != TimerHandle::NONE;)
+        {
+            auto& node = nodes[index];
+            assert(node.expiry == tick);
+            due.push_back({node.sequence, index, node.generation});
+            const auto next = node.next;
+            node.level = UNLINKED;
+            node.prev = TimerHandle::NONE;
+            node.next = TimerHandle::NONE;
+            index = next;
+        }
+        lvl.heads[slot] = TimerHandle::NONE;
+        lvl.occupied &= ~(std::uint64_t{1} << slot);
+        if (due.size() > 1)
+        {
+            std::sort(due.begin(), due.end(), [](const Due& a, const Due& b) { return a.sequence < b.sequence; });
+        }
+
+        firing = true;
+        for (const auto& [sequence, index, generation] : due)
+        {
+            // Skips timers cancelled by an earlier callback on this tick.
+            if (!find({index, generation})) continue;
+            auto callback = std::move(nodes[index].callback);
+            release(index);
+            ++stats.fired;
+            callback();
+        }
+        firing = false;
+    }
+
+    TimerHandle TimerWheel::Schedule(const float delay, std::function<void()> callback)
+    {
+        assert(callback);
+        const auto ticks = std::max<long long>(1, std::llround(static_cast<double>(delay) * TICKS_PER_SECOND));
+        const auto index = allocate();
+        auto& node = nodes[index];
+        node.callback = std::move(callback);
+        node.expiry = now + static_cast<std::uint64_t>(ticks);
+        node.sequence = nextSequence++;
+        node.live = true;
+        link(index, now + 1);
+        ++pending;
+        ++stats.scheduled;
+        return {index, node.generation};
+    }
+
+    bool TimerWheel::Cancel(const TimerHandle handle)
+    {
+        if (!find(handle)) return false;
+        unlink(handle.index);
+        release(handle.index);
+        ++stats.cancelled;
+        return true;
+    }
+
+    bool TimerWheel::IsPending(const TimerHandle handle) const
+    {
+        return find(handle) != nullptr;
+    }
+
+    float TimerWheel::GetRemaining(const TimerHandle handle) const
+    {
+        const auto* node = find(handle);
+        if (!node) return 0;
+        const double remaining = static_cast<double>(node->expiry) / TICKS_PER_SECOND - GetTime();
+        return static_cast<float>(std::max(remaining, 0.0));
+    }
+
+    void TimerWheel::Update(const float dt)
+    {
+        assert(!firing);
+        if (paused || dt <= 0 || timeScale <= 0) return;
+        time += static_cast<double>(dt) * timeScale;
+        const auto target = static_cast<std::uint64_t>(std::floor(time * TICKS_PER_SECOND));
+        for (auto tick = nextTickWithWork(); tick <= target; tick = nextTickWithWork())
+        {
+            processTick(tick);
+        }
+        now = std::max(now, target);
+    }
+
+    void TimerWheel::SetPaused(const bool _paused)
+    {
+        paused = _paused;
+    }
+
+    bool TimerWheel::IsPaused() const
+    {
+        return paused;
+    }
+
+    void TimerWheel::SetTimeScale(const float _timeScale)
+    {
+        timeScale = std::max(_timeScale, 0.0f);
+    }
+
+    float TimerWheel::GetTimeScale() const
+    {
+        return timeScale;
+    }
+
+    double TimerWheel::GetTime() const
+    {
+        return firing ? static_cast<double>(now) / TICKS_PER_SECOND : time;
+    }
+
+    std::size_t TimerWheel::GetPendingCount() const
+    {
+        return pending;
+    }
+
+    void TimerWheel::Clear()
+    {
+        for (std::uint32_t index = 0; index < nodes.size(); ++index)
+        {
+            if (!nodes[index].live) continue;
+            nodes[index].level = UNLINKED;
+            release(index);
+        }
+        for (auto& lvl : levels)
+        {
+            lvl.heads.fill(TimerHandle::NONE);
+            lvl.occupied = 0;
+        }
+    }
+
+    const TimerWheel::Stats& TimerWheel::GetStats() const
+    {
+        return stats;
+    }
+
+    void TimerWheel::ResetStats()
+    {
+        stats = {};
+    }
+
+    TimerWheel::TimerWheel()
+    {
+        for (auto& lvl : levels)
+        {
+            lvl.heads.fill(TimerHandle::NONE);
+        }
+    }
+} // namespace sage
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace sage
+{
+    // Refers to one scheduled timer. Stays safe to use after the timer fires or is cancelled; the
+    // generation tells a recycled slot apart from the timer the handle was issued for.
+    struct TimerHandle
+    {
+        static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = NONE;
+        std::uint32_t generation = 0;
+
+        [[nodiscard]] bool IsSet() const
+        {
+            return index != NONE;
+        }
+    };
+
+    /*
+     * Hierarchical timer wheel (Varghese & Lauck) on a game clock of millisecond ticks. Four levels
+     * of 64 slots cover about four and a half hours; later deadlines wait in the top level and are
+     * re-sorted as they come into range. Scheduling and cancelling are O(1) and nothing is polled:
+     * a level-0 slot is only visited when it holds timers, and a higher slot only when the clock
+     * crosses its boundary, so a long pause or a large dt costs the same as a short one.
+     *
+     * Timers that fall due in the same Update fire in deadline order, then in the order they were
+     * scheduled. During a callback GetTime reports the timer's own deadline, so a timer that
+     * reschedules itself does not drift. A callback may schedule or cancel any timer, including
+     * one due on the same tick.
+     */
+    class TimerWheel
+    {
+      public:
+        static constexpr std::uint64_t TICKS_PER_SECOND = 1000;
+
+        struct Stats
+        {
+            unsigned long scheduled = 0;
+            unsigned long fired = 0;
+            unsigned long cancelled = 0;
+            unsigned long cascaded = 0; // Timers moved down a level as their deadline came into range
+        };
+
+      private:
+        static constexpr unsigned int LEVELS = 4;
+        static constexpr unsigned int SLOT_BITS = 6;
+        static constexpr unsigned int SLOTS = 1u << SLOT_BITS;
+        static constexpr std::uint64_t MAX_DELTA = (std::uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+        static constexpr std::uint8_t UNLINKED = 0xff;
+
+        struct Node
+        {
+            std::function<void()> callback;
+            std::uint64_t expiry = 0;
+            std::uint64_t sequence = 0;
+            std::uint32_t generation = 1;
+            std::uint32_t prev = TimerHandle::NONE;
+            std::uint32_t next = TimerHandle::NONE; // Doubles as the free list link
+            std::uint8_t level = UNLINKED;
+            std::uint8_t slot = 0;
+            bool live = false;
+        };
+
+        struct Level
+        {
+            std::array<std::uint32_t, SLOTS> heads{};
+            std::uint64_t occupied = 0; // Bit per non-empty slot
+        };
+
+        struct Due
+        {
+            std::uint64_t sequence;
+            std::uint32_t index;
+            std::uint32_t generation;
+        };
+
+        std::vector<Node> nodes;
+        std::uint32_t freeList = TimerHandle::NONE;
+        std::array<Level, LEVELS> levels{};
+        std::vector<Due> due;
+
+        std::uint64_t now = 0; // Every timer due at or before this tick has fired
+        std::uint64_t nextSequence = 0;
+        double time = 0;
+        float timeScale = 1.0f;
+        bool paused = false;
+        bool firing = false;
+        std::size_t pending = 0;
+        Stats stats;
+
+        [[nodiscard]] const Node* find(TimerHandle handle) const;
+        std::uint32_t allocate();
+        void release(std::uint32_t index);
+        // Files the node under the slot it should next be looked at in; base is the first tick
+        // that has not been processed yet.
+        void link(std::uint32_t index, std::uint64_t base);
+        void unlink(std::uint32_t index);
+        void cascade(unsigned int level, std::uint64_t tick);
+        [[nodiscard]] std::uint64_t nextTickWithWork() const;
+        void processTick(std::uint64_t tick);
+
+      public:
+        // Calls callback once delay seconds of game time from now have passed. The delay is
+        // rounded to the nearest tick, and to at least one.
+        TimerHandle Schedule(float delay, std::function<void()> callback);
+        // Returns false if the timer had already fired or been cancelled.
+        bool Cancel(TimerHandle handle);
+        [[nodiscard]] bool IsPending(TimerHandle handle) const;
+        // Seconds until the timer fires, or 0 if it is not pending.
+        [[nodiscard]] float GetRemaining(TimerHandle handle) const;
+
+        // Advances the clock by dt scaled by the time scale, firing every timer it passes.
+        void Update(float dt);
+        void SetPaused(bool _paused);
+        [[nodiscard]] bool IsPaused() const;
+        void SetTimeScale(float _timeScale);
+        [[nodiscard]] float GetTimeScale() const;
+        // Seconds of game time since the wheel was created.
+        [[nodiscard]] double GetTime() const;
+
+        [[nodiscard]] std::size_t GetPendingCount() const;
+        // Drops every pending timer without calling it.
+        void Clear();
+        [[nodiscard]] const Stats& GetStats() const;
+        void ResetStats();
+
+        TimerWheel();
+    };
+} // namespace sage
@@ -38,7 +38,7 @@ namespace sage
         };
 
         std::unordered_map<AnimationId, int> animationMap;
-        ModelAnimation* animations;
+        const AnimationClip* animations;
         int animsCount;
 
         bool oneShotMode = false;
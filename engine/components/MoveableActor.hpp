@@ -18,23 +18,24 @@
 namespace sage
 {
 
-    struct MoveableActorCollision
-    {
-        entt::entity hitEntityId = entt::null;
-        Vector3 hitLastPos{};
-    };
-
     struct MoveableActor
     {
         float movementSpeed = 0.35f;
         // The max range the actor can pathfind at one time.
         int pathfindingBounds = 50;
-        // std::optional<MoveableActorCollision> moveableActorCollision;
-        entt::entity hitEntityId = entt::null;
-        Vector3 hitLastPos{};
         // Keeps collision rerouting from fighting deliberate movement toward another moveable entity.
         std::optional<entt::entity> movementCollisionTarget;
         std::deque<Vector3> path{};
+        // Local avoidance. Velocity is what was applied last frame (units per frame).
+        Vector3 velocity{};
+        // Footprint radius used for avoidance; 0 derives it from the Collideable's bounds.
+        float avoidanceRadius = 0;
+        // Seconds spent held back by other actors; a new path is requested once it reaches stuckRepathTime.
+        float stuckTime = 0;
+        float stuckRepathTime = 1.5f;
+        // Set by NavigationGridSystem::StampActor and cleared by UnstampActor. Idle actors are only
+        // re-stamped while it is set, so one taken off the grid (e.g. dying) stays off.
+        bool stamped = true;
 
         Event<entt::entity> onStartMovement{};
         Event<entt::entity> onDestinationReached{};
@@ -52,7 +53,5 @@ namespace sage
             assert(IsMoving()); // Check this independently before calling this function.
             return path.back();
         }
-
-        std::vector<GridSquare> debugRay;
     };
 } // namespace sage
@@ -95,7 +95,7 @@ namespace sage
         Vector3 worldPosMax; // Bottom Right
         Vector3 worldPosCentre;
         Vector3 debugBox;
-        entt::entity occupant = entt::null;
+        entt::entity occupant = entt::null; // Scenery only; actors are counted in ActorOccupancy
         bool occupied = false;
 
         NavigationGridSquare(
@@ -24,6 +24,13 @@ namespace sage
     {
     };
 
+    // Present while the renderable's model is streaming in (see RenderSystem::StreamModel).
+    // The renderable is not drawn until the tag is removed.
+    struct RenderableStreaming
+    {
+        AssetHandle handle;
+    };
+
     class Renderable
     {
         std::variant<std::monostate, ModelView, ModelMutable> model;
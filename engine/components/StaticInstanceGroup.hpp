@@ -0,0 +1,34 @@
+#pragma once
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+#include <vector>
+
+namespace sage
+{
+    /*
+     * Entity that draws every member (static props sharing one model) with a single instanced
+     * draw per mesh (InstanceStaticProps). Its Renderable holds a private copy of the model so
+     * it can use the instanced uber shader without affecting other users of the asset.
+     */
+    struct StaticInstanceGroup
+    {
+        std::vector<entt::entity> members;
+        std::vector<Matrix> transforms; // World transform per member, same order
+        std::vector<Matrix> visible;    // Transforms of the active members, submitted each frame
+        BoundingBox bounds{};           // World space, over every member
+        bool dirty = true;              // Members were added/removed; rebuild transforms and bounds
+    };
+
+    // A static prop drawn by a StaticInstanceGroup. Its Renderable is kept (picking, names,
+    // saving, the active flag) but not drawn on its own. The transform it was last drawn with is
+    // kept so the group only recomputes members that moved.
+    struct StaticInstanced
+    {
+        entt::entity group = entt::null;
+        Vector3 position{};
+        float rotation = 0;
+        Vector3 scale{};
+    };
+} // namespace sage
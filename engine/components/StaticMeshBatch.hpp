@@ -0,0 +1,20 @@
+#pragma once
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+namespace sage
+{
+    // Entity whose Renderable is a combined mesh baked from static map geometry (BatchStaticMeshes).
+    struct StaticMeshBatch
+    {
+        BoundingBox bounds{}; // World space; the batch itself sits at the origin
+    };
+
+    // A static entity whose geometry was merged into a batch. Its Renderable is kept (picking,
+    // names, saving) but no longer drawn.
+    struct StaticMeshBatched
+    {
+        entt::entity batch = entt::null;
+    };
+} // namespace sage
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include "engine/ShaderUniformCache.hpp"
 #include "raylib.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace sage
 {
     struct UberShaderComponent
@@ -29,45 +33,18 @@ namespace sage
 
         std::vector<uint32_t> materialMap;
 
+        // Uploads go through ShaderUniformCache, so consecutive draws with the same flags cost nothing.
         void SetShaderBools(unsigned int materialIdx) const
         {
-            int valueT = 1;
-            int valueF = 0;
-            if (HasFlag(materialIdx, Skinned))
-            {
-                SetShaderValue(shader, skinnedLoc, &valueT, RL_SHADER_UNIFORM_INT);
-            }
-            else
-            {
-                SetShaderValue(shader, skinnedLoc, &valueF, RL_SHADER_UNIFORM_INT);
-            }
-
-            if (HasFlag(materialIdx, Lit))
-            {
-                SetShaderValue(shader, litLoc, &valueT, RL_SHADER_UNIFORM_INT);
-            }
-            else
-            {
-                SetShaderValue(shader, litLoc, &valueF, RL_SHADER_UNIFORM_INT);
-            }
-
-            if (HasFlag(materialIdx, EmissiveTexture))
-            {
-                SetShaderValue(shader, hasEmissiveTexLoc, &valueT, RL_SHADER_UNIFORM_INT);
-            }
-            else
-            {
-                SetShaderValue(shader, hasEmissiveTexLoc, &valueF, RL_SHADER_UNIFORM_INT);
-            }
-
-            if (HasFlag(materialIdx, EmissiveCol))
-            {
-                SetShaderValue(shader, hasEmissiveColLoc, &valueT, RL_SHADER_UNIFORM_INT);
-            }
-            else
-            {
-                SetShaderValue(shader, hasEmissiveColLoc, &valueF, RL_SHADER_UNIFORM_INT);
-            }
+            auto& cache = ShaderUniformCache::GetInstance();
+            const int skinned = HasFlag(materialIdx, Skinned) ? 1 : 0;
+            const int lit = HasFlag(materialIdx, Lit) ? 1 : 0;
+            const int emissiveTex = HasFlag(materialIdx, EmissiveTexture) ? 1 : 0;
+            const int emissiveCol = HasFlag(materialIdx, EmissiveCol) ? 1 : 0;
+            cache.SetValue(shader, skinnedLoc, &skinned, RL_SHADER_UNIFORM_INT);
+            cache.SetValue(shader, litLoc, &lit, RL_SHADER_UNIFORM_INT);
+            cache.SetValue(shader, hasEmissiveTexLoc, &emissiveTex, RL_SHADER_UNIFORM_INT);
+            cache.SetValue(shader, hasEmissiveColLoc, &emissiveCol, RL_SHADER_UNIFORM_INT);
         }
 
         void SetShaderBools() const
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MeshQuantization.hpp"
+
 #include "cereal/cereal.hpp"
 #include "cereal/types/array.hpp"
 #include "cereal/types/string.hpp"
@@ -10,7 +12,9 @@
 #include "raymath.h"
 #include "rlgl.h"
 #include <array>
+#include <cstdint>
 #include <cstring>
+#include <string>
 
 template <typename Archive>
 void serialize(Archive& archive, Vector2& v2)
@@ -84,9 +88,18 @@ void load(Archive& archive, ModelAnimation& modelAnimation)
     }
 }
 
+// Prefixed with a sage::MeshFormat byte: Raw stores every attribute as-is, Quantized stores a
+// sage::QuantizedMesh (see MeshQuantization.hpp), chosen by sage::GetMeshEncodeOptions().
 template <typename Archive>
 void save(Archive& archive, Mesh const& mesh)
 {
+    if (sage::GetMeshEncodeOptions().quantize)
+    {
+        archive(static_cast<std::uint8_t>(sage::MeshFormat::Quantized), sage::QuantizeMesh(mesh));
+        return;
+    }
+    archive(static_cast<std::uint8_t>(sage::MeshFormat::Raw));
+
     std::vector<float> vertices(mesh.vertices, mesh.vertices + mesh.vertexCount * 3); // vec3
 
     std::vector<float> texcoords;
@@ -165,19 +178,42 @@ void load(Archive& archive, Mesh& mesh)
     std::vector<unsigned char> boneIds;
     std::vector<float> boneWeights;
 
-    archive(
-        mesh.vertexCount,
-        mesh.triangleCount,
-        mesh.boneCount,
-        vertices,
-        texcoords,
-        texcoords2,
-        normals,
-        tangents,
-        colors,
-        indices,
-        boneIds,
-        boneWeights);
+    std::uint8_t format = 0;
+    archive(format);
+    if (static_cast<sage::MeshFormat>(format) == sage::MeshFormat::Quantized)
+    {
+        sage::QuantizedMesh quantized;
+        archive(quantized);
+        mesh.vertexCount = quantized.vertexCount;
+        mesh.triangleCount = quantized.triangleCount;
+        mesh.boneCount = quantized.boneCount;
+        sage::DequantizeMesh(quantized, vertices, texcoords, texcoords2, normals, tangents);
+        colors = std::move(quantized.colors);
+        indices = std::move(quantized.indices);
+        boneIds = std::move(quantized.boneIds);
+        boneWeights = std::move(quantized.boneWeights);
+    }
+    else if (static_cast<sage::MeshFormat>(format) == sage::MeshFormat::Raw)
+    {
+        archive(
+            mesh.vertexCount,
+            mesh.triangleCount,
+            mesh.boneCount,
+            vertices,
+            texcoords,
+            texcoords2,
+            normals,
+            tangents,
+            colors,
+            indices,
+            boneIds,
+            boneWeights);
+    }
+    else
+    {
+        // Corrupt, or written by a newer packer.
+        throw cereal::Exception("Unknown mesh format " + std::to_string(format));
+    }
 
     bool animations = !boneIds.empty();
 
@@ -330,11 +366,29 @@ void save(Archive& archive, MaterialMap const& map)
     UnloadImage(image);
 };
 
+// CPU-side decode target with the same wire format as MaterialMap. Lets the image be decoded
+// off the main thread; UploadMaterialMap turns it into a GPU texture.
+struct DeferredMaterialMap
+{
+    Image image{};
+    Color color{};
+    float value{};
+};
+
 template <typename Archive>
-void load(Archive& archive, MaterialMap& map)
+void load(Archive& archive, DeferredMaterialMap& map)
 {
-    Image image;
-    archive(image, map.color, map.value);
+    archive(map.image, map.color, map.value);
+}
+
+// Uploads the decoded image (if any) and releases it. Main thread only.
+inline MaterialMap UploadMaterialMap(DeferredMaterialMap& deferred)
+{
+    MaterialMap map{};
+    map.color = deferred.color;
+    map.value = deferred.value;
+
+    Image& image = deferred.image;
     if (!image.data || (image.width == 0 && image.height == 0) || image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
     {
         map.texture = Texture2D{rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
@@ -343,11 +397,22 @@ void load(Archive& archive, MaterialMap& map)
         {
             UnloadImage(image);
         }
+        image = {};
 
-        return;
+        return map;
     }
     map.texture = LoadTextureFromImage(image);
     UnloadImage(image);
+    image = {};
+    return map;
+}
+
+template <typename Archive>
+void load(Archive& archive, MaterialMap& map)
+{
+    DeferredMaterialMap deferred;
+    load(archive, deferred);
+    map = UploadMaterialMap(deferred);
 };
 
 template <typename Archive>
@@ -371,18 +436,45 @@ void save(Archive& archive, Material const& material)
     archive(maps, params);
 };
 
-template <typename Archive>
-void load(Archive& archive, Material& material)
+// CPU-side decode target with the same wire format as Material (see DeferredMaterialMap).
+struct DeferredMaterial
 {
-    std::vector<MaterialMap> maps;
-    maps.resize(MAX_MATERIAL_MAPS);
+    std::vector<DeferredMaterialMap> maps;
     std::array<float, 4> params{};
+};
 
-    archive(maps, params);
+template <typename Archive>
+void load(Archive& archive, DeferredMaterial& material)
+{
+    archive(material.maps, material.params);
+}
+
+inline Material UploadMaterial(DeferredMaterial& deferred)
+{
+    Material material = LoadMaterialDefault();
+    for (size_t i = 0; i < deferred.maps.size() && i < MAX_MATERIAL_MAPS; ++i)
+    {
+        material.maps[i] = UploadMaterialMap(deferred.maps[i]);
+    }
+    return material;
+}
+
+// Releases decoded images that never made it to the GPU. Safe off the main thread.
+inline void UnloadDeferredMaterial(DeferredMaterial& deferred)
+{
+    for (auto& map : deferred.maps)
+    {
+        if (map.image.data) UnloadImage(map.image);
+        map.image = {};
+    }
+}
 
-    material = LoadMaterialDefault();
-    //  material.maps[MATERIAL_MAP_DIFFUSE] = maps.at(0);
-    std::memcpy(material.maps, maps.data(), MAX_MATERIAL_MAPS * sizeof(MaterialMap));
+template <typename Archive>
+void load(Archive& archive, Material& material)
+{
+    DeferredMaterial deferred;
+    load(archive, deferred);
+    material = UploadMaterial(deferred);
 };
 
 template <typename Archive>
@@ -412,9 +504,17 @@ void save(Archive& archive, Model const& model)
         bindPose);
 };
 
+// CPU-side decode target with the same wire format as Model. Mesh data is deserialised but not
+// uploaded, so it can be decoded off the main thread; UploadModelMeshes finishes the job.
+struct DeferredModel
+{
+    Model model{};
+};
+
 template <typename Archive>
-void load(Archive& archive, Model& model)
+void load(Archive& archive, DeferredModel& deferred)
 {
+    Model& model = deferred.model;
     std::vector<Mesh> meshes;
     // std::vector<Material> materials;
     std::vector<int> meshMaterial;
@@ -450,8 +550,12 @@ void load(Archive& archive, Model& model)
     std::memcpy(model.bones, bones.data(), model.boneCount * sizeof(BoneInfo));
     std::memcpy(model.bindPose, bindPose.data(), model.boneCount * sizeof(Transform));
 
-    // Below taken from raylib's LoadModel().
     model.transform = MatrixIdentity();
+}
+
+// Below taken from raylib's LoadModel(). Main thread only.
+inline void UploadModelMeshes(Model& model)
+{
     if ((model.meshCount != 0) && (model.meshes != nullptr))
     {
         // Upload vertex data to GPU (static meshes)
@@ -460,4 +564,40 @@ void load(Archive& archive, Model& model)
     }
     else
         TRACELOG(LOG_WARNING, "MESH: [%s] Failed to load model mesh(es) data", "Cereal Model Import");
+}
+
+// Frees the CPU-side arrays of a model that was never uploaded. Safe off the main thread.
+inline void UnloadDeferredModel(Model& model)
+{
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        Mesh& mesh = model.meshes[i];
+        RL_FREE(mesh.vertices);
+        RL_FREE(mesh.texcoords);
+        RL_FREE(mesh.normals);
+        RL_FREE(mesh.colors);
+        RL_FREE(mesh.tangents);
+        RL_FREE(mesh.texcoords2);
+        RL_FREE(mesh.indices);
+        RL_FREE(mesh.animVertices);
+        RL_FREE(mesh.animNormals);
+        RL_FREE(mesh.boneWeights);
+        RL_FREE(mesh.boneIds);
+        RL_FREE(mesh.boneMatrices);
+    }
+    RL_FREE(model.meshes);
+    RL_FREE(model.materials);
+    RL_FREE(model.meshMaterial);
+    RL_FREE(model.bones);
+    RL_FREE(model.bindPose);
+    model = {};
+}
+
+template <typename Archive>
+void load(Archive& archive, Model& model)
+{
+    DeferredModel deferred;
+    load(archive, deferred);
+    model = deferred.model;
+    UploadModelMeshes(model);
 };
\ No newline at end of file
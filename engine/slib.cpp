@@ -4,9 +4,12 @@
 
 #include "slib.hpp"
 
+#include "AnimationClip.hpp"
 #include "components/UberShaderComponent.hpp"
 #include "raymath.h"
 #include "ResourceManager.hpp"
+#include "ShaderUniformCache.hpp"
+#include "SkinningPool.hpp"
 
 #include <cstring>
 #include <vector>
@@ -44,7 +47,7 @@ namespace sage
         return image.height;
     }
 
-    ImageSafe::ImageSafe(ImageSafe&& other) noexcept : image(other.image)
+    ImageSafe::ImageSafe(ImageSafe&& other) noexcept : image(other.image), pin(std::move(other.pin))
     {
         // Reset the source object's model to prevent double deletion
         deepCopy = other.deepCopy;
@@ -53,6 +56,7 @@ namespace sage
 
     ImageSafe& ImageSafe::operator=(ImageSafe&& other) noexcept
     {
+        if (this != &other) pin = std::move(other.pin);
 
         if (this != &other && deepCopy)
         {
@@ -81,6 +85,11 @@ namespace sage
     {
     }
 
+    ImageSafe::ImageSafe(const Image& _image, std::shared_ptr<void> _pin)
+        : image(_image), deepCopy(false), pin(std::move(_pin))
+    {
+    }
+
     ImageSafe::ImageSafe(const std::string& path, bool _memorySafe)
         : image(LoadImage(path.c_str())), deepCopy(_memorySafe)
     {
@@ -189,9 +198,20 @@ namespace sage
         return GetRayCollisionMesh(ray, rlmodel.meshes[meshNum], mat);
     }
 
-    void ModelView::UpdateAnimation(ModelAnimation anim, unsigned int frame) const
+    // Samples the clip into a one-frame pose and lets raylib turn it into the meshes' bone matrices.
+    void ModelView::UpdateAnimation(const AnimationClip& anim, unsigned int frame) const
     {
-        UpdateModelAnimationBones(rlmodel, anim, static_cast<int>(frame));
+        static std::vector<Transform> pose;
+        pose.resize(anim.GetBoneCount());
+        anim.SamplePose(static_cast<int>(frame), pose.data());
+
+        Transform* framePose = pose.data();
+        ModelAnimation sampled{};
+        sampled.boneCount = anim.GetBoneCount();
+        sampled.frameCount = 1;
+        sampled.bones = const_cast<BoneInfo*>(anim.GetBones().data()); // Only read
+        sampled.framePoses = &framePose;
+        UpdateModelAnimationBones(rlmodel, sampled, 0);
     }
 
     void ModelView::Draw(const Vector3 position, float scale, const Color tint) const
@@ -202,9 +222,20 @@ namespace sage
     void ModelView::Draw(
         Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint) const
     {
+        for (int i = 0; i < rlmodel.meshCount; ++i)
+        {
+            SkinningPool::GetInstance().PrepareDraw(
+                rlmodel.meshes[i], rlmodel.materials[rlmodel.meshMaterial[i]]);
+        }
         DrawModelEx(rlmodel, position, rotationAxis, rotationAngle, scale, tint);
     }
 
+    Matrix ModelView::GetWorldTransform(
+        Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale) const
+    {
+        return ComposeWorldTransform(rlmodel.transform, position, rotationAxis, rotationAngle, scale);
+    }
+
     void ModelView::DrawUber(
         UberShaderComponent* uber,
         Vector3 position,
@@ -213,54 +244,18 @@ namespace sage
         Vector3 scale,
         Color tint) const
     {
-        Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
-        Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle * DEG2RAD);
-        Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
-
-        Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
-
-        auto model = rlmodel;
-        model.transform = MatrixMultiply(model.transform, matTransform);
-
-        for (int i = 0; i < model.meshCount; i++)
+        const Matrix transform = GetWorldTransform(position, rotationAxis, rotationAngle, scale);
+        for (int i = 0; i < rlmodel.meshCount; i++)
         {
-            uber->SetShaderBools(model.meshMaterial[i]);
-
-            if (uber->HasFlag(model.meshMaterial[i], UberShaderComponent::EmissiveTexture))
-            {
-                auto emTex = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_EMISSION].texture;
-                SetShaderValue(
-                    model.materials[i].shader,
-                    model.materials[model.meshMaterial[i]].shader.locs[SHADER_LOC_MAP_EMISSION],
-                    &emTex,
-                    SHADER_UNIFORM_SAMPLER2D);
-            }
-            if (uber->HasFlag(model.meshMaterial[i], UberShaderComponent::EmissiveCol))
-            {
-                auto emCol = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_EMISSION].color;
-
-                float values[4] = {
-                    static_cast<float>(emCol.r) / 255.0f,
-                    static_cast<float>(emCol.g) / 255.0f,
-                    static_cast<float>(emCol.b) / 255.0f,
-                    static_cast<float>(emCol.a) / 255.0f};
-                SetShaderValue(model.materials[i].shader, uber->colEmissiveLoc, &values, SHADER_UNIFORM_VEC4);
-            }
-
-            Color color = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color;
-
-            auto colorTint = WHITE;
-            colorTint.r = static_cast<unsigned char>((static_cast<int>(color.r) * static_cast<int>(tint.r)) / 255);
-            colorTint.g = static_cast<unsigned char>((static_cast<int>(color.g) * static_cast<int>(tint.g)) / 255);
-            colorTint.b = static_cast<unsigned char>((static_cast<int>(color.b) * static_cast<int>(tint.b)) / 255);
-            colorTint.a = static_cast<unsigned char>((static_cast<int>(color.a) * static_cast<int>(tint.a)) / 255);
-
-            model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = colorTint;
-            DrawMesh(model.meshes[i], model.materials[model.meshMaterial[i]], model.transform);
-            model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = color;
+            DrawModelMeshUber(rlmodel, uber, i, transform, tint);
         }
     }
 
+    void ModelView::DrawUberMesh(UberShaderComponent* uber, int meshIdx, const Matrix& transform, Color tint) const
+    {
+        DrawModelMeshUber(rlmodel, uber, meshIdx, transform, tint);
+    }
+
     int ModelView::GetMeshCount() const
     {
         return rlmodel.meshCount;
@@ -311,9 +306,13 @@ namespace sage
         rlmodel.materials[materialIdx].maps[mapIdx].texture = texture;
     }
 
+    // Copies mat into this instance's private material; the maps array stays owned by the instance.
     void ModelMutable::SetMaterial(unsigned int idx, Material mat) const
     {
-        rlmodel.materials[idx] = mat;
+        Material& target = rlmodel.materials[idx];
+        target.shader = mat.shader;
+        std::memcpy(target.maps, mat.maps, MAX_MATERIAL_MAPS * sizeof(MaterialMap));
+        std::memcpy(target.params, mat.params, sizeof(target.params));
     }
 
     Model& ModelMutable::GetRlModelMut()
@@ -326,6 +325,84 @@ namespace sage
         return instanceKey;
     }
 
+    // Same composition DrawModelEx applies: local model transform, then scale, rotation, translation.
+    Matrix ComposeWorldTransform(
+        const Matrix& local, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale)
+    {
+        Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+        Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle * DEG2RAD);
+        Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+
+        Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+        return MatrixMultiply(local, matTransform);
+    }
+
+    namespace
+    {
+        Color MultiplyColor(Color color, Color tint)
+        {
+            auto colorTint = WHITE;
+            colorTint.r = static_cast<unsigned char>((static_cast<int>(color.r) * static_cast<int>(tint.r)) / 255);
+            colorTint.g = static_cast<unsigned char>((static_cast<int>(color.g) * static_cast<int>(tint.g)) / 255);
+            colorTint.b = static_cast<unsigned char>((static_cast<int>(color.b) * static_cast<int>(tint.b)) / 255);
+            colorTint.a = static_cast<unsigned char>((static_cast<int>(color.a) * static_cast<int>(tint.a)) / 255);
+            return colorTint;
+        }
+    } // namespace
+
+    // One mesh of DrawModelEx. transform is the model's world transform (ComposeWorldTransform).
+    // With instances, draws the mesh once per world transform in a single instanced call instead;
+    // the material's shader must then take them as an attribute (see ubershader_instanced.vs).
+    void DrawModelMesh(
+        const Model& model, int meshIdx, const Matrix& transform, Color tint, const Matrix* instances, int instanceCount)
+    {
+        Material& material = model.materials[model.meshMaterial[meshIdx]];
+        Color color = material.maps[MATERIAL_MAP_DIFFUSE].color;
+        material.maps[MATERIAL_MAP_DIFFUSE].color = MultiplyColor(color, tint);
+        if (instances)
+        {
+            DrawMeshInstanced(model.meshes[meshIdx], material, instances, instanceCount);
+        }
+        else
+        {
+            SkinningPool::GetInstance().PrepareDraw(model.meshes[meshIdx], material);
+            DrawMesh(model.meshes[meshIdx], material, transform);
+        }
+        material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+    }
+
+    // As DrawModelMesh, setting the uber shader's per-material state first.
+    void DrawModelMeshUber(
+        const Model& model,
+        UberShaderComponent* uber,
+        int meshIdx,
+        const Matrix& transform,
+        Color tint,
+        const Matrix* instances,
+        int instanceCount)
+    {
+        const int materialIdx = model.meshMaterial[meshIdx];
+        const Material& material = model.materials[materialIdx];
+        uber->SetShaderBools(materialIdx);
+
+        // The emission texture itself needs no upload: DrawMesh binds every material map and
+        // points its sampler (shader.locs[SHADER_LOC_MAP_EMISSION]) at the right slot.
+        if (uber->HasFlag(materialIdx, UberShaderComponent::EmissiveCol))
+        {
+            auto emCol = material.maps[MATERIAL_MAP_EMISSION].color;
+
+            float values[4] = {
+                static_cast<float>(emCol.r) / 255.0f,
+                static_cast<float>(emCol.g) / 255.0f,
+                static_cast<float>(emCol.b) / 255.0f,
+                static_cast<float>(emCol.a) / 255.0f};
+            ShaderUniformCache::GetInstance().SetValue(
+                material.shader, uber->colEmissiveLoc, &values, SHADER_UNIFORM_VEC4);
+        }
+
+        DrawModelMesh(model, meshIdx, transform, tint, instances, instanceCount);
+    }
+
     std::string TitleCase(const std::string& A)
     {
         std::string lowercased = A;
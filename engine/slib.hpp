@@ -8,6 +8,7 @@
 #include "raylib.h"
 
 #include "entt/entt.hpp"
+#include <memory>
 #include <string>
 
 #include <optional>
@@ -15,12 +16,15 @@
 namespace sage
 {
     struct UberShaderComponent;
+    class AnimationClip;
 
     class ImageSafe
     {
         Image image{};
         // If Image is a deepCopy, this class will use RAII.
         bool deepCopy = true;
+        // Held by views of cached images so the cache cannot evict them while the view lives.
+        std::shared_ptr<void> pin;
 
       public:
         [[nodiscard]] const Image& GetImage() const;
@@ -37,6 +41,8 @@ namespace sage
 
         ~ImageSafe();
         explicit ImageSafe(const Image& _image, bool _deepCopy = true);
+        // Non-owning view that keeps _pin alive for as long as it (or whatever it is moved into) lives.
+        ImageSafe(const Image& _image, std::shared_ptr<void> _pin);
         explicit ImageSafe(const std::string& path, bool _deepCopy = true);
         explicit ImageSafe(bool _deepCopy = true);
 
@@ -67,7 +73,7 @@ namespace sage
         [[nodiscard]] BoundingBox CalcLocalMeshBoundingBox(const Mesh& mesh, bool& success) const;
         [[nodiscard]] BoundingBox CalcLocalBoundingBox() const;
         [[nodiscard]] RayCollision GetRayMeshCollision(Ray ray, int meshNum, Matrix transform) const;
-        void UpdateAnimation(ModelAnimation anim, unsigned int frame) const;
+        void UpdateAnimation(const AnimationClip& anim, unsigned int frame) const;
         void Draw(Vector3 position, float scale, Color tint) const;
         void Draw(Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint) const;
         void DrawUber(
@@ -77,6 +83,9 @@ namespace sage
             float rotationAngle,
             Vector3 scale,
             Color tint) const;
+        void DrawUberMesh(UberShaderComponent* uber, int meshIdx, const Matrix& transform, Color tint) const;
+        [[nodiscard]] Matrix GetWorldTransform(
+            Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale) const;
         [[nodiscard]] int GetMeshCount() const;
         [[nodiscard]] int GetMaterialCount() const;
         [[nodiscard]] Matrix GetTransform() const;
@@ -103,10 +112,12 @@ namespace sage
     };
 
     /**
-     * Non-owning, copyable view of a Model in ResourceManager's mutable pool. Each
-     * entry in that pool is a deep copy with private materials, so material/texture/
+     * Reference-counted, copyable handle to a Model in ResourceManager's mutable pool.
+     * Each entry in that pool is a clone with private materials, so material/texture/
      * shader mutations are local to the entry. Copying a ModelMutable yields another
-     * view onto the same entry — both copies see the same mutations.
+     * handle onto the same entry — both copies see the same mutations. When the last
+     * copy is destroyed (e.g. with the Renderable or VFX that held it) the entry goes
+     * back to the pool and is recycled by the next CreateModelMutable of that asset.
      *
      * Mutators (SetMaterial / SetTexture) write through the internal materials pointer,
      * they do not reallocate it. A future mutator must preserve that invariant or
@@ -115,6 +126,8 @@ namespace sage
     class ModelMutable : public ModelView
     {
         std::string instanceKey{};
+        // Shared by every copy; its deleter returns the entry to ResourceManager's pool.
+        std::shared_ptr<void> lease{};
 
       public:
         using ModelView::ModelView;
@@ -123,11 +136,12 @@ namespace sage
         void SetTexture(Texture texture, int materialIdx, MaterialMapIndex mapIdx) const;
         void SetMaterial(unsigned int idx, Material mat) const;
 
-        // Mutable handle to the underlying raylib Model. Use for direct buffer updates
-        // (e.g. UpdateMeshBuffer on a procedurally-evolving mesh). The pointers inside
+        // Mutable handle to the underlying raylib Model. The pointers inside
         // (meshes/materials/etc.) are shared with the RM-stored entry — writes through
         // them reach the entry. Do NOT reassign those pointers; that would diverge this
-        // view from the RM record.
+        // view from the RM record. Vertex/index arrays and GPU buffers are further shared
+        // with the source asset and every other instance of it (see CreateModelMutable), so
+        // they must not be written to (e.g. with UpdateMeshBuffer) through this handle.
         [[nodiscard]] Model& GetRlModelMut();
 
         [[nodiscard]] const std::string& GetInstanceKey() const;
@@ -139,6 +153,24 @@ namespace sage
     // Use when materials are shared (e.g. owned by ResourceManager::materialMap).
     void sgUnloadModel(const Model& model);
 
+    Matrix ComposeWorldTransform(
+        const Matrix& local, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale);
+    void DrawModelMesh(
+        const Model& model,
+        int meshIdx,
+        const Matrix& transform,
+        Color tint,
+        const Matrix* instances = nullptr,
+        int instanceCount = 0);
+    void DrawModelMeshUber(
+        const Model& model,
+        UberShaderComponent* uber,
+        int meshIdx,
+        const Matrix& transform,
+        Color tint,
+        const Matrix* instances = nullptr,
+        int instanceCount = 0);
+
     std::string TitleCase(const std::string& A);
     bool AlmostEquals(Vector3 a, Vector3 b);
     bool PointInsideRect(Rectangle rec, Vector2 point);
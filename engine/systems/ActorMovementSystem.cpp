@@ -10,12 +10,18 @@
 #include "slib.hpp"
 #include "TransformSystem.hpp"
 
+#include <algorithm>
 #include <format>
 #include <ranges>
 #include <tuple>
 
 namespace sage
 {
+    namespace
+    {
+        // Below this fraction of its speed an actor counts as held back by the crowd.
+        constexpr float STUCK_SPEED_FRACTION = 0.25f;
+    } // namespace
 
     void ActorMovementSystem::PruneMoveCommands(const entt::entity& entity) const
     {
@@ -94,7 +100,7 @@ namespace sage
         }
 
         const auto& collideable = registry->get<Collideable>(entity);
-        sys->navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, false);
+        sys->navigationGridSystem->UnstampActor(entity);
 
         const auto& actorTrans = registry->get<sgTransform>(entity);
         //        const auto path =
@@ -132,7 +138,7 @@ namespace sage
             onPathfindFailed.Publish(entity, destination, PathfindFailureReason::DestinationUnreachable);
         }
 
-        sys->navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, true, entity);
+        sys->navigationGridSystem->StampActor(entity, collideable.worldBoundingBox);
     }
 
     bool ActorMovementSystem::ReachedDestination(entt::entity entity) const
@@ -153,29 +159,86 @@ namespace sage
                 DrawCube({p.x, p.y + 1, p.z}, 1, 1, 1, GREEN);
             }
         }
+    }
 
-        for (auto& ray : debugRays)
-        {
-            DrawLine3D(ray.position, Vector3Add(ray.position, Vector3Multiply(ray.direction, {5, 1, 5})), RED);
-        }
+    // Only scenery counts; another actor standing on the next point is left to local avoidance.
+    bool ActorMovementSystem::isNextPointOccupied(
+        const MoveableActor& moveableActor, const Collideable& collideable) const
+    {
+        return !sys->navigationGridSystem->CheckBoundingBoxAreaUnoccupied(
+            moveableActor.path.front(), collideable.worldBoundingBox, false);
+    }
 
-        for (auto& col : debugCollisions)
-        {
-            DrawSphere(col.point, 1.5, GREEN);
-        }
+    bool ActorMovementSystem::isBlockedByScenery(const Vector3 worldPos) const
+    {
+        GridSquare square{};
+        if (!sys->navigationGridSystem->WorldToGridSpace(worldPos, square)) return true;
+        return sys->navigationGridSystem->CheckSingleSquareOccupied(square, false);
     }
 
-    void ActorMovementSystem::clearDebugData()
+    void ActorMovementSystem::refreshOccupancy(
+        const entt::entity entity, const sgTransform& transform, Collideable& collideable) const
     {
-        debugRays.erase(debugRays.begin(), debugRays.end());
-        debugCollisions.erase(debugCollisions.begin(), debugCollisions.end());
+        // The transform was mutated; refresh the world bbox so the stamp uses the post-move
+        // position (CollisionSystem::Update only runs once per frame).
+        collideable.worldBoundingBox = TransformBoundingBox(collideable.localBoundingBox, transform.GetMatrixNoRot());
+        sys->navigationGridSystem->StampActor(entity, collideable.worldBoundingBox);
     }
 
-    bool ActorMovementSystem::isNextPointOccupied(
-        const MoveableActor& moveableActor, const Collideable& collideable) const
+    std::size_t ActorMovementSystem::addAvoidanceAgent(
+        const MoveableActor& moveableActor,
+        const sgTransform& transform,
+        const Collideable& collideable,
+        const bool steering)
     {
-        return !sys->navigationGridSystem->CheckBoundingBoxAreaUnoccupied(
-            moveableActor.path.front(), collideable.worldBoundingBox);
+        const auto& bounds = collideable.worldBoundingBox;
+        const float radius = moveableActor.avoidanceRadius > 0
+                                 ? moveableActor.avoidanceRadius
+                                 : 0.5f * std::max(bounds.max.x - bounds.min.x, bounds.max.z - bounds.min.z);
+
+        LocalAvoidance::Agent agent;
+        agent.position = {transform.GetWorldPos().x, transform.GetWorldPos().z};
+        agent.velocity = {moveableActor.velocity.x, moveableActor.velocity.z};
+        agent.radius = radius;
+        agent.responsive = steering;
+        if (steering)
+        {
+            const Vector3& next = moveableActor.path.front();
+            const Vector2 toNext = {next.x - agent.position.x, next.z - agent.position.y};
+            agent.preferredVelocity = Vector2Scale(Vector2Normalize(toNext), moveableActor.movementSpeed);
+            agent.maxSpeed = moveableActor.movementSpeed;
+        }
+        return avoidance.AddAgent(agent);
+    }
+
+    void ActorMovementSystem::applyAvoidanceVelocity(
+        const entt::entity entity, MoveableActor& moveableActor, sgTransform& transform, Vector2 velocity) const
+    {
+        const Vector3 position = transform.GetWorldPos();
+        // Avoidance may steer off the planned path, but never into scenery.
+        if (isBlockedByScenery({position.x + velocity.x, position.y, position.z + velocity.y}))
+        {
+            velocity = {0, 0};
+        }
+
+        const bool heldBack = Vector2Length(velocity) < moveableActor.movementSpeed * STUCK_SPEED_FRACTION;
+        moveableActor.stuckTime = heldBack ? moveableActor.stuckTime + GetFrameTime() : 0;
+        if (moveableActor.stuckTime >= moveableActor.stuckRepathTime)
+        {
+            moveableActor.stuckTime = 0;
+            moveableActor.velocity = {};
+            PathfindToLocation(entity, moveableActor.GetDestination());
+            return;
+        }
+
+        moveableActor.velocity = {velocity.x, 0, velocity.y};
+        if (!heldBack)
+        {
+            // Shuffling in place would spin the actor around; only face the way it is really going.
+            transform.direction = Vector3Normalize(moveableActor.velocity);
+            updateActorRotation(entity, transform);
+        }
+        updateActorWorldPosition(entity, moveableActor.velocity);
     }
 
     void ActorMovementSystem::recalculatePath(
@@ -220,63 +283,6 @@ namespace sage
         moveableActor.onDestinationReached.Publish(entity);
     }
 
-    bool ActorMovementSystem::CheckCollisionWithOtherMoveable(
-        const entt::entity entity, const sgTransform& transform, MoveableActor& moveableActor) const
-    {
-        constexpr float avoidanceDistance = 10;
-        GridSquare actorIndex{};
-        sys->navigationGridSystem->WorldToGridSpace(transform.GetWorldPos(), actorIndex);
-
-        // navigationGridSystem->MarkSquaresDebug(moveableActor.debugRay, PURPLE, false);
-
-        NavigationGridSquare* hitCell =
-            castCollisionRay(actorIndex, transform.direction, avoidanceDistance, moveableActor);
-
-        // If we haven't hit anything, or the object is static, then we don't need to worry about it.
-        if (hitCell == nullptr || !registry->any_of<MoveableActor>(hitCell->occupant)) return false;
-
-        const auto& hitTransform = registry->get<sgTransform>(hitCell->occupant);
-
-        // Going same direction, ignore.
-        auto dot = Vector3DotProduct(transform.direction, hitTransform.direction);
-        if (dot >= 0)
-        {
-            return false;
-        }
-
-        if (registry->any_of<Collideable>(hitCell->occupant) &&
-            (!moveableActor.movementCollisionTarget.has_value() ||
-             hitCell->occupant != moveableActor.movementCollisionTarget.value()) &&
-            moveableActor.hitEntityId != entity)
-        {
-            if (!AlmostEquals(hitTransform.GetWorldPos(), moveableActor.hitLastPos))
-            {
-                moveableActor.hitEntityId = hitCell->occupant;
-                moveableActor.hitLastPos = hitTransform.GetWorldPos();
-
-                auto& hitCol = registry->get<Collideable>(hitCell->occupant);
-
-                if (Vector3Distance(hitTransform.GetWorldPos(), transform.GetWorldPos()) <
-                    Vector3Distance(moveableActor.path.back(), transform.GetWorldPos()))
-                {
-                    // std::cout << std::format(
-                    // "Entity {}: Collided with a moving object, rerouting \n", static_cast<int>(entity));
-                    PathfindToLocation(entity, moveableActor.GetDestination());
-                    hitCol.debugDraw = true;
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-
-    NavigationGridSquare* ActorMovementSystem::castCollisionRay(
-        const GridSquare& actorIndex, const Vector3& direction, float distance, MoveableActor& moveableActor) const
-    {
-        return sys->navigationGridSystem->CastRay(
-            actorIndex.row, actorIndex.col, {direction.x, direction.z}, distance, moveableActor.debugRay);
-    }
-
     void ActorMovementSystem::updateActorDirection(sgTransform& transform, const MoveableActor& moveableActor)
     {
         if (moveableActor.path.empty()) return;
@@ -291,17 +297,16 @@ namespace sage
         sys->transformSystem->SetRotation(entity, {transform.GetWorldRot().x, angle, transform.GetWorldRot().z});
     }
 
-    void ActorMovementSystem::updateActorWorldPosition(entt::entity entity) const
+    void ActorMovementSystem::updateActorWorldPosition(entt::entity entity, const Vector3 step) const
     {
         GridSquare actorIndex{};
         const auto& transform = registry->get<sgTransform>(entity);
         sys->navigationGridSystem->WorldToGridSpace(transform.GetWorldPos(), actorIndex);
         auto gridSquare = sys->navigationGridSystem->GetGridSquare(actorIndex.row, actorIndex.col);
-        auto& moveable = registry->get<MoveableActor>(entity);
         Vector3 newPos = {
-            transform.GetWorldPos().x + transform.direction.x * moveable.movementSpeed,
+            transform.GetWorldPos().x + step.x,
             gridSquare->heightMap.GetHeight(),
-            transform.GetWorldPos().z + transform.direction.z * moveable.movementSpeed};
+            transform.GetWorldPos().z + step.z};
         sys->transformSystem->SetPosition(entity, newPos);
     }
 
@@ -310,15 +315,17 @@ namespace sage
     {
         updateActorDirection(transform, moveableActor);
         updateActorRotation(entity, transform);
-        updateActorWorldPosition(entity);
+        updateActorWorldPosition(entity, Vector3Scale(transform.direction, moveableActor.movementSpeed));
     }
 
-    void ActorMovementSystem::updateActor(
+    // Advances the actor along its path. Returns whether it should steer towards the next point this
+    // frame; the move itself is made after local avoidance has run for every actor.
+    bool ActorMovementSystem::updateActor(
         entt::entity entity, MoveableActor& moveableActor, sgTransform& transform, Collideable& collideable)
     {
         if (moveableActor.path.empty())
         {
-            return;
+            return false;
         }
 
         if (isNextPointOccupied(moveableActor, collideable))
@@ -326,20 +333,16 @@ namespace sage
             // std::cout << std::format(// "Entity {}: Next point occupied, rerouting \n",
             // static_cast<int>(entity));
             recalculatePath(entity, moveableActor, collideable);
-            return;
+            return false;
         }
 
         if (hasReachedNextPoint(entity, moveableActor))
         {
             handlePointReached(entity, moveableActor);
-            return;
+            return false;
         }
 
-        if (!CheckCollisionWithOtherMoveable(entity, transform, moveableActor))
-        {
-            // TODO: Distance of the ray cast should be from the current pos to the next node
-            updateActorTransform(entity, transform, moveableActor);
-        }
+        return true;
     }
 
     void ActorMovementSystem::updateActor(
@@ -361,18 +364,45 @@ namespace sage
 
     void ActorMovementSystem::Update()
     {
-        clearDebugData();
+        avoidance.Clear();
+        steeringActors.clear();
 
+        // Path following. Every actor becomes an avoidance agent; idle ones are obstacles the
+        // others steer around.
         auto fullView = registry->view<MoveableActor, sgTransform, Collideable>();
         for (auto [entity, moveableActor, transform, collideable] : fullView.each())
         {
-            sys->navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, false);
-            updateActor(entity, moveableActor, transform, collideable);
-            // updateActor mutated the transform; refresh the world bbox so the re-mark
-            // uses the post-move position (CollisionSystem::Update only runs once per frame).
-            collideable.worldBoundingBox =
-                TransformBoundingBox(collideable.localBoundingBox, transform.GetMatrixNoRot());
-            sys->navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, true);
+            bool steering = false;
+            if (moveableActor.IsMoving())
+            {
+                steering = updateActor(entity, moveableActor, transform, collideable);
+                refreshOccupancy(entity, transform, collideable);
+            }
+            else if (moveableActor.stamped)
+            {
+                // Idle actors can still be placed by other systems; a no-op if they have not moved.
+                sys->navigationGridSystem->StampActor(entity, collideable.worldBoundingBox);
+            }
+            if (!steering)
+            {
+                moveableActor.velocity = {};
+                if (!moveableActor.IsMoving()) moveableActor.stuckTime = 0;
+            }
+
+            const auto agent = addAvoidanceAgent(moveableActor, transform, collideable, steering);
+            if (steering) steeringActors.emplace_back(entity, agent);
+        }
+
+        // Replaces per-actor raycasts and immediate repaths: actors slow down and sidestep each
+        // other, and only repath once held back for stuckRepathTime.
+        avoidance.Solve();
+        for (const auto& [entity, agent] : steeringActors)
+        {
+            auto& moveableActor = fullView.get<MoveableActor>(entity);
+            auto& transform = fullView.get<sgTransform>(entity);
+            auto& collideable = fullView.get<Collideable>(entity);
+            applyAvoidanceVelocity(entity, moveableActor, transform, avoidance.GetVelocity(agent));
+            refreshOccupancy(entity, transform, collideable);
         }
 
         // Process entities without Collideable component (e.g., some abilities etc)
@@ -4,10 +4,12 @@
 #pragma once
 
 #include "engine/Event.hpp"
+#include "engine/LocalAvoidance.hpp"
 
 #include "entt/entt.hpp"
 #include "raylib.h"
 
+#include <utility>
 #include <vector>
 
 namespace sage
@@ -25,43 +27,43 @@ namespace sage
     struct MoveableActor;
     class Collideable;
     struct sgTransform;
-    struct GridSquare;
-    struct NavigationGridSquare;
 
     class ActorMovementSystem
     {
         EngineSystems* sys;
         entt::registry* registry;
-        std::vector<Ray> debugRays;
-        std::vector<RayCollision> debugCollisions;
+        LocalAvoidance avoidance;
+        // Actors following a path this frame, with their agent index in avoidance.
+        std::vector<std::pair<entt::entity, std::size_t>> steeringActors;
 
-        void clearDebugData();
-        void updateActor(
+        [[nodiscard]] bool updateActor(
             entt::entity entity, MoveableActor& moveableActor, sgTransform& transform, Collideable& collideable);
         void updateActor(entt::entity entity, MoveableActor& moveableActor, sgTransform& transform);
         [[nodiscard]] bool isNextPointOccupied(
             const MoveableActor& moveableActor, const Collideable& collideable) const;
+        [[nodiscard]] bool isBlockedByScenery(Vector3 worldPos) const;
+        void refreshOccupancy(entt::entity entity, const sgTransform& transform, Collideable& collideable) const;
+        std::size_t addAvoidanceAgent(
+            const MoveableActor& moveableActor,
+            const sgTransform& transform,
+            const Collideable& collideable,
+            bool steering);
+        void applyAvoidanceVelocity(
+            entt::entity entity, MoveableActor& moveableActor, sgTransform& transform, Vector2 velocity) const;
         void recalculatePath(
             entt::entity entity, const MoveableActor& moveableActor, const Collideable& collideable) const;
         bool hasReachedNextPoint(entt::entity entity, const MoveableActor& moveableActor) const;
         void handlePointReached(entt::entity entity, MoveableActor& moveableActor);
         void setPositionToGridCenter(entt::entity, const MoveableActor& moveableActor) const;
         static void handleDestinationReached(entt::entity entity, MoveableActor& moveableActor);
-        NavigationGridSquare* castCollisionRay(
-            const GridSquare& actorIndex,
-            const Vector3& direction,
-            float distance,
-            MoveableActor& moveableActor) const;
         void updateActorTransform(entt::entity entity, sgTransform& transform, MoveableActor& moveableActor) const;
         static void updateActorDirection(sgTransform& transform, const MoveableActor& moveableActor);
         void updateActorRotation(entt::entity entity, const sgTransform& transform) const;
-        void updateActorWorldPosition(entt::entity entity) const;
+        void updateActorWorldPosition(entt::entity entity, Vector3 step) const;
 
       public:
         Event<entt::entity, Vector3, PathfindFailureReason> onPathfindFailed{};
 
-        [[nodiscard]] bool CheckCollisionWithOtherMoveable(
-            entt::entity entity, const sgTransform& transform, MoveableActor& moveableActor) const;
         [[nodiscard]] bool ReachedDestination(entt::entity entity) const;
         void PruneMoveCommands(const entt::entity& entity) const;
         [[nodiscard]] bool TryPathfindToLocation(
@@ -17,16 +17,16 @@ namespace sage
             auto& animation = registry->get<Animation>(entity);
             auto& renderable = registry->get<Renderable>(entity);
             auto& animData = animation.current;
-            const ModelAnimation& anim = animation.animations[animData.index];
+            const AnimationClip& anim = animation.animations[animData.index];
 
             if (animData.currentFrame == 0 || animData.currentFrame < animData.lastFrame)
             {
                 animation.onAnimationStart.Publish(entity);
             }
 
-            bool finalFrame = animData.currentFrame + animData.speed >= anim.frameCount;
+            bool finalFrame = animData.currentFrame + animData.speed >= anim.GetFrameCount();
             animData.lastFrame = animData.currentFrame;
-            animData.currentFrame = (animData.currentFrame + animData.speed) % anim.frameCount;
+            animData.currentFrame = (animData.currentFrame + animData.speed) % anim.GetFrameCount();
             renderable.GetModel()->UpdateAnimation(anim, animData.currentFrame);
 
             if (finalFrame) // Must be at end, as end of death animations can result in entities being destroyed
@@ -5,6 +5,7 @@
 #include "components/NavigationGridSquare.hpp"
 #include "components/Renderable.hpp"
 #include "components/sgTransform.hpp"
+#include "ParallelFor.hpp"
 #include <Serializer.hpp>
 
 #include <iostream>
@@ -96,6 +97,8 @@ namespace sage
                     gridSquareIndex, v1, v3, calculateGridsquareCentre(v1, v3)};
             }
         }
+
+        actorOccupancy.Reset(slices, slices);
     }
 
     void NavigationGridSystem::DrawDebugPathfinding(const GridSquare& minRange, const GridSquare& maxRange)
@@ -215,9 +218,10 @@ namespace sage
         return CheckSingleSquareOccupied(squareIndex);
     }
 
-    bool NavigationGridSystem::CheckSingleSquareOccupied(GridSquare position) const
+    bool NavigationGridSystem::CheckSingleSquareOccupied(GridSquare position, bool includeActors) const
     {
-        return gridSquares[position.row][position.col].occupied;
+        return includeActors ? isSquareOccupied(position.row, position.col)
+                             : gridSquares[position.row][position.col].occupied;
     }
 
     /**
@@ -226,7 +230,8 @@ namespace sage
      * @param bb
      * @return
      */
-    bool NavigationGridSystem::CheckBoundingBoxAreaUnoccupied(Vector3 worldPos, const BoundingBox& bb) const
+    bool NavigationGridSystem::CheckBoundingBoxAreaUnoccupied(
+        Vector3 worldPos, const BoundingBox& bb, bool includeActors) const
     {
         GridSquare gridPos{};
         if (!WorldToGridSpace(worldPos, gridPos))
@@ -234,10 +239,11 @@ namespace sage
             return false;
         }
 
-        return CheckBoundingBoxAreaUnoccupied(gridPos, bb);
+        return CheckBoundingBoxAreaUnoccupied(gridPos, bb, includeActors);
     }
 
-    bool NavigationGridSystem::CheckBoundingBoxAreaUnoccupied(GridSquare square, const BoundingBox& bb) const
+    bool NavigationGridSystem::CheckBoundingBoxAreaUnoccupied(
+        GridSquare square, const BoundingBox& bb, bool includeActors) const
     {
         GridSquare extents{};
         {
@@ -249,7 +255,7 @@ namespace sage
 
             extents -= bb_min;
         }
-        return checkExtents(square, extents);
+        return checkExtents(square, extents, includeActors);
     }
 
     entt::entity NavigationGridSystem::CheckSingleSquareOccupant(Vector3 worldPos) const
@@ -334,7 +340,7 @@ namespace sage
         }
         GridSquare dest{};
         WorldToGridSpace(point, dest);
-        if (GetGridSquare(dest.row, dest.col)->occupied)
+        if (isSquareOccupied(dest.row, dest.col))
         {
             return false;
         }
@@ -371,7 +377,9 @@ namespace sage
         return 1.0f + (angle / maxSlopeAngle);
     }
 
-    void NavigationGridSystem::calculateTerrainHeightAndNormals(const entt::entity& entity)
+    // Only writes rows in [rowBegin, rowEnd), so disjoint row bands can be processed concurrently.
+    void NavigationGridSystem::calculateTerrainHeightAndNormals(
+        const entt::entity& entity, int rowBegin, int rowEnd)
     {
         const auto& area = registry->get<Collideable>(entity).worldBoundingBox;
 
@@ -388,9 +396,10 @@ namespace sage
         const int min_col = std::max(0, std::min(topLeftIndex.col, bottomRightIndex.col));
         const int max_col = std::min(
             static_cast<int>(gridSquares[0].size()) - 1, std::max(topLeftIndex.col, bottomRightIndex.col));
-        const int min_row = std::max(0, std::min(topLeftIndex.row, bottomRightIndex.row));
-        const int max_row =
-            std::min(static_cast<int>(gridSquares.size()) - 1, std::max(topLeftIndex.row, bottomRightIndex.row));
+        const int min_row = std::max(rowBegin, std::min(topLeftIndex.row, bottomRightIndex.row));
+        const int max_row = std::min(
+            std::min(static_cast<int>(gridSquares.size()), rowEnd) - 1,
+            std::max(topLeftIndex.row, bottomRightIndex.row));
 
         for (int row = min_row; row <= max_row; ++row)
         {
@@ -439,21 +448,23 @@ namespace sage
 
         Image normalMap = GenImageColor(slices, slices, BLACK);
         std::cout << "START: Generating normal map..." << std::endl;
-        for (int y = 0; y < slices; ++y)
-        {
-            for (int x = 0; x < slices; ++x)
+        ParallelForBands(slices, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y)
             {
-                auto normal = gridSquares[y][x].heightMap.GetNormal();
+                for (int x = 0; x < slices; ++x)
+                {
+                    auto normal = gridSquares[y][x].heightMap.GetNormal();
 
-                // Map the normal components from [-1, 1] to [0, 255]
-                auto r = static_cast<unsigned char>((normal.x + 1.0f) * 127.5f);
-                auto g = static_cast<unsigned char>((normal.y + 1.0f) * 127.5f);
-                auto b = static_cast<unsigned char>((normal.z + 1.0f) * 127.5f);
+                    // Map the normal components from [-1, 1] to [0, 255]
+                    auto r = static_cast<unsigned char>((normal.x + 1.0f) * 127.5f);
+                    auto g = static_cast<unsigned char>((normal.y + 1.0f) * 127.5f);
+                    auto b = static_cast<unsigned char>((normal.z + 1.0f) * 127.5f);
 
-                Color pixelColor = {r, g, b, 255};
-                ImageDrawPixel(&normalMap, x, y, pixelColor);
+                    Color pixelColor = {r, g, b, 255};
+                    ImageDrawPixel(&normalMap, x, y, pixelColor);
+                }
             }
-        }
+        });
         image.SetImage(normalMap);
         std::cout << "FINISH: Generating normal map..." << std::endl;
     }
@@ -507,18 +518,20 @@ namespace sage
 
         Image heightMap = GenImageColor(slices, slices, BLACK);
         std::cout << "START: Generating height map..." << std::endl;
-        for (int y = 0; y < slices; ++y)
-        {
-            for (int x = 0; x < slices; ++x)
+        ParallelForBands(slices, [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; ++y)
             {
-                float height = gridSquares[y][x].heightMap.GetHeight();
+                for (int x = 0; x < slices; ++x)
+                {
+                    float height = gridSquares[y][x].heightMap.GetHeight();
 
-                auto heightValue = static_cast<unsigned char>(((height - minHeight) / heightRange) * 255.0f);
+                    auto heightValue = static_cast<unsigned char>(((height - minHeight) / heightRange) * 255.0f);
 
-                Color pixelColor = {heightValue, heightValue, heightValue, 255};
-                ImageDrawPixel(&heightMap, x, y, pixelColor);
+                    Color pixelColor = {heightValue, heightValue, heightValue, 255};
+                    ImageDrawPixel(&heightMap, x, y, pixelColor);
+                }
             }
-        }
+        });
         image.SetImage(heightMap);
         std::cout << "FINISH: Generating height map..." << std::endl;
     }
@@ -588,34 +601,6 @@ namespace sage
         std::cout << "FINISH: Applying terrain height map to grid. \n";
     }
 
-    /**
-     * Checks a position in the world for an occupant. If an occupant is found, the
-     * extents of the occupant are returned.
-     * @param worldPos The position in the world to check for an occupant.
-     * @param extents The extents of the occupant.
-     * @return Whether an occupant was found
-     */
-    bool NavigationGridSystem::getExtents(Vector3 worldPos, GridSquare& extents) const
-    {
-        GridSquare gridPos{};
-        if (!WorldToGridSpace(worldPos, gridPos))
-        {
-            return false;
-        }
-        const auto entity = CheckSingleSquareOccupant(worldPos);
-        if (entity == entt::null)
-        {
-            return false;
-        }
-
-        if (!getExtents(entity, extents))
-        {
-            return false;
-        }
-
-        return true;
-    }
-
     /**
      * Takes an entity and returns the extents of the entity in grid space.
      * @param entity The entity to get the extents of.
@@ -716,6 +701,32 @@ namespace sage
                out.row >= minRange.row;
     }
 
+    void NavigationGridSystem::StampActor(const entt::entity entity, const BoundingBox& footprint)
+    {
+        // Out-of-grid corners still map to a square; ActorOccupancy clamps the rectangle.
+        ActorOccupancy::Rect rect{};
+        WorldToGridSpace(footprint.min, rect.min);
+        WorldToGridSpace(footprint.max, rect.max);
+        actorOccupancy.Stamp(entity, rect);
+        if (auto* moveable = registry->try_get<MoveableActor>(entity)) moveable->stamped = true;
+    }
+
+    void NavigationGridSystem::UnstampActor(const entt::entity entity)
+    {
+        actorOccupancy.Unstamp(entity);
+        if (auto* moveable = registry->try_get<MoveableActor>(entity)) moveable->stamped = false;
+    }
+
+    bool NavigationGridSystem::ValidateActorOccupancy() const
+    {
+        return actorOccupancy.Validate();
+    }
+
+    const ActorOccupancy& NavigationGridSystem::GetActorOccupancy() const
+    {
+        return actorOccupancy;
+    }
+
     void NavigationGridSystem::DrawDebug() const
     {
         return;
@@ -805,7 +816,8 @@ namespace sage
                square.col < maxRange.col;
     }
 
-    bool NavigationGridSystem::checkExtents(const GridSquare square, const GridSquare extents) const
+    bool NavigationGridSystem::checkExtents(
+        const GridSquare square, const GridSquare extents, const bool includeActors) const
     {
         const auto min = square - extents;
         const auto max = square + extents;
@@ -814,7 +826,8 @@ namespace sage
         {
             for (int col = min.col; col < max.col; ++col)
             {
-                if (!CheckWithinGridBounds(GridSquare{row, col}) || gridSquares[row][col].occupied)
+                if (!CheckWithinGridBounds(GridSquare{row, col}) ||
+                    (includeActors ? isSquareOccupied(row, col) : gridSquares[row][col].occupied))
                 {
                     return false;
                 }
@@ -824,34 +837,9 @@ namespace sage
         return true;
     }
 
-    NavigationGridSquare* NavigationGridSystem::CastRay(
-        int currentRow, int currentCol, Vector2 direction, float distance, std::vector<GridSquare>& debugLines)
+    bool NavigationGridSystem::isSquareOccupied(const int row, const int col) const
     {
-        int dist = std::round(distance);
-        direction = Vector2Normalize(direction);
-        int dirRow = std::round(direction.y);
-        int dirCol = std::round(direction.x);
-
-        for (int i = 0; i < dist; ++i)
-        {
-            GridSquare square = {currentRow + (dirRow * i), currentCol + (dirCol * i)};
-            debugLines.push_back(square);
-
-            if (!CheckWithinGridBounds(square))
-            {
-                continue;
-            }
-
-            auto& cell = gridSquares[square.row][square.col];
-            cell.drawDebug = true;
-            cell.debugColor = PURPLE;
-
-            if (cell.occupant != entt::null)
-            {
-                return &cell;
-            }
-        }
-        return nullptr;
+        return gridSquares[row][col].occupied || actorOccupancy.IsOccupied(row, col);
     }
 
     GridSquare NavigationGridSystem::FindNextBestLocation(entt::entity entity, GridSquare target) const
@@ -1013,7 +1001,7 @@ namespace sage
                 if (CheckWithinBounds(next, minRange, maxRange) && checkExtents(next, extents) &&
                     (!visited[next.row][next.col] ||
                      (visited[next.row][next.col] && new_cost < cost_so_far[next.row][next.col])) &&
-                    !gridSquares.at(next.row).at(next.col).occupied)
+                    !isSquareOccupied(next.row, next.col))
                 {
                     cost_so_far[next.row][next.col] = new_cost;
                     const double heuristic_cost = heuristic(next, finishGridSquare);
@@ -1106,7 +1094,7 @@ namespace sage
             {
                 if (GridSquare next = {current.row + dirX, current.col + dirY};
                     CheckWithinBounds(next, minRange, maxRange) && !visited[next.row][next.col] &&
-                    checkExtents(next, extents) && !gridSquares[next.row][next.col].occupied)
+                    checkExtents(next, extents) && !isSquareOccupied(next.row, next.col))
                 {
                     frontier.emplace(next);
                     visited[next.row][next.col] = true;
@@ -1126,6 +1114,7 @@ namespace sage
     void NavigationGridSystem::InitGridHeightAndNormals()
     {
         std::cout << "START: Initialising grid height and normals \n";
+        std::vector<entt::entity> navigationEntities;
         const auto& view = registry->view<Collideable, Renderable>();
         for (const auto& entity : view)
         {
@@ -1133,9 +1122,18 @@ namespace sage
 
             if (IsNavigationLayer(bb.collisionLayer))
             {
-                calculateTerrainHeightAndNormals(entity);
+                navigationEntities.push_back(entity);
             }
         }
+
+        // Each band visits the entities in view order, so overlapping geometry resolves the same
+        // way as a serial pass. The registry and meshes are only read here.
+        ParallelForBands(static_cast<int>(gridSquares.size()), [&](int rowBegin, int rowEnd) {
+            for (const auto& entity : navigationEntities)
+            {
+                calculateTerrainHeightAndNormals(entity, rowBegin, rowEnd);
+            }
+        });
         std::cout << "FINISH: Initialising grid height and normals \n";
     }
 
@@ -1192,5 +1190,7 @@ namespace sage
     NavigationGridSystem::NavigationGridSystem(entt::registry* _registry, CollisionSystem* _collisionSystem)
         : registry(_registry), collisionSystem(_collisionSystem)
     {
+        registry->on_destroy<MoveableActor>().connect<&NavigationGridSystem::UnstampActor>(this);
+        registry->on_destroy<Collideable>().connect<&NavigationGridSystem::UnstampActor>(this);
     }
 } // namespace sage
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "engine/ActorOccupancy.hpp"
 #include "engine/components/NavigationGridSquare.hpp"
 #include "engine/slib.hpp"
 
@@ -25,6 +26,8 @@ namespace sage
             {1, 0}, {0, 1}, {-1, 0}, {0, -1}, {1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
         CollisionSystem* collisionSystem;
         std::vector<std::vector<NavigationGridSquare>> gridSquares;
+        // Moving actors are counted here rather than marked on the squares; see StampActor.
+        ActorOccupancy actorOccupancy;
 
         //---------------------------------------------------------
         [[nodiscard]] std::vector<Vector3> tracebackPath(
@@ -34,11 +37,11 @@ namespace sage
         //---------------------------------------------------------
         bool getExtents(entt::entity entity, GridSquare& extents) const;
         //---------------------------------------------------------
-        [[nodiscard]] bool checkExtents(GridSquare square, GridSquare extents) const;
+        [[nodiscard]] bool checkExtents(GridSquare square, GridSquare extents, bool includeActors = true) const;
         //---------------------------------------------------------
-        bool getExtents(Vector3 worldPos, GridSquare& extents) const;
+        [[nodiscard]] bool isSquareOccupied(int row, int col) const;
         //---------------------------------------------------------
-        void calculateTerrainHeightAndNormals(const entt::entity& entity);
+        void calculateTerrainHeightAndNormals(const entt::entity& entity, int rowBegin, int rowEnd);
         //---------------------------------------------------------
         std::pair<float, float> getHeightBounds(float slices);
         //---------------------------------------------------------
@@ -85,13 +88,6 @@ namespace sage
             GridSquare maxRange,
             GridSquare extents) const;
         //---------------------------------------------------------
-        [[nodiscard]] NavigationGridSquare* CastRay(
-            int currentRow,
-            int currentCol,
-            Vector2 direction,
-            float distance,
-            std::vector<GridSquare>& debugLines);
-        //---------------------------------------------------------
         [[nodiscard]] std::vector<Vector3> AStarPathfind(
             const entt::entity& entity,
             const Vector3& startPos,
@@ -141,12 +137,16 @@ namespace sage
         //---------------------------------------------------------
         [[nodiscard]] bool CheckSingleSquareOccupied(Vector3 worldPos) const;
         //---------------------------------------------------------
-        [[nodiscard]] bool CheckSingleSquareOccupied(GridSquare position) const;
+        [[nodiscard]] bool CheckSingleSquareOccupied(GridSquare position, bool includeActors = true) const;
         //---------------------------------------------------------
-        [[nodiscard]] bool CheckBoundingBoxAreaUnoccupied(Vector3 worldPos, const BoundingBox& bb) const;
+        [[nodiscard]] bool CheckBoundingBoxAreaUnoccupied(
+            Vector3 worldPos, const BoundingBox& bb, bool includeActors = true) const;
         //---------------------------------------------------------
-        [[nodiscard]] bool CheckBoundingBoxAreaUnoccupied(GridSquare square, const BoundingBox& bb) const;
+        [[nodiscard]] bool CheckBoundingBoxAreaUnoccupied(
+            GridSquare square, const BoundingBox& bb, bool includeActors = true) const;
         //---------------------------------------------------------
+        // The occupant queries report scenery only. Actors are counted in ActorOccupancy, which does
+        // not record who stands on a square.
         [[nodiscard]] entt::entity CheckSingleSquareOccupant(Vector3 worldPos) const;
         //---------------------------------------------------------
         [[nodiscard]] entt::entity CheckSingleSquareOccupant(GridSquare position) const;
@@ -161,6 +161,18 @@ namespace sage
         //---------------------------------------------------------
         [[nodiscard]] bool CompareSingleSquareOccupant(entt::entity entity, const BoundingBox& bb) const;
         //---------------------------------------------------------
+        // Counts a moving actor on the squares under its footprint, replacing where it was last
+        // stamped. Cheap when the footprint covers the same squares as before.
+        void StampActor(entt::entity entity, const BoundingBox& footprint);
+        //---------------------------------------------------------
+        // Removes the actor's stamp, e.g. so it does not block its own path while pathfinding.
+        void UnstampActor(entt::entity entity);
+        //---------------------------------------------------------
+        // Recomputes actor occupancy from every stamp and checks it matches the maintained counts.
+        [[nodiscard]] bool ValidateActorOccupancy() const;
+        //---------------------------------------------------------
+        [[nodiscard]] const ActorOccupancy& GetActorOccupancy() const;
+        //---------------------------------------------------------
         void DrawDebug() const;
         //---------------------------------------------------------
         explicit NavigationGridSystem(entt::registry* _registry, CollisionSystem* _collisionSystem);
@@ -7,106 +7,206 @@
 #include "components/DynamicRenderable.hpp"
 #include "components/Renderable.hpp"
 #include "components/sgTransform.hpp"
+#include "components/StaticInstanceGroup.hpp"
+#include "components/StaticMeshBatch.hpp"
 
 #include "components/UberShaderComponent.hpp"
 #include "raylib.h"
+#include "raymath.h"
+#include "ShaderUniformCache.hpp"
+#include "StaticInstancer.hpp"
+
+#include <iostream>
 
 namespace sage
 {
 
-    void RenderSystem::Update()
+    void RenderSystem::StreamModel(entt::entity entity, const std::string& key) const
     {
+        auto handle = ResourceManager::GetInstance().StreamModel(key);
+        registry->get_or_emplace<Renderable>(entity);
+        registry->emplace_or_replace<RenderableStreaming>(entity, std::move(handle));
     }
 
-    void RenderSystem::Draw() // Can't be const as GetModel returns pointers
+    void RenderSystem::Update()
     {
-        auto normalView =
-            registry->view<Renderable, sgTransform>(entt::exclude<RenderableDeferred, UberShaderComponent>);
-        auto deferredView =
-            registry->view<Renderable, sgTransform, RenderableDeferred>(entt::exclude<UberShaderComponent>);
-        auto uberView = registry->view<Renderable, sgTransform, UberShaderComponent>();
-        auto dynamicView = registry->view<DynamicRenderable, sgTransform>(entt::exclude<RenderableDeferred>);
-        auto dynamicDeferredView = registry->view<DynamicRenderable, sgTransform, RenderableDeferred>();
-
-        auto renderEntity = [this](auto& renderable, const auto& transform, const entt::entity entity) {
-            if (!renderable.active) return;
-
-            if (renderable.reqShaderUpdate) renderable.reqShaderUpdate(entity);
-
-            Vector3 rotationAxis = {0.0f, 1.0f, 0.0f};
-
-            renderable.GetModel()->Draw(
-                transform.GetWorldPos(),
-                rotationAxis,
-                transform.GetWorldRot().y,
-                transform.GetScale(),
-                renderable.hint);
-        };
-
-        auto renderDynamicEntity = [this](auto& renderable, const auto& transform, const entt::entity entity) {
-            if (!renderable.active) return;
+        auto view = registry->view<Renderable, RenderableStreaming>();
+        for (auto entity : view)
+        {
+            const auto& handle = view.get<RenderableStreaming>(entity).handle;
+            if (!handle.IsDone()) continue;
+
+            if (handle.IsReady())
+            {
+                auto& renderable = view.get<Renderable>(entity);
+                ModelView model = ResourceManager::GetInstance().GetModelView(handle.GetKey());
+                model.SetTransform(renderable.initialTransform);
+                renderable.SetModel(std::move(model));
+                registry->remove<RenderableStreaming>(entity);
+                onModelStreamed.Publish(entity);
+            }
+            else
+            {
+                std::cerr << "ERROR: RenderSystem -> Failed to stream model '" << handle.GetKey() << "'."
+                          << std::endl;
+                registry->remove<RenderableStreaming>(entity);
+            }
+        }
+    }
 
-            if (renderable.reqShaderUpdate) renderable.reqShaderUpdate(entity);
+    void RenderSystem::pushModel(
+        entt::entity entity,
+        RenderLayer layer,
+        const Model& model,
+        const Matrix& transform,
+        Color tint,
+        UberShaderComponent* uber,
+        const std::function<void(entt::entity)>* shaderUpdate,
+        const std::vector<Matrix>* instances)
+    {
+        for (int i = 0; i < model.meshCount; ++i)
+        {
+            const int materialIdx = model.meshMaterial[i];
+            const Material& material = model.materials[materialIdx];
+            const std::uint32_t flags = uber ? uber->materialMap.at(materialIdx) : 0;
+            DrawPacket packet;
+            packet.key = MakeSortKey(layer, flags, material);
+            packet.entity = entity;
+            packet.model = &model;
+            packet.mesh = i;
+            packet.transform = transform;
+            packet.tint = tint;
+            packet.uber = uber;
+            packet.shaderUpdate = shaderUpdate && *shaderUpdate ? shaderUpdate : nullptr;
+            if (instances)
+            {
+                packet.instances = instances->data();
+                packet.instanceCount = static_cast<int>(instances->size());
+            }
+            queue.Push(packet);
+        }
+    }
 
-            Vector3 rotationAxis = {0.0f, 1.0f, 0.0f};
+    std::size_t RenderSystem::GetDrawPacketCount() const
+    {
+        return queue.Size();
+    }
 
-            renderable.Draw(
-                transform.GetWorldPos(),
-                rotationAxis,
-                transform.GetWorldRot().y,
-                transform.GetScale(),
-                renderable.hint);
-        };
+    unsigned int RenderSystem::GetStateChanges() const
+    {
+        return stateChanges;
+    }
 
-        // TODO: Unsure if having three separate views will cause issues or not.
+    // Collects a packet per mesh from every drawable view, sorts them by state and draws in that
+    // order. Deferred renderables keep drawing after everything else via the key's layer bits.
+    // Instance groups submit one packet per mesh covering all their active members.
+    void RenderSystem::Draw() // Can't be const as GetModel returns pointers
+    {
+        ShaderUniformCache::GetInstance().BeginFrame();
+        queue.Clear();
 
-        for (auto entity : normalView)
-        {
-            auto& r = normalView.get<Renderable>(entity);
-            const auto& t = normalView.get<sgTransform>(entity);
-            renderEntity(r, t, entity);
-        }
+        const Vector3 rotationAxis = {0.0f, 1.0f, 0.0f};
 
-        for (auto entity : dynamicView)
+        auto renderableView =
+            registry->view<Renderable, sgTransform>(
+            entt::exclude<RenderableStreaming, StaticMeshBatched, StaticInstanced, StaticInstanceGroup>);
+        for (auto entity : renderableView)
         {
-            auto& r = dynamicView.get<DynamicRenderable>(entity);
-            const auto& t = dynamicView.get<sgTransform>(entity);
-            renderDynamicEntity(r, t, entity);
+            auto& renderable = renderableView.get<Renderable>(entity);
+            if (!renderable.active || !renderable.GetModel()) continue;
+
+            const auto& transform = renderableView.get<sgTransform>(entity);
+            const auto* model = renderable.GetModel();
+            const auto layer =
+                registry->all_of<RenderableDeferred>(entity) ? RenderLayer::Deferred : RenderLayer::Opaque;
+            pushModel(
+                entity,
+                layer,
+                model->GetRlModel(),
+                model->GetWorldTransform(
+                    transform.GetWorldPos(), rotationAxis, transform.GetWorldRot().y, transform.GetScale()),
+                renderable.hint,
+                registry->try_get<UberShaderComponent>(entity),
+                &renderable.reqShaderUpdate);
         }
 
-        for (auto entity : uberView)
+        for (auto groupView = registry->view<StaticInstanceGroup, Renderable>(); auto entity : groupView)
         {
-            auto& renderable = normalView.get<Renderable>(entity);
-            if (!renderable.active) continue;
-
-            const auto& transform = normalView.get<sgTransform>(entity);
-            auto& uber = registry->get<UberShaderComponent>(entity);
-            if (renderable.reqShaderUpdate) renderable.reqShaderUpdate(entity);
-
-            Vector3 rotationAxis = {0.0f, 1.0f, 0.0f};
-
-            renderable.GetModel()->DrawUber(
-                &uber,
-                transform.GetWorldPos(),
-                rotationAxis,
-                transform.GetWorldRot().y,
-                transform.GetScale(),
-                renderable.hint);
+            auto& renderable = groupView.get<Renderable>(entity);
+            if (!renderable.active || !renderable.GetModel()) continue;
+
+            RefreshInstanceGroup(registry, entity);
+            const auto& instances = groupView.get<StaticInstanceGroup>(entity).visible;
+            if (instances.empty()) continue;
+
+            const Model& model = renderable.GetModel()->GetRlModel();
+            const auto layer =
+                registry->all_of<RenderableDeferred>(entity) ? RenderLayer::Deferred : RenderLayer::Opaque;
+            if (auto* uber = registry->try_get<UberShaderComponent>(entity))
+            {
+                pushModel(
+                    entity, layer, model, MatrixIdentity(), renderable.hint, uber, &renderable.reqShaderUpdate, &instances);
+                continue;
+            }
+            // Only the instanced uber shader takes per-instance transforms; otherwise draw one by one.
+            for (const auto& transform : instances)
+            {
+                pushModel(entity, layer, model, transform, renderable.hint, nullptr, &renderable.reqShaderUpdate);
+            }
         }
 
-        for (auto entity : deferredView)
+        for (auto dynamicView = registry->view<DynamicRenderable, sgTransform>(); auto entity : dynamicView)
         {
-            auto& r = deferredView.get<Renderable>(entity);
-            const auto& t = deferredView.get<sgTransform>(entity);
-            renderEntity(r, t, entity);
+            auto& renderable = dynamicView.get<DynamicRenderable>(entity);
+            if (!renderable.active || !renderable.HasModel()) continue;
+
+            const auto& transform = dynamicView.get<sgTransform>(entity);
+            const Model& model = *renderable.GetModel();
+            const auto layer =
+                registry->all_of<RenderableDeferred>(entity) ? RenderLayer::Deferred : RenderLayer::Opaque;
+            pushModel(
+                entity,
+                layer,
+                model,
+                ComposeWorldTransform(
+                    model.transform,
+                    transform.GetWorldPos(),
+                    rotationAxis,
+                    transform.GetWorldRot().y,
+                    transform.GetScale()),
+                renderable.hint,
+                nullptr,
+                &renderable.reqShaderUpdate);
         }
 
-        for (auto entity : dynamicDeferredView)
-        {
-            auto& r = dynamicDeferredView.get<DynamicRenderable>(entity);
-            const auto& t = dynamicDeferredView.get<sgTransform>(entity);
-            renderDynamicEntity(r, t, entity);
-        }
+        queue.Sort();
+        stateChanges = queue.CountKeyChanges();
+
+        auto lastEntity = entt::null;
+        queue.ForEach([&lastEntity](const DrawPacket& packet) {
+            // Per-object state (e.g. lights) is set again whenever another entity was drawn in between.
+            if (packet.entity != lastEntity)
+            {
+                if (packet.shaderUpdate) (*packet.shaderUpdate)(packet.entity);
+                lastEntity = packet.entity;
+            }
+            if (packet.uber)
+            {
+                DrawModelMeshUber(
+                    *packet.model,
+                    packet.uber,
+                    packet.mesh,
+                    packet.transform,
+                    packet.tint,
+                    packet.instances,
+                    packet.instanceCount);
+            }
+            else
+            {
+                DrawModelMesh(
+                    *packet.model, packet.mesh, packet.transform, packet.tint, packet.instances, packet.instanceCount);
+            }
+        });
     }
 
     RenderSystem::RenderSystem(entt::registry* _registry) : registry(_registry)
@@ -5,15 +5,31 @@
 #pragma once
 
 #include "engine/components/Renderable.hpp"
+#include "engine/Event.hpp"
+#include "engine/RenderQueue.hpp"
 #include "engine/slib.hpp"
 
 #include "entt/entt.hpp"
 
+#include <vector>
+
 namespace sage
 {
     class RenderSystem
     {
         entt::registry* registry;
+        RenderQueue queue; // Rebuilt every frame; kept to reuse its storage
+        unsigned int stateChanges = 0;
+
+        void pushModel(
+            entt::entity entity,
+            RenderLayer layer,
+            const Model& model,
+            const Matrix& transform,
+            Color tint,
+            UberShaderComponent* uber,
+            const std::function<void(entt::entity)>* shaderUpdate,
+            const std::vector<Matrix>* instances = nullptr);
 
       public:
         [[nodiscard]] entt::entity FindRenderableByMeshName(const std::string& name) const
@@ -79,6 +95,18 @@ namespace sage
             }
             return entt::null;
         }
+        // Streams the model from the asset archive and assigns it to the entity's Renderable once
+        // resident. The Renderable is not drawn in the meantime.
+        void StreamModel(entt::entity entity, const std::string& key) const;
+
+        Event<entt::entity> onModelStreamed{};
+
+        // Draw packets submitted last frame, and how many times the sorted queue switched
+        // (layer, shader, flags, material) between them. Uniform uploads issued/avoided are
+        // counted by ShaderUniformCache::GetLastFrameStats.
+        [[nodiscard]] std::size_t GetDrawPacketCount() const;
+        [[nodiscard]] unsigned int GetStateChanges() const;
+
         void Update();
         void Draw();
         explicit RenderSystem(entt::registry* _registry);
@@ -72,6 +72,7 @@ namespace sage
             transform.m_positionLocal = position;
             transform.m_positionWorld = position;
         }
+        onPositionUpdate.Publish(entity);
         updateChildrenPos(entity);
     }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "engine/Event.hpp"
+
 #include "entt/entt.hpp"
 #include "raylib.h"
 
@@ -15,6 +17,9 @@ namespace sage
         void onComponentRemoved(entt::entity entity);
 
       public:
+        // Published whenever an entity's world position is set (including via its parent).
+        Event<entt::entity> onPositionUpdate{};
+
         void SetLocalPos(entt::entity entity, const Vector3& position);
         void SetLocalRot(entt::entity entity, const Quaternion& rotation);
         void SetLocalRot(entt::entity entity, const Vector3& rotation);
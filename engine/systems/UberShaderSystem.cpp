@@ -4,6 +4,7 @@
 
 #include "UberShaderSystem.hpp"
 #include "components/Renderable.hpp"
+#include "components/StaticInstanceGroup.hpp"
 #include "components/UberShaderComponent.hpp"
 #include "EngineSystems.hpp"
 #include "LightManager.hpp"
@@ -12,15 +13,37 @@
 namespace sage
 {
 
+    UberShaderSystem::ShaderVariant UberShaderSystem::loadVariant(const char* vsFileName) const
+    {
+        ShaderVariant variant;
+        variant.shader =
+            ResourceManager::GetInstance().ShaderLoad(vsFileName, "resources/shaders/custom/ubershader.fs");
+        auto& shader = variant.shader;
+
+        shader.locs[SHADER_LOC_MAP_EMISSION] = GetShaderLocation(shader, "emissionMap");
+        variant.colEmissionLoc = GetShaderLocation(shader, "colEmission");
+        //        shader.locs[SHADER_LOC_COLOR_AMBIENT] =
+        //            GetShaderLocation(shader, "emissionCol");         // stealing ambient color slot for emission
+        sys->lightSubSystem->LinkShaderToLights(shader); // Links shader to light data
+
+        variant.litLoc = GetShaderLocation(shader, "lit");
+        variant.skinnedLoc = GetShaderLocation(shader, "skinned");
+        variant.hasEmissiveTexLoc = GetShaderLocation(shader, "hasEmissionTex");
+        variant.hasEmissiveColLoc = GetShaderLocation(shader, "hasEmissionCol");
+        return variant;
+    }
+
     void UberShaderSystem::onComponentAdded(entt::entity entity)
     {
+        const auto& variant = registry->all_of<StaticInstanceGroup>(entity) ? instanced : standard;
+        const auto& shader = variant.shader;
         auto& uber = registry->get<UberShaderComponent>(entity);
         uber.shader = shader;
-        uber.litLoc = litLoc;
-        uber.skinnedLoc = skinnedLoc;
-        uber.hasEmissiveTexLoc = hasEmissiveTexLoc;
-        uber.hasEmissiveColLoc = hasEmissiveColLoc;
-        uber.colEmissiveLoc = colEmissionLoc;
+        uber.litLoc = variant.litLoc;
+        uber.skinnedLoc = variant.skinnedLoc;
+        uber.hasEmissiveTexLoc = variant.hasEmissiveTexLoc;
+        uber.hasEmissiveColLoc = variant.hasEmissiveColLoc;
+        uber.colEmissiveLoc = variant.colEmissionLoc;
         auto& renderable = registry->get<Renderable>(entity);
 
         const auto& rlmodel = renderable.GetModel()->GetRlModel();
@@ -42,6 +65,7 @@ namespace sage
         {
             renderable.GetModel()->SetShader(shader, i);
         }
+        sys->lightSubSystem->TrackRenderable(entity);
     }
 
     void UberShaderSystem::onComponentRemoved(entt::entity entity)
@@ -54,19 +78,9 @@ namespace sage
         registry->on_construct<UberShaderComponent>().connect<&UberShaderSystem::onComponentAdded>(this);
         registry->on_destroy<UberShaderComponent>().connect<&UberShaderSystem::onComponentRemoved>(this);
 
-        shader = ResourceManager::GetInstance().ShaderLoad(
-            "resources/shaders/custom/ubershader.vs", "resources/shaders/custom/ubershader.fs");
-
-        shader.locs[SHADER_LOC_MAP_EMISSION] = GetShaderLocation(shader, "emissionMap");
-        colEmissionLoc = GetShaderLocation(shader, "colEmission");
-        //        shader.locs[SHADER_LOC_COLOR_AMBIENT] =
-        //            GetShaderLocation(shader, "emissionCol");         // stealing ambient color slot for emission
-        sys->lightSubSystem->LinkShaderToLights(shader); // Links shader to light data
-
-        litLoc = GetShaderLocation(shader, "lit");
-        skinnedLoc = GetShaderLocation(shader, "skinned");
-        hasEmissiveTexLoc = GetShaderLocation(shader, "hasEmissionTex");
-        hasEmissiveColLoc = GetShaderLocation(shader, "hasEmissionCol");
-        // debug
+        standard = loadVariant("resources/shaders/custom/ubershader.vs");
+        // DrawMeshInstanced feeds the per-instance transforms to the attribute at the model matrix slot.
+        instanced = loadVariant("resources/shaders/custom/ubershader_instanced.vs");
+        instanced.shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(instanced.shader, "instanceTransform");
     }
-} // namespace sage
\ No newline at end of file
+} // namespace sage
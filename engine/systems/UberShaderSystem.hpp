@@ -16,13 +16,20 @@ namespace sage
     {
         entt::registry* registry;
         EngineSystems* sys;
-        Shader shader{};
-        int litLoc;
-        int skinnedLoc;
-        int hasEmissiveTexLoc;
-        int hasEmissiveColLoc;
-        int colEmissionLoc;
-
+        struct ShaderVariant
+        {
+            Shader shader{};
+            int litLoc = -1;
+            int skinnedLoc = -1;
+            int hasEmissiveTexLoc = -1;
+            int hasEmissiveColLoc = -1;
+            int colEmissionLoc = -1;
+        };
+
+        ShaderVariant standard;
+        ShaderVariant instanced; // For StaticInstanceGroup entities (per-instance transforms, no skinning)
+
+        [[nodiscard]] ShaderVariant loadVariant(const char* vsFileName) const;
         void onComponentAdded(entt::entity entity);
         void onComponentRemoved(entt::entity entity);
 
@@ -0,0 +1,205 @@
+#include "VisibilitySystem.hpp"
+
+#include "components/Collideable.hpp"
+#include "NavigationGridSystem.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace sage
+{
+    namespace
+    {
+        // Cached square pairs before the cache is dropped wholesale; ~1 MiB of map nodes.
+        constexpr std::size_t MAX_CACHE_ENTRIES = 1 << 15;
+    } // namespace
+
+    bool VisibilitySystem::blocksSightFor(const entt::entity entity) const
+    {
+        const auto& collideable = registry->get<Collideable>(entity);
+        return collideable.blocksNavigation || sightBlockingMask.Contains(collideable.collisionLayer);
+    }
+
+    void VisibilitySystem::stampBounds(
+        const BoundingBox& bounds, const GridSquare minSquare, const GridSquare maxSquare)
+    {
+        const auto a = toSquare(bounds.min);
+        const auto b = toSquare(bounds.max);
+        const int minRow = std::max(std::min(a.row, b.row), minSquare.row);
+        const int maxRow = std::min(std::max(a.row, b.row), maxSquare.row);
+        const int minCol = std::max(std::min(a.col, b.col), minSquare.col);
+        const int maxCol = std::min(std::max(a.col, b.col), maxSquare.col);
+        for (int row = minRow; row <= maxRow; ++row)
+        {
+            for (int col = minCol; col <= maxCol; ++col)
+            {
+                blocksSight[row * cols + col] = 1;
+            }
+        }
+    }
+
+    // Clamped to the grid, so off-grid points resolve to the nearest edge square.
+    GridSquare VisibilitySystem::toSquare(const Vector3 worldPos) const
+    {
+        GridSquare square{};
+        navigationGridSystem->WorldToGridSpace(worldPos, square);
+        square.row = std::clamp(square.row, 0, rows - 1);
+        square.col = std::clamp(square.col, 0, cols - 1);
+        return square;
+    }
+
+    bool VisibilitySystem::isBlocked(const int row, const int col) const
+    {
+        return blocksSight[row * cols + col] != 0;
+    }
+
+    // Line of sight is symmetric, so both directions share a key.
+    std::uint64_t VisibilitySystem::pairKey(const GridSquare from, const GridSquare to) const
+    {
+        const auto a = static_cast<std::uint32_t>(from.row * cols + from.col);
+        const auto b = static_cast<std::uint32_t>(to.row * cols + to.col);
+        return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+    }
+
+    bool VisibilitySystem::trace(const GridSquare from, const GridSquare to)
+    {
+        ++stats.traces;
+        return GridLineOfSight(from, to, [this](const int row, const int col) {
+            ++stats.squaresWalked;
+            return isBlocked(row, col);
+        });
+    }
+
+    bool VisibilitySystem::resolve(const std::uint64_t key)
+    {
+        if (const auto it = cache.find(key); it != cache.end())
+        {
+            ++stats.cacheHits;
+            return it->second;
+        }
+
+        const auto a = static_cast<int>(key >> 32);
+        const auto b = static_cast<int>(key & 0xFFFFFFFFu);
+        const bool visible = trace({a / cols, a % cols}, {b / cols, b % cols});
+        if (cache.size() >= MAX_CACHE_ENTRIES) cache.clear();
+        cache.emplace(key, visible);
+        return visible;
+    }
+
+    void VisibilitySystem::SetSightBlockingMask(const CollisionMask mask)
+    {
+        sightBlockingMask = mask;
+    }
+
+    void VisibilitySystem::Rebuild()
+    {
+        rows = cols = navigationGridSystem->slices;
+        blocksSight.assign(static_cast<std::size_t>(rows) * cols, 0);
+        cache.clear();
+        if (rows == 0) return;
+
+        for (const auto view = registry->view<Collideable>(); const auto entity : view)
+        {
+            if (!blocksSightFor(entity)) continue;
+            stampBounds(view.get<Collideable>(entity).worldBoundingBox, {0, 0}, {rows - 1, cols - 1});
+        }
+    }
+
+    void VisibilitySystem::RefreshArea(const BoundingBox& area)
+    {
+        if (rows == 0) return;
+
+        const auto a = toSquare(area.min);
+        const auto b = toSquare(area.max);
+        const GridSquare minSquare{std::min(a.row, b.row), std::min(a.col, b.col)};
+        const GridSquare maxSquare{std::max(a.row, b.row), std::max(a.col, b.col)};
+
+        for (int row = minSquare.row; row <= maxSquare.row; ++row)
+        {
+            for (int col = minSquare.col; col <= maxSquare.col; ++col)
+            {
+                blocksSight[row * cols + col] = 0;
+            }
+        }
+
+        // Only the XZ footprint matters; blockers at any height count. Read from the registry as Rebuild
+        // does, so the mask never depends on what SpatialQuery has indexed; blockers toggle rarely.
+        const BoundingBox column{{area.min.x, -FLT_MAX, area.min.z}, {area.max.x, FLT_MAX, area.max.z}};
+        for (const auto view = registry->view<Collideable>(); const auto entity : view)
+        {
+            const auto& bounds = view.get<Collideable>(entity).worldBoundingBox;
+            if (!blocksSightFor(entity) || !CheckCollisionBoxes(bounds, column)) continue;
+            stampBounds(bounds, minSquare, maxSquare);
+        }
+
+        // A walk stays within the rectangle spanned by its end squares.
+        std::erase_if(cache, [&](const auto& entry) {
+            const auto from = static_cast<int>(entry.first >> 32);
+            const auto to = static_cast<int>(entry.first & 0xFFFFFFFFu);
+            const int fromRow = from / cols, fromCol = from % cols;
+            const int toRow = to / cols, toCol = to % cols;
+            return std::min(fromRow, toRow) <= maxSquare.row && std::max(fromRow, toRow) >= minSquare.row &&
+                   std::min(fromCol, toCol) <= maxSquare.col && std::max(fromCol, toCol) >= minSquare.col;
+        });
+    }
+
+    bool VisibilitySystem::HasLineOfSight(const Vector3 from, const Vector3 to)
+    {
+        ++stats.requests;
+        if (rows == 0) return true;
+        return resolve(pairKey(toSquare(from), toSquare(to)));
+    }
+
+    void VisibilitySystem::Request(const Vector3 from, const Vector3 to, std::function<void(bool)> onResult)
+    {
+        ++stats.requests;
+        const std::uint64_t key = rows == 0 ? 0 : pairKey(toSquare(from), toSquare(to));
+        pending.push_back({key, std::move(onResult)});
+    }
+
+    void VisibilitySystem::Update()
+    {
+        if (pending.empty()) return;
+
+        // Callbacks may queue further requests; those wait for the next Update.
+        auto batch = std::move(pending);
+        pending.clear();
+
+        // Grouping equal pairs means each distinct pair is walked at most once per frame.
+        std::ranges::sort(batch, {}, &PendingRequest::key);
+        std::vector<bool> results(batch.size(), true);
+        if (rows > 0)
+        {
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                results[i] = resolve(batch[i].key);
+            }
+        }
+
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            batch[i].onResult(results[i]);
+        }
+    }
+
+    bool VisibilitySystem::BlocksSight(const GridSquare square) const
+    {
+        if (square.row < 0 || square.row >= rows || square.col < 0 || square.col >= cols) return false;
+        return isBlocked(square.row, square.col);
+    }
+
+    const VisibilitySystem::Stats& VisibilitySystem::GetStats() const
+    {
+        return stats;
+    }
+
+    void VisibilitySystem::ResetStats()
+    {
+        stats = {};
+    }
+
+    VisibilitySystem::VisibilitySystem(entt::registry* _registry, NavigationGridSystem* _navigationGridSystem)
+        : registry(_registry), navigationGridSystem(_navigationGridSystem)
+    {
+    }
+} // namespace sage
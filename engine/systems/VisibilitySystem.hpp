@@ -0,0 +1,131 @@
+#pragma once
+
+#include "engine/CollisionLayers.hpp"
+#include "engine/components/NavigationGridSquare.hpp"
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace sage
+{
+    class NavigationGridSystem;
+
+    /*
+     * Amanatides–Woo traversal from the centre of `from` to the centre of `to`, calling
+     * isBlocked(row, col) for each square crossed and stopping at the first that returns true. With
+     * both ends on square centres the crossing times are rational, so they are compared exactly in
+     * integers: the next x boundary is at t = (2 * stepsX + 1) / (2 * dx), likewise for y. A line
+     * passing exactly through a corner is blocked if either square beside the corner is. The end
+     * squares themselves are not tested.
+     */
+    template <typename IsBlocked>
+    [[nodiscard]] bool GridLineOfSight(const GridSquare from, const GridSquare to, IsBlocked&& isBlocked)
+    {
+        const int dx = std::abs(to.col - from.col);
+        const int dy = std::abs(to.row - from.row);
+        const int stepX = to.col > from.col ? 1 : -1;
+        const int stepY = to.row > from.row ? 1 : -1;
+
+        int col = from.col;
+        int row = from.row;
+        long long stepsX = 0;
+        long long stepsY = 0;
+        while (col != to.col || row != to.row)
+        {
+            const long long nextX = (2 * stepsX + 1) * dy; // tMaxX scaled by 2 * dx * dy
+            const long long nextY = (2 * stepsY + 1) * dx; // tMaxY likewise
+            if (nextX < nextY)
+            {
+                col += stepX;
+                ++stepsX;
+            }
+            else if (nextY < nextX)
+            {
+                row += stepY;
+                ++stepsY;
+            }
+            else
+            {
+                if (isBlocked(row, col + stepX) || isBlocked(row + stepY, col)) return false;
+                col += stepX;
+                row += stepY;
+                ++stepsX;
+                ++stepsY;
+            }
+
+            if (col == to.col && row == to.row) break;
+            if (isBlocked(row, col)) return false;
+        }
+        return true;
+    }
+
+    /*
+     * Line of sight over the navigation grid. Sight-blocking geometry is stamped into a per-square
+     * mask, and a query walks the squares between two points with GridLineOfSight. Results are cached
+     * per pair of squares until geometry overlapping the pair changes (see RefreshArea).
+     *
+     * Request() defers the walk to Update(), so every query made in a frame is resolved together
+     * and duplicates are served from the cache.
+     */
+    class VisibilitySystem
+    {
+      public:
+        struct Stats
+        {
+            unsigned long requests = 0;
+            unsigned long cacheHits = 0;
+            unsigned long traces = 0;
+            unsigned long squaresWalked = 0;
+        };
+
+      private:
+        struct PendingRequest
+        {
+            std::uint64_t key;
+            std::function<void(bool)> onResult;
+        };
+
+        entt::registry* registry;
+        NavigationGridSystem* navigationGridSystem;
+        CollisionMask sightBlockingMask{collision_layers::Obstacle.bit};
+        int rows = 0;
+        int cols = 0;
+        std::vector<std::uint8_t> blocksSight;
+        std::unordered_map<std::uint64_t, bool> cache;
+        std::vector<PendingRequest> pending;
+        Stats stats;
+
+        [[nodiscard]] bool blocksSightFor(entt::entity entity) const;
+        void stampBounds(const BoundingBox& bounds, GridSquare minSquare, GridSquare maxSquare);
+        [[nodiscard]] GridSquare toSquare(Vector3 worldPos) const;
+        [[nodiscard]] bool isBlocked(int row, int col) const;
+        [[nodiscard]] std::uint64_t pairKey(GridSquare from, GridSquare to) const;
+        [[nodiscard]] bool trace(GridSquare from, GridSquare to);
+        [[nodiscard]] bool resolve(std::uint64_t key);
+
+      public:
+        // Layers whose collideables block sight, in addition to anything that blocks navigation.
+        void SetSightBlockingMask(CollisionMask mask);
+        // Rebuilds the mask from every collideable. Call once the navigation grid is populated.
+        void Rebuild();
+        // Re-stamps the squares under area from the collideables currently overlapping it and drops
+        // cached results that may have crossed it. Call after a blocker moves or toggles (e.g. doors).
+        void RefreshArea(const BoundingBox& area);
+        // Immediate query; prefer Request for per-frame AI checks.
+        [[nodiscard]] bool HasLineOfSight(Vector3 from, Vector3 to);
+        // Queues a query; onResult is called from the next Update().
+        void Request(Vector3 from, Vector3 to, std::function<void(bool)> onResult);
+        void Update();
+        [[nodiscard]] bool BlocksSight(GridSquare square) const;
+        [[nodiscard]] const Stats& GetStats() const;
+        void ResetStats();
+
+        VisibilitySystem(entt::registry* _registry, NavigationGridSystem* _navigationGridSystem);
+    };
+} // namespace sage
@@ -10,6 +10,9 @@
 //   - static bool isLocked(const StateComponent&)      // short-circuits transitions while
 //                                                       // certain alternatives are current
 //
+// Derived using updateScheduled must provide:
+//   - private void update(StateAlt&, entt::entity, float dt); // dt covers any skipped frames
+//
 // StateComponent must provide:
 //   - Variant member named `current`
 //   - void RemoveAllSubscriptions();
@@ -17,6 +20,8 @@
 
 #pragma once
 
+#include "engine/systems/states/UpdateScheduler.hpp"
+
 #include "entt/entt.hpp"
 
 #include <utility>
@@ -29,9 +34,27 @@ namespace sage
     {
       protected:
         entt::registry* registry;
+        UpdateScheduler scheduler;
 
         explicit StateMachineBase(entt::registry* _registry) : registry(_registry)
         {
+            registry->on_destroy<StateComponent>().template connect<&UpdateScheduler::Forget>(scheduler);
+        }
+
+        // Ticks each entity in view when its bucket (from classify(entity)) is due this frame.
+        template <typename View, typename Classify>
+        void updateScheduled(const View& view, const AiUpdateSettings& settings, const float dt, Classify&& classify)
+        {
+            scheduler.BeginFrame(settings, dt);
+            for (const auto entity : view)
+            {
+                float elapsed = 0;
+                if (!scheduler.ShouldTick(entity, classify(entity), elapsed)) continue;
+                auto& state = registry->get<StateComponent>(entity);
+                std::visit(
+                    [this, entity, elapsed](auto& cur) { static_cast<Derived*>(this)->update(cur, entity, elapsed); },
+                    state.current);
+            }
         }
 
         // Default lock policy — never locked.
@@ -41,6 +64,11 @@ namespace sage
         }
 
       public:
+        [[nodiscard]] const UpdateScheduler& GetScheduler() const
+        {
+            return scheduler;
+        }
+
         template <typename NewState>
         void ChangeState(entt::entity entity, NewState newState = {})
         {
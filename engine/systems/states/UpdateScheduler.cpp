@@ -0,0 +1,73 @@
+#include "UpdateScheduler.hpp"
+
+#include "Settings.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+
+namespace sage
+{
+    namespace
+    {
+        bool isOnScreen(const Vector3 position, const Camera3D& camera)
+        {
+            const Vector3 view = Vector3Subtract(camera.target, camera.position);
+            if (Vector3DotProduct(Vector3Subtract(position, camera.position), view) <= 0) return false;
+            const Vector2 screen = GetWorldToScreen(position, camera);
+            return screen.x >= 0 && screen.y >= 0 && screen.x <= static_cast<float>(GetScreenWidth()) &&
+                   screen.y <= static_cast<float>(GetScreenHeight());
+        }
+    } // namespace
+
+    UpdateBucket ClassifyUpdateBucket(
+        const AiUpdateSettings& settings,
+        const Vector3 position,
+        const Vector3 focus,
+        const Camera3D& camera,
+        const bool critical)
+    {
+        if (critical) return UpdateBucket::Critical;
+        const float distance = Vector3Distance(position, focus);
+        if (distance <= settings.nearDistance || isOnScreen(position, camera)) return UpdateBucket::Near;
+        return distance <= settings.farDistance ? UpdateBucket::Far : UpdateBucket::Dormant;
+    }
+
+    void UpdateScheduler::BeginFrame(const AiUpdateSettings& _settings, const float dt)
+    {
+        settings = &_settings;
+        frameDt = dt;
+        frameStats = {};
+        ++frame;
+    }
+
+    bool UpdateScheduler::ShouldTick(const entt::entity entity, const UpdateBucket bucket, float& dt)
+    {
+        auto [it, inserted] = slots.try_emplace(entity);
+        auto& slot = it->second;
+        if (inserted) slot.phase = nextPhase++;
+        slot.pendingDt += frameDt;
+
+        auto& stats = frameStats[static_cast<std::size_t>(bucket)];
+        ++stats.considered;
+
+        const int interval =
+            settings && settings->enabled ? std::max(settings->intervals[static_cast<std::size_t>(bucket)], 1) : 1;
+        if ((frame + slot.phase) % static_cast<std::uint32_t>(interval) != 0) return false;
+
+        ++stats.ticked;
+        dt = slot.pendingDt;
+        slot.pendingDt = 0;
+        return true;
+    }
+
+    void UpdateScheduler::Forget(const entt::entity entity)
+    {
+        slots.erase(entity);
+    }
+
+    const std::array<UpdateScheduler::BucketStats, UPDATE_BUCKET_COUNT>& UpdateScheduler::GetFrameStats() const
+    {
+        return frameStats;
+    }
+} // namespace sage
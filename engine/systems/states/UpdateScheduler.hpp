@@ -0,0 +1,66 @@
+#pragma once
+
+#include "entt/entt.hpp"
+#include "raylib.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace sage
+{
+    struct AiUpdateSettings;
+
+    // How often an entity's AI needs to run. Indexes AiUpdateSettings::intervals.
+    enum class UpdateBucket : std::uint8_t
+    {
+        Critical, // In combat or otherwise time-sensitive: every frame
+        Near,     // Close to the focus or on screen
+        Far,
+        Dormant
+    };
+
+    inline constexpr std::size_t UPDATE_BUCKET_COUNT = 4;
+
+    // Buckets by distance to the focus (e.g. the selected actor), promoting anything on screen to Near.
+    [[nodiscard]] UpdateBucket ClassifyUpdateBucket(
+        const AiUpdateSettings& settings, Vector3 position, Vector3 focus, const Camera3D& camera, bool critical);
+
+    /*
+     * Decides which entities tick this frame. Each entity gets a fixed phase when first seen, and
+     * ticks when (frame + phase) is a multiple of its bucket's interval, so entities sharing an
+     * interval are spread evenly over the frames instead of all landing on the same one. Frame time
+     * accumulates while an entity is skipped and is handed over on its next tick.
+     */
+    class UpdateScheduler
+    {
+      public:
+        struct BucketStats
+        {
+            unsigned int considered = 0;
+            unsigned int ticked = 0;
+        };
+
+      private:
+        struct Slot
+        {
+            std::uint32_t phase = 0;
+            float pendingDt = 0;
+        };
+
+        std::unordered_map<entt::entity, Slot> slots;
+        std::array<BucketStats, UPDATE_BUCKET_COUNT> frameStats{};
+        const AiUpdateSettings* settings = nullptr;
+        std::uint32_t frame = 0;
+        std::uint32_t nextPhase = 0;
+        float frameDt = 0;
+
+      public:
+        void BeginFrame(const AiUpdateSettings& _settings, float dt);
+        // True if the entity is due this frame; dt is then the time since its last tick.
+        [[nodiscard]] bool ShouldTick(entt::entity entity, UpdateBucket bucket, float& dt);
+        void Forget(entt::entity entity);
+        // Counts for the frame started by the last BeginFrame.
+        [[nodiscard]] const std::array<BucketStats, UPDATE_BUCKET_COUNT>& GetFrameStats() const;
+    };
+} // namespace sage
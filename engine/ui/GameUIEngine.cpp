@@ -24,10 +24,31 @@ namespace sage
             tooltipWindow.reset();
         }
 
-        windows.erase(
-            std::ranges::remove_if(windows, [](const auto& window) { return window->IsMarkedForRemoval(); })
-                .begin(),
-            windows.end());
+        const auto removed =
+            std::ranges::remove_if(windows, [](const auto& window) { return window->IsMarkedForRemoval(); });
+        if (removed.empty()) return;
+        windows.erase(removed.begin(), removed.end());
+        buildHitRects();
+    }
+
+    void GameUIEngine::buildHitRects()
+    {
+        hitRects.clear();
+        for (const auto& window : windows)
+        {
+            if (window->IsHidden()) continue;
+            hitRects.push_back({window->rec, window.get()});
+        }
+    }
+
+    Window* GameUIEngine::windowAt(const Vector2 point) const
+    {
+        for (const auto& [rec, window] : std::views::reverse(hitRects))
+        {
+            // A window hidden since the rebuild no longer catches the mouse.
+            if (!window->IsHidden() && PointInsideRect(rec, point)) return window;
+        }
+        return nullptr;
     }
 
     void GameUIEngine::CreateErrorMessage(const std::string& msg)
@@ -53,6 +74,7 @@ namespace sage
         window->windowUpdateSub = userInput->onWindowUpdate.Subscribe(
             [window](Vector2 prev, Vector2 current) { window->OnWindowUpdate(prev, current); });
         window->InitLayout();
+        buildHitRects();
         return window;
     }
 
@@ -63,6 +85,7 @@ namespace sage
         window->windowUpdateSub = userInput->onWindowUpdate.Subscribe(
             [window](Vector2 prev, Vector2 current) { window->OnWindowUpdate(prev, current); });
         window->InitLayout();
+        buildHitRects();
         return window;
     }
 
@@ -86,16 +109,7 @@ namespace sage
 
     CellElement* GameUIEngine::GetCellUnderCursor() const
     {
-        Window* windowUnderCursor = nullptr;
-        const auto mousePos = GetMousePosition();
-        for (auto& window : windows)
-        {
-            if (window->IsHidden()) continue;
-            if (PointInsideRect(window->rec, mousePos) && mouseInNonObscuredWindowRegion(window.get(), mousePos))
-            {
-                windowUnderCursor = window.get();
-            }
-        }
+        const auto* windowUnderCursor = windowAt(GetMousePosition());
         if (windowUnderCursor == nullptr) return nullptr;
         for (const auto& child : windowUnderCursor->children)
         {
@@ -131,7 +145,9 @@ namespace sage
     {
         const auto it = std::ranges::find_if(
             windows, [clicked](const std::unique_ptr<Window>& ptr) { return ptr.get() == clicked; });
+        if (it == windows.end() || it + 1 == windows.end()) return;
         std::rotate(it, it + 1, windows.end());
+        buildHitRects();
     }
 
     void GameUIEngine::DrawDebug2D() const
@@ -143,6 +159,27 @@ namespace sage
         }
     }
 
+    void GameUIEngine::DrawOffscreen()
+    {
+        const auto refresh = [this](Window& window) {
+            if (window.IsHidden()) return;
+            window.PollChanges();
+            if (window.RenderCache())
+            {
+                ++stats.windowsRendered;
+            }
+            else
+            {
+                ++stats.windowsReused;
+            }
+        };
+        for (const auto& window : windows)
+        {
+            refresh(*window);
+        }
+        if (tooltipWindow) refresh(*tooltipWindow);
+    }
+
     void GameUIEngine::Draw2D() const
     {
         for (const auto& window : windows)
@@ -167,61 +204,26 @@ namespace sage
         }
     }
 
-    /**
-     *
-     * @return Whether the window region is not obscured by another window
-     */
-    bool GameUIEngine::mouseInNonObscuredWindowRegion(Window* window, Vector2 mousePos) const
+    void GameUIEngine::processWindows()
     {
-        if (auto collision = GetWindowCollision(window))
+        auto* hovered = windowAt(currentInput.mousePos);
+        for (const auto& window : windows)
         {
-            // check if window is lower
-            auto windowIt = std::ranges::find_if(
-                windows, [window](const std::unique_ptr<Window>& ptr) { return ptr.get() == window; });
-
-            const auto colIt = std::ranges::find_if(
-                windows, [collision](const std::unique_ptr<Window>& ptr) { return ptr.get() == collision; });
-
-            const auto windowDist = std::distance(windows.begin(), windowIt);
-
-            if (auto colDist = std::distance(windows.begin(), colIt); windowDist < colDist)
-            {
-                auto rec = GetOverlap(window->rec, collision->rec);
-                if (PointInsideRect(rec, mousePos))
-                {
-                    // this part of the window is being obscured by another
-                    return false;
-                }
-            }
+            if (window.get() == hovered || window->IsMarkedForRemoval() || window->IsHidden()) continue;
+            window->OnHoverStop();
         }
-        return true;
-    }
+        if (hovered == nullptr) return;
 
-    void GameUIEngine::processWindows()
-    {
-        const auto mousePos = GetMousePosition();
-
-        for (auto& window : windows)
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) || IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
         {
-            if (!window || window->IsMarkedForRemoval() || window->IsHidden()) continue;
-
-            if (!PointInsideRect(window->rec, mousePos) || !mouseInNonObscuredWindowRegion(window.get(), mousePos))
-            {
-                window->OnHoverStop();
-                continue;
-            }
-
-            if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) || IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                BringClickedWindowToFront(window.get());
-            }
+            BringClickedWindowToFront(hovered);
+        }
 
-            cursor->Disable();
-            cursor->DisableContextSwitching();
+        cursor->Disable();
+        cursor->DisableContextSwitching();
 
-            window->OnHoverStart(); // TODO: Need to check if it was already being hovered?
-            window->Update();
-        }
+        hovered->OnHoverStart(); // TODO: Need to check if it was already being hovered?
+        hovered->Update();
     }
 
     void GameUIEngine::Update()
@@ -229,6 +231,7 @@ namespace sage
         // Snapshot raylib input once per frame so the state machine doesn't pull
         // from globals; everyone reads via Input() for the rest of the pass.
         currentInput = InputSnapshot::Capture();
+        buildHitRects();
 
         if (draggedObject.has_value())
         {
@@ -248,6 +251,16 @@ namespace sage
         }
     }
 
+    const GameUIEngine::Stats& GameUIEngine::GetStats() const
+    {
+        return stats;
+    }
+
+    void GameUIEngine::ResetStats()
+    {
+        stats = {};
+    }
+
     GameUIEngine::GameUIEngine(entt::registry* _registry, const EngineSystems* _sys)
         : registry(_registry),
           userInput(_sys->userInput.get()),
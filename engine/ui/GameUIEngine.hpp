@@ -1,6 +1,8 @@
 //
 // GameUIEngine: top-level UI manager. Owns the window list, the tooltip window,
-// drag/hover tracking, and orchestrates per-frame Update / Draw2D.
+// drag/hover tracking, and orchestrates per-frame Update / Draw2D. Windows are
+// retained: DrawOffscreen re-renders the ones that changed into their caches,
+// and Draw2D only composites the caches.
 //
 
 #pragma once
@@ -25,19 +27,36 @@ namespace sage
 
     class GameUIEngine
     {
+      public:
+        struct Stats
+        {
+            unsigned long windowsRendered = 0; // Visible windows whose cache was re-rendered
+            unsigned long windowsReused = 0;   // Visible windows drawn from an unchanged cache
+        };
 
       protected:
+        // A visible window's rect as of the last rebuild. Kept back to front, in window order.
+        struct HitRect
+        {
+            Rectangle rec;
+            Window* window;
+        };
+
         std::optional<ErrorMessage> errorMessage;
         std::vector<std::unique_ptr<Window>> windows;
         std::unique_ptr<TooltipWindow> tooltipWindow;
         std::optional<CellElement*> draggedObject;
         std::optional<CellElement*> hoveredDraggableCellElement;
         InputSnapshot currentInput;
+        std::vector<HitRect> hitRects;
+        Stats stats;
 
         void pruneWindows();
         void processWindows();
-
-        [[nodiscard]] bool mouseInNonObscuredWindowRegion(Window* window, Vector2 mousePos) const;
+        // Rebuilt at the top of Update and whenever the window list or its order changes.
+        void buildHitRects();
+        // The front-most visible window containing point.
+        [[nodiscard]] Window* windowAt(Vector2 point) const;
 
       public:
         entt::registry* registry;
@@ -58,8 +77,13 @@ namespace sage
         [[nodiscard]] Window* GetWindowCollision(const Window* toCheck) const;
         [[nodiscard]] CellElement* GetCellUnderCursor() const;
         void DrawDebug2D() const;
+        // Polls visible windows for changes and re-renders the caches of those that changed.
+        // Must be called outside any texture mode, before Draw2D.
+        void DrawOffscreen();
         void Draw2D() const;
         void Update();
+        [[nodiscard]] const Stats& GetStats() const;
+        void ResetStats();
 
         // The current frame's input snapshot. Captured at the top of Update().
         [[nodiscard]] const InputSnapshot& Input() const { return currentInput; }
@@ -0,0 +1,349 @@
+//
+// Text layout cache implementation. See TextLayoutCache.hpp.
+//
+
+#include "TextLayoutCache.hpp"
+
+#include <functional>
+
+namespace sage
+{
+    namespace
+    {
+        // GetCodepointNext, bounds-checked: bytes past the end read as the terminator would.
+        int nextCodepoint(const std::string_view text, const std::size_t i, int& size)
+        {
+            const auto byte = [&text, i](const std::size_t offset) -> unsigned char {
+                return i + offset < text.size() ? static_cast<unsigned char>(text[i + offset]) : 0;
+            };
+            const auto continuation = [&byte](const std::size_t offset) { return (byte(offset) & 0xC0) == 0x80; };
+
+            size = 1;
+            const unsigned char lead = byte(0);
+            if ((lead & 0xF8) == 0xF0)
+            {
+                if (!continuation(1) || !continuation(2) || !continuation(3)) return '?';
+                size = 4;
+                return ((lead & 0x07) << 18) | ((byte(1) & 0x3F) << 12) | ((byte(2) & 0x3F) << 6) |
+                       (byte(3) & 0x3F);
+            }
+            if ((lead & 0xF0) == 0xE0)
+            {
+                if (!continuation(1) || !continuation(2)) return '?';
+                size = 3;
+                return ((lead & 0x0F) << 12) | ((byte(1) & 0x3F) << 6) | (byte(2) & 0x3F);
+            }
+            if ((lead & 0xE0) == 0xC0)
+            {
+                if (!continuation(1)) return '?';
+                size = 2;
+                return ((lead & 0x1F) << 6) | (byte(1) & 0x3F);
+            }
+            if ((lead & 0x80) == 0) return lead;
+            return '?';
+        }
+
+        // The characters std::istream's >> skips between words in the "C" locale.
+        bool isWordSeparator(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+
+        float lineWidth(const float advanceSum, const int codepoints, const float scale, const float spacing)
+        {
+            return advanceSum * scale + static_cast<float>((codepoints - 1) * spacing);
+        }
+    } // namespace
+
+    int TextLayoutCache::FontMetrics::GlyphIndex(const int codepoint) const
+    {
+        if (codepoint >= 0 && codepoint < static_cast<int>(ascii.size())) return ascii[codepoint];
+        const auto it = other.find(codepoint);
+        return it != other.end() ? it->second : fallback;
+    }
+
+    std::size_t TextLayoutCache::KeyHash::operator()(const Key& key) const
+    {
+        std::size_t hash = key.textHash;
+        const auto combine = [&hash](const std::size_t value) {
+            hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        };
+        combine(std::hash<std::uintptr_t>{}(key.font));
+        combine(std::hash<float>{}(key.fontSize));
+        combine(std::hash<float>{}(key.spacing));
+        combine(std::hash<float>{}(key.wrapWidth));
+        return hash;
+    }
+
+    const TextLayoutCache::FontMetrics& TextLayoutCache::metricsFor(const Font& font)
+    {
+        const auto id = reinterpret_cast<std::uintptr_t>(font.glyphs);
+        auto [it, inserted] = fonts.try_emplace(id);
+        auto& metrics = it->second;
+        if (!inserted && metrics.textureId == font.texture.id && metrics.glyphCount == font.glyphCount)
+        {
+            return metrics;
+        }
+        // A different font now lives at this address; layouts made with the old one are stale.
+        if (!inserted) layouts.clear();
+
+        metrics = {};
+        metrics.textureId = font.texture.id;
+        metrics.glyphCount = font.glyphCount;
+        metrics.ascii.fill(-1);
+        metrics.measureAdvance.resize(font.glyphCount);
+        metrics.drawAdvance.resize(font.glyphCount);
+        for (int i = 0; i < font.glyphCount; ++i)
+        {
+            const auto& glyph = font.glyphs[i];
+            // GetGlyphIndex takes the first glyph with the codepoint, and falls back to the last '?'.
+            if (glyph.value >= 0 && glyph.value < static_cast<int>(metrics.ascii.size()))
+            {
+                if (metrics.ascii[glyph.value] < 0) metrics.ascii[glyph.value] = i;
+            }
+            else
+            {
+                metrics.other.try_emplace(glyph.value, i);
+            }
+            if (glyph.value == '?') metrics.fallback = i;
+
+            metrics.measureAdvance[i] = glyph.advanceX > 0 ? static_cast<float>(glyph.advanceX)
+                                                           : font.recs[i].width + glyph.offsetX;
+            metrics.drawAdvance[i] = glyph.advanceX == 0 ? font.recs[i].width : static_cast<float>(glyph.advanceX);
+        }
+        for (auto& index : metrics.ascii)
+        {
+            if (index < 0) index = metrics.fallback;
+        }
+        return metrics;
+    }
+
+    Vector2 TextLayoutCache::measure(
+        const FontMetrics& metrics,
+        const Font& font,
+        const std::string_view text,
+        const float fontSize,
+        const float spacing)
+    {
+        if (text.empty()) return {0, 0};
+
+        // Mirrors MeasureTextEx, including taking the widest line and the longest line (in
+        // codepoints) separately.
+        int longestLine = 0;
+        int lineLength = 0;
+        float widest = 0;
+        float width = 0;
+        float height = fontSize;
+        for (std::size_t i = 0; i < text.size();)
+        {
+            ++lineLength;
+            int size = 0;
+            const int codepoint = nextCodepoint(text, i, size);
+            i += size;
+            if (codepoint != '\n')
+            {
+                width += metrics.measureAdvance[metrics.GlyphIndex(codepoint)];
+            }
+            else
+            {
+                if (widest < width) widest = width;
+                lineLength = 0;
+                width = 0;
+                height += fontSize + LINE_SPACING;
+            }
+            if (longestLine < lineLength) longestLine = lineLength;
+        }
+        if (widest < width) widest = width;
+
+        const float scale = fontSize / static_cast<float>(font.baseSize);
+        return {lineWidth(widest, longestLine, scale, spacing), height};
+    }
+
+    std::string TextLayoutCache::wrap(
+        const FontMetrics& metrics,
+        const Font& font,
+        const std::string_view text,
+        const float fontSize,
+        const float spacing,
+        const float width)
+    {
+        // The word wrap TextBox has always used: words are packed onto a line while the line,
+        // measured with MeasureTextEx, still fits; a word that does not fit on its own keeps a
+        // line to itself. The line's advance sum is carried forward instead of re-measuring it.
+        const float scale = fontSize / static_cast<float>(font.baseSize);
+        const float spaceAdvance = metrics.measureAdvance[metrics.GlyphIndex(' ')];
+
+        std::string wrapped;
+        std::string current;
+        float currentAdvance = 0;
+        int currentCodepoints = 0;
+        for (std::size_t i = 0;;)
+        {
+            while (i < text.size() && isWordSeparator(text[i]))
+            {
+                ++i;
+            }
+            if (i >= text.size()) break;
+            const std::size_t wordStart = i;
+            while (i < text.size() && !isWordSeparator(text[i]))
+            {
+                ++i;
+            }
+            const std::string_view word = text.substr(wordStart, i - wordStart);
+
+            float wordAdvance = 0;
+            int wordCodepoints = 0;
+            float advance = currentAdvance;
+            int codepoints = currentCodepoints;
+            if (!current.empty())
+            {
+                advance += spaceAdvance;
+                ++codepoints;
+            }
+            for (std::size_t c = 0; c < word.size();)
+            {
+                int size = 0;
+                const int codepoint = nextCodepoint(word, c, size);
+                const float glyphAdvance = metrics.measureAdvance[metrics.GlyphIndex(codepoint)];
+                // Accumulated in the order MeasureTextEx would add them, for identical rounding.
+                advance += glyphAdvance;
+                wordAdvance += glyphAdvance;
+                ++codepoints;
+                ++wordCodepoints;
+                c += size;
+            }
+
+            if (lineWidth(advance, codepoints, scale, spacing) <= width)
+            {
+                if (!current.empty()) current += ' ';
+                current += word;
+                currentAdvance = advance;
+                currentCodepoints = codepoints;
+            }
+            else
+            {
+                if (!wrapped.empty()) wrapped += '\n';
+                wrapped += current;
+                current = word;
+                currentAdvance = wordAdvance;
+                currentCodepoints = wordCodepoints;
+            }
+        }
+
+        if (!current.empty())
+        {
+            if (!wrapped.empty()) wrapped += '\n';
+            wrapped += current;
+        }
+        return wrapped;
+    }
+
+    void TextLayoutCache::build(
+        const FontMetrics& metrics,
+        const Font& font,
+        const float fontSize,
+        const float spacing,
+        TextLayout& layout)
+    {
+        const std::string_view text = layout.text;
+        layout.size = measure(metrics, font, text, fontSize, spacing);
+        layout.lineCount = text.empty() ? 0 : 1;
+        layout.glyphs.clear();
+        layout.glyphs.reserve(text.size());
+
+        // Mirrors DrawTextEx's pen movement.
+        const float scale = fontSize / static_cast<float>(font.baseSize);
+        Vector2 pen{0, 0};
+        for (std::size_t i = 0; i < text.size();)
+        {
+            int size = 0;
+            const int codepoint = nextCodepoint(text, i, size);
+            i += size;
+            if (codepoint == '\n')
+            {
+                pen.y += fontSize + LINE_SPACING;
+                pen.x = 0;
+                ++layout.lineCount;
+                continue;
+            }
+            const int index = metrics.GlyphIndex(codepoint);
+            if (codepoint != ' ' && codepoint != '\t') layout.glyphs.push_back({index, pen});
+            pen.x += metrics.drawAdvance[index] * scale + spacing;
+        }
+    }
+
+    const TextLayout& TextLayoutCache::Get(
+        const Font& font,
+        const std::string& text,
+        const float fontSize,
+        const float spacing,
+        const float wrapWidth)
+    {
+        // Before the lookup: a font reloaded at the same address must not hit the old font's layouts.
+        const auto& metrics = metricsFor(font);
+        const Key key{
+            std::hash<std::string>{}(text),
+            reinterpret_cast<std::uintptr_t>(font.glyphs),
+            fontSize,
+            spacing,
+            wrapWidth};
+        if (const auto it = layouts.find(key); it != layouts.end() && it->second.source == text)
+        {
+            ++stats.hits;
+            return it->second.layout;
+        }
+        ++stats.misses;
+
+        if (layouts.size() >= MAX_LAYOUTS) layouts.clear();
+        auto& entry = layouts[key];
+        entry.source = text;
+        entry.layout.text =
+            wrapWidth == NO_WRAP ? text : wrap(metrics, font, text, fontSize, spacing, wrapWidth);
+        build(metrics, font, fontSize, spacing, entry.layout);
+        return entry.layout;
+    }
+
+    Vector2 TextLayoutCache::Measure(
+        const Font& font, const std::string_view text, const float fontSize, const float spacing)
+    {
+        return measure(metricsFor(font), font, text, fontSize, spacing);
+    }
+
+    void TextLayoutCache::Draw(
+        const Font& font, const TextLayout& layout, const Vector2 position, const float fontSize, const Color tint)
+    {
+        // Same quads DrawTextCodepoint would emit, minus its glyph lookup.
+        const float scale = fontSize / static_cast<float>(font.baseSize);
+        const auto padding = static_cast<float>(font.glyphPadding);
+        for (const auto& [index, offset] : layout.glyphs)
+        {
+            const auto& glyph = font.glyphs[index];
+            const auto& rec = font.recs[index];
+            const Vector2 pen{position.x + offset.x, position.y + offset.y};
+            const Rectangle dest{
+                pen.x + glyph.offsetX * scale - padding * scale,
+                pen.y + glyph.offsetY * scale - padding * scale,
+                (rec.width + 2.0f * padding) * scale,
+                (rec.height + 2.0f * padding) * scale};
+            const Rectangle source{
+                rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding};
+            DrawTexturePro(font.texture, source, dest, Vector2{0, 0}, 0.0f, tint);
+        }
+    }
+
+    void TextLayoutCache::Clear()
+    {
+        layouts.clear();
+        fonts.clear();
+    }
+
+    std::size_t TextLayoutCache::GetLayoutCount() const
+    {
+        return layouts.size();
+    }
+
+    const TextLayoutCache::Stats& TextLayoutCache::GetStats() const
+    {
+        return stats;
+    }
+} // namespace sage
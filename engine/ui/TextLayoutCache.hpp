@@ -0,0 +1,127 @@
+//
+// Word-wrap and glyph-placement cache for UI text. A layout is computed once per
+// (text, font, size, spacing, wrap width) and then drawn straight from its glyph
+// list, so neither measuring nor drawing walks raylib's per-character glyph
+// lookup (a linear scan of the font) after the first time. Wrapping, sizes and
+// positions reproduce MeasureTextEx / DrawTextEx and the word-wrap TextBox has
+// always used, so swapping it in does not move any text.
+//
+
+#pragma once
+
+#include "raylib.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sage
+{
+    struct TextLayout
+    {
+        struct Glyph
+        {
+            int index;        // Into the font's glyphs/recs
+            Vector2 position; // Pen position relative to the layout origin, as DrawTextEx has it
+        };
+
+        std::string text;          // After wrapping; lines separated by '\n'
+        std::vector<Glyph> glyphs; // Visible glyphs only (no spaces, tabs or newlines)
+        Vector2 size{};            // What MeasureTextEx reports for text
+        int lineCount = 0;
+    };
+
+    class TextLayoutCache
+    {
+      public:
+        static constexpr float NO_WRAP = -1.0f;
+        // raylib's default, which this game never changes with SetTextLineSpacing.
+        static constexpr int LINE_SPACING = 2;
+        static constexpr std::size_t MAX_LAYOUTS = 1024;
+
+        struct Stats
+        {
+            unsigned long hits = 0;
+            unsigned long misses = 0;
+        };
+
+      private:
+        // Per-font codepoint -> glyph table with the advances raylib would compute.
+        struct FontMetrics
+        {
+            unsigned int textureId = 0;
+            int glyphCount = 0;
+            std::array<int, 128> ascii{};
+            std::unordered_map<int, int> other;
+            int fallback = 0; // raylib substitutes '?' for codepoints the font lacks
+            std::vector<float> measureAdvance; // As MeasureTextEx sums them (unscaled)
+            std::vector<float> drawAdvance;    // As DrawTextEx steps the pen (unscaled)
+
+            [[nodiscard]] int GlyphIndex(int codepoint) const;
+        };
+
+        struct Key
+        {
+            std::size_t textHash;
+            std::uintptr_t font;
+            float fontSize;
+            float spacing;
+            float wrapWidth;
+
+            bool operator==(const Key& other) const = default;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            std::string source;
+            TextLayout layout;
+        };
+
+        std::unordered_map<std::uintptr_t, FontMetrics> fonts;
+        std::unordered_map<Key, Entry, KeyHash> layouts;
+        Stats stats;
+
+        const FontMetrics& metricsFor(const Font& font);
+        static std::string wrap(
+            const FontMetrics& metrics,
+            const Font& font,
+            std::string_view text,
+            float fontSize,
+            float spacing,
+            float width);
+        static void build(
+            const FontMetrics& metrics, const Font& font, float fontSize, float spacing, TextLayout& layout);
+        static Vector2 measure(
+            const FontMetrics& metrics, const Font& font, std::string_view text, float fontSize, float spacing);
+
+      public:
+        // Lays out text, wrapped the way TextBox's WORD_WRAP has always done it unless wrapWidth is
+        // NO_WRAP. The reference stays valid until the next call.
+        const TextLayout& Get(
+            const Font& font, const std::string& text, float fontSize, float spacing, float wrapWidth = NO_WRAP);
+        // MeasureTextEx through the font table, without storing a layout. For measuring the same
+        // text at many sizes (e.g. shrink-to-fit).
+        Vector2 Measure(const Font& font, std::string_view text, float fontSize, float spacing);
+        // DrawTextEx for a layout produced with the same font and size.
+        static void Draw(const Font& font, const TextLayout& layout, Vector2 position, float fontSize, Color tint);
+
+        void Clear();
+        [[nodiscard]] std::size_t GetLayoutCount() const;
+        [[nodiscard]] const Stats& GetStats() const;
+
+        static TextLayoutCache& GetInstance()
+        {
+            static TextLayoutCache instance;
+            return instance;
+        }
+    };
+} // namespace sage
@@ -19,6 +19,11 @@ namespace sage
     {
     }
 
+    void CellElement::MarkDirty()
+    {
+        if (parent) parent->MarkDirty();
+    }
+
     void CellElement::OnClick()
     {
         onMouseClicked.Publish();
@@ -49,6 +54,7 @@ namespace sage
 
     void CellElement::UpdateDimensions()
     {
+        MarkDirty();
         tex.width = parent->GetRec().width;
         tex.height = parent->GetRec().height;
     }
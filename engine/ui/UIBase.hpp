@@ -69,6 +69,9 @@ namespace sage
         virtual void OnIdleStop() {};
         virtual void OnHoverStart();
         virtual void OnHoverStop();
+        // Anything that changes how an element looks calls this. It reaches the owning Window,
+        // which re-renders its cached texture before the next draw.
+        virtual void MarkDirty() {};
         virtual ~UIElement() = default;
         UIElement() = default;
     };
@@ -94,6 +97,11 @@ namespace sage
         float dragDelayTime = 0.1;
 
         virtual void RetrieveInfo() {};
+        // Called every frame while the window is visible. Elements that draw from providers
+        // compare the current values with the ones they last drew and call MarkDirty if any
+        // changed; Draw2D then only reads what was stored here.
+        virtual void PollChanges() {};
+        void MarkDirty() override;
         virtual void OnClick();
         virtual void HoverUpdate();
         virtual void OnDragStart();
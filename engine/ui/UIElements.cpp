@@ -6,11 +6,11 @@
 
 #include "../GameUiEngine.hpp" // for Window/TableCell/TooltipWindow full defs
 #include "../Settings.hpp"
+#include "TextLayoutCache.hpp"
 
 #include "raylib.h"
 
 #include <algorithm>
-#include <sstream>
 
 namespace sage
 {
@@ -32,38 +32,11 @@ namespace sage
 
     float TextBox::WrappedHeight(const FontInfo& info, const std::string& text, float availableWidth)
     {
-        // Mirrors the WORD_WRAP branch of TextBox::UpdateDimensions so callers
-        // measure the same number of lines that UpdateDimensions will produce.
-        std::string wrappedText;
-        std::string currentLine;
-        std::istringstream words(text);
-        std::string word;
-        while (words >> word)
-        {
-            std::string testLine = currentLine;
-            if (!testLine.empty()) testLine += " ";
-            testLine += word;
-
-            const Vector2 lineSize =
-                MeasureTextEx(info.font, testLine.c_str(), info.fontSize, info.fontSpacing);
-
-            if (lineSize.x <= availableWidth)
-            {
-                currentLine = testLine;
-            }
-            else
-            {
-                if (!wrappedText.empty()) wrappedText += "\n";
-                wrappedText += currentLine;
-                currentLine = word;
-            }
-        }
-        if (!currentLine.empty())
-        {
-            if (!wrappedText.empty()) wrappedText += "\n";
-            wrappedText += currentLine;
-        }
-        return MeasureTextEx(info.font, wrappedText.c_str(), info.fontSize, info.fontSpacing).y;
+        // Same cache entry UpdateDimensions's WORD_WRAP path will look up, so the text box built
+        // from this measurement does not wrap the text a second time.
+        return TextLayoutCache::GetInstance()
+            .Get(info.font, text, info.fontSize, info.fontSpacing, availableWidth)
+            .size.y;
     }
 
     void TextBox::UpdateFontScaling()
@@ -75,57 +48,32 @@ namespace sage
 
     void TextBox::UpdateDimensions()
     {
+        MarkDirty();
         UpdateFontScaling();
+        auto& textLayout = TextLayoutCache::GetInstance();
         float availableWidth = parent->GetRec().width - (parent->padding.left + parent->padding.right);
-        Vector2 textSize = MeasureTextEx(fontInfo.font, content.c_str(), fontInfo.fontSize, fontInfo.fontSpacing);
 
         if (fontInfo.overflowBehaviour == OverflowBehaviour::SHRINK_TO_FIT)
         {
-
+            const auto measure = [this, &textLayout]() {
+                return textLayout.Measure(fontInfo.font, content, fontInfo.fontSize, fontInfo.fontSpacing);
+            };
+            Vector2 textSize = measure();
             while (textSize.x > availableWidth && fontInfo.fontSize > FontInfo::minFontSize)
             {
                 fontInfo.fontSize -= 1;
-                textSize = MeasureTextEx(fontInfo.font, content.c_str(), fontInfo.fontSize, fontInfo.fontSpacing);
+                textSize = measure();
             }
         }
         else if (fontInfo.overflowBehaviour == OverflowBehaviour::WORD_WRAP)
         {
-            std::string wrappedText;
-            std::string currentLine;
-            std::istringstream words(content);
-            std::string word;
-
-            while (words >> word)
-            {
-                std::string testLine = currentLine;
-                if (!testLine.empty()) testLine += " ";
-                testLine += word;
-
-                Vector2 lineSize =
-                    MeasureTextEx(fontInfo.font, testLine.c_str(), fontInfo.fontSize, fontInfo.fontSpacing);
-
-                if (lineSize.x <= availableWidth)
-                {
-                    currentLine = testLine;
-                }
-                else
-                {
-                    if (!wrappedText.empty()) wrappedText += "\n";
-                    wrappedText += currentLine;
-                    currentLine = word;
-                }
-            }
-
-            if (!currentLine.empty())
-            {
-                if (!wrappedText.empty()) wrappedText += "\n";
-                wrappedText += currentLine;
-            }
-
-            content = wrappedText;
+            const auto& wrapped =
+                textLayout.Get(fontInfo.font, content, fontInfo.fontSize, fontInfo.fontSpacing, availableWidth);
+            content = wrapped.text;
         }
 
-        textSize = MeasureTextEx(fontInfo.font, content.c_str(), fontInfo.fontSize, fontInfo.fontSpacing);
+        const Vector2 textSize =
+            textLayout.Get(fontInfo.font, content, fontInfo.fontSize, fontInfo.fontSpacing).size;
 
         float horiOffset = 0;
         float vertOffset = 0;
@@ -164,9 +112,10 @@ namespace sage
 
     void TextBox::Draw2D()
     {
+        const auto& layout =
+            TextLayoutCache::GetInstance().Get(fontInfo.font, content, fontInfo.fontSize, fontInfo.fontSpacing);
         BeginShaderMode(sdfShader);
-        DrawTextEx(
-            fontInfo.font, content.c_str(), Vector2{rec.x, rec.y}, fontInfo.fontSize, fontInfo.fontSpacing, BLACK);
+        TextLayoutCache::Draw(fontInfo.font, layout, Vector2{rec.x, rec.y}, fontInfo.fontSize, BLACK);
         EndShaderMode();
     }
 
@@ -218,16 +167,20 @@ namespace sage
     void ImageBox::SetHoverShader()
     {
         shader = ResourceManager::GetInstance().ShaderLoad(nullptr, "resources/shaders/custom/ui_hover.fs");
+        MarkDirty();
     }
 
     void ImageBox::SetGrayscale()
     {
         shader = ResourceManager::GetInstance().ShaderLoad(nullptr, "resources/shaders/glsl330/grayscale.fs");
+        MarkDirty();
     }
 
     void ImageBox::RemoveShader()
     {
+        if (!shader.has_value()) return;
         shader.reset();
+        MarkDirty();
     }
 
     void ImageBox::OnIdleStart()
@@ -473,6 +426,7 @@ namespace sage
 
     void ImageBox::UpdateDimensions()
     {
+        MarkDirty();
         if (overflowBehaviour == OverflowBehaviour::SHRINK_ROW_TO_FIT)
         {
             shrinkRowToFit();
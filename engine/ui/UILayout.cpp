@@ -57,6 +57,7 @@ namespace sage
 
     void Table::InitLayout()
     {
+        MarkDirty();
         const float availableHeight = rec.height - (padding.up + padding.down);
         const float startY = rec.y + padding.up;
 
@@ -97,6 +98,7 @@ namespace sage
 
     void TableRowGrid::InitLayout()
     {
+        MarkDirty();
         if (children.empty()) return;
 
         const unsigned int cols = children.size();
@@ -127,6 +129,7 @@ namespace sage
 
     void TableGrid::InitLayout()
     {
+        MarkDirty();
         if (children.empty()) return;
 
         const unsigned int cols = children[0]->children.size();
@@ -173,6 +176,7 @@ namespace sage
 
     void TableRow::InitLayout()
     {
+        MarkDirty();
         const float availableWidth = rec.width - (padding.left + padding.right);
         const float startX = rec.x + padding.left;
 
@@ -213,6 +217,7 @@ namespace sage
 
     void TableCell::InitLayout()
     {
+        MarkDirty();
         if (element.has_value())
         {
             if (element.value())
@@ -291,6 +296,24 @@ namespace sage
         return nullptr;
     }
 
+    void TableElement::MarkDirty()
+    {
+        if (parent) parent->MarkDirty();
+    }
+
+    void TableElement::PollChanges()
+    {
+        if (element.has_value())
+        {
+            if (element.value()) element.value()->PollChanges();
+            return;
+        }
+        for (const auto& child : children)
+        {
+            child->PollChanges();
+        }
+    }
+
     void TableElement::Update()
     {
         assert(!(element.has_value() && !children.empty()));
@@ -313,6 +336,9 @@ namespace sage
             if (!element.value()) return;
             if (element.value()->beingDragged) return;
             auto* el = element.value().get();
+            // Every window the mouse is not over gets this each frame; re-entering Idle would mark
+            // them all dirty.
+            if (std::holds_alternative<IdleState>(el->state)) return;
             transitionTo(*el, *el->engine, IdleState{});
         }
         else
@@ -326,6 +352,7 @@ namespace sage
 
     void TableElement::ScaleContents(Settings* _settings)
     {
+        MarkDirty();
         {
             auto posScaled = _settings->ScalePos({rec.x, rec.y});
 
@@ -373,6 +400,7 @@ namespace sage
         tex = _tex;
         textureStretchMode = _stretchMode;
         UpdateTextureDimensions();
+        MarkDirty();
     }
 
     void TableElement::UpdateTextureDimensions()
@@ -51,6 +51,8 @@ namespace sage
 
         virtual CellElement* GetCellUnderCursor();
         void OnHoverStop() override;
+        void MarkDirty() override;
+        virtual void PollChanges();
         virtual void Update();
         virtual void ScaleContents(Settings* _settings);
         virtual void SetPos(float x, float y);
@@ -79,6 +79,8 @@ namespace sage
         runExit(el.state, el, engine);
         el.state = std::move(newState);
         runEnter(el.state, el, engine);
+        // Hover highlights, shaders and the dragged-away gap are all drawn from the state.
+        el.MarkDirty();
     }
 
     void updateUIState(CellElement& el, GameUIEngine& engine, const InputSnapshot& in)
@@ -64,7 +64,7 @@ namespace sage
     // Calls state-specific draw (currently only Drag draws an overlay).
     void drawUIState(CellElement& el);
 
-    // Runs Exit on the current state, replaces it, runs Enter on the new state.
-    // Honours `el.stateLocked` (no-op while locked).
+    // Runs Exit on the current state, replaces it, runs Enter on the new state,
+    // then marks the element dirty. Honours `el.stateLocked` (no-op while locked).
     void transitionTo(CellElement& el, GameUIEngine& engine, UIState newState);
 } // namespace sage
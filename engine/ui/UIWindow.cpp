@@ -10,6 +10,7 @@
 
 #include "raylib.h"
 #include "raymath.h"
+#include "rlgl.h"
 
 #include <cassert>
 #include <cmath>
@@ -18,8 +19,66 @@
 
 namespace sage
 {
+    namespace
+    {
+        WindowCacheBackend defaultCacheBackend;
+    } // namespace
+
+    RenderTexture WindowCacheBackend::Load(const int width, const int height)
+    {
+        return LoadRenderTexture(width, height);
+    }
+
+    void WindowCacheBackend::Unload(const RenderTexture& cache)
+    {
+        UnloadRenderTexture(cache);
+    }
+
+    void WindowCacheBackend::Begin(const RenderTexture& cache, const Vector2 origin)
+    {
+        Camera2D camera{};
+        camera.target = origin;
+        camera.zoom = 1.0f;
+
+        BeginTextureMode(cache);
+        ClearBackground(BLANK);
+        // Colour blends as it would on screen, but alpha is accumulated instead of multiplied by
+        // itself. The cache then holds premultiplied colour, which Composite draws as such.
+        rlSetBlendFactorsSeparate(
+            RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+        BeginMode2D(camera);
+    }
+
+    void WindowCacheBackend::End()
+    {
+        EndMode2D();
+        EndBlendMode();
+        EndTextureMode();
+    }
+
+    void WindowCacheBackend::Composite(const RenderTexture& cache, const Vector2 origin)
+    {
+        const auto& texture = cache.texture;
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(
+            texture,
+            {0, 0, static_cast<float>(texture.width), static_cast<float>(-texture.height)},
+            origin,
+            WHITE);
+        EndBlendMode();
+    }
+
+    WindowCacheBackend* Window::cacheBackend = &defaultCacheBackend;
+
+    void Window::SetCacheBackend(WindowCacheBackend* backend)
+    {
+        cacheBackend = backend ? backend : &defaultCacheBackend;
+    }
+
     void Window::InitLayout()
     {
+        MarkDirty();
         if (children.empty()) return;
         const float availableWidth = rec.width - (padding.left + padding.right);
         const float availableHeight = rec.height - (padding.up + padding.down);
@@ -61,6 +120,7 @@ namespace sage
 
     void Window::SetPos(const float x, const float y)
     {
+        MarkDirty();
         const auto old = Vector2{rec.x, rec.y};
         rec = {x, y, rec.width, rec.height};
         ClampToScreen();
@@ -94,9 +154,67 @@ namespace sage
         }
     }
 
+    void Window::MarkDirty()
+    {
+        dirty = true;
+    }
+
+    bool Window::IsDirty() const
+    {
+        return dirty;
+    }
+
+    bool Window::cacheCurrent() const
+    {
+        return !dirty && cache.id != 0 && rec.x == cacheRec.x && rec.y == cacheRec.y &&
+               rec.width == cacheRec.width && rec.height == cacheRec.height;
+    }
+
+    Vector2 Window::cacheOrigin() const
+    {
+        // Whole pixels, so the cache lands texel-for-pixel and the tree keeps the sub-pixel
+        // offsets it would have had drawn straight to the screen.
+        return {std::floor(rec.x) - CACHE_MARGIN, std::floor(rec.y) - CACHE_MARGIN};
+    }
+
+    bool Window::RenderCache()
+    {
+        if (cacheCurrent()) return false;
+
+        const auto origin = cacheOrigin();
+        const int width = static_cast<int>(std::ceil(rec.x + rec.width) - origin.x) + CACHE_MARGIN;
+        const int height = static_cast<int>(std::ceil(rec.y + rec.height) - origin.y) + CACHE_MARGIN;
+        if (cache.id == 0 || cache.texture.width != width || cache.texture.height != height)
+        {
+            if (cache.id != 0) cacheBackend->Unload(cache);
+            cache = cacheBackend->Load(width, height);
+            if (cache.id == 0) return false; // Draw2D falls back to drawing the tree
+        }
+
+        // Cleared first, so anything marked dirty while drawing is drawn again next frame.
+        dirty = false;
+        cacheRec = rec;
+
+        cacheBackend->Begin(cache, origin);
+        TableElement::Draw2D();
+        cacheBackend->End();
+        return true;
+    }
+
+    void Window::Draw2D()
+    {
+        if (!cacheCurrent())
+        {
+            TableElement::Draw2D();
+            return;
+        }
+        cacheBackend->Composite(cache, cacheOrigin());
+    }
+
     void Window::ToggleHide()
     {
         hidden = !hidden;
+        MarkDirty();
         if (hidden)
         {
             onHide.Publish();
@@ -110,6 +228,7 @@ namespace sage
     void Window::Show()
     {
         hidden = false;
+        MarkDirty();
         onShow.Publish();
     }
 
@@ -156,6 +275,7 @@ namespace sage
     {
         if (markForRemoval) return;
 
+        MarkDirty();
         Reset();
 
         rec = {
@@ -207,6 +327,7 @@ namespace sage
     Window::~Window()
     {
         windowUpdateSub.UnSubscribe();
+        if (cache.id != 0) cacheBackend->Unload(cache);
     }
 
     Window::Window(Settings* _settings, const Padding _padding)
@@ -294,6 +415,7 @@ namespace sage
         // while it's visible. That's an accepted trade-off — tooltips are
         // transient and get recreated on the next hover at the new scale factor.
         if (markForRemoval) return;
+        MarkDirty();
         UpdateTextureDimensions();
     }
 
@@ -327,6 +449,7 @@ namespace sage
 
     void WindowDocked::ScaleContents(Settings* _settings)
     {
+        MarkDirty();
         Reset();
         setAlignment();
 
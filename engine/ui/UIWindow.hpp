@@ -1,7 +1,9 @@
 //
 // Top-level Window types: Window, TooltipWindow, WindowDocked, plus ErrorMessage.
 // A Window is a TableElement that owns a tree of layout/elements and provides
-// chrome (title bar drag, hide/show, scaling, removal).
+// chrome (title bar drag, hide/show, scaling, removal). Each window keeps its
+// tree rendered in a texture, and only redraws the tree after something in it
+// has called MarkDirty.
 //
 
 #pragma once
@@ -18,9 +20,36 @@ namespace sage
 {
     struct Settings;
 
+    // How a Window renders and composites its cache. The default uses raylib render textures; the
+    // headless tests substitute one that records calls instead.
+    class WindowCacheBackend
+    {
+      public:
+        // A cache with id 0 could not be created; the window then draws its tree directly.
+        virtual RenderTexture Load(int width, int height);
+        virtual void Unload(const RenderTexture& cache);
+        // What is drawn between Begin and End lands in cache, with origin at its top left.
+        virtual void Begin(const RenderTexture& cache, Vector2 origin);
+        virtual void End();
+        virtual void Composite(const RenderTexture& cache, Vector2 origin);
+        virtual ~WindowCacheBackend() = default;
+    };
+
     class Window : public TableElement
     {
+        // Pixels kept around the window in its cache, for elements that draw a little past their
+        // cell (highlight outlines, portrait borders).
+        static constexpr int CACHE_MARGIN = 32;
+
+        static WindowCacheBackend* cacheBackend;
+
+        RenderTexture cache{};
+        Rectangle cacheRec{}; // rec the cache was rendered at
+        bool dirty = true;
+
         void ScaleContents(Settings* _settings) override;
+        [[nodiscard]] bool cacheCurrent() const;
+        [[nodiscard]] Vector2 cacheOrigin() const;
 
       protected:
         bool hidden = false;
@@ -33,7 +62,17 @@ namespace sage
         bool mouseHover = false;
         Settings* settings{}; // for screen width/height
 
+        // nullptr restores the default. Windows must not outlive the backend that loaded their caches.
+        static void SetCacheBackend(WindowCacheBackend* backend);
+
         void SetPos(float x, float y) override;
+        void MarkDirty() override;
+        [[nodiscard]] bool IsDirty() const;
+        // Re-renders the cache if the window changed since it was last rendered. Must be called
+        // outside any texture mode. Returns whether it rendered.
+        bool RenderCache();
+        // Draws the cache, or the tree directly if there is no up-to-date cache.
+        void Draw2D() override;
         void FinalizeLayout() override;
         void OnWindowUpdate(Vector2 prev, Vector2 current);
         void ClampToScreen();
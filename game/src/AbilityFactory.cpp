@@ -74,8 +74,8 @@ namespace lq
         auto& data = registry->get<AbilityData>(out);
         ability.self = out;
         ability.caster = caster;
-        ability.cooldownTimer.SetMaxTime(data.base.cooldownDuration);
-        ability.castTimer.SetMaxTime(data.base.castTime);
+        ability.cooldownDuration = data.base.cooldownDuration;
+        ability.castTime = data.base.castTime;
         AttachVisualFX(sys, out);
         if (data.base.HasOptionalBehaviour(AbilityBehaviourOptional::INDICATOR))
         {
@@ -37,7 +37,7 @@ namespace lq
 
         audioManager = std::make_unique<sage::AudioManager>();
 
-        sage::serializer::LoadAssetBinFile(registry.get(), "resources/assets.bin");
+        sage::serializer::LoadAssetBinFile("resources/assets.bin");
         maploader::LoadMap(registry.get(), "resources/dungeon-map.bin");
         // serializer::LoadMap(registry.get(), "resources/cave.bin");
 
@@ -132,6 +132,7 @@ namespace lq
                     exitWindowRequested = false;
             }
 
+            sage::ResourceManager::GetInstance().PumpUploads();
             scene->Update();
             cleanupSystem->Execute();
             draw();
@@ -141,6 +142,7 @@ namespace lq
 
     void Application::draw()
     {
+        scene->DrawOffscreen();
 
         BeginTextureMode(renderTexture);
         ClearBackground(BLANK);
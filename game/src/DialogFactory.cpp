@@ -8,360 +8,117 @@
 #include "components/QuestComponents.hpp"
 #include "engine/components/sgTransform.hpp"
 #include "NpcManager.hpp"
-#include "ParsingHelpers.hpp"
 #include "QuestManager.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptLinker.hpp"
 #include "Systems.hpp"
+#include "TextToRealFunction.hpp"
 #include "engine/systems/RenderSystem.hpp"
 
 #include "raylib.h"
 
-#include <filesystem>
-#include <fstream>
-#include <iostream>
-#include <regex>
-#include <sstream>
-#include <tuple>
-#include <vector>
-
-namespace fs = std::filesystem;
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
 
 namespace lq
 {
-    using namespace parsing;
-
-    static std::unordered_map<std::string, std::string> extractVariables(const std::string& content)
+    namespace
     {
-        std::unordered_map<std::string, std::string> variables;
-        std::istringstream stream(content);
-        std::string line;
-        bool inVariableBlock = false;
-
-        while (std::getline(stream, line, '\n'))
+        template <typename T, typename... Args>
+        std::unique_ptr<T> makeOption(std::optional<std::function<bool()>> condition, Args&&... args)
         {
-            line = trim(line);
-
-            if (line == "<variables>")
-            {
-                inVariableBlock = true;
-                continue;
-            }
-
-            if (line == "</variables>")
-            {
-                inVariableBlock = false;
-                continue;
-            }
-
-            if (inVariableBlock)
+            if (condition.has_value())
             {
-                size_t colonPos = line.find(':');
-                if (colonPos != std::string::npos)
-                {
-                    std::string key = trim(line.substr(0, colonPos));
-                    std::string value = trim(line.substr(colonPos + 1));
-                    variables[key] = value;
-                }
+                return std::make_unique<T>(std::forward<Args>(args)..., std::move(condition.value()));
             }
+            return std::make_unique<T>(std::forward<Args>(args)...);
         }
+    } // namespace
 
-        return variables;
-    }
-
-    static std::string substituteVariablesInText(const std::string& content)
-    {
-        auto variables = extractVariables(content);
-        std::string result = content;
-
-        for (const auto& [varName, value] : variables)
-        {
-            result = std::regex_replace(result, std::regex(R"(\$)" + varName), value);
-        }
-
-        return result;
-    }
-
-    void DialogFactory::parseNode(
+    void DialogFactory::buildNode(
         dialog::Conversation* conversation,
-        const std::string& nodeName,
-        const std::string& content,
-        const std::string& dialogOptions) const
+        script::ScriptLinker& linker,
+        const script::Conversation& script,
+        const script::Node& nodeScript) const
     {
+        const auto& module = linker.GetModule();
         auto node = std::make_unique<dialog::ConversationNode>(conversation);
-        node->title = nodeName;
-        node->content = content;
+        node->title = module.String(nodeScript.title);
+        node->content = module.String(nodeScript.content);
 
-        std::optional<std::function<bool()>> condition;
-
-        std::stringstream optionStream(dialogOptions);
-        std::string line;
-
-        while (std::getline(optionStream, line, '\n'))
+        for (const auto& optionScript : nodeScript.options)
         {
-            if (line.starts_with("if"))
+            std::optional<std::function<bool()>> condition;
+            if (optionScript.condition != script::NONE)
             {
-                assert(!condition.has_value()); // "if blocks" must be closed with end. No nesting allowed (yet).
-
-                condition = GetConditionalStatement(line, registry, sys);
+                condition = linker.LinkCondition(optionScript.condition);
             }
-            else if (line == "end")
+
+            std::unique_ptr<dialog::Option> option;
+            if (!optionScript.action.has_value())
             {
-                assert(condition.has_value()); // ensures that 'end' has an accompanying 'if'
-                condition.reset();
+                option = makeOption<dialog::Option>(std::move(condition), node.get());
             }
-            else if (line.starts_with("[["))
+            else
             {
-                std::stringstream ss(line.substr(2)); // 2 == [[
-                std::string word;
-                std::vector<std::string> option;
-
-                while (std::getline(ss, word, '|'))
-                {
-                    option.push_back(parsing::trim(word));
-                }
-
-                auto& lastWord = option.at(option.size() - 1);
-                lastWord = lastWord.substr(0, lastWord.find_first_of("]]"));
-
-                if (option.size() == 2)
-                {
-                    std::unique_ptr<dialog::Option> baseOption;
-                    if (condition.has_value())
-                    {
-                        baseOption = std::make_unique<dialog::Option>(node.get(), condition.value());
-                    }
-                    else
-                    {
-                        baseOption = std::make_unique<dialog::Option>(node.get());
-                    }
-                    baseOption->description = option.at(0);
-                    if (const auto& next = option.at(1); !next.empty() && next != "exit")
-                    {
-                        baseOption->nextNode = next;
-                    }
-                    node->options.push_back(std::move(baseOption));
-                }
-                else if (option.size() == 3) // "[[" with function
-                {
-                    const auto& func = getFunctionNameAndArgs(option.at(0));
-                    if (func.name == "complete_quest_task")
-                    {
-                        assert(!func.params.empty());
-                        auto questId = sys->questManager->GetQuest(func.params);
-                        std::unique_ptr<dialog::QuestOption> questOption;
-                        if (condition.has_value())
-                        {
-                            questOption =
-                                std::make_unique<dialog::QuestOption>(node.get(), questId, condition.value());
-                        }
-                        else
-                        {
-                            questOption = std::make_unique<dialog::QuestOption>(node.get(), questId);
-                        }
-                        questOption->description = option.at(1);
-                        const auto& next = option.at(2);
-                        if (!next.empty() && next != "exit")
-                        {
-                            questOption->nextNode = next;
-                        }
-                        node->options.push_back(std::move(questOption));
-                    }
-                    else if (func.name == "start_quest")
-                    {
-                        assert(!func.params.empty());
-                        auto questId = sys->questManager->GetQuest(func.params);
-                        std::unique_ptr<dialog::QuestStartOption> questStartOption;
-                        if (condition.has_value())
-                        {
-                            questStartOption =
-                                std::make_unique<dialog::QuestStartOption>(node.get(), questId, condition.value());
-                        }
-                        else
-                        {
-                            questStartOption = std::make_unique<dialog::QuestStartOption>(node.get(), questId);
-                        }
-                        questStartOption->description = option.at(1);
-                        const auto& next = option.at(2);
-                        if (!next.empty() && next != "exit")
-                        {
-                            questStartOption->nextNode = next;
-                        }
-                        node->options.push_back(std::move(questStartOption));
-                    }
-                    else if (func.name == "complete_quest")
-                    {
-                        assert(!func.params.empty());
-                        auto questId = sys->questManager->GetQuest(func.params);
-                        std::unique_ptr<dialog::QuestFinishOption> questFinishOption;
-                        if (condition.has_value())
-                        {
-                            questFinishOption = std::make_unique<dialog::QuestFinishOption>(
-                                node.get(), questId, condition.value());
-                        }
-                        else
-                        {
-                            questFinishOption = std::make_unique<dialog::QuestFinishOption>(node.get(), questId);
-                        }
+                auto action = parsing::BindOptionAction(linker, optionScript.action.value(), conversation->owner);
+                if (!action) continue;
+                option = makeOption<dialog::ActionOption>(std::move(condition), node.get(), std::move(action));
+            }
 
-                        questFinishOption->description = option.at(1);
-                        const auto& next = option.at(2);
-                        if (!next.empty() && next != "exit")
-                        {
-                            questFinishOption->nextNode = next;
-                        }
-                        node->options.push_back(std::move(questFinishOption));
-                    }
-                    else
-                    {
-                        assert(0);
-                    }
-                }
+            option->description = module.String(optionScript.description);
+            if (optionScript.next != script::NONE)
+            {
+                option->nextNode = module.String(script.nodes[optionScript.next].title);
             }
+            node->options.push_back(std::move(option));
         }
         conversation->AddNode(std::move(node));
     }
 
-    void DialogFactory::InitDialogFromDirectory()
+    void DialogFactory::InitDialog(script::ScriptLinker& linker)
     {
-        fs::path inputPath("resources/dialog");
-        if (!fs::is_directory(inputPath))
-        {
-            std::cout << "ERROR: DialogFactory -> Directory does not exist or path invalid." << std::endl;
-            exit(1);
-        }
-
-        for (const auto& entry : fs::directory_iterator(inputPath))
+        const auto& module = linker.GetModule();
+        for (const auto& script : module.conversations)
         {
-            if (entry.path().extension() != ".txt") continue;
-            std::ifstream infile(entry.path());
-
-            if (!infile)
+            const auto& owner = module.String(script.owner);
+            const auto entity = sys->engine.renderSystem->FindRenderable<DialogComponent>(owner);
+            if (entity == entt::null)
             {
-                std::cerr << "Could not open file: " << entry.path() << std::endl;
+                linker.Error(std::format("dialog: no renderable with dialog named '{}'", owner));
                 continue;
             }
-
-            std::ostringstream fileContent;
-            fileContent << infile.rdbuf();
-            std::string processedContent = trimWhiteSpaceFromFile(
-                substituteVariablesInText(removeCommentsFromFile(normalizeLineEndings(fileContent.str()))));
-            std::stringstream contentStream(processedContent);
-
-            entt::entity entity = entt::null;
-            DialogComponent* dialogComponent = nullptr;
-
-            std::string currentNodeName;
-            std::string currentNodeSpeakerText;
-            std::string currentNodeOptions;
-            std::string line;
-
-            while (std::getline(contentStream, line))
+            auto& dialogComponent = registry->get<DialogComponent>(entity);
+            dialogComponent.conversation = std::make_unique<dialog::Conversation>(registry, sys, entity);
+            if (script.speaker != script::NONE)
             {
-                if (line == "<meta>")
-                {
-                    // Reset for a new dialog
-                    entity = entt::null;
-                    dialogComponent = nullptr;
-                    currentNodeName.clear();
-                    currentNodeSpeakerText.clear();
-                    currentNodeOptions.clear();
-                }
-                else if (line.starts_with("owner:"))
-                {
-                    auto owner = line.substr(std::string("owner:").size());
-                    owner = trim(owner);
+                dialogComponent.conversation->speaker = module.String(script.speaker);
+            }
 
-                    entity = sys->engine.renderSystem->FindRenderable<DialogComponent>(owner);
-                    assert(entity != entt::null);
-                    // if (!registry->any_of<DialogComponent>(entity))
-                    // {
-                    //     registry->emplace<DialogComponent>(entity);
-                    // }
-                    dialogComponent = &registry->get<DialogComponent>(entity);
-                    dialogComponent->conversation = std::make_unique<dialog::Conversation>(registry, sys, entity);
-                }
-                else if (line.starts_with("speaker_name:"))
-                {
-                    assert(dialogComponent);
-                    auto str_size = std::string("speaker_name:").size();
-                    auto speaker = line.substr(str_size);
-                    speaker = trim(speaker);
-                    dialogComponent->conversation->speaker = speaker;
-                }
-                else if (line.starts_with("conversation_pos:"))
-                {
-                    assert(dialogComponent);
-                    if (entity != entt::null && registry->all_of<sage::sgTransform>(entity))
-                    {
-                        auto& transform = registry->get<sage::sgTransform>(entity);
-                        auto str_size = std::string("conversation_pos:").size();
-                        std::istringstream iss(line.substr(str_size));
-                        Vector3 filePos{0};
-                        iss >> filePos.x >> filePos.y >> filePos.z;
-                        dialogComponent->conversationPos = Vector3Add(
-                            transform.GetWorldPos(),
-                            Vector3Multiply(
-                                transform.forward(), filePos)); // This doesn't account for movable NPCs at all
-                    }
-                }
-                else if (line.starts_with("camera_pos:"))
-                {
-                    assert(dialogComponent);
-                    if (entity != entt::null && registry->all_of<sage::sgTransform>(entity))
-                    {
-                        auto& transform = registry->get<sage::sgTransform>(entity);
-                        auto str_size = std::string("camera_pos:").size();
-                        std::istringstream iss(line.substr(str_size));
-                        Vector3 filePos{0};
-                        iss >> filePos.x >> filePos.y >> filePos.z;
-                        dialogComponent->cameraPos = filePos;
-                    }
-                }
-                else if (line == "<node>")
-                {
-                    currentNodeName.clear();
-                    currentNodeSpeakerText.clear();
-                    currentNodeOptions.clear();
-                }
-                else if (line.starts_with("title:"))
-                {
-                    currentNodeName = line.substr(6);
-                    currentNodeName = trim(currentNodeName);
-                }
-                else if (line == "---")
-                {
-                    std::string contentLine;
-                    currentNodeSpeakerText.clear();
-                    while (std::getline(contentStream, contentLine) && contentLine != "---")
-                    {
-                        currentNodeSpeakerText += contentLine + "\n";
-                    }
-                }
-                else if (line.starts_with("if"))
-                {
-                    currentNodeOptions += (trim(line) + "\n");
-                }
-                else if (line == "end")
-                {
-                    currentNodeOptions += "end\n";
-                }
-                else if (line.starts_with("[["))
+            if (registry->all_of<sage::sgTransform>(entity))
+            {
+                const auto& transform = registry->get<sage::sgTransform>(entity);
+                if (script.conversationPos.has_value())
                 {
-                    currentNodeOptions += (trim(line) + "\n");
+                    dialogComponent.conversationPos = Vector3Add(
+                        transform.GetWorldPos(),
+                        Vector3Multiply(
+                            transform.forward(),
+                            script.conversationPos.value())); // This doesn't account for movable NPCs at all
                 }
-                else if (line == "</node>")
+                if (script.cameraPos.has_value())
                 {
-                    assert(dialogComponent);
-                    // Finalize and parse the node
-                    if (!currentNodeName.empty())
-                    {
-                        parseNode(
-                            dialogComponent->conversation.get(),
-                            currentNodeName,
-                            currentNodeSpeakerText,
-                            currentNodeOptions);
-                    }
+                    dialogComponent.cameraPos = script.cameraPos.value();
                 }
             }
+
+            for (const auto& node : script.nodes)
+            {
+                buildNode(dialogComponent.conversation.get(), linker, script, node);
+            }
         }
     }
 
@@ -16,19 +16,26 @@ namespace lq
         class Conversation;
     } // namespace dialog
 
+    namespace script
+    {
+        struct Conversation;
+        struct Node;
+        class ScriptLinker;
+    } // namespace script
+
     class DialogFactory
     {
         entt::registry* registry;
         Systems* sys;
 
-        void parseNode(
+        void buildNode(
             dialog::Conversation* conversation,
-            const std::string& nodeName,
-            const std::string& content,
-            const std::string& dialogOptions) const;
+            script::ScriptLinker& linker,
+            const script::Conversation& script,
+            const script::Node& nodeScript) const;
 
       public:
-        void InitDialogFromDirectory();
+        void InitDialog(script::ScriptLinker& linker);
 
         DialogFactory(entt::registry* _registry, Systems* _sys);
     };
@@ -158,7 +158,7 @@ namespace lq
         collideable.SetCollisionLayer(
             lq::collision_layers::Npc, lq::collision_masks::ForLayer(lq::collision_layers::Npc));
         sys->engine.transformSystem->SetRotation(id, rotation);
-        sys->engine.navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, true, id);
+        sys->engine.navigationGridSystem->StampActor(id, collideable.worldBoundingBox);
 
         registry->emplace<DialogComponent>(id);
 
@@ -205,7 +205,7 @@ namespace lq
         collideable.SetCollisionLayer(
             lq::collision_layers::Npc, lq::collision_masks::ForLayer(lq::collision_layers::Npc));
         sys->engine.transformSystem->SetRotation(id, rotation);
-        sys->engine.navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, true, id);
+        sys->engine.navigationGridSystem->StampActor(id, collideable.worldBoundingBox);
 
         registry->emplace<DialogComponent>(id);
 
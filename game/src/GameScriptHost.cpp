@@ -0,0 +1,156 @@
+//
+// Game script host implementation. See GameScriptHost.hpp.
+//
+
+#include "GameScriptHost.hpp"
+
+#include "components/QuestComponents.hpp"
+#include "QuestManager.hpp"
+#include "Systems.hpp"
+#include "systems/DoorSystem.hpp"
+#include "systems/PartySystem.hpp"
+
+#include "engine/AudioManager.hpp"
+#include "engine/components/Collideable.hpp"
+#include "engine/components/DoorBehaviorComponent.hpp"
+#include "engine/components/Renderable.hpp"
+#include "engine/FullscreenTextOverlayManager.hpp"
+#include "engine/Settings.hpp"
+#include "engine/systems/RenderSystem.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace lq
+{
+    entt::entity GameScriptHost::FindRenderable(const std::string& name)
+    {
+        return sys->engine.renderSystem->FindRenderable(name);
+    }
+
+    entt::entity GameScriptHost::FindDoor(const std::string& name)
+    {
+        return sys->engine.renderSystem->FindRenderable<sage::DoorBehaviorComponent>(name);
+    }
+
+    entt::entity GameScriptHost::FindQuest(const std::string& key)
+    {
+        return sys->questManager->HasQuest(key) ? sys->questManager->GetQuest(key) : entt::null;
+    }
+
+    bool GameScriptHost::IsQuestTask(const entt::entity entity)
+    {
+        return registry->any_of<QuestTaskComponent>(entity);
+    }
+
+    bool GameScriptHost::QuestComplete(const entt::entity quest)
+    {
+        return registry->get<Quest>(quest).IsComplete();
+    }
+
+    bool GameScriptHost::QuestInProgress(const entt::entity quest)
+    {
+        const auto& component = registry->get<Quest>(quest);
+        return component.HasStarted() && !component.IsComplete();
+    }
+
+    bool GameScriptHost::QuestAllTasksComplete(const entt::entity quest)
+    {
+        const auto& component = registry->get<Quest>(quest);
+        return component.HasStarted() && component.AllTasksComplete();
+    }
+
+    bool GameScriptHost::QuestTaskComplete(const entt::entity task)
+    {
+        return registry->get<QuestTaskComponent>(task).IsComplete();
+    }
+
+    bool GameScriptHost::HasItem(const std::string& item)
+    {
+        return sys->partySystem->CheckPartyHasItem(item);
+    }
+
+    void GameScriptHost::OpenDoor(const entt::entity door)
+    {
+        sys->doorSystem->UnlockAndOpenDoor(door);
+    }
+
+    void GameScriptHost::JoinParty(const entt::entity npc)
+    {
+        sys->partySystem->NPCToMember(npc);
+    }
+
+    void GameScriptHost::RemoveItem(const std::string& item)
+    {
+        sys->partySystem->RemoveItemFromParty(item);
+    }
+
+    void GameScriptHost::GiveItem(const std::string& item)
+    {
+        sys->partySystem->GiveItemToSelected(item);
+    }
+
+    void GameScriptHost::PlaySFX(const std::string& name)
+    {
+        sys->engine.audioManager->PlaySFX(name);
+    }
+
+    void GameScriptHost::PlayMusic(const std::string& name)
+    {
+        sys->engine.audioManager->PlayMusic(name);
+    }
+
+    void GameScriptHost::DisableWorldItem(const entt::entity item)
+    {
+        if (registry->any_of<sage::Renderable>(item))
+        {
+            registry->get<sage::Renderable>(item).Disable();
+        }
+        if (registry->any_of<sage::Collideable>(item))
+        {
+            registry->get<sage::Collideable>(item).active = false;
+        }
+    }
+
+    void GameScriptHost::EndGame()
+    {
+        std::vector<std::pair<std::string, float>> text;
+        text.emplace_back("Our bold heroes step forward, out of the gate.", 4.0f);
+        text.emplace_back("What will await our valiant heroes?", 4.0f);
+        text.emplace_back("Find out soon.", 4.0f);
+        text.emplace_back("Thanks for playing!", 4.0f);
+        sys->engine.fullscreenTextOverlayFactory->SetOverlay(text, 0.5f, 1.0f);
+        sys->engine.fullscreenTextOverlayFactory->onOverlayEnd.Subscribe(
+            [this] { sys->engine.settings->ExitProgram(); });
+    }
+
+    void GameScriptHost::StartQuest(const entt::entity quest)
+    {
+        auto& component = registry->get<Quest>(quest);
+        if (!component.HasStarted())
+        {
+            component.StartQuest();
+        }
+    }
+
+    void GameScriptHost::CompleteQuest(const entt::entity quest)
+    {
+        auto& component = registry->get<Quest>(quest);
+        if (component.HasStarted())
+        {
+            component.CompleteQuest();
+        }
+    }
+
+    void GameScriptHost::CompleteQuestTask(const entt::entity quest, const entt::entity owner)
+    {
+        if (registry->get<Quest>(quest).HasStarted())
+        {
+            registry->get<QuestTaskComponent>(owner).MarkComplete();
+        }
+    }
+
+    GameScriptHost::GameScriptHost(entt::registry* _registry, Systems* _sys) : registry(_registry), sys(_sys)
+    {
+    }
+} // namespace lq
@@ -0,0 +1,50 @@
+//
+// The game side of ScriptHost: script names, predicates, commands and option actions answered by the
+// scene's registry and systems.
+//
+
+#pragma once
+
+#include "ScriptHost.hpp"
+
+#include "entt/entt.hpp"
+
+#include <string>
+
+namespace lq
+{
+    class Systems;
+
+    class GameScriptHost final : public script::ScriptHost
+    {
+        entt::registry* registry;
+        Systems* sys;
+
+      public:
+        [[nodiscard]] entt::entity FindRenderable(const std::string& name) override;
+        [[nodiscard]] entt::entity FindDoor(const std::string& name) override;
+        [[nodiscard]] entt::entity FindQuest(const std::string& key) override;
+        [[nodiscard]] bool IsQuestTask(entt::entity entity) override;
+
+        [[nodiscard]] bool QuestComplete(entt::entity quest) override;
+        [[nodiscard]] bool QuestInProgress(entt::entity quest) override;
+        [[nodiscard]] bool QuestAllTasksComplete(entt::entity quest) override;
+        [[nodiscard]] bool QuestTaskComplete(entt::entity task) override;
+        [[nodiscard]] bool HasItem(const std::string& item) override;
+
+        void OpenDoor(entt::entity door) override;
+        void JoinParty(entt::entity npc) override;
+        void RemoveItem(const std::string& item) override;
+        void GiveItem(const std::string& item) override;
+        void PlaySFX(const std::string& name) override;
+        void PlayMusic(const std::string& name) override;
+        void DisableWorldItem(entt::entity item) override;
+        void EndGame() override;
+
+        void StartQuest(entt::entity quest) override;
+        void CompleteQuest(entt::entity quest) override;
+        void CompleteQuestTask(entt::entity quest, entt::entity owner) override;
+
+        GameScriptHost(entt::registry* _registry, Systems* _sys);
+    };
+} // namespace lq
@@ -4,165 +4,66 @@
 
 #include "QuestManager.hpp"
 
+#include "components/DialogComponent.hpp"
+#include "components/ItemComponent.hpp"
 #include "components/QuestComponents.hpp"
 #include "engine/GameUiEngine.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptLinker.hpp"
 #include "TextToRealFunction.hpp"
 #include "ui/GameUI.hpp"
 
 #include <cassert>
-#include <filesystem>
 #include <format>
-#include <fstream>
 #include <functional>
-#include <sstream>
-
-namespace fs = std::filesystem;
-static constexpr auto QUEST_PATH = "resources/quests";
 
 namespace lq
 {
     using namespace parsing;
 
-    void QuestManager::InitQuestsFromDirectory()
+    void QuestManager::InitQuests(script::ScriptLinker& linker)
     {
-        for (const fs::path path{QUEST_PATH}; const auto& entry : fs::directory_iterator(path))
+        // TODO: Must make sure renderable and item systems are initialised before this
+        const auto& module = linker.GetModule();
+        for (const auto& script : module.quests)
         {
-            if (entry.path().extension() == ".txt")
-            {
-                // TODO: Must make sure renderable and item systems are initialised before this
-                std::string fileName = entry.path().filename().string();
-                std::string questName = sage::StripPath(fileName);
-                std::ostringstream fileContent;
+            const auto& questName = module.String(script.key);
+            auto& quest = registry->get<Quest>(createQuest(questName));
+            if (script.title != script::NONE) quest.journalTitle = module.String(script.title);
+            if (script.description != script::NONE) quest.journalDescription = module.String(script.description);
 
-                // Scoped to prevent accidentally using 'file' instead of 'stringstream'
+            for (const auto& taskScript : script.tasks)
+            {
+                const auto& target = module.String(taskScript.target);
+                const auto entity = linker.FindRenderable(taskScript.target, questName);
+                if (entity == entt::null) continue;
+                if (taskScript.kind == script::TaskKind::Dialog && !registry->any_of<DialogComponent>(entity))
                 {
-                    std::ifstream file{std::format("{}/{}", QUEST_PATH, fileName)};
-                    if (!file.is_open()) return;
-                    fileContent << file.rdbuf();
+                    linker.Error(std::format("{}: '{}' has no dialog", questName, target));
+                    continue;
+                }
+                if (taskScript.kind == script::TaskKind::Item && !registry->any_of<ItemComponent>(entity))
+                {
+                    linker.Error(std::format("{}: '{}' is not an item", questName, target));
+                    continue;
                 }
 
-                auto& quest = registry->get<Quest>(createQuest(questName));
-                std::string processed =
-                    removeCommentsFromFile(trimWhiteSpaceFromFile(normalizeLineEndings(fileContent.str())));
-
-                std::stringstream ss(processed);
-                std::string buff;
-
-                while (std::getline(ss, buff, '\n'))
+                auto& task = registry->emplace<QuestTaskComponent>(entity, questName);
+                quest.AddTask(entity);
+                for (const auto& call : taskScript.onCompleted)
                 {
-                    if (buff.find("<meta>") != std::string::npos)
-                    {
-                        std::string metaLine;
-                        while (std::getline(ss, metaLine) && metaLine.find("</meta>") == std::string::npos)
-                        {
-                            if (metaLine.find("title: ") != std::string::npos)
-                            {
-                                auto sub = metaLine.substr(std::string("title: ").size());
-                                quest.journalTitle = sub;
-                            }
-                            else if (metaLine.find("giver: ") != std::string::npos)
-                            {
-                                auto sub = metaLine.substr(std::string("giver: ").size());
-                                // Do something here
-                            }
-                        }
-                    }
-                    else if (buff.find("<description>") != std::string::npos)
-                    {
-                        std::string description;
-                        std::string descriptionLine;
-                        while (std::getline(ss, descriptionLine) &&
-                               descriptionLine.find("</description>") == std::string::npos)
-                        {
-                            description += descriptionLine + "\n";
-                        }
-                        quest.journalDescription = description;
-                    }
-                    else if (buff.find("<tasks>") != std::string::npos)
-                    {
-                        std::string taskLine;
-                        while (std::getline(ss, taskLine) && taskLine.find("</tasks>") == std::string::npos)
-                        {
-                            std::string sub;
-                            entt::entity entity;
-
-                            auto commandStartPos = taskLine.find_first_of(';');
-
-                            if (taskLine.find("dialog: ") != std::string::npos)
-                            {
-                                auto start = std::string("dialog: ").size();
-                                if (commandStartPos != std::string::npos)
-                                {
-                                    sub = taskLine.substr(start, commandStartPos - start);
-                                }
-                                else
-                                {
-                                    sub = taskLine.substr(start);
-                                }
-                                entity = sys->engine.renderSystem->FindRenderable(sub);
-                                assert(entity != entt::null);
-                                assert(registry->any_of<DialogComponent>(entity));
-                            }
-                            else if (taskLine.find("item: ") != std::string::npos)
-                            {
-                                auto start = std::string("item: ").size();
-                                if (commandStartPos != std::string::npos)
-                                {
-                                    sub = taskLine.substr(start, commandStartPos - start);
-                                }
-                                else
-                                {
-                                    sub = taskLine.substr(start);
-                                }
-                                entity = sys->engine.renderSystem->FindRenderable(sub);
-                                assert(entity != entt::null);
-                                assert(registry->any_of<ItemComponent>(entity));
-                            }
-
-                            auto& task = registry->emplace<QuestTaskComponent>(entity, questName);
-                            quest.AddTask(entity);
-
-                            if (commandStartPos != std::string::npos)
-                            {
-                                std::string commandLine = taskLine.substr(commandStartPos + 1);
-                                commandLine.erase(
-                                    std::ranges::remove_if(commandLine, isspace).begin(), commandLine.end());
-                                std::stringstream commandStream(commandLine);
-                                std::string command;
-
-                                while (std::getline(commandStream, command, ';'))
-                                {
-                                    auto func = getFunctionNameAndArgs(command);
-                                    BindFunctionToEvent<sage::Event<QuestTaskComponent*>, QuestTaskComponent*>(
-                                        registry, sys, func, &task.onCompleted);
-                                }
-                            }
-                        }
-                    }
-                    else if (buff.find("<onStart>") != std::string::npos)
-                    {
-                        std::string functionLine;
-                        while (std::getline(ss, functionLine) &&
-                               functionLine.find("</onStart>") == std::string::npos)
-                        {
-                            auto func = getFunctionNameAndArgs(functionLine);
-                            BindFunctionToEvent<sage::Event<entt::entity>, entt::entity>(
-                                registry, sys, func, &quest.onStart);
-                        }
-                    }
-                    else if (buff.find("<onComplete>") != std::string::npos)
-                    {
-                        std::string functionLine;
-                        while (std::getline(ss, functionLine) &&
-                               functionLine.find("</onComplete>") == std::string::npos)
-                        {
-                            auto func = getFunctionNameAndArgs(functionLine);
-                            BindFunctionToEvent<sage::Event<entt::entity>, entt::entity>(
-                                registry, sys, func, &quest.onCompleted);
-                        }
-                    }
+                    BindFunctionToEvent<sage::Event<QuestTaskComponent*>, QuestTaskComponent*>(
+                        linker, call, &task.onCompleted);
                 }
             }
+            for (const auto& call : script.onStart)
+            {
+                BindFunctionToEvent<sage::Event<entt::entity>, entt::entity>(linker, call, &quest.onStart);
+            }
+            for (const auto& call : script.onComplete)
+            {
+                BindFunctionToEvent<sage::Event<entt::entity>, entt::entity>(linker, call, &quest.onCompleted);
+            }
         }
     }
 
@@ -216,6 +117,11 @@ namespace lq
         return out;
     }
 
+    bool QuestManager::HasQuest(const std::string& key) const
+    {
+        return map.contains(key);
+    }
+
     entt::entity QuestManager::GetQuest(const std::string& key) const
     {
         assert(map.contains(key));
@@ -15,6 +15,10 @@ namespace lq
 {
     class Systems;
     class Quest;
+    namespace script
+    {
+        class ScriptLinker;
+    } // namespace script
 
     class QuestManager
     {
@@ -28,9 +32,10 @@ namespace lq
 
       public:
         sage::Event<entt::entity> onQuestUpdate{};
-        void InitQuestsFromDirectory();
+        void InitQuests(script::ScriptLinker& linker);
         void RemoveQuest(const std::string& key);
         std::vector<Quest*> GetActiveQuests();
+        [[nodiscard]] bool HasQuest(const std::string& key) const;
         [[nodiscard]] entt::entity GetQuest(const std::string& key) const;
 
         explicit QuestManager(entt::registry* _registry, Systems* _sys);
@@ -39,13 +39,16 @@ namespace lq
           questManager(std::make_unique<QuestManager>(_registry, this)),
           contextualDialogSystem(std::make_unique<ContextualDialogSystem>(_registry, this)),
           lootTable(std::make_unique<LootTable>(_registry, this)),
-          lootSystem(std::make_unique<LootSystem>(_registry, this))
+          lootSystem(std::make_unique<LootSystem>(_registry, this)),
+          scriptHost(std::make_unique<GameScriptHost>(_registry, this))
     {
         engine.ReplaceUiEngine(std::make_unique<LeverUIEngine>(_registry, this));
         selectionSystem->onSelectedActorChange.Subscribe([this](entt::entity prev, entt::entity current) {
             cursorClickIndicator->OnSelectedActorChanged(prev, current);
         });
         engine.collisionSystem->SetDefaultQueryMask(collision_masks::DefaultQuery);
+        engine.visibilitySystem->SetSightBlockingMask(
+            sage::collision_layers::Obstacle | collision_layers::Building);
         engine.cursor->SetNavigationRangeProvider([this, _registry](const Vector3& point) {
             const auto selectedActor = selectionSystem->GetSelectedActor();
             if (selectedActor == entt::null || !_registry->valid(selectedActor) ||
@@ -32,6 +32,7 @@ namespace lq
     class ControllableActorSystem;
     class CursorClickIndicator;
     class DoorSystem;
+    class GameScriptHost;
 
     class Systems
     {
@@ -59,6 +60,7 @@ namespace lq
         std::unique_ptr<ContextualDialogSystem> contextualDialogSystem;
         std::unique_ptr<LootTable> lootTable;
         std::unique_ptr<LootSystem> lootSystem;
+        std::unique_ptr<GameScriptHost> scriptHost; // What linked scripts call
         Systems(
             entt::registry* _registry,
             sage::KeyMapping* _keyMapping,
@@ -4,104 +4,101 @@
 
 #pragma once
 
-#include "engine/AudioManager.hpp"
-#include "engine/Camera.hpp"
-#include "engine/components/Collideable.hpp"
-#include "engine/components/DoorBehaviorComponent.hpp"
-#include "engine/components/OverheadDialogComponent.hpp"
-#include "engine/components/Renderable.hpp"
-#include "engine/components/sgTransform.hpp"
-#include "engine/FullscreenTextOverlayManager.hpp"
-#include "engine/Settings.hpp"
-#include "engine/slib.hpp"
-#include "engine/systems/RenderSystem.hpp"
-
-#include "components/ContextualDialogTriggerComponent.hpp"
-#include "components/DialogComponent.hpp"
-#include "components/ItemComponent.hpp"
-#include "ParsingHelpers.hpp"
-#include "Systems.hpp"
-#include "systems/DoorSystem.hpp"
-#include "systems/PartySystem.hpp"
+#include "ScriptHost.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptLinker.hpp"
 
 #include "entt/entt.hpp"
-#include "raylib.h"
+
+#include <format>
+#include <functional>
+#include <string>
 
 namespace lq::parsing
 {
+    // Entities are resolved through the linker when binding; a name the scene lacks is recorded there
+    // and the function is left unbound.
     template <typename EventType, typename... Args>
-    void BindFunctionToEvent(entt::registry* registry, Systems* sys, TextFunction func, EventType* event)
+    void BindFunctionToEvent(script::ScriptLinker& linker, const script::Call& call, EventType* event)
     {
-        assert(!func.name.empty());
-        // Not all functions require params
+        // Not all functions require params; the compiler has checked the ones that do have them.
+        auto* host = linker.GetHost();
+        const auto& module = linker.GetModule();
+        const std::string params = call.arg != script::NONE ? module.String(call.arg) : std::string{};
+        const auto name = script::GetFunctionInfo(call.function).name;
 
-        if (func.name.find("OpenDoor") != std::string::npos)
-        {
-            assert(!func.params.empty());
-            auto doorId = sys->engine.renderSystem->FindRenderable<sage::DoorBehaviorComponent>(func.params);
-            assert(doorId != entt::null);
-            event->Subscribe([doorId, sys](Args...) { sys->doorSystem->UnlockAndOpenDoor(doorId); });
-        }
-        else if (func.name.find("JoinParty") != std::string::npos)
-        {
-            assert(!func.params.empty());
-            auto npcId = sys->engine.renderSystem->FindRenderable(func.params);
-            assert(npcId != entt::null);
-            event->Subscribe([npcId, sys](Args...) { sys->partySystem->NPCToMember(npcId); });
-        }
-        else if (func.name.find("RemoveItem") != std::string::npos)
-        {
-            assert(!func.params.empty());
-            event->Subscribe(
-                [params = func.params, sys](Args...) { sys->partySystem->RemoveItemFromParty(params); });
-        }
-        else if (func.name.find("GiveItem") != std::string::npos)
+        switch (call.function)
         {
-            assert(!func.params.empty());
-            event->Subscribe(
-                [itemName = func.params, sys](Args...) { sys->partySystem->GiveItemToSelected(itemName); });
+        case script::Function::OpenDoor: {
+            auto doorId = linker.FindDoor(call.arg, name);
+            if (doorId == entt::null) break;
+            event->Subscribe([doorId, host](Args...) { host->OpenDoor(doorId); });
+            break;
         }
-        else if (func.name.find("PlaySFX") != std::string::npos)
-        {
-            assert(!func.params.empty());
-            event->Subscribe([sfxName = func.params, sys](Args...) { sys->engine.audioManager->PlaySFX(sfxName); });
+        case script::Function::JoinParty: {
+            auto npcId = linker.FindRenderable(call.arg, name);
+            if (npcId == entt::null) break;
+            event->Subscribe([npcId, host](Args...) { host->JoinParty(npcId); });
+            break;
         }
-        else if (func.name.find("PlayMusic") != std::string::npos)
-        {
-            assert(!func.params.empty());
-            event->Subscribe([musicName = func.params, sys](Args...) { sys->engine.audioManager->PlayMusic(musicName); });
+        case script::Function::RemoveItem:
+            event->Subscribe([params, host](Args...) { host->RemoveItem(params); });
+            break;
+        case script::Function::GiveItem:
+            event->Subscribe([itemName = params, host](Args...) { host->GiveItem(itemName); });
+            break;
+        case script::Function::PlaySFX:
+            event->Subscribe([sfxName = params, host](Args...) { host->PlaySFX(sfxName); });
+            break;
+        case script::Function::PlayMusic:
+            event->Subscribe([musicName = params, host](Args...) { host->PlayMusic(musicName); });
+            break;
+        case script::Function::DisableWorldItem: {
+            auto itemId = linker.FindRenderable(call.arg, name);
+            if (itemId == entt::null) break;
+            event->Subscribe([itemId, host](Args...) { host->DisableWorldItem(itemId); });
+            break;
         }
-        else if (func.name.find("DisableWorldItem") != std::string::npos)
-        {
-            assert(!func.params.empty());
-            auto itemId = sys->engine.renderSystem->FindRenderable(func.params);
-            assert(itemId != entt::null);
-            event->Subscribe([itemId, registry](Args...) {
-                if (registry->any_of<sage::Renderable>(itemId))
-                {
-                    registry->get<sage::Renderable>(itemId).Disable();
-                }
-                if (registry->any_of<sage::Collideable>(itemId))
-                {
-                    registry->get<sage::Collideable>(itemId).active = false;
-                }
-            });
+        case script::Function::EndGame:
+            event->Subscribe([host](Args...) { host->EndGame(); });
+            break;
+        default:
+            linker.Error(std::format("{}: not a command", name));
         }
-        else if (func.name.find("EndGame") != std::string::npos)
+    }
+
+    // What selecting a dialog option runs, for the conversation owned by owner. Empty, with the error
+    // recorded in the linker, if the quest is missing or the call is not an option action.
+    [[nodiscard]] inline std::function<void()> BindOptionAction(
+        script::ScriptLinker& linker, const script::Call& call, const entt::entity owner)
+    {
+        auto* host = linker.GetHost();
+        const auto& info = script::GetFunctionInfo(call.function);
+        const auto name = info.name;
+        if (info.kind != script::FunctionKind::OptionAction)
         {
-            event->Subscribe([sys](Args...) {
-                std::vector<std::pair<std::string, float>> text;
-                text.emplace_back("Our bold heroes step forward, out of the gate.", 4.0f);
-                text.emplace_back("What will await our valiant heroes?", 4.0f);
-                text.emplace_back("Find out soon.", 4.0f);
-                text.emplace_back("Thanks for playing!", 4.0f);
-                sys->engine.fullscreenTextOverlayFactory->SetOverlay(text, 0.5f, 1.0f);
-                sys->engine.fullscreenTextOverlayFactory->onOverlayEnd.Subscribe([sys] { sys->engine.settings->ExitProgram(); });
-            });
+            linker.Error(std::format("{}: not an option action", name));
+            return {};
         }
-        else
+
+        const auto questId = linker.FindQuest(call.arg, name);
+        if (questId == entt::null) return {};
+
+        switch (call.function)
         {
-            assert(0);
+        case script::Function::StartQuest:
+            return [questId, host] { host->StartQuest(questId); };
+        case script::Function::CompleteQuest:
+            return [questId, host] { host->CompleteQuest(questId); };
+        case script::Function::CompleteQuestTask:
+            if (!host->IsQuestTask(owner))
+            {
+                linker.Error(std::format("{}: the conversation's owner is not a quest task", name));
+                return {};
+            }
+            return [questId, owner, host] { host->CompleteQuestTask(questId, owner); };
+        default:
+            return {};
         }
     }
 } // namespace lq::parsing
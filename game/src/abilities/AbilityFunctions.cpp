@@ -7,6 +7,7 @@
 #include "Systems.hpp"
 
 #include "engine/Camera.hpp"
+#include "engine/SpatialQuery.hpp"
 #include "engine/components/Collideable.hpp"
 #include "engine/components/sgTransform.hpp"
 #include "engine/systems/ActorMovementSystem.hpp"
@@ -22,27 +23,25 @@
 namespace lq
 {
     void AOEAtPoint(
-        entt::registry* registry, entt::entity caster, entt::entity abilityEntity, Vector3 point, float radius)
+        entt::registry* registry,
+        sage::EngineSystems* sys,
+        entt::entity caster,
+        entt::entity abilityEntity,
+        Vector3 point,
+        float radius)
     {
         auto& abilityData = registry->get<AbilityData>(abilityEntity);
-        auto view = registry->view<CombatableActor>();
-        for (auto& entity : view)
+        for (const auto entity : sys->spatialQuery->QueryRadius<CombatableActor>(point, radius))
         {
             if (entity == caster) continue;
 
-            const auto& targetTransform = registry->get<sage::sgTransform>(entity);
-            const auto& targetCol = registry->get<sage::Collideable>(entity);
-
-            if (CheckCollisionBoxSphere(targetCol.worldBoundingBox, point, radius))
-            {
-                const auto& combatable = registry->get<CombatableActor>(entity);
-                AttackData attackData{
-                    .attacker = caster,
-                    .hit = entity,
-                    .damage = abilityData.base.baseDamage,
-                    .elements = abilityData.base.elements};
-                combatable.onHit.Publish(attackData);
-            }
+            const auto& combatable = registry->get<CombatableActor>(entity);
+            AttackData attackData{
+                .attacker = caster,
+                .hit = entity,
+                .damage = abilityData.base.baseDamage,
+                .elements = abilityData.base.elements};
+            combatable.onHit.Publish(attackData);
         }
     }
 
@@ -11,7 +11,12 @@ namespace sage
 namespace lq
 {
     void AOEAtPoint(
-        entt::registry* registry, entt::entity caster, entt::entity abilityEntity, Vector3 point, float radius);
+        entt::registry* registry,
+        sage::EngineSystems* sys,
+        entt::entity caster,
+        entt::entity abilityEntity,
+        Vector3 point,
+        float radius);
 
     void HitSingleTarget(
         entt::registry* registry,
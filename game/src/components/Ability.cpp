@@ -41,29 +41,26 @@ namespace lq
         return nullptr;
     }
 
-    void Ability::ResetCooldown()
+    bool Ability::IsActive() const
     {
-        cooldownTimer.Reset();
+        return onCooldown;
     }
 
-    bool Ability::IsActive()
+    float Ability::GetRemainingCooldownTime(const sage::TimerWheel& timerWheel) const
     {
-        return cooldownTimer.IsRunning();
-    }
-
-    float Ability::GetRemainingCooldownTime() const
-    {
-        return cooldownTimer.GetRemainingTime();
+        if (!onCooldown) return 0;
+        // The cooldown only starts counting once the ability has executed.
+        return cooldownTimer.IsSet() ? timerWheel.GetRemaining(cooldownTimer) : cooldownDuration;
     }
 
     float Ability::GetCooldownDuration() const
     {
-        return cooldownTimer.GetMaxTime();
+        return cooldownDuration;
     }
 
     bool Ability::CooldownReady() const
     {
-        return cooldownTimer.HasFinished() || cooldownTimer.GetRemainingTime() <= 0;
+        return !onCooldown;
     }
 
 }; // namespace lq
@@ -2,7 +2,7 @@
 
 #include "abilities/AbilityData.hpp"
 #include "abilities/AbilityIndicator.hpp"
-#include "engine/Timer.hpp"
+#include "engine/TimerWheel.hpp"
 
 #include "entt/entt.hpp"
 
@@ -14,8 +14,12 @@ namespace lq
     {
         entt::entity self{};
         entt::entity caster{};
-        Timer cooldownTimer;
-        Timer castTimer;
+        float cooldownDuration = 0;
+        float castTime = 0;
+        // Scheduled on the engine's timer wheel by AbilityStateMachine.
+        sage::TimerHandle cooldownTimer{};
+        sage::TimerHandle castTimer{};
+        bool onCooldown = false; // From the start of a cast until its cooldown has run out
 
         AssetID icon{};
         std::string iconPath; // Use AssetID where possible
@@ -23,9 +27,8 @@ namespace lq
         VisualFX* GetVfx(entt::registry* registry) const;
         std::unique_ptr<AbilityIndicator> abilityIndicator{};
 
-        void ResetCooldown();
-        bool IsActive();
-        [[nodiscard]] float GetRemainingCooldownTime() const;
+        [[nodiscard]] bool IsActive() const;
+        [[nodiscard]] float GetRemainingCooldownTime(const sage::TimerWheel& timerWheel) const;
         [[nodiscard]] float GetCooldownDuration() const;
         [[nodiscard]] bool CooldownReady() const;
 
@@ -4,7 +4,7 @@
 
 #include "DialogComponent.hpp"
 
-#include "QuestComponents.hpp"
+#include <utility>
 
 namespace lq::dialog
 {
@@ -36,62 +36,19 @@ namespace lq::dialog
     {
     }
 
-    void QuestOption::OnSelected()
+    void ActionOption::OnSelected()
     {
-        auto& task = parent->parent->registry->get<QuestTaskComponent>(parent->parent->owner);
-        auto& quest = parent->parent->registry->get<Quest>(questId);
-        if (quest.HasStarted())
-        {
-            task.MarkComplete();
-        }
-    }
-
-    QuestOption::QuestOption(ConversationNode* _parent, entt::entity _questId) : Option(_parent), questId(_questId)
-    {
-    }
-
-    QuestOption::QuestOption(ConversationNode* _parent, entt::entity _questId, std::function<bool()> _condition)
-        : Option(_parent, std::move(_condition)), questId(_questId)
-    {
-    }
-
-    void QuestStartOption::OnSelected()
-    {
-        auto& quest = parent->parent->registry->get<Quest>(questId);
-        if (!quest.HasStarted())
-        {
-            quest.StartQuest();
-        }
-    }
-
-    QuestStartOption::QuestStartOption(ConversationNode* _parent, entt::entity _questId)
-        : QuestOption(_parent, _questId)
-    {
-    }
-
-    QuestStartOption::QuestStartOption(
-        ConversationNode* _parent, entt::entity _questId, std::function<bool()> _condition)
-        : QuestOption(_parent, _questId, std::move(_condition))
-    {
-    }
-
-    void QuestFinishOption::OnSelected()
-    {
-        auto& quest = parent->parent->registry->get<Quest>(questId);
-        if (quest.HasStarted())
-        {
-            quest.CompleteQuest();
-        }
+        action();
     }
 
-    QuestFinishOption::QuestFinishOption(ConversationNode* _parent, entt::entity _questId)
-        : QuestOption(_parent, _questId)
+    ActionOption::ActionOption(ConversationNode* _parent, std::function<void()> _action)
+        : Option(_parent), action(std::move(_action))
     {
     }
 
-    QuestFinishOption::QuestFinishOption(
-        ConversationNode* _parent, entt::entity _questId, std::function<bool()> _condition)
-        : QuestOption(_parent, _questId, std::move(_condition))
+    ActionOption::ActionOption(
+        ConversationNode* _parent, std::function<void()> _action, std::function<bool()> _condition)
+        : Option(_parent, std::move(_condition)), action(std::move(_action))
     {
     }
 
@@ -48,38 +48,17 @@ namespace lq
             Option(ConversationNode* _parent, std::function<bool()> _condition);
         };
 
-        // Shows if quest has started. Marks as complete. Does not finish the quest.
-        class QuestOption : public Option
-        {
-          protected:
-            entt::entity questId{};
-
-          public:
-            void OnSelected() override;
-
-            QuestOption(ConversationNode* _parent, entt::entity _questId);
-            QuestOption(ConversationNode* _parent, entt::entity _questId, std::function<bool()> _condition);
-        };
-
-        // Shows if quest has not been started (and starts quest on select)
-        class QuestStartOption : public QuestOption
+        // Runs a script option action (start_quest, complete_quest, complete_quest_task) when selected.
+        class ActionOption : public Option
         {
+            std::function<void()> action;
 
           public:
             void OnSelected() override;
 
-            QuestStartOption(ConversationNode* _parent, entt::entity _questId);
-            QuestStartOption(ConversationNode* _parent, entt::entity _questId, std::function<bool()> _condition);
-        };
-
-        // Shows if the dialog task is the final task left to be complete
-        class QuestFinishOption : public QuestOption
-        {
-
-          public:
-            void OnSelected() override;
-            QuestFinishOption(ConversationNode* _parent, entt::entity _questId);
-            QuestFinishOption(ConversationNode* _parent, entt::entity _questId, std::function<bool()> _condition);
+            ActionOption(ConversationNode* _parent, std::function<void()> _action);
+            ActionOption(
+                ConversationNode* _parent, std::function<void()> _action, std::function<bool()> _condition);
         };
 
         struct ConversationNode
@@ -4,8 +4,6 @@
 
 #include "HealthBar.hpp"
 
-#include <cmath>
-
 namespace lq
 {
     void HealthBar::Decrement(int value)
@@ -17,14 +15,4 @@ namespace lq
     {
         damageTaken = 0;
     }
-
-    HealthBar::HealthBar()
-    {
-        healthBarTexture = LoadRenderTexture(200, 50);
-    }
-
-    HealthBar::~HealthBar()
-    {
-        UnloadRenderTexture(healthBarTexture);
-    }
 } // namespace lq
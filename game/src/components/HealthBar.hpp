@@ -12,8 +12,7 @@ namespace lq
 {
     struct HealthBar
     {
-        float damageTaken = 0;
-        RenderTexture2D healthBarTexture{};
+        float damageTaken = 0; // Decays towards zero each frame (HealthBarSystem::Update)
         const int healthBarWidth = 200;
         const int healthBarHeight = 20;
         const Color healthBarColor = RED;
@@ -21,7 +20,5 @@ namespace lq
         const Color healthBarBorderColor = MAROON;
         void Decrement(int value);
         void Increment(int value);
-        HealthBar();
-        ~HealthBar();
     };
 } // namespace lq
@@ -4,6 +4,7 @@
 
 #pragma once
 #include "engine/Event.hpp"
+#include "engine/TimerWheel.hpp"
 
 #include "entt/entt.hpp"
 #include "raylib.h"
@@ -124,7 +125,7 @@ namespace lq
     struct PartyMemberDestinationUnreachableState
     {
         Vector3 originalDestination{};
-        double timeStart{};
+        sage::TimerHandle retryTimer{};
         unsigned int tryCount = 0;
     };
 
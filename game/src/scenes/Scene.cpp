@@ -11,11 +11,14 @@
 #include "engine/Cursor.hpp"
 #include "engine/FullscreenTextOverlayManager.hpp"
 #include "engine/GameUiEngine.hpp"
+#include "engine/TimerWheel.hpp"
 
 #include "DialogFactory.hpp"
 #include "engine/GameUiEngine.hpp"
 #include "GameObjectFactory.hpp"
 #include "MapLoader.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptLinker.hpp"
 #include "ui/GameUI.hpp"
 #include "ui/GameUiFactory.hpp"
 
@@ -78,12 +81,31 @@ namespace lq
         }
 
         loadSpawners();
+        // After spawners, which place sight-blocking buildings
+        sys->engine.visibilitySystem->Rebuild();
 
-        // Requires renderables being loaded first
-        sys->contextualDialogSystem->InitContextualDialogsFromDirectory();
-        sys->questManager->InitQuestsFromDirectory();
+        // Compiled from resources/dialog and resources/quests by the packer.
+        script::ScriptModule scripts;
+        if (!sage::ResourceManager::GetInstance().ReadScript(script::MODULE_KEY, scripts))
+        {
+            TraceLog(LOG_FATAL, "Scene: the asset archive has no compiled scripts; re-run respacker.");
+        }
+
+        // Requires renderables being loaded first. Quests come before anything with conditions, which
+        // resolve quest keys and quest tasks when they are linked.
+        script::ScriptLinker linker(scripts, sys->scriptHost.get());
+        sys->questManager->InitQuests(linker);
+        sys->contextualDialogSystem->InitContextualDialogs(linker);
 
-        sys->dialogFactory->InitDialogFromDirectory(); // Must be called after all npcs are loaded
+        sys->dialogFactory->InitDialog(linker); // Must be called after all npcs are loaded
+        for (const auto& error : linker.GetErrors())
+        {
+            TraceLog(LOG_ERROR, "Scene: script: %s", error.c_str());
+        }
+        if (linker.HasErrors())
+        {
+            TraceLog(LOG_FATAL, "Scene: the scripts name things this map does not have; see above.");
+        }
         sys->engine.camera->FocusEntity(sys->selectionSystem->GetSelectedActor());
     }
 
@@ -127,7 +149,9 @@ namespace lq
         sys->contextualDialogSystem->Update();
         sys->engine.spatialAudioSystem->Update();
         sys->lootSystem->Update();
+        sys->engine.timerWheel->Update(GetFrameTime());
         sys->stateMachines->Update();
+        sys->engine.visibilitySystem->Update();
     }
 
     void Scene::DrawDebug3D()
@@ -154,6 +178,11 @@ namespace lq
         sys->UI().DrawDebug2D();
     }
 
+    void Scene::DrawOffscreen()
+    {
+        sys->UI().DrawOffscreen();
+    }
+
     void Scene::Draw2D()
     {
         sys->contextualDialogSystem->Draw2D();
@@ -40,6 +40,8 @@ namespace lq
         virtual void Update();
         virtual void Draw3D();
         virtual void DrawDebug3D();
+        // Renders to textures of its own; called before any of the scene's texture modes begin.
+        virtual void DrawOffscreen();
         virtual void Draw2D();
         virtual void DrawDebug2D();
         virtual ~Scene();
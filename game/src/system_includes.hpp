@@ -7,6 +7,7 @@
 // Systems
 #include "AbilityFactory.hpp"
 #include "DialogFactory.hpp"
+#include "GameScriptHost.hpp"
 #include "ItemFactory.hpp"
 #include "LootTable.hpp"
 #include "NpcManager.hpp"
@@ -39,5 +40,6 @@
 #include "engine/systems/SpatialAudioSystem.hpp"
 #include "engine/systems/TransformSystem.hpp"
 #include "engine/systems/UberShaderSystem.hpp"
+#include "engine/systems/VisibilitySystem.hpp"
 #include "engine/UserInput.hpp"
 #include "systems/ControllableActorSystem.hpp"
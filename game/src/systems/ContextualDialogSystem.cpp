@@ -15,143 +15,62 @@
 #include "engine/Settings.hpp"
 #include "engine/slib.hpp"
 #include "engine/systems/RenderSystem.hpp"
+#include "engine/ui/TextLayoutCache.hpp"
 
 #include "components/ContextualDialogTriggerComponent.hpp"
-#include "ParsingHelpers.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptLinker.hpp"
 #include "Systems.hpp"
 
 #include "engine/Cursor.hpp"
 #include "raylib.h"
 
-#include <filesystem>
-#include <format>
-#include <fstream>
+#include <algorithm>
 #include <utility>
 
-namespace fs = std::filesystem;
-constexpr auto CONTEXTUAL_DIALOG_PATH = "resources/dialog/contextual";
-
 namespace lq
 {
     using namespace parsing;
 
-    void ContextualDialogSystem::InitContextualDialogsFromDirectory()
+    void ContextualDialogSystem::InitContextualDialogs(script::ScriptLinker& linker)
     {
-        for (const fs::path path{CONTEXTUAL_DIALOG_PATH}; const auto& entry : fs::directory_iterator(path))
+        const auto& module = linker.GetModule();
+        for (const auto& script : module.contextualDialogs)
         {
-            if (entry.path().extension() == ".txt")
+            const auto entity = linker.FindRenderable(script.owner, "contextual dialog");
+            if (entity == entt::null) continue;
+            entt::entity speaker{};
+            if (script.speaker != script::NONE)
             {
-
-                std::ostringstream fileContent;
+                speaker = linker.FindRenderable(script.speaker, "contextual dialog");
+                if (speaker == entt::null) continue;
+            }
+            auto& trigger = registry->emplace<ContextualDialogTriggerComponent>(entity);
+            trigger.speaker = speaker;
+            if (script.distance.has_value()) trigger.distance = script.distance.value();
+            trigger.loop = script.loop;
+            trigger.shouldRetrigger = script.shouldRetrigger;
+
+            std::vector<std::pair<std::string, std::function<bool()>>> text;
+            text.reserve(script.lines.size());
+            for (const auto& line : script.lines)
+            {
+                if (line.condition != script::NONE)
                 {
-                    std::string fileName = entry.path().filename().string();
-                    std::ifstream file{std::format("{}/{}", CONTEXTUAL_DIALOG_PATH, fileName)};
-                    if (!file.is_open()) assert(0);
-                    if (!file.is_open()) return;
-                    fileContent << file.rdbuf();
+                    text.emplace_back(module.String(line.text), linker.LinkCondition(line.condition));
                 }
-
-                std::vector<std::pair<std::string, std::function<bool()>>> text;
-                entt::entity entity = entt::null;
-                ContextualDialogTriggerComponent* trigger = nullptr;
-
-                std::string processed =
-                    removeCommentsFromFile(trimWhiteSpaceFromFile(normalizeLineEndings(fileContent.str())));
-                std::stringstream ss(processed);
-                std::string buff;
-                while (std::getline(ss, buff, '\n'))
+                else
                 {
-                    if (buff.find("<meta>") != std::string::npos)
-                    {
-                        std::string metaLine;
-                        while (std::getline(ss, metaLine) && metaLine.find("</meta>") == std::string::npos)
-                        {
-                            if (metaLine.find("owner: ") != std::string::npos)
-                            {
-                                auto sub = metaLine.substr(std::string("owner: ").size());
-                                entity = sys->engine.renderSystem->FindRenderable(sub);
-                                trigger = &registry->emplace<ContextualDialogTriggerComponent>(entity);
-                                assert(entity != entt::null && trigger);
-                            }
-                            else if (metaLine.find("distance: ") != std::string::npos)
-                            {
-                                assert(entity != entt::null && trigger);
-                                auto sub = metaLine.substr(std::string("distance: ").size());
-                                float dist = std::stof(sub);
-                                trigger->distance = dist;
-                            }
-                            else if (metaLine.find("speaker: ") != std::string::npos)
-                            {
-                                assert(entity != entt::null && trigger);
-                                auto sub = metaLine.substr(std::string("speaker: ").size());
-                                entt::entity speaker = sys->engine.renderSystem->FindRenderable(sub);
-                                assert(trigger->speaker != entt::null);
-                                trigger->speaker = speaker;
-                            }
-                            else if (metaLine.find("loop: ") != std::string::npos)
-                            {
-                                assert(entity != entt::null && trigger);
-                                auto sub = metaLine.substr(std::string("loop: ").size());
-                                if (sub.find("true") != std::string::npos)
-                                {
-                                    trigger->loop = true;
-                                }
-                            }
-                            else if (metaLine.find("should_retrigger: ") != std::string::npos)
-                            {
-                                assert(entity != entt::null && trigger);
-                                auto sub = metaLine.substr(std::string("should_retrigger: ").size());
-                                if (sub.find("true") != std::string::npos)
-                                {
-                                    trigger->shouldRetrigger = true;
-                                }
-                            }
-                        }
-                    }
-                    else if (buff.find("<dialog>") != std::string::npos)
-                    {
-                        std::optional<std::function<bool()>> condition;
-                        std::string dialogLine;
-                        while (std::getline(ss, dialogLine) && dialogLine.find("</dialog>") == std::string::npos)
-                        {
-
-                            if (dialogLine.starts_with("if"))
-                            {
-                                assert(!condition.has_value()); // "if blocks" must be closed with end. No nesting
-                                                                // allowed (yet).
-                                condition = GetConditionalStatement(dialogLine, registry, sys);
-                            }
-                            else if (dialogLine.starts_with("end"))
-                            {
-                                condition.reset();
-                            }
-                            else
-                            {
-                                if (condition.has_value())
-                                {
-                                    text.emplace_back(dialogLine, condition.value());
-                                }
-                                else
-                                {
-                                    text.emplace_back(dialogLine, []() { return true; });
-                                }
-                            }
-                        }
-                    }
-                    else if (buff.find("<onTrigger>") != std::string::npos)
-                    {
-                        std::string commandLine;
-                        while (std::getline(ss, commandLine) &&
-                               commandLine.find("</onTrigger>") == std::string::npos)
-                        {
-                            auto func = getFunctionNameAndArgs(commandLine);
-                            parsing::BindFunctionToEvent<sage::Event<>>(registry, sys, func, &trigger->onTrigger);
-                        }
-                    }
+                    text.emplace_back(module.String(line.text), []() { return true; });
                 }
+            }
 
-                dialogTextMap.emplace(entity, text);
+            for (const auto& call : script.onTrigger)
+            {
+                BindFunctionToEvent<sage::Event<>>(linker, call, &trigger.onTrigger);
             }
+
+            dialogTextMap.emplace(entity, std::move(text));
         }
     }
 
@@ -212,13 +131,21 @@ namespace lq
             auto screenPos = GetWorldToScreenEx(pos, *sys->engine.camera->getRaylibCam(), width, height);
             auto& contextualDiag = registry->get<sage::OverheadDialogComponent>(entity);
 
-            auto scaledFontSize = sys->engine.settings->ScaleValueMaintainRatio(fontSize);
-            const auto text = contextualDiag.GetText();
-            DrawText(
-                text.c_str(),
-                static_cast<float>(static_cast<int>(screenPos.x) - MeasureText(text.c_str(), scaledFontSize) / 2),
-                static_cast<float>(static_cast<int>(screenPos.y)),
-                scaledFontSize,
+            // DrawText's conventions for the default font: whole-pixel size of at least 10, spacing of
+            // a tenth of it.
+            const int scaledFontSize =
+                std::max(static_cast<int>(sys->engine.settings->ScaleValueMaintainRatio(fontSize)), 10);
+            const auto size = static_cast<float>(scaledFontSize);
+            const auto spacing = static_cast<float>(scaledFontSize / 10);
+            const Font font = GetFontDefault();
+            const auto& layout =
+                sage::TextLayoutCache::GetInstance().Get(font, contextualDiag.GetText(), size, spacing);
+            sage::TextLayoutCache::Draw(
+                font,
+                layout,
+                {static_cast<float>(static_cast<int>(screenPos.x) - static_cast<int>(layout.size.x) / 2),
+                 static_cast<float>(static_cast<int>(screenPos.y))},
+                size,
                 WHITE);
         }
     }
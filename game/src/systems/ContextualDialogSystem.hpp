@@ -15,6 +15,10 @@
 namespace lq
 {
     class Systems;
+    namespace script
+    {
+        class ScriptLinker;
+    } // namespace script
 
     class ContextualDialogSystem
     {
@@ -27,7 +31,7 @@ namespace lq
         void Update() const;
         void Draw2D() const;
 
-        void InitContextualDialogsFromDirectory();
+        void InitContextualDialogs(script::ScriptLinker& linker);
         ContextualDialogSystem(entt::registry* _registry, Systems* _sys);
     };
 
@@ -11,6 +11,7 @@
 #include "engine/components/DoorBehaviorComponent.hpp"
 #include "engine/components/sgTransform.hpp"
 #include "engine/systems/NavigationGridSystem.hpp"
+#include "engine/systems/VisibilitySystem.hpp"
 
 namespace lq
 {
@@ -42,6 +43,7 @@ namespace lq
             col.SetCollisionLayer(sage::collision_layers::Background);
             col.blocksNavigation = false;
             sys->navigationGridSystem->MarkSquareAreaOccupied(col.worldBoundingBox, false);
+            sys->visibilitySystem->RefreshArea(col.worldBoundingBox);
             float targetRotation = (transform.forward().z > 0) ? door.openYRotation : -door.openYRotation;
             sys->transformSystem->SetLocalRot(entity, Vector3{rotx, targetRotation, rotz});
             door.open = true;
@@ -54,6 +56,7 @@ namespace lq
             col.SetCollisionLayer(sage::collision_layers::Obstacle);
             col.blocksNavigation = true;
             sys->navigationGridSystem->MarkSquareAreaOccupied(col.worldBoundingBox, true);
+            sys->visibilitySystem->RefreshArea(col.worldBoundingBox);
         }
     }
 
@@ -52,7 +52,7 @@ namespace lq
         {
             auto& animation = registry.get<sage::Animation>(entity);
             auto& renderable = registry.get<sage::Renderable>(entity);
-            const ModelAnimation& anim = animation.animations[animationIndex];
+            const sage::AnimationClip& anim = animation.animations[animationIndex];
             renderable.GetModel()->UpdateAnimation(anim, frame);
             animation.onAnimationUpdated.Publish(entity);
         }
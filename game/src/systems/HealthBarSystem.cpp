@@ -10,6 +10,10 @@
 #include "components/HealthBar.hpp"
 
 #include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <cmath>
 
 namespace lq
 {
@@ -17,48 +21,56 @@ namespace lq
     {
     }
 
-    void HealthBarSystem::updateHealthBarTextures() const
+    namespace
+    {
+        // World size of a bar's billboard; the bar fills the top healthBarHeight / BAR_TEXELS_HIGH of it.
+        constexpr float BILLBOARD_WIDTH = 3.0f;
+        constexpr float BILLBOARD_HEIGHT = 1.0f;
+        constexpr float BAR_TEXELS_HIGH = 50.0f;
+        // Each layer (background, fill, damage, border) is nudged towards the camera so the
+        // coplanar quads don't z-fight.
+        constexpr float LAYER_OFFSET = 0.002f;
+
+        // A flat quad facing the camera, spanning [x0, x1] along right and [y0, y1] up from origin.
+        void PushQuad(Vector3 origin, Vector3 right, float x0, float x1, float y0, float y1, Color color)
+        {
+            const Vector3 a = Vector3Add(origin, Vector3Scale(right, x0));
+            const Vector3 b = Vector3Add(origin, Vector3Scale(right, x1));
+            rlColor4ub(color.r, color.g, color.b, color.a);
+            rlTexCoord2f(0, 0);
+            rlVertex3f(a.x, a.y + y1, a.z);
+            rlVertex3f(a.x, a.y + y0, a.z);
+            rlVertex3f(b.x, b.y + y0, b.z);
+            rlVertex3f(b.x, b.y + y1, b.z);
+        }
+    } // namespace
+
+    void HealthBarSystem::updateDamageDecay() const
     {
         const auto& view = registry->view<HealthBar>();
         for (const auto& entity : view)
         {
             auto& hb = registry->get<HealthBar>(entity);
-            const auto& c = registry->get<CombatableActor>(entity);
             const float decayRate = 2.0f; // Adjust this value to control the speed of decay
             hb.damageTaken *= exp(-decayRate * GetFrameTime());
 
             if (hb.damageTaken < 0.1f) hb.damageTaken = 0; // Reset to zero when it's very small
-
-            float width = 200;
-            float height = 20;
-            BeginTextureMode(hb.healthBarTexture);
-            ClearBackground(BLANK);
-
-            DrawRectangle(0, 0, width, height, hb.healthBarBgColor);
-            float healthPercentage = static_cast<float>(c.data.hp) / 100.0f;
-            float damageTakenPercentage = static_cast<float>(hb.damageTaken) / 100.0f;
-            int fillWidth = static_cast<int>(healthPercentage * width);
-            DrawRectangle(0, 0, fillWidth, height, hb.healthBarColor);
-            DrawRectangle(fillWidth, 0, static_cast<int>(damageTakenPercentage * 200), 20, WHITE);
-            DrawRectangleLines(0, 0, width, height, hb.healthBarBorderColor);
-
-            // Vector2 textSize = MeasureTextEx(GetFontDefault(), TextFormat("HP: %03i", c.data.hp), 20, 1);
-            // DrawTextEx(
-            //     GetFontDefault(),
-            //     TextFormat("HP: %03i", c.data.hp),
-            //     {10, hb.healthBarTexture.texture.height - 30 - textSize.y},
-            //     20,
-            //     1,
-            //     GREEN);
-
-            EndTextureMode();
         }
     }
 
+    // Every bar is a handful of untextured quads in one rlgl batch, so all bars share a draw call
+    // instead of each rendering into (and sampling from) its own render texture.
     void HealthBarSystem::Draw3D()
     {
-        const auto& view = registry->view<HealthBar, sage::Collideable>();
-        view.each([this](const auto& c, const auto& col) {
+        const auto& cam = *camera->getRaylibCam();
+        const Matrix matView = MatrixLookAt(cam.position, cam.target, cam.up);
+        const Vector3 right = {matView.m0, matView.m4, matView.m8};
+        const Vector3 toCamera = {matView.m2, matView.m6, matView.m10};
+
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        const auto& view = registry->view<HealthBar, CombatableActor, sage::Collideable>();
+        view.each([&right, &toCamera](const auto& hb, const auto& c, const auto& col) {
             const Vector3& min = col.worldBoundingBox.min;
             const Vector3& max = col.worldBoundingBox.max;
 
@@ -66,19 +78,44 @@ namespace lq
 
             Vector3 billboardPos = modelCenter;
             billboardPos.y += 1.0f;
-            Rectangle sourceRec = {
-                0.0f,
-                0.0f,
-                static_cast<float>(c.healthBarTexture.texture.width),
-                static_cast<float>(-c.healthBarTexture.texture.height)};
-            DrawBillboardRec(
-                *camera->getRaylibCam(), c.healthBarTexture.texture, sourceRec, billboardPos, {3.0f, 1.0f}, WHITE);
+
+            // Bars are laid out in texels (healthBarWidth across the billboard's width).
+            const float texel = BILLBOARD_WIDTH / static_cast<float>(hb.healthBarWidth);
+            const float width = BILLBOARD_WIDTH;
+            const float top = BILLBOARD_HEIGHT / 2;
+            const float bottom = top - static_cast<float>(hb.healthBarHeight) * BILLBOARD_HEIGHT / BAR_TEXELS_HIGH;
+            Vector3 origin = Vector3Subtract(billboardPos, Vector3Scale(right, width / 2));
+            const Vector3 layerStep = Vector3Scale(toCamera, LAYER_OFFSET);
+
+            const float healthPercentage = static_cast<float>(c.data.hp) / 100.0f;
+            const float damageTakenPercentage = hb.damageTaken / 100.0f;
+            const float fillWidth = healthPercentage * width;
+
+            PushQuad(origin, right, 0, width, bottom, top, hb.healthBarBgColor);
+            origin = Vector3Add(origin, layerStep);
+            PushQuad(origin, right, 0, fillWidth, bottom, top, hb.healthBarColor);
+            if (hb.damageTaken > 0)
+            {
+                PushQuad(
+                    origin, right, fillWidth, fillWidth + damageTakenPercentage * width, bottom, top, WHITE);
+            }
+
+            // One-texel border
+            origin = Vector3Add(origin, layerStep);
+            const float border = texel;
+            const Color borderColor = hb.healthBarBorderColor;
+            PushQuad(origin, right, 0, width, top - border, top, borderColor);
+            PushQuad(origin, right, 0, width, bottom, bottom + border, borderColor);
+            PushQuad(origin, right, 0, border, bottom, top, borderColor);
+            PushQuad(origin, right, width - border, width, bottom, top, borderColor);
         });
+        rlEnd();
+        rlSetTexture(0);
     }
 
     void HealthBarSystem::Update()
     {
-        updateHealthBarTextures();
+        updateDamageDecay();
     }
 
     HealthBarSystem::HealthBarSystem(entt::registry* _registry, sage::Camera* _camera)
@@ -19,7 +19,7 @@ namespace lq
         entt::registry* registry;
         sage::Camera* camera;
 
-        void updateHealthBarTextures() const;
+        void updateDamageDecay() const;
 
       public:
         void Draw2D();
@@ -53,7 +53,7 @@ namespace lq
         }
 
         const auto& collideable = registry->get<sage::Collideable>(actorId);
-        sys->engine.navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, false);
+        sys->engine.navigationGridSystem->UnstampActor(actorId);
         if (sys->engine.navigationGridSystem->AStarPathfind(actorId, playerPos, cursorPos).empty())
         {
             if (!hover)
@@ -65,7 +65,7 @@ namespace lq
         {
             lastWorldItemHovered.reachable = true;
         }
-        sys->engine.navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, true);
+        sys->engine.navigationGridSystem->StampActor(actorId, collideable.worldBoundingBox);
 
         return lastWorldItemHovered.reachable;
     }
@@ -6,6 +6,7 @@
 
 #include "ControllableActorSystem.hpp"
 #include "engine/Cursor.hpp"
+#include "engine/TimerWheel.hpp"
 #include "engine/UserInput.hpp"
 
 #include <cassert>
@@ -27,7 +28,8 @@ namespace lq
 
         if (!ab.CooldownReady())
         {
-            std::cout << "Waiting for cooldown timer: " << ab.GetRemainingCooldownTime() << "\n";
+            std::cout << "Waiting for cooldown timer: " << ab.GetRemainingCooldownTime(*sys->engine.timerWheel)
+                      << "\n";
             return;
         }
         ab.startCast.Publish(abilitySlots[slotNumber]);
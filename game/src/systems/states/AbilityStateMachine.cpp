@@ -7,7 +7,7 @@
 #include "AbilityFactory.hpp"
 #include "components/Ability.hpp"
 #include "components/CombatableActor.hpp"
-#include "engine/Timer.hpp"
+#include "engine/TimerWheel.hpp"
 #include "GameObjectFactory.hpp"
 #include "Systems.hpp"
 
@@ -28,12 +28,15 @@ namespace lq
 {
     // ====== AbilityIdleState ========================================================
 
-    void AbilityStateMachine::update(AbilityIdleState&, const entt::entity entity)
+    void AbilityStateMachine::onCooldownFinished(const entt::entity entity)
     {
         auto& ab = registry->get<Ability>(entity);
+        ab.cooldownTimer = {};
+        ab.onCooldown = false;
+
         const auto& ad = registry->get<AbilityData>(entity);
-        ab.cooldownTimer.Update(GetFrameTime());
-        if (ab.cooldownTimer.HasFinished() &&
+        const auto& state = registry->get<AbilityState>(entity);
+        if (std::holds_alternative<AbilityIdleState>(state.current) &&
             ad.base.HasOptionalBehaviour(AbilityBehaviourOptional::REPEAT_AUTO))
         {
             startCast(entity);
@@ -84,10 +87,20 @@ namespace lq
     void AbilityStateMachine::onEnter(AbilityAwaitingExecutionState&, const entt::entity entity)
     {
         auto& ab = registry->get<Ability>(entity);
-        ab.cooldownTimer.Start();
-        ab.castTimer.Start();
+        auto& timerWheel = *sys->engine.timerWheel;
+        // Casting again restarts the cooldown, which then runs from execution.
+        timerWheel.Cancel(ab.cooldownTimer);
+        ab.cooldownTimer = {};
+        ab.onCooldown = true;
 
         const auto& ad = registry->get<AbilityData>(entity);
+        // "executionDelayTimer" should just be a cast timer. Therefore, below should check for cast time
+        // behaviour
+        if (!ad.base.HasBehaviour(AbilityBehaviour::CAST_REGULAR))
+        {
+            ab.castTimer = timerWheel.Schedule(ab.castTime, [this, entity]() { onCastFinished(entity); });
+        }
+
         if (ad.base.HasBehaviour(AbilityBehaviour::MOVEMENT_PROJECTILE))
         {
             createProjectile(registry, ab.caster, entity, sys);
@@ -98,18 +111,17 @@ namespace lq
         }
     }
 
-    void AbilityStateMachine::update(AbilityAwaitingExecutionState&, const entt::entity entity)
+    void AbilityStateMachine::onExit(AbilityAwaitingExecutionState&, const entt::entity entity)
     {
         auto& ab = registry->get<Ability>(entity);
-        ab.castTimer.Update(GetFrameTime());
-        const auto& ad = registry->get<AbilityData>(entity);
+        sys->engine.timerWheel->Cancel(ab.castTimer);
+        ab.castTimer = {};
+    }
 
-        // "executionDelayTimer" should just be a cast timer. Therefore, below should check for cast time
-        // behaviour
-        if (ab.castTimer.HasFinished() && !ad.base.HasBehaviour(AbilityBehaviour::CAST_REGULAR))
-        {
-            executeAbility(entity);
-        }
+    void AbilityStateMachine::onCastFinished(const entt::entity entity)
+    {
+        registry->get<Ability>(entity).castTimer = {};
+        executeAbility(entity);
     }
 
     // ====== Cross-state transitions =================================================
@@ -121,14 +133,14 @@ namespace lq
         {
             vfx->active = false;
         }
-        ab.cooldownTimer.Stop();
-        ab.castTimer.Stop();
+        cancelTimers(ab);
+        ab.onCooldown = false;
         ChangeState(entity, AbilityIdleState{});
     }
 
     void AbilityStateMachine::executeAbility(const entt::entity entity)
     {
-        const auto& ab = registry->get<Ability>(entity);
+        auto& ab = registry->get<Ability>(entity);
         const auto& ad = registry->get<AbilityData>(entity);
 
         if (ad.base.HasBehaviour(AbilityBehaviour::ATTACK_TARGET))
@@ -147,9 +159,13 @@ namespace lq
             {
                 targetPos = registry->get<sage::sgTransform>(ab.caster).GetWorldPos();
             }
-            AOEAtPoint(registry, ab.caster, entity, targetPos, ad.base.radius);
+            AOEAtPoint(registry, sys->Engine(), ab.caster, entity, targetPos, ad.base.radius);
         }
 
+        auto& timerWheel = *sys->engine.timerWheel;
+        timerWheel.Cancel(ab.cooldownTimer);
+        ab.cooldownTimer =
+            timerWheel.Schedule(ab.cooldownDuration, [this, entity]() { onCooldownFinished(entity); });
         ChangeState(entity, AbilityIdleState{});
     }
 
@@ -241,6 +257,15 @@ namespace lq
         spawnAbility(entity);
     }
 
+    void AbilityStateMachine::cancelTimers(Ability& ab) const
+    {
+        auto& timerWheel = *sys->engine.timerWheel;
+        timerWheel.Cancel(ab.cooldownTimer);
+        timerWheel.Cancel(ab.castTimer);
+        ab.cooldownTimer = {};
+        ab.castTimer = {};
+    }
+
     // ====== Lifecycle ===============================================================
 
     void AbilityStateMachine::Update()
@@ -292,6 +317,11 @@ namespace lq
         std::visit([this, entity](auto& cur) { onEnter(cur, entity); }, state.current);
     }
 
+    void AbilityStateMachine::onComponentRemoved(const entt::entity entity)
+    {
+        cancelTimers(registry->get<Ability>(entity));
+    }
+
     AbilityStateMachine::AbilityStateMachine(entt::registry* _registry, Systems* _sys)
         : Base(_registry), sys(_sys)
     {
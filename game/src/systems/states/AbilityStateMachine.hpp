@@ -8,6 +8,7 @@
 namespace lq
 {
     class Systems;
+    struct Ability;
 
     class AbilityStateMachine final : public sage::StateMachineBase<AbilityStateMachine, AbilityState>
     {
@@ -23,7 +24,10 @@ namespace lq
         void onExit(AbilityIdleState&, entt::entity)
         {
         }
-        void update(AbilityIdleState&, entt::entity entity);
+        void update(AbilityIdleState&, entt::entity)
+        {
+        }
+        void onCooldownFinished(entt::entity entity);
 
         // ===== CursorSelect =====
         void onEnter(AbilityCursorSelectState&, entt::entity entity);
@@ -34,10 +38,11 @@ namespace lq
         // TODO: I think this should be split into two states depending on whether its detached or not
         // Or maybe if it has a cast time or not...
         void onEnter(AbilityAwaitingExecutionState&, entt::entity entity);
-        void onExit(AbilityAwaitingExecutionState&, entt::entity)
+        void onExit(AbilityAwaitingExecutionState&, entt::entity entity);
+        void update(AbilityAwaitingExecutionState&, entt::entity)
         {
         }
-        void update(AbilityAwaitingExecutionState&, entt::entity entity);
+        void onCastFinished(entt::entity entity);
 
         void enableCursor(entt::entity entity);
         void disableCursor(entt::entity entity);
@@ -47,11 +52,10 @@ namespace lq
         void spawnAbility(entt::entity entity);
         void executeAbility(entt::entity entity);
         [[nodiscard]] bool checkRange(entt::entity entity) const;
+        void cancelTimers(Ability& ab) const;
 
         void onComponentAdded(entt::entity entity);
-        void onComponentRemoved(entt::entity) const
-        {
-        }
+        void onComponentRemoved(entt::entity entity);
 
       public:
         void Update();
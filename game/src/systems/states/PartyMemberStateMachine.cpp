@@ -6,10 +6,13 @@
 #include "components/PartyMemberComponent.hpp"
 #include "systems/ControllableActorSystem.hpp"
 
+#include "engine/Camera.hpp"
 #include "engine/components/Animation.hpp"
 #include "engine/components/MoveableActor.hpp"
 #include "engine/components/sgTransform.hpp"
 #include "engine/Cursor.hpp"
+#include "engine/Settings.hpp"
+#include "engine/TimerWheel.hpp"
 #include "engine/systems/ActorMovementSystem.hpp"
 
 #include "raylib.h"
@@ -47,8 +50,7 @@ namespace lq
         auto onDestinationUnreachable = [this](const entt::entity e, const Vector3 requestedPos) {
             ChangeState(
                 e,
-                PartyMemberDestinationUnreachableState{
-                    .originalDestination = requestedPos, .timeStart = GetTime()});
+                PartyMemberDestinationUnreachableState{.originalDestination = requestedPos});
         };
 
         state.BindSubscription(moveable.onDestinationReached.Subscribe(onTargetReached));
@@ -67,7 +69,7 @@ namespace lq
         sys->engine.actorMovementSystem->CancelMovement(entity);
     }
 
-    void PartyMemberStateMachine::update(PartyMemberFollowingLeaderState&, const entt::entity entity)
+    void PartyMemberStateMachine::update(PartyMemberFollowingLeaderState&, const entt::entity entity, float)
     {
         const auto& partyMember = registry->get<PartyMemberComponent>(entity);
         assert(partyMember.followTarget.has_value());
@@ -119,7 +121,7 @@ namespace lq
         registry->get<sage::MoveableActor>(entity).movementCollisionTarget.reset();
     }
 
-    void PartyMemberStateMachine::update(PartyMemberWaitingForLeaderState&, const entt::entity entity)
+    void PartyMemberStateMachine::update(PartyMemberWaitingForLeaderState&, const entt::entity entity, float)
     {
         if (entity == sys->selectionSystem->GetSelectedActor())
         {
@@ -147,16 +149,37 @@ namespace lq
     static constexpr float RETRY_TIME_THRESHOLD = 1.5f;
     static constexpr unsigned int MAX_TRIES = 10;
 
-    void PartyMemberStateMachine::onEnter(PartyMemberDestinationUnreachableState&, const entt::entity entity)
+    void PartyMemberStateMachine::onEnter(PartyMemberDestinationUnreachableState& s, const entt::entity entity)
     {
         registry->get<sage::Animation>(entity).ChangeAnimationById(lq::animation_ids::Idle);
+        scheduleRetry(s, entity);
     }
 
-    void PartyMemberStateMachine::update(
+    void PartyMemberStateMachine::onExit(PartyMemberDestinationUnreachableState& s, const entt::entity)
+    {
+        sys->engine.timerWheel->Cancel(s.retryTimer);
+        s.retryTimer = {};
+    }
+
+    void PartyMemberStateMachine::scheduleRetry(
         PartyMemberDestinationUnreachableState& s, const entt::entity entity)
     {
+        s.retryTimer =
+            sys->engine.timerWheel->Schedule(RETRY_TIME_THRESHOLD, [this, entity]() { retryDestination(entity); });
+    }
+
+    void PartyMemberStateMachine::retryDestination(const entt::entity entity)
+    {
+        auto& state = registry->get<PartyMemberState>(entity);
+        auto& s = std::get<PartyMemberDestinationUnreachableState>(state.current);
+        s.retryTimer = {};
+
         auto& moveable = registry->get<sage::MoveableActor>(entity);
-        if (moveable.IsMoving()) return;
+        if (moveable.IsMoving())
+        {
+            scheduleRetry(s, entity);
+            return;
+        }
 
         if (s.tryCount >= MAX_TRIES)
         {
@@ -166,10 +189,7 @@ namespace lq
             return;
         }
 
-        if (GetTime() < s.timeStart + RETRY_TIME_THRESHOLD) return;
-
         ++s.tryCount;
-        s.timeStart = GetTime();
         if (sys->engine.actorMovementSystem->TryPathfindToLocation(entity, s.originalDestination, true))
         {
             ChangeState(entity, PartyMemberFollowingLeaderState{});
@@ -186,6 +206,7 @@ namespace lq
         {
             s.tryCount = 0;
         }
+        scheduleRetry(s, entity);
     }
 
     // ====== Cross-state handlers ====================================================
@@ -200,12 +221,21 @@ namespace lq
 
     void PartyMemberStateMachine::Update()
     {
-        for (const auto view = registry->view<PartyMemberState>(); const auto& entity : view)
-        {
-            assert(!registry->any_of<PlayerState>(entity));
-            auto& state = registry->get<PartyMemberState>(entity);
-            std::visit([this, entity](auto& cur) { update(cur, entity); }, state.current);
-        }
+        const auto selected = sys->selectionSystem->GetSelectedActor();
+        const auto& camera = *sys->engine.camera->getRaylibCam();
+        const Vector3 focus = selected != entt::null && registry->valid(selected)
+                                  ? registry->get<sage::sgTransform>(selected).GetWorldPos()
+                                  : camera.target;
+
+        updateScheduled(
+            registry->view<PartyMemberState>(),
+            sys->engine.settings->aiUpdate,
+            GetFrameTime(),
+            [this, focus, &camera](const entt::entity entity) {
+                assert(!registry->any_of<PlayerState>(entity));
+                const auto& pos = registry->get<sage::sgTransform>(entity).GetWorldPos();
+                return sage::ClassifyUpdateBucket(sys->engine.settings->aiUpdate, pos, focus, camera, false);
+            });
     }
 
     void PartyMemberStateMachine::Draw3D()
@@ -223,6 +253,15 @@ namespace lq
         std::visit([this, entity](auto& cur) { onEnter(cur, entity); }, state.current);
     }
 
+    void PartyMemberStateMachine::onComponentRemoved(const entt::entity entity)
+    {
+        const auto& state = registry->get<PartyMemberState>(entity);
+        if (const auto* s = std::get_if<PartyMemberDestinationUnreachableState>(&state.current))
+        {
+            sys->engine.timerWheel->Cancel(s->retryTimer);
+        }
+    }
+
     PartyMemberStateMachine::PartyMemberStateMachine(entt::registry* _registry, Systems* _sys)
         : Base(_registry), sys(_sys)
     {
@@ -23,34 +23,34 @@ namespace lq
         void onExit(PartyMemberDefaultState&, entt::entity)
         {
         }
-        void update(PartyMemberDefaultState&, entt::entity)
+        void update(PartyMemberDefaultState&, entt::entity, float)
         {
         }
 
         // ===== FollowingLeader =====
         void onEnter(PartyMemberFollowingLeaderState&, entt::entity entity);
         void onExit(PartyMemberFollowingLeaderState&, entt::entity entity);
-        void update(PartyMemberFollowingLeaderState&, entt::entity entity);
+        void update(PartyMemberFollowingLeaderState&, entt::entity entity, float dt);
 
         // ===== WaitingForLeader =====
         void onEnter(PartyMemberWaitingForLeaderState&, entt::entity entity);
         void onExit(PartyMemberWaitingForLeaderState&, entt::entity entity);
-        void update(PartyMemberWaitingForLeaderState&, entt::entity entity);
+        void update(PartyMemberWaitingForLeaderState&, entt::entity entity, float dt);
 
         // ===== DestinationUnreachable =====
         void onEnter(PartyMemberDestinationUnreachableState& s, entt::entity entity);
-        void onExit(PartyMemberDestinationUnreachableState&, entt::entity)
+        void onExit(PartyMemberDestinationUnreachableState& s, entt::entity);
+        void update(PartyMemberDestinationUnreachableState&, entt::entity, float)
         {
         }
-        void update(PartyMemberDestinationUnreachableState& s, entt::entity entity);
+        void scheduleRetry(PartyMemberDestinationUnreachableState& s, entt::entity entity);
+        void retryDestination(entt::entity entity);
 
         void onLeaderMove(entt::entity entity);
         void onFollowingTargetPathChanged(entt::entity entity, entt::entity target);
 
         void onComponentAdded(entt::entity entity);
-        void onComponentRemoved(entt::entity) const
-        {
-        }
+        void onComponentRemoved(entt::entity entity);
 
       public:
         void Update();
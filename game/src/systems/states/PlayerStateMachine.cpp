@@ -43,8 +43,7 @@ namespace lq
         const auto party = sys->partySystem->GetAllMembers();
         for (const auto& member : party)
         {
-            const auto& collideable = registry->get<sage::Collideable>(member);
-            sys->engine.navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, false);
+            sys->engine.navigationGridSystem->UnstampActor(member);
         }
 
         if (sys->engine.actorMovementSystem->TryPathfindToLocation(
@@ -66,7 +65,7 @@ namespace lq
         for (const auto& member : party)
         {
             const auto& collideable = registry->get<sage::Collideable>(member);
-            sys->engine.navigationGridSystem->MarkSquareAreaOccupied(collideable.worldBoundingBox, true);
+            sys->engine.navigationGridSystem->StampActor(member, collideable.worldBoundingBox);
         }
     }
 
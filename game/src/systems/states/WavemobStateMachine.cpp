@@ -4,22 +4,31 @@
 #include "Systems.hpp"
 
 #include "AbilityFactory.hpp"
-#include "collision/RpgCollisionLayers.hpp"
 #include "components/Ability.hpp"
 #include "components/CombatableActor.hpp"
 
+#include "engine/Camera.hpp"
 #include "engine/components/Animation.hpp"
 #include "engine/components/DeleteEntityComponent.hpp"
 #include "engine/components/MoveableActor.hpp"
 #include "engine/components/sgTransform.hpp"
+#include "engine/Settings.hpp"
+#include "engine/SpatialQuery.hpp"
 #include "engine/systems/ActorMovementSystem.hpp"
 #include "engine/systems/CollisionSystem.hpp"
 #include "engine/systems/NavigationGridSystem.hpp"
+#include "engine/systems/VisibilitySystem.hpp"
 
 #include "raylib.h"
 
 namespace lq
 {
+    namespace
+    {
+        // Distance at which an idle wavemob notices a player.
+        constexpr float AGGRO_RADIUS = 12.0f;
+    } // namespace
+
     // ====== WavemobDefaultState =====================================================
 
     void WavemobStateMachine::onEnter(WavemobDefaultState&, const entt::entity entity)
@@ -27,6 +36,41 @@ namespace lq
         registry->get<sage::Animation>(entity).ChangeAnimationById(lq::animation_ids::Idle);
     }
 
+    void WavemobStateMachine::update(WavemobDefaultState&, const entt::entity entity, float)
+    {
+        const auto target = findNearestPlayer(entity);
+        if (target == entt::null) return;
+
+        requestLineOfSight(entity, target, [this, entity, target](const bool visible) {
+            if (!visible || !isInState<WavemobDefaultState>(entity) || !registry->valid(target)) return;
+            registry->get<CombatableActor>(entity).target = target;
+            ChangeState(entity, WavemobTargetOutOfRangeState{});
+        });
+    }
+
+    entt::entity WavemobStateMachine::findNearestPlayer(const entt::entity entity) const
+    {
+        const auto& pos = registry->get<sage::sgTransform>(entity).GetWorldPos();
+        const auto candidates =
+            sys->engine.spatialQuery->QueryRadius(pos, AGGRO_RADIUS, [this](const entt::entity e) {
+                const auto* combatable = registry->try_get<CombatableActor>(e);
+                return combatable && combatable->actorType == CombatableActorType::PLAYER && !combatable->dying;
+            });
+
+        entt::entity nearest = entt::null;
+        float nearestDistance = AGGRO_RADIUS * AGGRO_RADIUS;
+        for (const auto candidate : candidates)
+        {
+            const auto& candidatePos = registry->get<sage::sgTransform>(candidate).GetWorldPos();
+            if (const float distance = Vector3DistanceSqr(pos, candidatePos); distance <= nearestDistance)
+            {
+                nearest = candidate;
+                nearestDistance = distance;
+            }
+        }
+        return nearest;
+    }
+
     // ====== WavemobTargetOutOfRangeState ============================================
 
     void WavemobStateMachine::onEnter(WavemobTargetOutOfRangeState&, const entt::entity entity)
@@ -54,45 +98,32 @@ namespace lq
         registry->get<sage::MoveableActor>(entity).movementCollisionTarget.reset();
     }
 
-    void WavemobStateMachine::update(WavemobTargetOutOfRangeState&, const entt::entity entity)
+    void WavemobStateMachine::update(WavemobTargetOutOfRangeState&, const entt::entity entity, float)
     {
         const auto& combatable = registry->get<CombatableActor>(entity);
-        if (combatable.target == entt::null || isTargetOutOfSight(entity))
+        if (combatable.target == entt::null)
         {
             ChangeState(entity, WavemobDefaultState{});
+            return;
         }
+
+        const auto target = combatable.target;
+        requestLineOfSight(entity, target, [this, entity, target](const bool visible) {
+            if (visible || !isInState<WavemobTargetOutOfRangeState>(entity)) return;
+            auto& current = registry->get<CombatableActor>(entity);
+            if (current.target != target) return;
+            // Lost line of sight, out of combat
+            current.target = entt::null;
+            ChangeState(entity, WavemobDefaultState{});
+        });
     }
 
-    bool WavemobStateMachine::isTargetOutOfSight(const entt::entity entity) const
+    void WavemobStateMachine::requestLineOfSight(
+        const entt::entity entity, const entt::entity target, std::function<void(bool)> onResult) const
     {
-        auto& combatable = registry->get<CombatableActor>(entity);
-        auto& trans = registry->get<sage::sgTransform>(entity);
-        auto& collideable = registry->get<sage::Collideable>(entity);
-
-        const auto& targetPos = registry->get<sage::sgTransform>(combatable.target).GetWorldPos();
-        Vector3 direction = Vector3Subtract(targetPos, trans.GetWorldPos());
-        const float distance = Vector3Distance(trans.GetWorldPos(), targetPos);
-        const Vector3 normDirection = Vector3Normalize(direction);
-
-        Ray ray;
-        ray.position = trans.GetWorldPos();
-        ray.direction = Vector3Scale(normDirection, distance);
-        const float height = Vector3Subtract(collideable.localBoundingBox.max, collideable.localBoundingBox.min).y;
-        ray.position.y = trans.GetWorldPos().y + height;
-        ray.direction.y = trans.GetWorldPos().y + height;
-        trans.movementDirectionDebugLine = ray;
-
-        const auto collisions =
-            sys->engine.collisionSystem->GetCollisionsWithRay(entity, ray, collideable.collidesWith);
-
-        if (!collisions.empty() && collisions.at(0).collisionLayer != lq::collision_layers::Player)
-        {
-            // Lost line of sight, out of combat
-            combatable.target = entt::null;
-            trans.movementDirectionDebugLine = {};
-            return true;
-        }
-        return false;
+        const auto& pos = registry->get<sage::sgTransform>(entity).GetWorldPos();
+        const auto& targetPos = registry->get<sage::sgTransform>(target).GetWorldPos();
+        sys->engine.visibilitySystem->Request(pos, targetPos, std::move(onResult));
     }
 
     void WavemobStateMachine::onTargetPosUpdate(const entt::entity entity, const entt::entity target) const
@@ -116,7 +147,7 @@ namespace lq
         registry->get<Ability>(abilityEntity).cancelCast.Publish(abilityEntity);
     }
 
-    void WavemobStateMachine::update(WavemobCombatState&, const entt::entity entity)
+    void WavemobStateMachine::update(WavemobCombatState&, const entt::entity entity, float)
     {
         const auto& combatable = registry->get<CombatableActor>(entity);
         if (combatable.dying || combatable.target == entt::null)
@@ -142,8 +173,7 @@ namespace lq
         auto& combatable = registry->get<CombatableActor>(entity);
         combatable.target = entt::null;
         combatable.dying = true;
-        const auto& bb = registry->get<sage::Collideable>(entity).worldBoundingBox;
-        sys->engine.navigationGridSystem->MarkSquareAreaOccupied(bb, false);
+        sys->engine.navigationGridSystem->UnstampActor(entity);
 
         auto& animation = registry->get<sage::Animation>(entity);
         animation.ChangeAnimationById(lq::animation_ids::Death, true);
@@ -180,13 +210,27 @@ namespace lq
 
     // ====== Lifecycle ===============================================================
 
+    sage::UpdateBucket WavemobStateMachine::classifyUpdate(const entt::entity entity, const Vector3 focus) const
+    {
+        // Anything past idle is reacting to a target and needs every frame.
+        const bool critical = !isInState<WavemobDefaultState>(entity);
+        const auto& pos = registry->get<sage::sgTransform>(entity).GetWorldPos();
+        return sage::ClassifyUpdateBucket(
+            sys->engine.settings->aiUpdate, pos, focus, *sys->engine.camera->getRaylibCam(), critical);
+    }
+
     void WavemobStateMachine::Update()
     {
-        for (const auto view = registry->view<WavemobState>(); const auto& entity : view)
-        {
-            auto& state = registry->get<WavemobState>(entity);
-            std::visit([this, entity](auto& cur) { update(cur, entity); }, state.current);
-        }
+        const auto selected = sys->selectionSystem->GetSelectedActor();
+        const Vector3 focus = selected != entt::null && registry->valid(selected)
+                                  ? registry->get<sage::sgTransform>(selected).GetWorldPos()
+                                  : sys->engine.camera->getRaylibCam()->target;
+
+        updateScheduled(
+            registry->view<WavemobState>(),
+            sys->engine.settings->aiUpdate,
+            GetFrameTime(),
+            [this, focus](const entt::entity entity) { return classifyUpdate(entity, focus); });
     }
 
     void WavemobStateMachine::Draw3D()
@@ -6,6 +6,7 @@
 
 #include "entt/entt.hpp"
 
+#include <functional>
 #include <variant>
 
 namespace lq
@@ -31,35 +32,44 @@ namespace lq
         void onExit(WavemobDefaultState&, entt::entity)
         {
         }
-        void update(WavemobDefaultState&, entt::entity)
-        {
-        }
+        void update(WavemobDefaultState&, entt::entity entity, float dt);
 
         // ===== TargetOutOfRange =====
         void onEnter(WavemobTargetOutOfRangeState&, entt::entity entity);
         void onExit(WavemobTargetOutOfRangeState&, entt::entity entity);
-        void update(WavemobTargetOutOfRangeState&, entt::entity entity);
+        void update(WavemobTargetOutOfRangeState&, entt::entity entity, float dt);
 
         // ===== Combat =====
         void onEnter(WavemobCombatState&, entt::entity entity);
         void onExit(WavemobCombatState&, entt::entity entity);
-        void update(WavemobCombatState&, entt::entity entity);
+        void update(WavemobCombatState&, entt::entity entity, float dt);
 
         // ===== Dying =====
         void onEnter(WavemobDyingState&, entt::entity entity);
         void onExit(WavemobDyingState&, entt::entity)
         {
         }
-        void update(WavemobDyingState&, entt::entity)
+        void update(WavemobDyingState&, entt::entity, float)
         {
         }
 
         void onHit(AttackData attackData);
         void onDeath(entt::entity entity);
-        [[nodiscard]] bool isTargetOutOfSight(entt::entity entity) const;
+        [[nodiscard]] entt::entity findNearestPlayer(entt::entity entity) const;
+        // Line of sight is resolved in a batch after all state machines update; onResult runs then.
+        void requestLineOfSight(entt::entity entity, entt::entity target, std::function<void(bool)> onResult) const;
+
+        template <typename State>
+        [[nodiscard]] bool isInState(const entt::entity entity) const
+        {
+            if (!registry->valid(entity)) return false;
+            const auto* state = registry->try_get<WavemobState>(entity);
+            return state && std::holds_alternative<State>(state->current);
+        }
         void onTargetPosUpdate(entt::entity entity, entt::entity target) const;
         void destroyEntity(entt::entity entity);
 
+        [[nodiscard]] sage::UpdateBucket classifyUpdate(entt::entity entity, Vector3 focus) const;
         void onComponentAdded(entt::entity entity);
         void onComponentRemoved(entt::entity) const
         {
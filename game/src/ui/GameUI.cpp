@@ -26,6 +26,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 
 namespace lq
 {
@@ -309,14 +310,30 @@ namespace lq
         onPortraitClicked.Publish(this);
     }
 
-    void PartyMemberPortrait::Draw2D()
+    void PartyMemberPortrait::PollChanges()
     {
-        const auto entity = GetMember();
-        if (entity == entt::null) return;
-        if (isSelectedProvider && isSelectedProvider())
+        const auto currentMember = GetMember();
+        const bool currentSelected = currentMember != entt::null && isSelectedProvider && isSelectedProvider();
+        if (currentMember != member || currentSelected != selected)
+        {
+            member = currentMember;
+            selected = currentSelected;
+            MarkDirty();
+        }
+        // The selected portrait keeps the hover highlight after the mouse leaves it.
+        if (selected && !shader.has_value())
         {
             SetHoverShader();
         }
+        else if (!selected && shader.has_value() && std::holds_alternative<sage::IdleState>(state))
+        {
+            RemoveShader();
+        }
+    }
+
+    void PartyMemberPortrait::Draw2D()
+    {
+        if (member == entt::null) return;
 
         DrawTextureRec(
             tex, {0, 0, static_cast<float>(tex.width), static_cast<float>(-tex.height)}, {rec.x, rec.y}, WHITE);
@@ -425,19 +442,28 @@ namespace lq
         }
     }
 
-    void AbilitySlot::Draw2D()
+    void AbilitySlot::PollChanges()
     {
         const bool ready = !cooldownReadyProvider || cooldownReadyProvider();
-        if (ready)
-        {
-            ImageBox::Draw2D();
-        }
-        else
+        if (ready == cooldownReady) return;
+        cooldownReady = ready;
+        MarkDirty();
+    }
+
+    void AbilitySlot::Draw2D()
+    {
+        if (cooldownReady)
         {
-            SetGrayscale();
             ImageBox::Draw2D();
-            RemoveShader();
+            return;
         }
+        // Swapped in for this draw only: SetGrayscale would mark the slot dirty again, and would
+        // lose the hover shader.
+        const auto previous = std::exchange(
+            shader,
+            sage::ResourceManager::GetInstance().ShaderLoad(nullptr, "resources/shaders/glsl330/grayscale.fs"));
+        ImageBox::Draw2D();
+        shader = previous;
     }
 
     void AbilitySlot::OnClick()
@@ -149,6 +149,9 @@ namespace lq
         Texture portraitBgTex{};
         int width;
         int height;
+        // As last drawn; see PollChanges.
+        entt::entity member = entt::null;
+        bool selected = false;
 
       public:
         std::function<entt::entity()> memberProvider;
@@ -164,6 +167,7 @@ namespace lq
         void HoverUpdate() override;
         void UpdateDimensions() override;
         void RetrieveInfo() override;
+        void PollChanges() override;
         void ReceiveDrop(CellElement* droppedElement) override;
         void OnClick() override;
         void Draw2D() override;
@@ -182,13 +186,16 @@ namespace lq
 
     class AbilitySlot : public sage::ImageBox
     {
+        bool cooldownReady = true; // As last drawn; see PollChanges
+
       public:
         // Identity tag used by the factory to wire callbacks, and by drag/drop to
         // distinguish source slots in a swap. Pure data — no system coupling.
         unsigned int slotNumber{};
 
         // Providers — caller (factory) supplies these to bridge to whichever game
-        // system owns the underlying data. Slot calls them on demand.
+        // system owns the underlying data. Slot calls them on demand, except
+        // cooldownReadyProvider, which is polled once a frame.
         std::function<Texture()> iconProvider;
         std::function<bool()> isInteractiveProvider;
         std::function<bool()> cooldownReadyProvider;
@@ -199,6 +206,7 @@ namespace lq
         sage::Event<AbilitySlot*> onSwapRequested;
 
         void RetrieveInfo() override;
+        void PollChanges() override;
         void ReceiveDrop(CellElement* droppedElement) override;
         void HoverUpdate() override;
         void Draw2D() override;
@@ -20,6 +20,7 @@
 #include "engine/components/Renderable.hpp"
 #include "engine/Cursor.hpp"
 #include "engine/ResourceManager.hpp"
+#include "engine/ui/TextLayoutCache.hpp"
 
 #include "magic_enum.hpp"
 
@@ -262,8 +263,8 @@ namespace lq
 
             // Both measurements come back in viewport pixels; we keep everything
             // in viewport-coord from here on.
-            const Vector2 headerSize =
-                MeasureTextEx(fontInfo.font, header.c_str(), fontInfo.fontSize, fontInfo.fontSpacing);
+            const Vector2 headerSize = sage::TextLayoutCache::GetInstance().Measure(
+                fontInfo.font, header, fontInfo.fontSize, fontInfo.fontSpacing);
             const float bodyHeight = sage::TextBox::WrappedHeight(fontInfo, body, availableTextWidth);
 
             const float rowGap = 10.0f * scaleFactor;
@@ -7,6 +7,8 @@
 #include "engine/components/Spawner.hpp"
 #include "engine/Light.hpp"
 #include "engine/Serializer.hpp"
+#include "engine/StaticInstancer.hpp"
+#include "engine/StaticMeshBatcher.hpp"
 #include "engine/ViewSerializer.hpp"
 
 #include "components/DialogComponent.hpp"
@@ -116,6 +118,8 @@ namespace lq::maploader
                         std::cerr << "ERROR: Serialization error: " << e.what() << std::endl;
                         break;
                     }
+                    // Bounds were filled after the emplace; let SpatialQuery re-index them.
+                    destination->patch<sage::Collideable>(entt);
                 }
 
                 while (stream.peek() != EOF)
@@ -136,6 +140,7 @@ namespace lq::maploader
                         std::cerr << "ERROR: Serialization error: " << e.what() << std::endl;
                         break;
                     }
+                    destination->patch<sage::Collideable>(entt);
 
                     if (renderable.GetName().find("_DOOR_") != std::string::npos)
                     {
@@ -152,6 +157,18 @@ namespace lq::maploader
                 }
             });
 
+        // Doors move and interactables/chests/items are highlighted or removed individually.
+        const auto isStaticProp = [destination](entt::entity entity) {
+            return !destination->any_of<
+                sage::DoorBehaviorComponent,
+                DialogComponent,
+                InventoryComponent,
+                ItemComponent>(entity);
+        };
+        // Repeated props are instanced first; whatever is left is merged into batches.
+        sage::InstanceStaticProps(destination, isStaticProp);
+        sage::BatchStaticMeshes(destination, isStaticProp);
+
         std::cout << "FINISH: Loading map data from file." << std::endl;
     }
 } // namespace lq::maploader
\ No newline at end of file
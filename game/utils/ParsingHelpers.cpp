@@ -4,46 +4,11 @@
 
 #include "ParsingHelpers.hpp"
 
-#include "components/QuestComponents.hpp"
-#include "QuestManager.hpp"
-#include "Systems.hpp"
-#include "systems/PartySystem.hpp"
-
-#include "engine/components/Renderable.hpp"
-#include "engine/systems/RenderSystem.hpp"
-
 #include <regex>
-#include <sstream>
 
 namespace lq::parsing
 {
 
-    std::string removeCommentsFromFile(const std::string& fileContents)
-    {
-        std::stringstream ss(fileContents);
-        std::string out;
-        out.reserve(fileContents.length()); // Worth it? What if the comments take up a huge amount of space?
-        std::string buff;
-        while (std::getline(ss, buff, '\n'))
-        {
-            buff = trim(buff);
-            if (buff.starts_with("//"))
-            {
-                continue;
-            }
-            auto commentPos = buff.find("//");
-            if (commentPos != std::string::npos)
-            {
-                out.append(buff.substr(0, commentPos) + '\n');
-            }
-            else
-            {
-                out.append(buff + '\n');
-            }
-        }
-        return out;
-    }
-
     std::string trim(const std::string& str)
     {
         const auto start = str.find_first_not_of(" \t\n\r");
@@ -51,27 +16,32 @@ namespace lq::parsing
         return (start == std::string::npos) ? "" : str.substr(start, end - start + 1);
     }
 
-    std::string trimWhiteSpaceFromFile(const std::string& fileContents)
+    std::vector<SourceLine> splitScriptLines(const std::string& fileContents)
     {
-        std::string out;
-        out.reserve(fileContents.length());
-
-        std::stringstream ss(fileContents);
-        std::string buff;
-        ;
-        while (std::getline(ss, buff, '\n'))
+        std::vector<SourceLine> lines;
+        int number = 0;
+        std::size_t start = 0;
+        while (start < fileContents.size())
         {
-            out.append(trim(buff) + "\n");
-        }
-        return out;
-    }
+            // "\r\n", "\r" and "\n" all end a line.
+            auto end = fileContents.find_first_of("\r\n", start);
+            if (end == std::string::npos) end = fileContents.size();
+            std::string line = trim(fileContents.substr(start, end - start));
+            ++number;
+            start = end + 1;
+            if (end + 1 < fileContents.size() && fileContents[end] == '\r' && fileContents[end + 1] == '\n')
+            {
+                ++start;
+            }
 
-    std::string normalizeLineEndings(const std::string& content)
-    {
-        std::string normalized = content;
-        normalized = std::regex_replace(normalized, std::regex("\r\n"), "\n");
-        normalized = std::regex_replace(normalized, std::regex("\r"), "\n");
-        return normalized;
+            if (line.starts_with("//")) continue;
+            if (const auto commentPos = line.find("//"); commentPos != std::string::npos)
+            {
+                line = trim(line.substr(0, commentPos));
+            }
+            lines.push_back({std::move(line), number});
+        }
+        return lines;
     }
 
     TextFunction getFunctionNameAndArgs(const std::string& input)
@@ -93,97 +63,4 @@ namespace lq::parsing
             return {trimmedInput, ""};
         }
     }
-
-    std::function<bool()> GetConditionalStatement(const std::string& line, entt::registry* registry, Systems* sys)
-    {
-        return [registry, sys, line]() -> bool {
-            auto quest_complete = [&](const std::string& params) -> bool {
-                const auto& quest = registry->get<Quest>(sys->questManager->GetQuest(params));
-                return quest.IsComplete();
-            };
-
-            auto quest_in_progress = [&](const std::string& params) -> bool {
-                const auto& quest = registry->get<Quest>(sys->questManager->GetQuest(params));
-                return quest.HasStarted() && !quest.IsComplete();
-            };
-
-            auto has_item = [&](const std::string& params) -> bool {
-                return sys->partySystem->CheckPartyHasItem(params);
-            };
-
-            auto quest_all_tasks_complete = [&](const std::string& params) -> bool {
-                const auto& quest = registry->get<Quest>(sys->questManager->GetQuest(params));
-                return quest.HasStarted() && quest.AllTasksComplete();
-            };
-
-            auto quest_task_complete = [&](const std::string& params) -> bool {
-                const auto entity = sys->engine.renderSystem->FindRenderable(params);
-                assert(entity != entt::null);
-                const auto& questComponent = registry->get<QuestTaskComponent>(entity);
-                return questComponent.IsComplete();
-            };
-
-            const std::unordered_map<std::string, std::function<bool(std::string)>> functionMap = {
-                {"quest_complete", quest_complete},
-                {"quest_in_progress", quest_in_progress},
-                {"has_item", has_item},
-                {"quest_all_tasks_complete", quest_all_tasks_complete},
-                {"quest_task_complete", quest_task_complete}};
-
-            bool out = false;
-            bool positive = true;
-            bool andCondition = false;
-            bool orCondition = false;
-            bool isFirstCondition = true;
-
-            std::stringstream condStream(trim(line.substr(line.find("if") + 2)));
-            std::string current;
-
-            while (std::getline(condStream, current, ' '))
-            {
-                if (current == "not")
-                {
-                    positive = false;
-                    continue;
-                }
-                if (current == "and")
-                {
-                    andCondition = true;
-                    continue;
-                }
-                if (current == "or")
-                {
-                    orCondition = true;
-                    continue;
-                }
-                auto func = getFunctionNameAndArgs(current);
-
-                assert(!func.name.empty());
-                assert(!func.params.empty());
-                assert(functionMap.contains(func.name));
-
-                auto funcResult = functionMap.at(func.name)(func.params);
-                const bool currentResult = positive == funcResult; // 'not'
-
-                if (isFirstCondition)
-                {
-                    isFirstCondition = false;
-                    out = currentResult;
-                }
-                else if (andCondition)
-                {
-                    out = out && currentResult;
-                }
-                else if (orCondition)
-                {
-                    out = out || currentResult;
-                }
-
-                positive = true;
-                andCondition = false;
-                orCondition = false;
-            }
-            return out;
-        };
-    }
 } // namespace lq::parsing
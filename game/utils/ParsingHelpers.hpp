@@ -4,12 +4,11 @@
 
 #pragma once
 
-#include "entt/entt.hpp"
 #include <string>
+#include <vector>
 
 namespace lq
 {
-    class Systems;
     namespace parsing
     {
         struct TextFunction
@@ -18,13 +17,17 @@ namespace lq
             std::string params;
         };
 
-        std::string removeCommentsFromFile(const std::string& fileContents);
+        struct SourceLine
+        {
+            std::string text;
+            int number; // 1-based, in the original file
+        };
+
         std::string trim(const std::string& str);
-        std::string trimWhiteSpaceFromFile(const std::string& fileContents);
-        std::string normalizeLineEndings(const std::string& content);
+        // Splits a script into trimmed lines with "//" comments removed. Lines that were only a comment
+        // are dropped; blank lines are kept.
+        std::vector<SourceLine> splitScriptLines(const std::string& fileContents);
         TextFunction getFunctionNameAndArgs(const std::string& input);
-        std::function<bool()> GetConditionalStatement(
-            const std::string& line, entt::registry* registry, Systems* sys);
 
     } // namespace parsing
 } // namespace lq
@@ -0,0 +1,638 @@
+//
+// Script compiler implementation. See ScriptCompiler.hpp.
+//
+
+#include "ScriptCompiler.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace lq::script
+{
+    using namespace parsing;
+
+    namespace
+    {
+        std::vector<std::pair<std::string, std::string>> extractVariables(const std::vector<SourceLine>& lines)
+        {
+            std::vector<std::pair<std::string, std::string>> variables;
+            bool inVariableBlock = false;
+            for (const auto& [text, number] : lines)
+            {
+                if (text == "<variables>")
+                {
+                    inVariableBlock = true;
+                }
+                else if (text == "</variables>")
+                {
+                    inVariableBlock = false;
+                }
+                else if (inVariableBlock)
+                {
+                    if (const auto colonPos = text.find(':'); colonPos != std::string::npos)
+                    {
+                        variables.emplace_back(trim(text.substr(0, colonPos)), trim(text.substr(colonPos + 1)));
+                    }
+                }
+            }
+            // Longest first, so "$questId" is not clobbered by a variable called "quest".
+            std::ranges::stable_sort(
+                variables, [](const auto& a, const auto& b) { return a.first.size() > b.first.size(); });
+            return variables;
+        }
+
+        void substituteVariables(std::vector<SourceLine>& lines)
+        {
+            const auto variables = extractVariables(lines);
+            for (auto& line : lines)
+            {
+                for (const auto& [name, value] : variables)
+                {
+                    const std::string token = "$" + name;
+                    for (auto pos = line.text.find(token); pos != std::string::npos;
+                         pos = line.text.find(token, pos + value.size()))
+                    {
+                        line.text.replace(pos, token.size(), value);
+                    }
+                }
+                line.text = trim(line.text);
+            }
+        }
+
+        std::string afterKey(const std::string& text, const std::string_view key)
+        {
+            return trim(text.substr(key.size()));
+        }
+
+        std::string_view argName(const ArgType arg)
+        {
+            switch (arg)
+            {
+            case ArgType::None:
+                return "no argument";
+            case ArgType::Quest:
+                return "a quest";
+            case ArgType::Renderable:
+                return "an object name";
+            case ArgType::Door:
+                return "a door name";
+            case ArgType::Item:
+                return "an item name";
+            case ArgType::Audio:
+                return "a sound name";
+            }
+            return "an argument";
+        }
+
+        std::string_view kindName(const FunctionKind kind)
+        {
+            switch (kind)
+            {
+            case FunctionKind::Predicate:
+                return "condition";
+            case FunctionKind::Command:
+                return "command";
+            case FunctionKind::OptionAction:
+                return "option action";
+            }
+            return "function";
+        }
+    } // namespace
+
+    std::uint32_t ScriptCompiler::intern(const std::string& str)
+    {
+        const auto [it, inserted] = stringIds.try_emplace(str, static_cast<std::uint32_t>(module.strings.size()));
+        if (inserted) module.strings.push_back(str);
+        return it->second;
+    }
+
+    void ScriptCompiler::error(const int line, std::string message)
+    {
+        errors.push_back({file, line, std::move(message)});
+    }
+
+    std::optional<Call> ScriptCompiler::compileCall(
+        const TextFunction& func, const FunctionKind kind, const int line)
+    {
+        const auto* info = FindFunction(func.name, kind);
+        if (!info)
+        {
+            error(line, std::format("unknown {} '{}'", kindName(kind), func.name));
+            return std::nullopt;
+        }
+        if (info->arg == ArgType::None)
+        {
+            if (!func.params.empty())
+            {
+                error(line, std::format("'{}' takes no argument", func.name));
+                return std::nullopt;
+            }
+            return Call{info->function, NONE};
+        }
+        if (func.params.empty())
+        {
+            error(line, std::format("'{}' needs {}", func.name, argName(info->arg)));
+            return std::nullopt;
+        }
+        return Call{info->function, intern(func.params)};
+    }
+
+    // "if [not] predicate(arg) [and|or [not] predicate(arg)]...", folded left to right.
+    std::uint32_t ScriptCompiler::compileCondition(const SourceLine& line)
+    {
+        Condition condition;
+        std::optional<Join> join;
+        bool negate = false;
+        bool ok = true;
+
+        std::istringstream words(line.text.substr(line.text.find("if") + 2));
+        std::string word;
+        while (words >> word)
+        {
+            if (word == "not")
+            {
+                negate = true;
+                continue;
+            }
+            if (word == "and" || word == "or")
+            {
+                if (join.has_value() || condition.terms.empty() || negate)
+                {
+                    error(line.number, std::format("unexpected '{}'", word));
+                    ok = false;
+                }
+                join = word == "and" ? Join::And : Join::Or;
+                continue;
+            }
+            if (!condition.terms.empty() && !join.has_value())
+            {
+                error(line.number, std::format("expected 'and' or 'or' before '{}'", word));
+                ok = false;
+            }
+
+            const auto call = compileCall(getFunctionNameAndArgs(word), FunctionKind::Predicate, line.number);
+            if (!call.has_value())
+            {
+                ok = false;
+            }
+            else
+            {
+                condition.terms.push_back({*call, condition.terms.empty() ? Join::First : *join, negate});
+            }
+            join.reset();
+            negate = false;
+        }
+        if (condition.terms.empty() || join.has_value() || negate)
+        {
+            error(line.number, "incomplete condition");
+            ok = false;
+        }
+        if (!ok) return NONE;
+
+        module.conditions.push_back(std::move(condition));
+        return static_cast<std::uint32_t>(module.conditions.size() - 1);
+    }
+
+    void ScriptCompiler::compileNodes(PendingConversation& pending)
+    {
+        std::unordered_map<std::string, std::uint32_t> nodeIndex;
+        for (const auto& node : pending.nodes)
+        {
+            const auto index = static_cast<std::uint32_t>(nodeIndex.size());
+            if (!nodeIndex.try_emplace(node.title, index).second)
+            {
+                error(node.line, std::format("duplicate node title '{}'", node.title));
+            }
+        }
+
+        for (const auto& pendingNode : pending.nodes)
+        {
+            if (nodeIndex.at(pendingNode.title) != pending.conversation.nodes.size()) continue; // Duplicate
+            auto& node = pending.conversation.nodes.emplace_back();
+            node.title = intern(pendingNode.title);
+            node.content = intern(pendingNode.content);
+
+            std::optional<SourceLine> ifLine;
+            std::uint32_t condition = NONE;
+            for (const auto& line : pendingNode.options)
+            {
+                if (line.text.starts_with("if"))
+                {
+                    if (ifLine.has_value())
+                    {
+                        // "if" blocks must be closed with "end". No nesting allowed (yet).
+                        error(line.number, std::format("'if' inside the 'if' on line {}", ifLine->number));
+                    }
+                    ifLine = line;
+                    condition = compileCondition(line);
+                }
+                else if (line.text == "end")
+                {
+                    if (!ifLine.has_value()) error(line.number, "'end' without 'if'");
+                    ifLine.reset();
+                    condition = NONE;
+                }
+                else if (line.text.starts_with("[["))
+                {
+                    if (!line.text.ends_with("]]")) error(line.number, "option is missing its closing ']]'");
+
+                    std::vector<std::string> parts;
+                    std::stringstream ss(line.text.substr(2)); // 2 == [[
+                    std::string part;
+                    while (std::getline(ss, part, '|'))
+                    {
+                        parts.push_back(trim(part));
+                    }
+                    if (!parts.empty())
+                    {
+                        auto& last = parts.back();
+                        last = trim(last.substr(0, last.find_first_of(']')));
+                    }
+                    if (parts.size() != 2 && parts.size() != 3)
+                    {
+                        error(line.number, "expected [[text | next]] or [[action | text | next]]");
+                        continue;
+                    }
+
+                    auto& option = node.options.emplace_back();
+                    option.condition = condition;
+                    option.description = intern(parts.at(parts.size() - 2));
+                    if (parts.size() == 3)
+                    {
+                        const auto action = getFunctionNameAndArgs(parts.at(0));
+                        option.action = compileCall(action, FunctionKind::OptionAction, line.number);
+                    }
+                    if (const auto& next = parts.back(); !next.empty() && next != "exit")
+                    {
+                        if (const auto it = nodeIndex.find(next); it != nodeIndex.end())
+                        {
+                            option.next = it->second;
+                        }
+                        else
+                        {
+                            error(line.number, std::format("option leads to unknown node '{}'", next));
+                        }
+                    }
+                }
+            }
+            if (ifLine.has_value()) error(ifLine->number, "'if' without 'end'");
+        }
+    }
+
+    void ScriptCompiler::finishConversation(std::optional<PendingConversation>& pending)
+    {
+        if (!pending.has_value()) return;
+        compileNodes(*pending);
+        module.conversations.push_back(std::move(pending->conversation));
+        pending.reset();
+    }
+
+    void ScriptCompiler::CompileDialog(const std::string& path, const std::string& source)
+    {
+        file = path;
+        auto lines = splitScriptLines(source);
+        substituteVariables(lines);
+
+        std::optional<PendingConversation> conversation;
+        PendingNode node;
+
+        auto readVector = [this](const SourceLine& line, const std::string_view key) -> std::optional<Vector3> {
+            std::istringstream iss(line.text.substr(key.size()));
+            Vector3 pos{0};
+            if (!(iss >> pos.x >> pos.y >> pos.z))
+            {
+                error(line.number, std::format("'{}' expects three numbers", key.substr(0, key.size() - 1)));
+                return std::nullopt;
+            }
+            return pos;
+        };
+        auto requireOwner = [this, &conversation](const SourceLine& line) {
+            if (conversation.has_value()) return true;
+            error(line.number, "expected 'owner:' first");
+            return false;
+        };
+
+        for (std::size_t i = 0; i < lines.size(); ++i)
+        {
+            const auto& line = lines[i];
+            const auto& text = line.text;
+            if (text == "<meta>")
+            {
+                // A new conversation
+                finishConversation(conversation);
+            }
+            else if (text.starts_with("owner:"))
+            {
+                finishConversation(conversation);
+                conversation.emplace();
+                conversation->conversation.owner = intern(afterKey(text, "owner:"));
+            }
+            else if (text.starts_with("speaker_name:"))
+            {
+                if (!requireOwner(line)) continue;
+                conversation->conversation.speaker = intern(afterKey(text, "speaker_name:"));
+            }
+            else if (text.starts_with("conversation_pos:"))
+            {
+                if (!requireOwner(line)) continue;
+                conversation->conversation.conversationPos = readVector(line, "conversation_pos:");
+            }
+            else if (text.starts_with("camera_pos:"))
+            {
+                if (!requireOwner(line)) continue;
+                conversation->conversation.cameraPos = readVector(line, "camera_pos:");
+            }
+            else if (text == "<node>")
+            {
+                node = {};
+                node.line = line.number;
+            }
+            else if (text.starts_with("title:"))
+            {
+                node.title = afterKey(text, "title:");
+            }
+            else if (text == "---")
+            {
+                node.content.clear();
+                for (++i; i < lines.size() && lines[i].text != "---"; ++i)
+                {
+                    node.content += lines[i].text + "\n";
+                }
+                if (i == lines.size()) error(line.number, "speaker text is missing its closing '---'");
+            }
+            else if (text.starts_with("if") || text == "end" || text.starts_with("[["))
+            {
+                node.options.push_back(line);
+            }
+            else if (text == "</node>")
+            {
+                if (!requireOwner(line)) continue;
+                if (node.title.empty())
+                {
+                    error(node.line, "node has no title");
+                    continue;
+                }
+                conversation->nodes.push_back(std::move(node));
+                node = {};
+            }
+        }
+        finishConversation(conversation);
+    }
+
+    void ScriptCompiler::CompileQuest(const std::string& path, const std::string& source)
+    {
+        file = path;
+        const auto lines = splitScriptLines(source);
+
+        auto& quest = module.quests.emplace_back();
+        quest.key = intern(fs::path(path).stem().string());
+
+        // Runs body on each line up to the closing tag, leaving i on it.
+        auto block = [this, &lines](std::size_t& i, const std::string_view close, auto&& body) {
+            const int open = lines[i].number;
+            for (++i; i < lines.size() && lines[i].text.find(close) == std::string::npos; ++i)
+            {
+                body(lines[i]);
+            }
+            if (i == lines.size()) error(open, std::format("missing '{}'", close));
+        };
+        auto commands = [this](std::vector<Call>& out) {
+            return [this, &out](const SourceLine& line) {
+                if (line.text.empty()) return;
+                if (auto call = compileCall(getFunctionNameAndArgs(line.text), FunctionKind::Command, line.number))
+                {
+                    out.push_back(*call);
+                }
+            };
+        };
+
+        for (std::size_t i = 0; i < lines.size(); ++i)
+        {
+            const auto& text = lines[i].text;
+            if (text.find("<meta>") != std::string::npos)
+            {
+                block(i, "</meta>", [this, &quest](const SourceLine& line) {
+                    if (line.text.find("title: ") != std::string::npos)
+                    {
+                        quest.title = intern(afterKey(line.text, "title: "));
+                    }
+                    // "giver:" is informational.
+                });
+            }
+            else if (text.find("<description>") != std::string::npos)
+            {
+                std::string description;
+                block(i, "</description>", [&description](const SourceLine& line) {
+                    description += line.text + "\n";
+                });
+                quest.description = intern(description);
+            }
+            else if (text.find("<tasks>") != std::string::npos)
+            {
+                block(i, "</tasks>", [this, &quest, &commands](const SourceLine& line) {
+                    if (line.text.empty()) return;
+                    // "dialog: <object>" or "item: <object>", then optionally "; Command(arg); ..."
+                    Task task;
+                    std::string_view key;
+                    if (line.text.find("dialog: ") != std::string::npos)
+                    {
+                        task.kind = TaskKind::Dialog;
+                        key = "dialog: ";
+                    }
+                    else if (line.text.find("item: ") != std::string::npos)
+                    {
+                        task.kind = TaskKind::Item;
+                        key = "item: ";
+                    }
+                    else
+                    {
+                        error(line.number, "expected 'dialog:' or 'item:' task");
+                        return;
+                    }
+                    const auto commandStartPos = line.text.find_first_of(';');
+                    task.target = intern(trim(line.text.substr(key.size(), commandStartPos - key.size())));
+
+                    if (commandStartPos != std::string::npos)
+                    {
+                        std::string commandLine = line.text.substr(commandStartPos + 1);
+                        std::erase_if(commandLine, [](const unsigned char c) { return std::isspace(c); });
+                        std::stringstream commandStream(commandLine);
+                        std::string command;
+                        while (std::getline(commandStream, command, ';'))
+                        {
+                            commands(task.onCompleted)({command, line.number});
+                        }
+                    }
+                    quest.tasks.push_back(std::move(task));
+                });
+            }
+            else if (text.find("<onStart>") != std::string::npos)
+            {
+                block(i, "</onStart>", commands(quest.onStart));
+            }
+            else if (text.find("<onComplete>") != std::string::npos)
+            {
+                block(i, "</onComplete>", commands(quest.onComplete));
+            }
+        }
+    }
+
+    void ScriptCompiler::CompileContextualDialog(const std::string& path, const std::string& source)
+    {
+        file = path;
+        const auto lines = splitScriptLines(source);
+        ContextualDialog dialog;
+
+        auto block = [this, &lines](std::size_t& i, const std::string_view close, auto&& body) {
+            const int open = lines[i].number;
+            for (++i; i < lines.size() && lines[i].text.find(close) == std::string::npos; ++i)
+            {
+                body(lines[i]);
+            }
+            if (i == lines.size()) error(open, std::format("missing '{}'", close));
+        };
+
+        for (std::size_t i = 0; i < lines.size(); ++i)
+        {
+            const auto& text = lines[i].text;
+            if (text.find("<meta>") != std::string::npos)
+            {
+                block(i, "</meta>", [this, &dialog](const SourceLine& line) {
+                    const auto& meta = line.text;
+                    if (meta.find("owner: ") != std::string::npos)
+                    {
+                        dialog.owner = intern(afterKey(meta, "owner: "));
+                    }
+                    else if (meta.find("distance: ") != std::string::npos)
+                    {
+                        try
+                        {
+                            dialog.distance = std::stof(afterKey(meta, "distance: "));
+                        }
+                        catch (const std::logic_error&)
+                        {
+                            error(line.number, "'distance' expects a number");
+                        }
+                    }
+                    else if (meta.find("speaker: ") != std::string::npos)
+                    {
+                        dialog.speaker = intern(afterKey(meta, "speaker: "));
+                    }
+                    else if (meta.find("loop: ") != std::string::npos)
+                    {
+                        dialog.loop = meta.find("true") != std::string::npos;
+                    }
+                    else if (meta.find("should_retrigger: ") != std::string::npos)
+                    {
+                        dialog.shouldRetrigger = meta.find("true") != std::string::npos;
+                    }
+                });
+            }
+            else if (text.find("<dialog>") != std::string::npos)
+            {
+                std::optional<int> ifLine;
+                std::uint32_t condition = NONE;
+                block(i, "</dialog>", [&](const SourceLine& line) {
+                    if (line.text.starts_with("if"))
+                    {
+                        if (ifLine.has_value())
+                        {
+                            error(line.number, std::format("'if' inside the 'if' on line {}", *ifLine));
+                        }
+                        ifLine = line.number;
+                        condition = compileCondition(line);
+                    }
+                    else if (line.text.starts_with("end"))
+                    {
+                        ifLine.reset();
+                        condition = NONE;
+                    }
+                    else
+                    {
+                        dialog.lines.push_back({intern(line.text), condition});
+                    }
+                });
+                if (ifLine.has_value()) error(*ifLine, "'if' without 'end'");
+            }
+            else if (text.find("<onTrigger>") != std::string::npos)
+            {
+                block(i, "</onTrigger>", [this, &dialog](const SourceLine& line) {
+                    if (line.text.empty()) return;
+                    if (auto call =
+                            compileCall(getFunctionNameAndArgs(line.text), FunctionKind::Command, line.number))
+                    {
+                        dialog.onTrigger.push_back(*call);
+                    }
+                });
+            }
+        }
+
+        if (dialog.owner == NONE)
+        {
+            error(0, "missing 'owner:'");
+            return;
+        }
+        module.contextualDialogs.push_back(std::move(dialog));
+    }
+
+    void ScriptCompiler::CompileDirectory(const std::string& resourcePath)
+    {
+        using CompileFn = void (ScriptCompiler::*)(const std::string&, const std::string&);
+        auto compileEach = [this](const fs::path& directory, const CompileFn compile) {
+            if (!fs::is_directory(directory))
+            {
+                file = directory.string();
+                error(0, "directory does not exist");
+                return;
+            }
+            std::vector<fs::path> paths;
+            for (const auto& entry : fs::directory_iterator(directory))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".txt") paths.push_back(entry.path());
+            }
+            std::ranges::sort(paths);
+
+            for (const auto& path : paths)
+            {
+                std::ifstream infile(path, std::ios::binary);
+                if (!infile)
+                {
+                    file = path.string();
+                    error(0, "could not open file");
+                    continue;
+                }
+                std::ostringstream contents;
+                contents << infile.rdbuf();
+                (this->*compile)(path.generic_string(), contents.str());
+            }
+        };
+
+        const fs::path root(resourcePath);
+        compileEach(root / "dialog", &ScriptCompiler::CompileDialog);
+        compileEach(root / "dialog" / "contextual", &ScriptCompiler::CompileContextualDialog);
+        compileEach(root / "quests", &ScriptCompiler::CompileQuest);
+    }
+
+    bool ScriptCompiler::HasErrors() const
+    {
+        return !errors.empty();
+    }
+
+    const std::vector<CompileError>& ScriptCompiler::GetErrors() const
+    {
+        return errors;
+    }
+
+    const ScriptModule& ScriptCompiler::GetModule() const
+    {
+        return module;
+    }
+} // namespace lq::script
@@ -0,0 +1,70 @@
+//
+// Compiles the text dialog, quest and contextual dialog scripts into a ScriptModule (ScriptIR.hpp).
+// Runs in the packer; problems are collected with their file and line instead of asserting at scene
+// load, so a broken script fails the pack and every mistake is reported at once.
+//
+
+#pragma once
+
+#include "ParsingHelpers.hpp"
+#include "ScriptIR.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lq::script
+{
+    struct CompileError
+    {
+        std::string file;
+        int line; // 0 when the error is about the file as a whole
+        std::string message;
+    };
+
+    class ScriptCompiler
+    {
+        ScriptModule module;
+        std::unordered_map<std::string, std::uint32_t> stringIds;
+        std::vector<CompileError> errors;
+        std::string file; // The file being compiled, for errors
+
+        struct PendingNode
+        {
+            std::string title;
+            std::string content;
+            std::vector<parsing::SourceLine> options;
+            int line = 0;
+        };
+
+        struct PendingConversation
+        {
+            Conversation conversation;
+            std::vector<PendingNode> nodes;
+        };
+
+        std::uint32_t intern(const std::string& str);
+        void error(int line, std::string message);
+        std::optional<Call> compileCall(const parsing::TextFunction& func, FunctionKind kind, int line);
+        std::uint32_t compileCondition(const parsing::SourceLine& line);
+        void compileNodes(PendingConversation& pending);
+        void finishConversation(std::optional<PendingConversation>& pending);
+
+      public:
+        // Text from resources/dialog. A file may hold several conversations, one per <meta> block.
+        void CompileDialog(const std::string& path, const std::string& source);
+        // Text from resources/quests. The quest's key is the file name without its extension.
+        void CompileQuest(const std::string& path, const std::string& source);
+        // Text from resources/dialog/contextual.
+        void CompileContextualDialog(const std::string& path, const std::string& source);
+        // Compiles every .txt script under resourcePath's dialog, dialog/contextual and quests
+        // directories, in name order so the output is stable.
+        void CompileDirectory(const std::string& resourcePath);
+
+        [[nodiscard]] bool HasErrors() const;
+        [[nodiscard]] const std::vector<CompileError>& GetErrors() const;
+        [[nodiscard]] const ScriptModule& GetModule() const;
+    };
+} // namespace lq::script
@@ -0,0 +1,48 @@
+//
+// What linked scripts ask of the game. ScriptLinker resolves names through it, linked conditions call
+// its predicates and bound commands and option actions call the rest, so neither the linker nor the
+// scripts reach into Systems directly (GameScriptHost is the game's implementation; tests substitute their own).
+//
+
+#pragma once
+
+#include "entt/entt.hpp"
+
+#include <string>
+
+namespace lq::script
+{
+    class ScriptHost
+    {
+      public:
+        // Used once, while linking. entt::null when the scene has no match.
+        [[nodiscard]] virtual entt::entity FindRenderable(const std::string& name) = 0;
+        [[nodiscard]] virtual entt::entity FindDoor(const std::string& name) = 0;
+        [[nodiscard]] virtual entt::entity FindQuest(const std::string& key) = 0;
+        [[nodiscard]] virtual bool IsQuestTask(entt::entity entity) = 0;
+
+        // Predicates
+        [[nodiscard]] virtual bool QuestComplete(entt::entity quest) = 0;
+        [[nodiscard]] virtual bool QuestInProgress(entt::entity quest) = 0;
+        [[nodiscard]] virtual bool QuestAllTasksComplete(entt::entity quest) = 0;
+        [[nodiscard]] virtual bool QuestTaskComplete(entt::entity task) = 0;
+        [[nodiscard]] virtual bool HasItem(const std::string& item) = 0;
+
+        // Commands
+        virtual void OpenDoor(entt::entity door) = 0;
+        virtual void JoinParty(entt::entity npc) = 0;
+        virtual void RemoveItem(const std::string& item) = 0;
+        virtual void GiveItem(const std::string& item) = 0;
+        virtual void PlaySFX(const std::string& name) = 0;
+        virtual void PlayMusic(const std::string& name) = 0;
+        virtual void DisableWorldItem(entt::entity item) = 0;
+        virtual void EndGame() = 0;
+
+        // Option actions, run when a dialog option is selected. owner has the conversation.
+        virtual void StartQuest(entt::entity quest) = 0;
+        virtual void CompleteQuest(entt::entity quest) = 0;
+        virtual void CompleteQuestTask(entt::entity quest, entt::entity owner) = 0;
+
+        virtual ~ScriptHost() = default;
+    };
+} // namespace lq::script
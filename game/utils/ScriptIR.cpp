@@ -0,0 +1,56 @@
+//
+// Script function table. See ScriptIR.hpp.
+//
+
+#include "ScriptIR.hpp"
+
+#include <array>
+#include <cassert>
+
+namespace lq::script
+{
+    namespace
+    {
+        // In Function order.
+        constexpr std::array FUNCTIONS{
+            FunctionInfo{Function::QuestComplete, FunctionKind::Predicate, ArgType::Quest, "quest_complete"},
+            FunctionInfo{Function::QuestInProgress, FunctionKind::Predicate, ArgType::Quest, "quest_in_progress"},
+            FunctionInfo{Function::HasItem, FunctionKind::Predicate, ArgType::Item, "has_item"},
+            FunctionInfo{
+                Function::QuestAllTasksComplete,
+                FunctionKind::Predicate,
+                ArgType::Quest,
+                "quest_all_tasks_complete"},
+            FunctionInfo{
+                Function::QuestTaskComplete, FunctionKind::Predicate, ArgType::Renderable, "quest_task_complete"},
+            FunctionInfo{Function::OpenDoor, FunctionKind::Command, ArgType::Door, "OpenDoor"},
+            FunctionInfo{Function::JoinParty, FunctionKind::Command, ArgType::Renderable, "JoinParty"},
+            FunctionInfo{Function::RemoveItem, FunctionKind::Command, ArgType::Item, "RemoveItem"},
+            FunctionInfo{Function::GiveItem, FunctionKind::Command, ArgType::Item, "GiveItem"},
+            FunctionInfo{Function::PlaySFX, FunctionKind::Command, ArgType::Audio, "PlaySFX"},
+            FunctionInfo{Function::PlayMusic, FunctionKind::Command, ArgType::Audio, "PlayMusic"},
+            FunctionInfo{
+                Function::DisableWorldItem, FunctionKind::Command, ArgType::Renderable, "DisableWorldItem"},
+            FunctionInfo{Function::EndGame, FunctionKind::Command, ArgType::None, "EndGame"},
+            FunctionInfo{Function::StartQuest, FunctionKind::OptionAction, ArgType::Quest, "start_quest"},
+            FunctionInfo{Function::CompleteQuest, FunctionKind::OptionAction, ArgType::Quest, "complete_quest"},
+            FunctionInfo{
+                Function::CompleteQuestTask, FunctionKind::OptionAction, ArgType::Quest, "complete_quest_task"}};
+    } // namespace
+
+    const FunctionInfo& GetFunctionInfo(const Function function)
+    {
+        const auto& info = FUNCTIONS[static_cast<std::size_t>(function)];
+        assert(info.function == function);
+        return info;
+    }
+
+    const FunctionInfo* FindFunction(const std::string_view name, const FunctionKind kind)
+    {
+        for (const auto& info : FUNCTIONS)
+        {
+            if (info.kind == kind && info.name == name) return &info;
+        }
+        return nullptr;
+    }
+} // namespace lq::script
@@ -0,0 +1,255 @@
+//
+// Compiled form of the dialog, quest and contextual dialog scripts (resources/dialog, resources/quests).
+// The packer parses the text once (ScriptCompiler) and stores a ScriptModule in the asset bin; scenes
+// build their conversations, quests and triggers straight from it without touching the text.
+//
+
+#pragma once
+
+#include "cereal/cereal.hpp"
+#include "cereal/types/optional.hpp"
+#include "cereal/types/string.hpp"
+#include "cereal/types/vector.hpp"
+#include "engine/raylib-cereal.hpp"
+#include "raylib.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lq::script
+{
+    // Index into the module's string table (or its condition/node lists) that refers to nothing.
+    inline constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    // Asset bin key the packer stores the module under.
+    inline constexpr auto MODULE_KEY = "scripts";
+
+    // Every function a script can name. Interned at compile time; unknown names are pack-time errors.
+    enum class Function : std::uint8_t
+    {
+        // Predicates, used in "if" lines
+        QuestComplete,
+        QuestInProgress,
+        HasItem,
+        QuestAllTasksComplete,
+        QuestTaskComplete,
+        // Commands, bound to quest and trigger events
+        OpenDoor,
+        JoinParty,
+        RemoveItem,
+        GiveItem,
+        PlaySFX,
+        PlayMusic,
+        DisableWorldItem,
+        EndGame,
+        // Dialog option actions, run when the option is selected
+        StartQuest,
+        CompleteQuest,
+        CompleteQuestTask
+    };
+
+    enum class FunctionKind : std::uint8_t
+    {
+        Predicate,
+        Command,
+        OptionAction
+    };
+
+    // What a function's argument names, so the loader knows how to resolve it.
+    enum class ArgType : std::uint8_t
+    {
+        None,
+        Quest,      // Quest key (its file name)
+        Renderable, // Renderable name
+        Door,       // Renderable name of an entity with a door
+        Item,       // Item name
+        Audio       // Sound or music name
+    };
+
+    struct FunctionInfo
+    {
+        Function function;
+        FunctionKind kind;
+        ArgType arg;
+        std::string_view name; // As written in scripts
+    };
+
+    [[nodiscard]] const FunctionInfo& GetFunctionInfo(Function function);
+    [[nodiscard]] const FunctionInfo* FindFunction(std::string_view name, FunctionKind kind);
+
+    struct Call
+    {
+        Function function{};
+        std::uint32_t arg = NONE; // String; NONE for functions without an argument
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(function, arg);
+        }
+    };
+
+    enum class Join : std::uint8_t
+    {
+        First,
+        And,
+        Or
+    };
+
+    // One predicate of a condition. Terms are folded left to right, with no precedence.
+    struct Term
+    {
+        Call call;
+        Join join = Join::First;
+        bool negate = false;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(call, join, negate);
+        }
+    };
+
+    struct Condition
+    {
+        std::vector<Term> terms;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(terms);
+        }
+    };
+
+    struct Option
+    {
+        std::uint32_t description = NONE;
+        std::uint32_t next = NONE;      // Node index; NONE ends the conversation
+        std::uint32_t condition = NONE; // Condition index; NONE always shows
+        std::optional<Call> action;     // OptionAction run on selection
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(description, next, condition, action);
+        }
+    };
+
+    struct Node
+    {
+        std::uint32_t title = NONE;
+        std::uint32_t content = NONE;
+        std::vector<Option> options;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(title, content, options);
+        }
+    };
+
+    // One <meta> block of a dialog file. The first node is where the conversation starts.
+    struct Conversation
+    {
+        std::uint32_t owner = NONE; // Renderable name
+        std::uint32_t speaker = NONE;
+        std::optional<Vector3> conversationPos; // Local to the owner
+        std::optional<Vector3> cameraPos;
+        std::vector<Node> nodes;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(owner, speaker, conversationPos, cameraPos, nodes);
+        }
+    };
+
+    enum class TaskKind : std::uint8_t
+    {
+        Dialog,
+        Item
+    };
+
+    struct Task
+    {
+        TaskKind kind{};
+        std::uint32_t target = NONE; // Renderable name
+        std::vector<Call> onCompleted;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(kind, target, onCompleted);
+        }
+    };
+
+    struct Quest
+    {
+        std::uint32_t key = NONE; // File name without extension
+        std::uint32_t title = NONE;
+        std::uint32_t description = NONE;
+        std::vector<Task> tasks;
+        std::vector<Call> onStart;
+        std::vector<Call> onComplete;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(key, title, description, tasks, onStart, onComplete);
+        }
+    };
+
+    struct ContextualLine
+    {
+        std::uint32_t text = NONE;
+        std::uint32_t condition = NONE;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(text, condition);
+        }
+    };
+
+    struct ContextualDialog
+    {
+        std::uint32_t owner = NONE; // Renderable name
+        std::uint32_t speaker = NONE;
+        std::optional<float> distance;
+        bool loop = false;
+        bool shouldRetrigger = false;
+        std::vector<ContextualLine> lines;
+        std::vector<Call> onTrigger;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(owner, speaker, distance, loop, shouldRetrigger, lines, onTrigger);
+        }
+    };
+
+    // Every shipped script. Strings are interned once across all of them.
+    struct ScriptModule
+    {
+        std::vector<std::string> strings;
+        std::vector<Condition> conditions;
+        std::vector<Conversation> conversations;
+        std::vector<Quest> quests;
+        std::vector<ContextualDialog> contextualDialogs;
+
+        [[nodiscard]] const std::string& String(std::uint32_t index) const
+        {
+            return strings.at(index);
+        }
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(strings, conditions, conversations, quests, contextualDialogs);
+        }
+    };
+} // namespace lq::script
@@ -0,0 +1,156 @@
+//
+// Script linker implementation. See ScriptLinker.hpp.
+//
+
+#include "ScriptLinker.hpp"
+
+#include "ScriptHost.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptVM.hpp"
+
+#include <cassert>
+#include <format>
+#include <utility>
+
+namespace lq::script
+{
+    namespace
+    {
+        bool evaluatePredicate(const ConditionProgram& program, const Instruction& instruction, ScriptHost* host)
+        {
+            switch (instruction.op)
+            {
+            case OpCode::QuestComplete:
+                return host->QuestComplete(instruction.entity);
+            case OpCode::QuestInProgress:
+                return host->QuestInProgress(instruction.entity);
+            case OpCode::QuestAllTasksComplete:
+                return host->QuestAllTasksComplete(instruction.entity);
+            case OpCode::QuestTaskComplete:
+                return host->QuestTaskComplete(instruction.entity);
+            case OpCode::HasItem:
+                return host->HasItem(program.String(instruction));
+            default:
+                assert(0); // Operators are handled by the program
+                return false;
+            }
+        }
+    } // namespace
+
+    entt::entity ScriptLinker::FindRenderable(const std::uint32_t name, const std::string_view context)
+    {
+        const auto& key = module.String(name);
+        auto it = renderables.find(key);
+        if (it == renderables.end())
+        {
+            it = renderables.emplace(key, host->FindRenderable(key)).first;
+        }
+        if (it->second == entt::null)
+        {
+            Error(std::format("{}: no renderable named '{}'", context, key));
+        }
+        return it->second;
+    }
+
+    entt::entity ScriptLinker::FindDoor(const std::uint32_t name, const std::string_view context)
+    {
+        const auto& key = module.String(name);
+        const auto entity = host->FindDoor(key);
+        if (entity == entt::null)
+        {
+            Error(std::format("{}: no door named '{}'", context, key));
+        }
+        return entity;
+    }
+
+    entt::entity ScriptLinker::FindQuest(const std::uint32_t key, const std::string_view context)
+    {
+        const auto& questKey = module.String(key);
+        const auto entity = host->FindQuest(questKey);
+        if (entity == entt::null)
+        {
+            Error(std::format("{}: no quest named '{}'", context, questKey));
+        }
+        return entity;
+    }
+
+    std::function<bool()> ScriptLinker::LinkCondition(const std::uint32_t condition)
+    {
+        const auto errorCount = errors.size();
+        ConditionProgram program;
+        for (const auto& term : module.conditions.at(condition).terms)
+        {
+            const auto& [function, arg] = term.call;
+            const auto name = GetFunctionInfo(function).name;
+            switch (function)
+            {
+            case Function::QuestComplete:
+                program.Push(OpCode::QuestComplete, FindQuest(arg, name));
+                break;
+            case Function::QuestInProgress:
+                program.Push(OpCode::QuestInProgress, FindQuest(arg, name));
+                break;
+            case Function::QuestAllTasksComplete:
+                program.Push(OpCode::QuestAllTasksComplete, FindQuest(arg, name));
+                break;
+            case Function::QuestTaskComplete: {
+                const auto entity = FindRenderable(arg, name);
+                if (entity != entt::null && !host->IsQuestTask(entity))
+                {
+                    Error(std::format("{}: '{}' is not a quest task", name, module.String(arg)));
+                }
+                program.Push(OpCode::QuestTaskComplete, entity);
+                break;
+            }
+            case Function::HasItem:
+                program.Push(OpCode::HasItem, module.String(arg));
+                break;
+            default:
+                Error(std::format("{}: not a condition", name));
+                return [] { return false; };
+            }
+
+            if (term.negate) program.Apply(OpCode::Not);
+            if (term.join == Join::And) program.Apply(OpCode::And);
+            if (term.join == Join::Or) program.Apply(OpCode::Or);
+        }
+
+        if (errors.size() != errorCount || !program.IsComplete())
+        {
+            return [] { return false; };
+        }
+        return [program = std::move(program), host = host]() {
+            return program.Evaluate(
+                [&](const Instruction& instruction) { return evaluatePredicate(program, instruction, host); });
+        };
+    }
+
+    void ScriptLinker::Error(std::string message)
+    {
+        errors.push_back(std::move(message));
+    }
+
+    bool ScriptLinker::HasErrors() const
+    {
+        return !errors.empty();
+    }
+
+    const std::vector<std::string>& ScriptLinker::GetErrors() const
+    {
+        return errors;
+    }
+
+    const ScriptModule& ScriptLinker::GetModule() const
+    {
+        return module;
+    }
+
+    ScriptHost* ScriptLinker::GetHost() const
+    {
+        return host;
+    }
+
+    ScriptLinker::ScriptLinker(const ScriptModule& _module, ScriptHost* _host) : module(_module), host(_host)
+    {
+    }
+} // namespace lq::script
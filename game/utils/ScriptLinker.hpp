@@ -0,0 +1,52 @@
+//
+// Binds a compiled ScriptModule to the loaded scene. Every name a script uses (quest keys, renderables,
+// doors) is resolved to its entity once here, through the ScriptHost, and conditions are linked into
+// ConditionPrograms (ScriptVM.hpp) that call the host's predicates. A name the scene does not have is
+// recorded as an error rather than asserted, so the scene can report every mismatch between the scripts
+// and the map at once.
+//
+
+#pragma once
+
+#include "entt/entt.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lq::script
+{
+    class ScriptHost;
+    struct ScriptModule;
+
+    class ScriptLinker
+    {
+        const ScriptModule& module;
+        ScriptHost* host;
+        std::unordered_map<std::string, entt::entity> renderables; // ScriptHost::FindRenderable, by name
+        std::vector<std::string> errors;
+
+      public:
+        // context names what is asking (e.g. the script function), for the error message.
+        // All return entt::null, having recorded an error, if the scene has no match.
+        [[nodiscard]] entt::entity FindRenderable(std::uint32_t name, std::string_view context);
+        [[nodiscard]] entt::entity FindDoor(std::uint32_t name, std::string_view context);
+        [[nodiscard]] entt::entity FindQuest(std::uint32_t key, std::string_view context);
+
+        // Quests must be initialised first: conditions resolve quest keys and quest task components.
+        // A condition that failed to link evaluates to false.
+        [[nodiscard]] std::function<bool()> LinkCondition(std::uint32_t condition);
+
+        void Error(std::string message);
+        [[nodiscard]] bool HasErrors() const;
+        [[nodiscard]] const std::vector<std::string>& GetErrors() const;
+        [[nodiscard]] const ScriptModule& GetModule() const;
+        // What bound commands call; must outlive them.
+        [[nodiscard]] ScriptHost* GetHost() const;
+
+        ScriptLinker(const ScriptModule& _module, ScriptHost* _host);
+    };
+} // namespace lq::script
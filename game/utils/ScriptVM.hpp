@@ -0,0 +1,119 @@
+//
+// Stack machine for script conditions ("if" lines). ScriptLinker turns a compiled Condition into a
+// ConditionProgram once at scene load: names are resolved to entities and the terms are laid out as
+// flat postfix code, so evaluating an option's condition is a walk over a few instructions with no
+// string handling or renderable searches.
+//
+
+#pragma once
+
+#include "entt/entt.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lq::script
+{
+    enum class OpCode : std::uint8_t
+    {
+        // Predicates; push one value
+        QuestComplete,         // entity: quest
+        QuestInProgress,       // entity: quest
+        QuestAllTasksComplete, // entity: quest
+        QuestTaskComplete,     // entity: renderable holding the QuestTaskComponent
+        HasItem,               // operand: item name
+        // Operators; pop their inputs and push the result
+        Not,
+        And,
+        Or
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        entt::entity entity = entt::null;
+        std::uint32_t operand = 0; // Into the program's strings
+    };
+
+    class ConditionProgram
+    {
+        std::vector<Instruction> code;
+        std::vector<std::string> strings;
+        std::size_t depth = 0; // Stack depth after the code emitted so far
+
+      public:
+        // Terms fold left to right, so the stack never holds more than two values.
+        static constexpr std::size_t STACK_SIZE = 4;
+
+        void Push(OpCode op, entt::entity entity)
+        {
+            assert(op < OpCode::Not && depth < STACK_SIZE);
+            code.push_back({op, entity});
+            ++depth;
+        }
+
+        void Push(OpCode op, std::string operand)
+        {
+            assert(op < OpCode::Not && depth < STACK_SIZE);
+            code.push_back({op, entt::null, static_cast<std::uint32_t>(strings.size())});
+            strings.push_back(std::move(operand));
+            ++depth;
+        }
+
+        void Apply(OpCode op)
+        {
+            assert(op == OpCode::Not ? depth >= 1 : op > OpCode::Not && depth >= 2);
+            code.push_back({op});
+            if (op != OpCode::Not) --depth;
+        }
+
+        [[nodiscard]] const std::string& String(const Instruction& instruction) const
+        {
+            return strings[instruction.operand];
+        }
+
+        [[nodiscard]] bool IsComplete() const
+        {
+            return depth == 1;
+        }
+
+        [[nodiscard]] const std::vector<Instruction>& GetCode() const
+        {
+            return code;
+        }
+
+        // predicate(const Instruction&) -> bool answers the predicate opcodes; every one is evaluated.
+        template <typename Predicate>
+        [[nodiscard]] bool Evaluate(Predicate&& predicate) const
+        {
+            std::array<bool, STACK_SIZE> stack{};
+            std::size_t top = 0;
+            for (const auto& instruction : code)
+            {
+                switch (instruction.op)
+                {
+                case OpCode::Not:
+                    stack[top - 1] = !stack[top - 1];
+                    break;
+                case OpCode::And:
+                    --top;
+                    stack[top - 1] = stack[top - 1] && stack[top];
+                    break;
+                case OpCode::Or:
+                    --top;
+                    stack[top - 1] = stack[top - 1] || stack[top];
+                    break;
+                default:
+                    stack[top++] = predicate(instruction);
+                    break;
+                }
+            }
+            assert(top == 1);
+            return stack[0];
+        }
+    };
+} // namespace lq::script
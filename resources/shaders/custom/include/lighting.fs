@@ -1,4 +1,4 @@
-#define     MAX_LIGHTS              50
+#define     MAX_LIGHTS              8 // Per object: LightManager uploads each object's nearest lights
 #define     LIGHT_DIRECTIONAL       0
 #define     LIGHT_POINT             1
 
@@ -61,10 +61,12 @@ void main()
 	
 	}
 	
-	fragPosition = vec3(matModel*vec4(vertexPosition, 1.0));
+	// Each instance shares the asset's mesh; only its bone palette differs, so lighting must
+	// use the skinned position/normal rather than the bind pose.
+	fragPosition = vec3(matModel*pos);
     fragTexCoord = vertexTexCoord;
     fragColor = vertexColor;
-    fragNormal = normalize(vec3(matNormal*vec4(vertexNormal, 1.0)));
+    fragNormal = normalize(vec3(matNormal*vec4(normal, 0.0)));
 
     // Calculate final vertex position
     gl_Position = mvp * pos;
@@ -0,0 +1,30 @@
+#version 330
+
+// Uber shader vertex stage for hardware-instanced static props (no skinning). Pairs with
+// ubershader.fs. Each instance's world transform arrives as a per-instance attribute.
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexColor;
+in mat4 instanceTransform;
+
+// raylib uploads mvp as view * projection for instanced draws
+uniform mat4 mvp;
+
+out vec3 fragPosition;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+
+void main()
+{
+    vec4 pos = instanceTransform * vec4(vertexPosition, 1.0);
+
+    fragPosition = vec3(pos);
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    fragNormal = normalize(transpose(inverse(mat3(instanceTransform))) * vertexNormal);
+
+    gl_Position = mvp * pos;
+}
@@ -0,0 +1,197 @@
+#include "AssetBuildCache.hpp"
+
+#include "cereal/types/common.hpp"
+#include "cereal/types/string.hpp"
+#include "cereal/types/unordered_map.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace sage
+{
+    namespace
+    {
+        constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+        constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+        void hashBytes(std::uint64_t& hash, const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * FNV_PRIME;
+            }
+        }
+
+        std::string blobFileName(const std::string& source, std::uint64_t hash, std::size_t index)
+        {
+            // Identical files under different names must not share blobs, so mix in the source.
+            std::uint64_t name = FNV_OFFSET;
+            hashBytes(name, source.data(), source.size());
+            hashBytes(name, &hash, sizeof(hash));
+            std::ostringstream out;
+            out << std::hex << std::setw(16) << std::setfill('0') << name << "_" << std::dec << index << ".blob";
+            return out.str();
+        }
+    } // namespace
+
+    std::string AssetBuildCache::manifestPath() const
+    {
+        return (fs::path(directory) / "manifest.bin").string();
+    }
+
+    // Hashes the packer settings together with each file's path and contents.
+    std::uint64_t AssetBuildCache::HashFiles(const std::vector<std::string>& paths) const
+    {
+        std::uint64_t hash = FNV_OFFSET;
+        hashBytes(hash, &settingsHash, sizeof(settingsHash));
+
+        std::vector<char> buffer(64 * 1024);
+        for (const auto& path : paths)
+        {
+            hashBytes(hash, path.data(), path.size() + 1);
+            std::ifstream file(path, std::ios::binary);
+            while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || file.gcount() > 0)
+            {
+                hashBytes(hash, buffer.data(), static_cast<std::size_t>(file.gcount()));
+            }
+        }
+        return hash;
+    }
+
+    bool AssetBuildCache::Fetch(const std::string& source, std::uint64_t hash, std::vector<EncodedAsset>& out)
+    {
+        CacheRecord record;
+        {
+            std::lock_guard lock(mutex);
+            const auto it = manifest.find(source);
+            if (!enabled || it == manifest.end() || it->second.hash != hash)
+            {
+                ++misses;
+                return false;
+            }
+            record = it->second;
+        }
+
+        std::vector<EncodedAsset> assets;
+        assets.reserve(record.assets.size());
+        for (const auto& cached : record.assets)
+        {
+            std::ifstream file(fs::path(directory) / cached.blobFile, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+            {
+                std::lock_guard lock(mutex);
+                ++misses;
+                return false;
+            }
+            EncodedAsset asset{cached.type, cached.key, {}};
+            asset.blob.data.resize(static_cast<std::size_t>(file.tellg()));
+            asset.blob.uncompressedSize = cached.uncompressedSize;
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(asset.blob.data.data()), static_cast<std::streamsize>(asset.blob.data.size()));
+            assets.push_back(std::move(asset));
+        }
+
+        out = std::move(assets);
+        std::lock_guard lock(mutex);
+        ++hits;
+        savedMs += record.buildMs;
+        return true;
+    }
+
+    void AssetBuildCache::Store(
+        const std::string& source, std::uint64_t hash, double buildMs, const std::vector<EncodedAsset>& assets)
+    {
+        CacheRecord record{hash, buildMs, {}};
+        record.assets.reserve(assets.size());
+        for (std::size_t i = 0; i < assets.size(); ++i)
+        {
+            const auto& asset = assets[i];
+            CachedAsset cached{asset.type, asset.key, blobFileName(source, hash, i), asset.blob.uncompressedSize};
+            std::ofstream file(fs::path(directory) / cached.blobFile, std::ios::binary);
+            file.write(
+                reinterpret_cast<const char*>(asset.blob.data.data()),
+                static_cast<std::streamsize>(asset.blob.data.size()));
+            record.assets.push_back(std::move(cached));
+        }
+
+        std::lock_guard lock(mutex);
+        rebuiltMs += buildMs;
+        if (const auto it = manifest.find(source); it != manifest.end())
+        {
+            // Blob names are derived from the source hash, so a changed source leaves stale files behind.
+            for (const auto& stale : it->second.assets)
+            {
+                const bool reused = std::ranges::any_of(
+                    record.assets, [&stale](const CachedAsset& a) { return a.blobFile == stale.blobFile; });
+                if (!reused) fs::remove(fs::path(directory) / stale.blobFile);
+            }
+        }
+        manifest[source] = std::move(record);
+    }
+
+    bool AssetBuildCache::IsUpToDate(const std::string& output, std::uint64_t hash)
+    {
+        std::lock_guard lock(mutex);
+        const auto it = manifest.find(output);
+        if (!enabled || it == manifest.end() || it->second.hash != hash || !fs::exists(output))
+        {
+            ++misses;
+            return false;
+        }
+        ++hits;
+        savedMs += it->second.buildMs;
+        return true;
+    }
+
+    void AssetBuildCache::Save()
+    {
+        std::lock_guard lock(mutex);
+        std::ofstream file(manifestPath(), std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "ERROR: AssetBuildCache -> Unable to write " << manifestPath() << std::endl;
+            return;
+        }
+        cereal::BinaryOutputArchive output(file);
+        output(PACKER_CACHE_VERSION, manifest);
+    }
+
+    void AssetBuildCache::PrintStats() const
+    {
+        const unsigned int total = hits + misses;
+        std::cout << "CACHE: " << hits << "/" << total << " sources reused ("
+                  << (total > 0 ? 100.0 * hits / total : 0.0) << "% hit rate) \n";
+        std::cout << "  rebuilt: " << misses << " sources in " << rebuiltMs << " ms \n";
+        std::cout << "  saved: ~" << savedMs << " ms of processing \n";
+    }
+
+    AssetBuildCache::AssetBuildCache(std::string _directory, std::uint64_t _settingsHash, bool _enabled)
+        : directory(std::move(_directory)), settingsHash(_settingsHash), enabled(_enabled)
+    {
+        fs::create_directories(directory);
+
+        std::ifstream file(manifestPath(), std::ios::binary);
+        if (!file.is_open()) return;
+
+        try
+        {
+            std::uint64_t version = 0;
+            cereal::BinaryInputArchive input(file);
+            input(version);
+            if (version != PACKER_CACHE_VERSION) return;
+            input(manifest);
+        }
+        catch (const cereal::Exception& e)
+        {
+            std::cerr << "WARNING: AssetBuildCache -> Discarding unreadable manifest: " << e.what() << std::endl;
+            manifest.clear();
+        }
+    }
+} // namespace sage
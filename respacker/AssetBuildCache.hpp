@@ -0,0 +1,85 @@
+#pragma once
+
+#include "engine/AssetArchive.hpp"
+
+#include "cereal/types/vector.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Content-hashed cache of processed asset blobs, so the packer only re-imports sources that changed.
+
+namespace sage
+{
+    // Bump when the packer's processing or the blob format changes, to invalidate every cache entry.
+    constexpr std::uint64_t PACKER_CACHE_VERSION = 4;
+
+    struct EncodedAsset
+    {
+        AssetType type{};
+        std::string key;
+        AssetBlob blob;
+    };
+
+    struct CachedAsset
+    {
+        AssetType type{};
+        std::string key;
+        std::string blobFile; // Relative to the cache directory
+        std::uint64_t uncompressedSize = 0;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(type, key, blobFile, uncompressedSize);
+        }
+    };
+
+    // Everything one source produced the last time it was processed.
+    struct CacheRecord
+    {
+        std::uint64_t hash = 0;
+        double buildMs = 0;
+        std::vector<CachedAsset> assets;
+
+        template <class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(hash, buildMs, assets);
+        }
+    };
+
+    /*
+     * Maps each source (a file, or a whole map directory) to the hash of its contents and the
+     * blobs it produced. Fetch/Store are safe to call from packer worker threads.
+     */
+    class AssetBuildCache
+    {
+        std::string directory;
+        std::uint64_t settingsHash;
+        bool enabled;
+        std::unordered_map<std::string, CacheRecord> manifest;
+        std::mutex mutex;
+
+        unsigned int hits = 0;
+        unsigned int misses = 0;
+        double savedMs = 0;
+        double rebuiltMs = 0;
+
+        [[nodiscard]] std::string manifestPath() const;
+
+      public:
+        [[nodiscard]] std::uint64_t HashFiles(const std::vector<std::string>& paths) const;
+        bool Fetch(const std::string& source, std::uint64_t hash, std::vector<EncodedAsset>& out);
+        void Store(const std::string& source, std::uint64_t hash, double buildMs, const std::vector<EncodedAsset>& assets);
+        // For sources whose output is a standalone file (e.g. a map bin) rather than archive blobs.
+        bool IsUpToDate(const std::string& output, std::uint64_t hash);
+        void Save();
+        void PrintStats() const;
+
+        AssetBuildCache(std::string _directory, std::uint64_t _settingsHash, bool _enabled);
+    };
+} // namespace sage
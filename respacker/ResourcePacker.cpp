@@ -1,5 +1,7 @@
 #include "ResourcePacker.hpp"
 
+#include "AssetBuildCache.hpp"
+
 #include "engine/components/Collideable.hpp"
 #include "engine/components/DoorBehaviorComponent.hpp"
 #include "engine/components/Renderable.hpp"
@@ -7,6 +9,8 @@
 #include "engine/components/Spawner.hpp"
 #include "engine/Light.hpp"
 #include "engine/LightManager.hpp"
+#include "engine/MeshOptimizer.hpp"
+#include "engine/ParallelFor.hpp"
 #include "engine/ResourceManager.hpp"
 #include "engine/Serializer.hpp"
 #include "engine/slib.hpp"
@@ -19,18 +23,23 @@
 #include "game/src/ItemFactory.hpp"
 #include "game/src/QuestManager.hpp"
 #include "game/utils/MapLoader.hpp"
+#include "game/utils/ScriptCompiler.hpp"
 
 #include "engine/systems/TransformSystem.hpp"
 #include "raylib.h"
 #include "raymath.h"
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <functional>
 #include <fstream>
 #include <iostream>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -39,6 +48,163 @@ namespace sage
 
     constexpr float WORLD_SCALE = 5.0f;
 
+    // Wall-clock time spent in each packer phase, printed as a summary once packing finishes.
+    class PhaseTimer
+    {
+        std::vector<std::pair<std::string, double>> phases;
+        std::string current;
+        std::chrono::steady_clock::time_point start;
+
+      public:
+        void Begin(const std::string& name)
+        {
+            current = name;
+            start = std::chrono::steady_clock::now();
+        }
+
+        void End()
+        {
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            phases.emplace_back(current, elapsed.count());
+        }
+
+        void PrintSummary(const std::string& title) const
+        {
+            double total = 0;
+            std::cout << "TIMINGS: " << title << " (" << HardwareWorkerCount() << " workers) \n";
+            for (const auto& [name, ms] : phases)
+            {
+                std::cout << "  " << name << ": " << ms << " ms \n";
+                total += ms;
+            }
+            std::cout << "  total: " << total << " ms \n";
+        }
+    };
+
+    std::vector<std::string> collectFiles(const fs::path& directory, std::initializer_list<const char*> extensions)
+    {
+        std::vector<std::string> files;
+        for (const auto& entry : fs::recursive_directory_iterator(directory))
+        {
+            if (!entry.is_regular_file()) continue;
+            if (std::ranges::find(extensions, entry.path().extension()) == extensions.end()) continue;
+            files.push_back(entry.path().string());
+        }
+        // Directory iteration order is unspecified; keep pack output stable between runs.
+        std::ranges::sort(files);
+        return files;
+    }
+
+    // Sources that feed a model's import besides the model file itself (.mtl, external textures, .bin
+    // buffers). Conservatively, that is every non-model file in the model's directory.
+    std::vector<std::string> modelDependencies(const std::string& modelPath)
+    {
+        std::vector<std::string> files{modelPath};
+        for (const auto& entry : fs::directory_iterator(fs::path(modelPath).parent_path()))
+        {
+            if (!entry.is_regular_file()) continue;
+            const auto extension = entry.path().extension();
+            if (extension == ".obj" || extension == ".glb" || extension == ".gltf") continue;
+            files.push_back(entry.path().string());
+        }
+        std::ranges::sort(files.begin() + 1, files.end());
+        return files;
+    }
+
+    /*
+     * Runs each source through the build cache. Unchanged sources reuse their cached blobs; the
+     * rest are imported with importFn(path, out), timed and stored. With parallel set, importFn
+     * runs on worker threads and must not touch the GL context or the ResourceManager.
+     */
+    template <typename ImportFn>
+    std::vector<std::vector<EncodedAsset>> importSources(
+        AssetBuildCache& cache,
+        const std::vector<std::string>& paths,
+        bool parallel,
+        const std::function<std::vector<std::string>(const std::string&)>& dependencies,
+        ImportFn&& importFn)
+    {
+        std::vector<std::vector<EncodedAsset>> results(paths.size());
+        auto importOne = [&](std::size_t i) {
+            const auto& path = paths[i];
+            const auto hash = cache.HashFiles(dependencies ? dependencies(path) : std::vector{path});
+            if (cache.Fetch(path, hash, results[i])) return;
+
+            const auto start = std::chrono::steady_clock::now();
+            importFn(path, results[i]);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            cache.Store(path, hash, elapsed.count(), results[i]);
+        };
+
+        if (parallel)
+        {
+            ParallelFor(paths.size(), importOne);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < paths.size(); ++i)
+            {
+                importOne(i);
+            }
+        }
+        return results;
+    }
+
+    // Totals over the meshes optimised this run (cached sources are not re-optimised).
+    struct MeshOptimizeTotals
+    {
+        unsigned int meshes = 0;
+        long long verticesBefore = 0;
+        long long verticesAfter = 0;
+        double acmrBefore = 0;
+        double acmrAfter = 0;
+
+        void Print() const
+        {
+            if (meshes == 0) return;
+            std::cout << "  optimised " << meshes << " meshes: " << verticesBefore << " -> " << verticesAfter
+                      << " vertices, average ACMR " << acmrBefore / meshes << " -> " << acmrAfter / meshes << " \n";
+        }
+    };
+
+    // Welds and reorders every mesh of the model before it is encoded (see MeshOptimizer.hpp).
+    void optimizeMeshes(Model& model, MeshOptimizeTotals& totals)
+    {
+        for (int i = 0; i < model.meshCount; ++i)
+        {
+            const auto stats = OptimizeMesh(model.meshes[i]);
+            ++totals.meshes;
+            totals.verticesBefore += stats.verticesBefore;
+            totals.verticesAfter += stats.verticesAfter;
+            totals.acmrBefore += stats.acmrBefore;
+            totals.acmrAfter += stats.acmrAfter;
+        }
+    }
+
+    template <typename T>
+    void encodeAsset(AssetType type, const std::string& key, const T& asset, std::vector<EncodedAsset>& out)
+    {
+        EncodedAsset encoded{type, key, {}};
+        if (EncodeAssetBlob(asset, encoded.blob))
+        {
+            out.push_back(std::move(encoded));
+        }
+    }
+
+    // Keys can collide across sources (paths are stripped); the first source in pack order wins,
+    // matching the resource manager's first-write-wins material pooling.
+    void linkAssets(AssetArchiveWriter& writer, const std::vector<std::vector<EncodedAsset>>& sources)
+    {
+        for (const auto& assets : sources)
+        {
+            for (const auto& asset : assets)
+            {
+                if (writer.Contains(asset.type, asset.key)) continue;
+                writer.AddBlob(asset.type, asset.key, asset.blob);
+            }
+        }
+    }
+
     Vector3 scaleFromOrigin(const Vector3& point, float scale)
     {
         return Vector3Scale(point, scale);
@@ -341,8 +507,22 @@ namespace sage
         NavigationGridSystem* navigationGridSystem,
         TransformSystem* transformSystem,
         const char* input,
-        const char* output)
+        const char* output,
+        AssetBuildCache& cache)
     {
+        // The map bin is rebuilt as a whole whenever anything under the map directory (or the
+        // item definitions it pulls in) changes.
+        std::vector<std::string> mapSources =
+            collectFiles(input, {".txt", ".obj", ".mtl", ".glb", ".gltf", ".bin", ".png"});
+        mapSources.emplace_back("resources/items.json");
+        const auto mapHash = cache.HashFiles(mapSources);
+        if (cache.IsUpToDate(output, mapHash))
+        {
+            std::cout << "SKIP: " << output << " is up to date. \n";
+            return;
+        }
+        const auto mapStart = std::chrono::steady_clock::now();
+
         registry->clear();
         ResourceManager::GetInstance().Reset();
         lq::ItemFactory itemFactory{registry};
@@ -358,8 +538,10 @@ namespace sage
 
         InitWindow(300, 100, "Loading Map!");
 
+        PhaseTimer timer;
         std::cout << "START: Constructing map into bin file. \n";
 
+        timer.Begin("load meshes");
         std::cout << "START: Loading mesh data into resource manager. \n";
         for (const auto& entry : fs::directory_iterator(meshPath))
         {
@@ -370,10 +552,20 @@ namespace sage
                 ResourceManager::GetInstance().ModelLoadFromFile(entry.path().string());
             }
         }
+        // Map meshes are welded and reordered like the packed models, before the txt data reads
+        // them for collision bounds.
+        MeshOptimizeTotals optimized;
+        for (auto& [key, info] : ResourceManager::GetInstance().modelCopies)
+        {
+            optimizeMeshes(info.model, optimized);
+        }
+        optimized.Print();
         std::cout << "FINISH: Loading mesh data into resource manager. \n";
+        timer.End();
 
         int slices = 0;
 
+        timer.Begin("process txt data");
         std::cout << "START: Processing txt data into resource manager. \n";
         for (const auto& entry : fs::directory_iterator(inputPath))
         {
@@ -384,13 +576,18 @@ namespace sage
             }
         }
         std::cout << "FINISH: Processing txt data into resource manager. \n";
+        timer.End();
 
         ImageSafe heightMap(false), normalMap(false);
 
+        timer.Begin("grid height and normals");
         navigationGridSystem->Init(slices, 1.0f);
         navigationGridSystem->InitGridHeightAndNormals();
+        timer.End();
+        timer.Begin("height/normal maps");
         navigationGridSystem->GenerateHeightMap(heightMap);
         navigationGridSystem->GenerateNormalMap(normalMap);
+        timer.End();
 
         // ExportImage(heightMap.GetImage(), "resources/HeightMap.png");
         // ExportImage(normalMap.GetImage(), "resources/NormalMap.png");
@@ -398,14 +595,21 @@ namespace sage
         ResourceManager::GetInstance().ImageLoadFromFile("HEIGHT_MAP", heightMap.GetImage());
         ResourceManager::GetInstance().ImageLoadFromFile("NORMAL_MAP", normalMap.GetImage());
 
+        timer.Begin("write map");
         lq::maploader::SaveMap(*registry, output);
+        timer.End();
+
+        const std::chrono::duration<double, std::milli> mapElapsed = std::chrono::steady_clock::now() - mapStart;
+        cache.Store(output, mapHash, mapElapsed.count(), {});
+        cache.Save();
         std::cout << "FINISH: Constructing map into bin file. \n";
+        timer.PrintSummary(output);
     }
 
     /**
      * output: The path + filename of the resulting binary
      **/
-    void ResourcePacker::PackAssets(entt::registry* registry, const std::string& output)
+    void ResourcePacker::PackAssets(entt::registry* registry, const std::string& output, AssetBuildCache& cache)
     {
         fs::path outputPath(output);
         if (!fs::is_directory(outputPath.parent_path()))
@@ -419,100 +623,150 @@ namespace sage
             return;
         }
 
-        std::cout << "START: Loading assets into memory \n";
+        PhaseTimer timer;
+
+        // Scripts are compiled first so a broken one fails the pack before anything is written.
+        timer.Begin("scripts");
+        std::cout << "START: Compiling scripts. \n";
+        lq::script::ScriptCompiler scripts;
+        scripts.CompileDirectory("resources");
+        if (scripts.HasErrors())
         {
-            fs::path imagePath("resources/textures");
-            if (!fs::is_directory(imagePath.parent_path()))
-            {
-                std::cout << "ResourcePacker: Image directory does not exist, cannot load. Aborting... \n";
-                return;
-            }
-            std::cout << "START: Processing image data into resource manager. \n";
-            for (const auto& entry : fs::recursive_directory_iterator(imagePath))
+            for (const auto& [file, line, message] : scripts.GetErrors())
             {
-                if (!entry.is_regular_file()) continue;
-                if (entry.path().extension() == ".png")
-                {
-                    ResourceManager::GetInstance().ImageLoadFromFile(entry.path());
-                }
+                std::cout << "ERROR: " << file << ":" << line << ": " << message << "\n";
             }
-            std::cout << "FINISH: Processing image data into resource manager. \n";
+            std::cout << "ResourcePacker: " << scripts.GetErrors().size() << " script error(s). Aborting... \n";
+            return;
         }
+        const auto& module = scripts.GetModule();
+        std::cout << "  " << module.conversations.size() << " conversations, " << module.quests.size()
+                  << " quests, " << module.contextualDialogs.size() << " contextual dialogs, "
+                  << module.strings.size() << " strings \n";
+        std::cout << "FINISH: Compiling scripts. \n";
+        timer.End();
+
+        AssetArchiveWriter writer(output.c_str());
+        if (!writer.IsOpen()) return;
+
+        std::vector<std::vector<EncodedAsset>> sources;
+        auto append = [&sources](std::vector<std::vector<EncodedAsset>> imported) {
+            std::ranges::move(imported, std::back_inserter(sources));
+        };
+
+        std::cout << "START: Importing assets \n";
         {
+            fs::path imagePath("resources/textures");
             fs::path iconsPath("resources/icons");
-            if (!fs::is_directory(iconsPath.parent_path()))
-            {
-                std::cout << "ResourcePacker: Icon directory does not exist, cannot load. Aborting... \n";
-                return;
-            }
-            std::cout << "START: Processing icon data into resource manager. \n";
-            for (const auto& entry : fs::recursive_directory_iterator(iconsPath))
-            {
-                if (!entry.is_regular_file()) continue;
-                if (entry.path().extension() == ".png")
-                {
-                    ResourceManager::GetInstance().ImageLoadFromFile(entry.path());
-                }
-            }
-            std::cout << "FINISH: Processing icon data into resource manager. \n";
-        }
-        {
-            fs::path iconsPath("resources/fonts");
-            if (!fs::is_directory(iconsPath.parent_path()))
+            if (!fs::is_directory(imagePath) || !fs::is_directory(iconsPath))
             {
-                std::cout << "ResourcePacker: Font directory does not exist, cannot load. Aborting... \n";
+                std::cout << "ResourcePacker: Image directory does not exist, cannot load. Aborting... \n";
                 return;
             }
-            std::cout << "START: Processing font data into resource manager. \n";
-            for (const auto& entry : fs::recursive_directory_iterator(iconsPath))
-            {
-                if (!entry.is_regular_file()) continue;
-                if (entry.path().extension() == ".ttf")
-                {
-                    ResourceManager::GetInstance().FontLoadFromFile(entry.path());
-                }
-            }
-            std::cout << "FINISH: Processing font data into resource manager. \n";
+            timer.Begin("images");
+            std::cout << "START: Processing image data. \n";
+            auto images = collectFiles(imagePath, {".png"});
+            std::ranges::move(collectFiles(iconsPath, {".png"}), std::back_inserter(images));
+            append(importSources(
+                cache, images, /*parallel=*/true, nullptr, [](const std::string& path, auto& out) {
+                    Image image = LoadImage(path.c_str());
+                    encodeAsset(AssetType::Image, StripPath(path), image, out);
+                    UnloadImage(image);
+                }));
+            std::cout << "FINISH: Processing image data. \n";
+            timer.End();
         }
         {
             fs::path modelPath("resources/models");
-            if (!fs::is_directory(modelPath.parent_path()))
+            if (!fs::is_directory(modelPath))
             {
                 std::cout << "ResourcePacker: Model directory does not exist, cannot load. Aborting... \n";
                 return;
             }
-            std::cout << "START: Processing model data into resource manager. \n";
-            constexpr std::array validExtensions = {".glb", ".gltf", ".obj"};
-            for (const auto& entry : fs::recursive_directory_iterator(modelPath))
+            const auto models = collectFiles(modelPath, {".glb", ".gltf", ".obj"});
+
+            // LoadModel uploads meshes and material textures as it parses, and material encoding
+            // reads the textures back, so models are imported on the main thread.
+            timer.Begin("models");
+            std::cout << "START: Processing model data. \n";
+            MeshOptimizeTotals optimized;
+            append(importSources(
+                cache,
+                models,
+                /*parallel=*/false,
+                &modelDependencies,
+                [&optimized](const std::string& path, auto& out) {
+                    ModelInfo info = ResourceManager::importModel(path);
+                    optimizeMeshes(info.model, optimized);
+                    for (int i = 0; i < info.model.materialCount; ++i)
+                    {
+                        encodeAsset(AssetType::Material, info.materialNames[i], info.model.materials[i], out);
+                    }
+                    encodeAsset(AssetType::Model, StripPath(path), info, out);
+                    UnloadModel(info.model);
+                }));
+            optimized.Print();
+            std::cout << "FINISH: Processing model data. \n";
+            timer.End();
+
+            // Animation decoding and compression are CPU only, so unlike the models themselves they
+            // run on workers.
+            std::vector<std::string> animated;
+            std::ranges::copy_if(models, std::back_inserter(animated), [](const std::string& path) {
+                return !IsFileExtension(path.c_str(), ".obj");
+            });
+            timer.Begin("animations");
+            std::cout << "START: Processing animation data. \n";
+            std::atomic<std::size_t> rawAnimationBytes{0};
+            std::atomic<std::size_t> compressedAnimationBytes{0};
+            append(importSources(
+                cache,
+                animated,
+                /*parallel=*/true,
+                nullptr,
+                [&rawAnimationBytes, &compressedAnimationBytes](const std::string& path, auto& out) {
+                    int animsCount = 0;
+                    ModelAnimation* animations = LoadModelAnimations(path.c_str(), &animsCount);
+                    if (animations == nullptr) return;
+                    std::vector<AnimationClip> clips;
+                    clips.reserve(animsCount);
+                    for (int i = 0; i < animsCount; ++i)
+                    {
+                        clips.push_back(AnimationClip::Compress(animations[i]));
+                        rawAnimationBytes +=
+                            static_cast<std::size_t>(animations[i].frameCount) * animations[i].boneCount * sizeof(Transform);
+                        compressedAnimationBytes += clips.back().GetMemoryUsage();
+                    }
+                    encodeAsset(AssetType::Animation, StripPath(path), clips, out);
+                    UnloadModelAnimations(animations, animsCount);
+                }));
+            if (rawAnimationBytes > 0)
             {
-                if (!entry.is_regular_file()) continue;
-                if (std::find(validExtensions.begin(), validExtensions.end(), entry.path().extension()) ==
-                    validExtensions.end())
-                {
-                    continue;
-                }
-                ResourceManager::GetInstance().ModelLoadFromFile(entry.path());
-                if (entry.path().extension() == ".glb" || entry.path().extension() == ".gltf")
-                {
-                    ResourceManager::GetInstance().ModelAnimationLoadFromFile(entry.path());
-                }
+                std::cout << "  compressed animation poses: " << rawAnimationBytes << " -> " << compressedAnimationBytes
+                          << " bytes \n";
             }
-            std::cout << "FINISH: Processing image data into resource manager. \n";
+            std::cout << "FINISH: Processing animation data. \n";
+            timer.End();
         }
 
         {
             // Bake raylib primitives into the asset pack as shared entries. Each gets a
-            // stable key ("primitive_sphere", etc.) and goes through dedupeAndShareMaterials
-            // so the default material is pooled like any other. Mutable instances are minted
-            // at runtime via ResourceManager::CreateModelMutable, which regenerates the mesh
-            // via a hardcoded generator (sourcePath is empty for primitives).
-            std::cout << "START: Baking raylib primitives into resource manager. \n";
-            auto& rm = ResourceManager::GetInstance();
-            auto registerPrimitive = [&rm](const std::string& key, Mesh mesh) {
-                Model model = LoadModelFromMesh(mesh);
-                std::vector<std::string> materialNames;
-                rm.dedupeAndShareMaterials(model, materialNames, /*sourcePath=*/"");
-                rm.StoreModel(ModelInfo{model, std::move(materialNames), "", /*privateMaterials=*/false}, key);
+            // stable key ("primitive_sphere", etc.); their default material is pooled like any
+            // other. Mutable instances are cloned from these at runtime by
+            // ResourceManager::CreateModelMutable. Cheap enough that they bypass the build cache.
+            timer.Begin("primitives");
+            std::cout << "START: Baking raylib primitives. \n";
+            auto& primitives = sources.emplace_back();
+            MeshOptimizeTotals optimized;
+            auto registerPrimitive = [&primitives, &optimized](const std::string& key, Mesh mesh) {
+                ModelInfo info = ResourceManager::importModel(LoadModelFromMesh(mesh));
+                optimizeMeshes(info.model, optimized);
+                for (int i = 0; i < info.model.materialCount; ++i)
+                {
+                    encodeAsset(AssetType::Material, info.materialNames[i], info.model.materials[i], primitives);
+                }
+                encodeAsset(AssetType::Model, key, info, primitives);
+                UnloadModel(info.model);
             };
             registerPrimitive("primitive_sphere", GenMeshSphere(1.0f, 32, 32));
             registerPrimitive("primitive_hemisphere", GenMeshHemiSphere(1.0f, 16, 32));
@@ -523,7 +777,9 @@ namespace sage
             registerPrimitive("primitive_torus", GenMeshTorus(0.25f, 1.0f, 16, 32));
             registerPrimitive("primitive_knot", GenMeshKnot(1.0f, 2.0f, 16, 128));
             registerPrimitive("primitive_poly", GenMeshPoly(5, 1.0f));
-            std::cout << "FINISH: Baking raylib primitives into resource manager. \n";
+            optimized.Print();
+            std::cout << "FINISH: Baking raylib primitives. \n";
+            timer.End();
         }
 
         // Currently, serialization of music/sound is not supported
@@ -535,7 +791,15 @@ namespace sage
         // ResourceManager::GetInstance().SFXLoadFromFile("resources/audio/sfx/book_open.ogg");
         // ResourceManager::GetInstance().SFXLoadFromFile("resources/audio/sfx/equip_open.ogg");
 
-        std::cout << "FINISH: Loading assets into memory \n";
-        serializer::SaveClassBinary(output.c_str(), ResourceManager::GetInstance());
+        std::cout << "FINISH: Importing assets \n";
+        timer.Begin("link archive");
+        std::cout << "START: Linking asset archive. \n";
+        linkAssets(writer, sources);
+        writer.Add(AssetType::Script, lq::script::MODULE_KEY, module);
+        writer.Finish();
+        cache.Save();
+        std::cout << "FINISH: Linking asset archive. \n";
+        timer.End();
+        timer.PrintSummary(output);
     }
 }; // namespace sage
@@ -11,6 +11,7 @@
 
 namespace sage
 {
+    class AssetBuildCache;
     class NavigationGridSystem;
     class TransformSystem;
 
@@ -22,9 +23,10 @@ namespace sage
             NavigationGridSystem* navigationGridSystem,
             TransformSystem* transformSystem,
             const char* input,
-            const char* output);
+            const char* output,
+            AssetBuildCache& cache);
 
-        static void PackAssets(entt::registry* registry, const std::string& output);
+        static void PackAssets(entt::registry* registry, const std::string& output, AssetBuildCache& cache);
     };
 
 } // namespace sage
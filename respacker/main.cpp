@@ -1,23 +1,56 @@
+#include "AssetBuildCache.hpp"
+#include "engine/MeshQuantization.hpp"
 #include "engine/ResourceManager.hpp"
 #include "engine/systems/CollisionSystem.hpp"
 #include "engine/systems/NavigationGridSystem.hpp"
 #include "engine/systems/TransformSystem.hpp"
 #include "ResourcePacker.hpp"
 
+#include <cstring>
+#include <iostream>
+
+// Usage: respacker [--stats] [--rebuild] [--quantize] [--cache-dir <dir>]
+//   --stats      print build cache hits/misses and the processing time the cache saved
+//   --rebuild    ignore cached blobs (the cache is still refreshed)
+//   --quantize   store mesh attributes quantised (16-bit positions, octahedral normals, half UVs)
+//   --cache-dir  where processed blobs are kept (default: resources/.respacker-cache)
 int main(int argc, char* argv[])
 {
+    bool printStats = false;
+    bool useCache = true;
+    std::string cacheDir = "resources/.respacker-cache";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--stats") == 0)
+            printStats = true;
+        else if (std::strcmp(argv[i], "--rebuild") == 0)
+            useCache = false;
+        else if (std::strcmp(argv[i], "--quantize") == 0)
+            sage::GetMeshEncodeOptions().quantize = true;
+        else if (std::strcmp(argv[i], "--cache-dir") == 0 && i + 1 < argc)
+            cacheDir = argv[++i];
+        else
+            std::cout << "respacker: ignoring unknown argument '" << argv[i] << "' \n";
+    }
+
     InitWindow(300, 100, "Packing Assets...");
     entt::registry registry{};
     sage::TransformSystem transformSystem(&registry);
     sage::CollisionSystem collisionSystem(&registry);
     sage::NavigationGridSystem navigationGridSystem(&registry, &collisionSystem);
+    // Encoding options change the blobs, so they are part of the settings every cache entry is keyed on.
+    const std::uint64_t settingsHash =
+        sage::PACKER_CACHE_VERSION * 2 + (sage::GetMeshEncodeOptions().quantize ? 1 : 0);
+    sage::AssetBuildCache cache(cacheDir, settingsHash, useCache);
 
     // clang-format off
-    sage::ResourcePacker::PackAssets(&registry, "resources/assets.bin");
-    sage::ResourcePacker::ConstructMap( &registry, &navigationGridSystem, &transformSystem, "resources/maps/dungeon-map", "resources/dungeon-map.bin");
+    sage::ResourcePacker::PackAssets(&registry, "resources/assets.bin", cache);
+    sage::ResourcePacker::ConstructMap( &registry, &navigationGridSystem, &transformSystem, "resources/maps/dungeon-map", "resources/dungeon-map.bin", cache);
     // clang-format on
 
+    if (printStats) cache.PrintStats();
+
     CloseWindow();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+//
+// Minimal check and timing helpers shared by the tests. Each test is its own executable registered
+// with CTest; it prints every failed check and exits non-zero if there were any.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace sage::test
+{
+    inline int failures = 0;
+
+    inline bool Check(bool ok, const char* expr, const char* file, int line)
+    {
+        if (!ok)
+        {
+            ++failures;
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        }
+        return ok;
+    }
+
+    // Returns the process exit code.
+    inline int Result(const char* name)
+    {
+        if (failures == 0)
+        {
+            std::printf("%s: passed\n", name);
+            return 0;
+        }
+        std::printf("%s: %d check(s) failed\n", name, failures);
+        return 1;
+    }
+
+    // Wall time of fn() in milliseconds, best of runs.
+    template <typename Fn>
+    double TimeMs(Fn&& fn, int runs = 5)
+    {
+        double best = 0;
+        for (int run = 0; run < runs; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (run == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        return best;
+    }
+} // namespace sage::test
+
+#define CHECK(expr) ::sage::test::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
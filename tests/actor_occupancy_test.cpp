@@ -0,0 +1,156 @@
+//
+// ActorOccupancy: incremental stamping checked with Validate and against counts rebuilt by hand,
+// through random moves, overlaps, unstamps and stamps that leave the grid.
+//
+
+#include "engine/ActorOccupancy.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    constexpr int ROWS = 64;
+    constexpr int COLS = 48;
+
+    bool countsMatch(const ActorOccupancy& occupancy, const std::map<entt::entity, ActorOccupancy::Rect>& live)
+    {
+        std::vector<int> expected(ROWS * COLS, 0);
+        for (const auto& [entity, rect] : live)
+        {
+            for (int row = std::max(rect.min.row, 0); row <= std::min(rect.max.row, ROWS - 1); ++row)
+            {
+                for (int col = std::max(rect.min.col, 0); col <= std::min(rect.max.col, COLS - 1); ++col)
+                {
+                    ++expected[row * COLS + col];
+                }
+            }
+        }
+        for (int row = 0; row < ROWS; ++row)
+        {
+            for (int col = 0; col < COLS; ++col)
+            {
+                if (occupancy.GetCount(row, col) != expected[row * COLS + col]) return false;
+                if (occupancy.IsOccupied(row, col) != (expected[row * COLS + col] > 0)) return false;
+            }
+        }
+        return true;
+    }
+
+    void randomWalk()
+    {
+        std::mt19937 rng(45);
+        ActorOccupancy occupancy;
+        occupancy.Reset(ROWS, COLS);
+        std::map<entt::entity, ActorOccupancy::Rect> live;
+
+        for (int step = 0; step < 20000; ++step)
+        {
+            const auto entity = static_cast<entt::entity>(rng() % 200);
+            const int op = static_cast<int>(rng() % 10);
+            if (op == 0)
+            {
+                occupancy.Unstamp(entity);
+                live.erase(entity);
+            }
+            else
+            {
+                // Mostly small steps from where the actor was, sometimes a jump (possibly off the grid).
+                ActorOccupancy::Rect rect{};
+                if (const auto it = live.find(entity); it != live.end() && op < 8)
+                {
+                    const int dRow = static_cast<int>(rng() % 3) - 1;
+                    const int dCol = static_cast<int>(rng() % 3) - 1;
+                    rect = it->second;
+                    rect.min.row += dRow, rect.max.row += dRow, rect.min.col += dCol, rect.max.col += dCol;
+                }
+                else
+                {
+                    const int row = static_cast<int>(rng() % (ROWS + 10)) - 5;
+                    const int col = static_cast<int>(rng() % (COLS + 10)) - 5;
+                    rect = {{row, col}, {row + static_cast<int>(rng() % 4), col + static_cast<int>(rng() % 4)}};
+                }
+                occupancy.Stamp(entity, rect);
+
+                // The occupancy clamps to the grid and drops rects entirely off it.
+                const bool onGrid = rect.max.row >= 0 && rect.max.col >= 0 && rect.min.row < ROWS &&
+                                    rect.min.col < COLS;
+                if (onGrid)
+                {
+                    live[entity] = rect;
+                }
+                else
+                {
+                    live.erase(entity);
+                }
+            }
+
+            CHECK(occupancy.IsStamped(entity) == live.contains(entity));
+            if (step % 97 == 0)
+            {
+                CHECK(occupancy.Validate());
+                CHECK(countsMatch(occupancy, live));
+            }
+        }
+        CHECK(occupancy.Validate());
+        CHECK(countsMatch(occupancy, live));
+    }
+
+    void overlapsAndRestamps()
+    {
+        ActorOccupancy occupancy;
+        occupancy.Reset(8, 8);
+        const auto a = static_cast<entt::entity>(1);
+        const auto b = static_cast<entt::entity>(2);
+
+        // Overlapping actors do not clear each other out.
+        occupancy.Stamp(a, {{1, 1}, {3, 3}});
+        occupancy.Stamp(b, {{2, 2}, {4, 4}});
+        CHECK(occupancy.GetCount(2, 2) == 2);
+        occupancy.Unstamp(a);
+        CHECK(occupancy.IsOccupied(2, 2));
+        CHECK(!occupancy.IsOccupied(1, 1));
+
+        // Re-stamping the same squares touches nothing; a one-square move touches only the edges.
+        occupancy.ResetStats();
+        occupancy.Stamp(b, {{2, 2}, {4, 4}});
+        CHECK(occupancy.GetStats().unchanged == 1);
+        CHECK(occupancy.GetStats().squaresTouched == 0);
+        occupancy.Stamp(b, {{2, 3}, {4, 5}});
+        CHECK(occupancy.GetStats().squaresTouched == 6);
+        CHECK(occupancy.Validate());
+
+        // Corners given in either order describe the same rectangle.
+        occupancy.Stamp(a, {{5, 5}, {4, 4}});
+        CHECK(occupancy.GetCount(4, 4) == 2);
+        CHECK(occupancy.GetCount(5, 5) == 1);
+
+        // Off the grid, or unknown, or twice: no stamp and no underflow.
+        occupancy.Stamp(a, {{20, 20}, {21, 21}});
+        CHECK(!occupancy.IsStamped(a));
+        occupancy.Unstamp(a);
+        occupancy.Unstamp(static_cast<entt::entity>(99));
+        CHECK(occupancy.GetCount(-1, 0) == 0);
+        CHECK(occupancy.GetCount(0, 8) == 0);
+        CHECK(occupancy.Validate());
+
+        // Reset drops every stamp.
+        occupancy.Reset(8, 8);
+        CHECK(!occupancy.IsStamped(b));
+        CHECK(!occupancy.IsOccupied(3, 3));
+        CHECK(occupancy.Validate());
+    }
+} // namespace
+
+int main()
+{
+    randomWalk();
+    overlapsAndRestamps();
+    return sage::test::Result("actor_occupancy_test");
+}
@@ -0,0 +1,171 @@
+//
+// LightGrid against a brute-force reference: every light tested against every box, ranked the same way.
+//
+
+#include "engine/LightCulling.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    std::vector<int> reference(
+        const std::vector<LightCullSource>& lights, const BoundingBox& bounds, const int maxLights)
+    {
+        std::vector<int> out;
+        for (int i = 0; i < static_cast<int>(lights.size()); ++i)
+        {
+            if (lights[i].directional && static_cast<int>(out.size()) < maxLights) out.push_back(i);
+        }
+
+        const Vector3 centre = Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f);
+        std::vector<std::pair<float, int>> candidates;
+        for (int i = 0; i < static_cast<int>(lights.size()); ++i)
+        {
+            const auto& light = lights[i];
+            if (light.directional) continue;
+            const Vector3 closest = Vector3Clamp(light.position, bounds.min, bounds.max);
+            if (Vector3DistanceSqr(closest, light.position) > light.radius * light.radius) continue;
+            const float distance = std::max(Vector3Distance(centre, light.position), 0.001f);
+            candidates.emplace_back(light.brightness / distance, i);
+        }
+        std::ranges::stable_sort(candidates, [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (const auto& [score, index] : candidates)
+        {
+            if (static_cast<int>(out.size()) == maxLights) break;
+            out.push_back(index);
+        }
+        return out;
+    }
+
+    // Same set, and the same ranking where scores differ (ties may come back in either order).
+    bool sameResult(
+        const std::vector<LightCullSource>& lights,
+        const BoundingBox& bounds,
+        std::vector<int> got,
+        std::vector<int> expected)
+    {
+        if (got.size() != expected.size()) return false;
+        const Vector3 centre = Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f);
+        auto score = [&](const int i) {
+            if (lights[i].directional) return std::numeric_limits<float>::infinity();
+            return lights[i].brightness / std::max(Vector3Distance(centre, lights[i].position), 0.001f);
+        };
+        for (std::size_t i = 0; i < got.size(); ++i)
+        {
+            if (score(got[i]) != score(expected[i])) return false;
+        }
+        std::ranges::sort(got);
+        std::ranges::sort(expected);
+        return got == expected;
+    }
+
+    void randomScenes()
+    {
+        std::mt19937 rng(34);
+        std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> radius(1.0f, 60.0f);
+        std::uniform_real_distribution<float> brightness(0.1f, 4.0f);
+        std::uniform_real_distribution<float> extent(0.1f, 20.0f);
+        std::uniform_int_distribution<int> kind(0, 49);
+
+        for (int scene = 0; scene < 20; ++scene)
+        {
+            std::vector<LightCullSource> lights;
+            for (int i = 0; i < 300; ++i)
+            {
+                LightCullSource light{{pos(rng), pos(rng) * 0.05f, pos(rng)}, radius(rng), brightness(rng)};
+                const int k = kind(rng);
+                if (k == 0) light.directional = true;
+                if (k == 1) light.radius = std::numeric_limits<float>::infinity(); // Unbounded
+                if (k == 2) light.radius = 5000.0f;                              // Too wide to bucket
+                lights.push_back(light);
+            }
+
+            LightGrid grid(16.0f);
+            grid.Build(lights);
+            CHECK(grid.GetLightCount() == lights.size());
+
+            for (int query = 0; query < 200; ++query)
+            {
+                const Vector3 min{pos(rng), pos(rng) * 0.05f, pos(rng)};
+                const BoundingBox bounds{min, Vector3Add(min, {extent(rng), extent(rng), extent(rng)})};
+                for (const int maxLights : {1, 4, 8})
+                {
+                    std::vector<int> out(maxLights);
+                    const int count = grid.Query(bounds, out.data(), maxLights);
+                    out.resize(count);
+                    CHECK(sameResult(lights, bounds, out, reference(lights, bounds, maxLights)));
+                }
+            }
+        }
+    }
+
+    void directionalFirst()
+    {
+        LightGrid grid;
+        grid.Build({{{0, 0, 0}, 10, 100}, {{}, 0, 0.1f, true}, {{1, 0, 1}, 10, 50}});
+        int out[3];
+        const BoundingBox bounds{{-1, -1, -1}, {1, 1, 1}};
+        CHECK(grid.Query(bounds, out, 3) == 3);
+        CHECK(out[0] == 1);
+        CHECK(out[1] == 0);
+        CHECK(out[2] == 2);
+        CHECK(grid.Query(bounds, out, 1) == 1);
+        CHECK(out[0] == 1);
+    }
+
+    void outOfReach()
+    {
+        LightGrid grid;
+        grid.Build({{{0, 0, 0}, 5, 1}});
+        int out[1];
+        CHECK(grid.Query({{5.5f, 0, 0}, {6, 1, 1}}, out, 1) == 0);
+        CHECK(grid.Query({{4.5f, 0, 0}, {6, 1, 1}}, out, 1) == 1);
+        // On a cell boundary, and negative coordinates.
+        grid.Build({{{-16, 0, -16}, 1, 1}});
+        CHECK(grid.Query({{-15.5f, 0, -16.5f}, {-15.2f, 1, -15.8f}}, out, 1) == 1);
+    }
+
+    void repeatedQueries()
+    {
+        // The per-light visited stamps must not leak between queries.
+        LightGrid grid(4.0f);
+        grid.Build({{{0, 0, 0}, 30, 1}});
+        int out[1];
+        for (int i = 0; i < 1000; ++i)
+        {
+            CHECK(grid.Query({{-20, 0, -20}, {20, 1, 20}}, out, 1) == 1);
+        }
+    }
+
+    void radius()
+    {
+        // brightness * (constant + linear / d + quadratic * 100 / d^2) == cutoff at the returned distance.
+        const float brightness = 2.0f, constant = 0.0f, linear = 0.5f, quadratic = 0.3f, cutoff = 0.02f;
+        const float d = LightRadius(brightness, constant, linear, quadratic, cutoff);
+        const float at = brightness * (constant + linear / d + quadratic * 100.0f / (d * d));
+        CHECK(std::abs(at - cutoff) < 1e-4f);
+        CHECK(LightRadius(0, 0, 1, 1, cutoff) == 0);
+        CHECK(std::isinf(LightRadius(1, 1, 0, 0, cutoff)));
+    }
+} // namespace
+
+int main()
+{
+    randomScenes();
+    directionalFirst();
+    outOfReach();
+    repeatedQueries();
+    radius();
+    return sage::test::Result("light_culling_test");
+}
@@ -0,0 +1,187 @@
+//
+// Headless crossing scenarios for LocalAvoidance: agents stepped the way ActorMovementSystem steps
+// actors (re-added every frame, preferred velocity towards the goal at movement speed), checking they
+// never overlap and all arrive.
+//
+
+#include "engine/LocalAvoidance.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    constexpr float SPEED = 0.35f; // MoveableActor's default movementSpeed, units per frame
+    constexpr float RADIUS = 0.5f;
+    constexpr float OVERLAP_TOLERANCE = 0.05f;
+
+    struct Walker
+    {
+        Vector2 position;
+        Vector2 goal;
+        Vector2 velocity{};
+        bool responsive = true;
+    };
+
+    struct Outcome
+    {
+        int steps = 0;
+        bool arrived = false;
+        float closest = 1e9f; // Smallest gap between two agents' edges over the whole run
+        float fastest = 0;
+    };
+
+    Outcome run(std::vector<Walker>& walkers, const int maxSteps)
+    {
+        LocalAvoidance avoidance;
+        Outcome outcome;
+        for (; outcome.steps < maxSteps; ++outcome.steps)
+        {
+            avoidance.Clear();
+            bool allArrived = true;
+            for (const auto& walker : walkers)
+            {
+                LocalAvoidance::Agent agent;
+                agent.position = walker.position;
+                agent.velocity = walker.velocity;
+                agent.radius = RADIUS;
+                agent.responsive = walker.responsive;
+                if (walker.responsive)
+                {
+                    const Vector2 toGoal = Vector2Subtract(walker.goal, walker.position);
+                    const float distance = Vector2Length(toGoal);
+                    if (distance > 0.05f) allArrived = false;
+                    agent.preferredVelocity = Vector2Scale(Vector2Normalize(toGoal), std::min(SPEED, distance));
+                    agent.maxSpeed = SPEED;
+                }
+                avoidance.AddAgent(agent);
+            }
+            if (allArrived)
+            {
+                outcome.arrived = true;
+                break;
+            }
+
+            avoidance.Solve();
+            for (std::size_t i = 0; i < walkers.size(); ++i)
+            {
+                if (!walkers[i].responsive) continue;
+                walkers[i].velocity = avoidance.GetVelocity(i);
+                walkers[i].position = Vector2Add(walkers[i].position, walkers[i].velocity);
+                outcome.fastest = std::max(outcome.fastest, Vector2Length(walkers[i].velocity));
+            }
+
+            for (std::size_t i = 0; i < walkers.size(); ++i)
+            {
+                for (std::size_t j = i + 1; j < walkers.size(); ++j)
+                {
+                    const float gap = Vector2Distance(walkers[i].position, walkers[j].position) - 2 * RADIUS;
+                    outcome.closest = std::min(outcome.closest, gap);
+                }
+            }
+        }
+        return outcome;
+    }
+
+    void headOn()
+    {
+        std::vector<Walker> walkers{{{-10, 0}, {10, 0}}, {{10, 0}, {-10, 0}}};
+        const auto outcome = run(walkers, 400);
+        CHECK(outcome.arrived);
+        CHECK(outcome.closest > -OVERLAP_TOLERANCE);
+        CHECK(outcome.fastest <= SPEED + 1e-4f);
+    }
+
+    std::vector<Walker> circle(const int agents, const float radius)
+    {
+        // Everyone heads for the opposite point of the circle, so all paths cross in the middle.
+        std::vector<Walker> walkers;
+        for (int i = 0; i < agents; ++i)
+        {
+            const float angle = 2 * PI * static_cast<float>(i) / static_cast<float>(agents);
+            const Vector2 start{radius * std::cos(angle), radius * std::sin(angle)};
+            walkers.push_back({start, Vector2Negate(start)});
+        }
+        return walkers;
+    }
+
+    void circleSwap()
+    {
+        auto walkers = circle(16, 12.0f);
+        const auto outcome = run(walkers, 2000);
+        CHECK(outcome.arrived);
+        CHECK(outcome.closest > -OVERLAP_TOLERANCE);
+        CHECK(outcome.fastest <= SPEED + 1e-4f);
+
+        // Packed shoulder to shoulder, the constraints cannot all be met in the middle; ORCA then
+        // takes the least-violating velocity, so contact stays shallow rather than agents passing
+        // through each other.
+        auto packed = circle(24, 12.0f);
+        const auto crowded = run(packed, 2000);
+        CHECK(crowded.arrived);
+        CHECK(crowded.closest > -0.15f);
+    }
+
+    void crossingStreams()
+    {
+        // Two columns of actors crossing at right angles.
+        std::vector<Walker> walkers;
+        for (int i = 0; i < 6; ++i)
+        {
+            const auto offset = static_cast<float>(i) * 1.5f;
+            walkers.push_back({{-15 - offset, 0.3f}, {15 + 10 - offset, 0.3f}});
+            walkers.push_back({{0, -15 - offset}, {0, 15 + 10 - offset}});
+        }
+        const auto outcome = run(walkers, 2000);
+        CHECK(outcome.arrived);
+        CHECK(outcome.closest > -OVERLAP_TOLERANCE);
+    }
+
+    void idleActorIsWalkedAround()
+    {
+        // An unresponsive agent stands on the straight line between the walker and its goal.
+        std::vector<Walker> walkers{{{-8, 0}, {8, 0}}, {{0, 0}, {0, 0}, {}, false}};
+        const auto outcome = run(walkers, 400);
+        CHECK(outcome.arrived);
+        CHECK(outcome.closest > -OVERLAP_TOLERANCE);
+        CHECK(walkers[1].position.x == 0 && walkers[1].position.y == 0);
+    }
+
+    void deterministic()
+    {
+        auto makeWalkers = [] {
+            std::vector<Walker> walkers;
+            for (int i = 0; i < 10; ++i)
+            {
+                const auto f = static_cast<float>(i);
+                walkers.push_back({{-10 + f * 0.3f, f * 1.1f - 5}, {10 - f * 0.2f, 5 - f * 1.1f}});
+            }
+            return walkers;
+        };
+        auto a = makeWalkers();
+        auto b = makeWalkers();
+        run(a, 300);
+        run(b, 300);
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            CHECK(a[i].position.x == b[i].position.x && a[i].position.y == b[i].position.y);
+        }
+    }
+} // namespace
+
+int main()
+{
+    headOn();
+    circleSwap();
+    crossingStreams();
+    idleActorIsWalkedAround();
+    deterministic();
+    return sage::test::Result("local_avoidance_test");
+}
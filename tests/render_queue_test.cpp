@@ -0,0 +1,237 @@
+//
+// Render queue ordering, sort keys and material identity, and static batch mesh merging.
+//
+
+#include "engine/RenderQueue.hpp"
+#include "engine/StaticMeshBatcher.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "raylib/src/config.h"
+#include "raymath.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    void freeMesh(Mesh& mesh)
+    {
+        // CPU-side only (never uploaded), so no UnloadMesh.
+        RL_FREE(mesh.vertices);
+        RL_FREE(mesh.normals);
+        RL_FREE(mesh.texcoords);
+        RL_FREE(mesh.texcoords2);
+        RL_FREE(mesh.tangents);
+        RL_FREE(mesh.colors);
+        RL_FREE(mesh.indices);
+        mesh = {};
+    }
+
+    void sortOrdersByKeyStably()
+    {
+        std::mt19937_64 rng(36);
+        RenderQueue queue;
+        for (int i = 0; i < 5000; ++i)
+        {
+            DrawPacket packet;
+            packet.key = rng() & 0xF0F0'0000'00FF'00FFull; // Plenty of equal keys
+            packet.mesh = i;                               // Push order, to check stability
+            queue.Push(packet);
+        }
+        queue.Sort();
+        CHECK(queue.Size() == 5000);
+
+        const DrawPacket* previous = nullptr;
+        unsigned int changes = 1; // The first packet binds its state too
+        queue.ForEach([&](const DrawPacket& packet) {
+            if (previous)
+            {
+                CHECK(previous->key <= packet.key);
+                if (previous->key == packet.key) CHECK(previous->mesh < packet.mesh);
+                if (previous->key != packet.key) ++changes;
+            }
+            previous = &packet;
+        });
+        CHECK(queue.CountKeyChanges() == changes);
+
+        queue.Clear();
+        CHECK(queue.Size() == 0);
+    }
+
+    void keyLayout()
+    {
+        std::array<MaterialMap, MAX_MATERIAL_MAPS> maps{};
+        maps[MATERIAL_MAP_DIFFUSE].texture.id = 7;
+        Material material{};
+        material.shader.id = 3;
+        material.maps = maps.data();
+
+        const auto opaque = MakeSortKey(RenderLayer::Opaque, 0x5, material);
+        const auto deferred = MakeSortKey(RenderLayer::Deferred, 0, material);
+        CHECK(opaque < deferred); // Layer dominates
+        CHECK((opaque >> 48 & 0x3FFF) == 3);
+        CHECK((opaque >> 40 & 0xFF) == 0x5);
+        CHECK((opaque >> 16 & 0xFFFFFF) == 7);
+        CHECK((opaque & 0xFFFF) == (MaterialIdentity(material) & 0xFFFF));
+    }
+
+    void materialIdentity()
+    {
+        std::array<MaterialMap, MAX_MATERIAL_MAPS> source{};
+        source[MATERIAL_MAP_DIFFUSE].texture.id = 4;
+        source[MATERIAL_MAP_NORMAL].texture.id = 5;
+        source[MATERIAL_MAP_DIFFUSE].color = {200, 100, 50, 255};
+        Material a{};
+        a.shader.id = 2;
+        a.maps = source.data();
+
+        // A mutable model instance's private copy of the same material.
+        auto copy = source;
+        Material b = a;
+        b.maps = copy.data();
+        CHECK(MaterialIdentity(a) == MaterialIdentity(b));
+        CHECK(MakeSortKey(RenderLayer::Opaque, 0, a) == MakeSortKey(RenderLayer::Opaque, 0, b));
+
+        // Changing what a draw binds changes the identity.
+        copy[MATERIAL_MAP_NORMAL].texture.id = 6;
+        CHECK(MaterialIdentity(a) != MaterialIdentity(b));
+        copy = source;
+        copy[MATERIAL_MAP_DIFFUSE].color.r = 10;
+        CHECK(MaterialIdentity(a) != MaterialIdentity(b));
+        copy = source;
+        b.shader.id = 9;
+        CHECK(MaterialIdentity(a) != MaterialIdentity(b));
+
+        Material empty{};
+        CHECK(MaterialIdentity(empty) == MaterialIdentity(empty));
+    }
+
+    // One triangle with every attribute set.
+    Mesh fullTriangle()
+    {
+        Mesh mesh{};
+        mesh.vertexCount = 3;
+        mesh.triangleCount = 1;
+        mesh.vertices = static_cast<float*>(RL_CALLOC(9, sizeof(float)));
+        mesh.normals = static_cast<float*>(RL_CALLOC(9, sizeof(float)));
+        mesh.texcoords = static_cast<float*>(RL_CALLOC(6, sizeof(float)));
+        mesh.texcoords2 = static_cast<float*>(RL_CALLOC(6, sizeof(float)));
+        mesh.tangents = static_cast<float*>(RL_CALLOC(12, sizeof(float)));
+        mesh.colors = static_cast<unsigned char*>(RL_CALLOC(12, 1));
+        const float positions[9] = {0, 0, 0, 1, 0, 0, 0, 0, 1};
+        for (int v = 0; v < 3; ++v)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                mesh.vertices[v * 3 + c] = positions[v * 3 + c];
+            }
+            mesh.normals[v * 3 + 1] = 1;
+            mesh.texcoords[v * 2] = 0.25f * v;
+            mesh.texcoords2[v * 2] = 0.5f;
+            mesh.texcoords2[v * 2 + 1] = 0.1f * v;
+            mesh.tangents[v * 4] = 1;
+            mesh.tangents[v * 4 + 3] = -1;
+            mesh.colors[v * 4] = 10;
+            mesh.colors[v * 4 + 3] = 255;
+        }
+        return mesh;
+    }
+
+    // Same triangle with positions only.
+    Mesh bareTriangle()
+    {
+        Mesh mesh{};
+        mesh.vertexCount = 3;
+        mesh.triangleCount = 1;
+        mesh.vertices = static_cast<float*>(RL_CALLOC(9, sizeof(float)));
+        mesh.vertices[3] = 1;
+        mesh.vertices[8] = 1;
+        return mesh;
+    }
+
+    bool near(const float a, const float b)
+    {
+        return std::abs(a - b) < 1e-5f;
+    }
+
+    void mergeCarriesEveryAttribute()
+    {
+        Mesh full = fullTriangle();
+        Mesh bare = bareTriangle();
+        // Rotate 90 degrees about Y and scale non-uniformly, then move.
+        const Matrix transform = MatrixMultiply(
+            MatrixMultiply(MatrixScale(2, 1, 1), MatrixRotateY(PI / 2)), MatrixTranslate(10, 0, 0));
+
+        Mesh merged = MergeMeshes({{&full, transform}, {&bare, MatrixIdentity()}});
+        CHECK(merged.vertexCount == 6);
+        CHECK(merged.triangleCount == 2);
+        CHECK(merged.tangents != nullptr);
+        CHECK(merged.texcoords2 != nullptr);
+        CHECK(merged.colors != nullptr);
+
+        if (merged.tangents && merged.texcoords2 && merged.colors)
+        {
+            for (int v = 0; v < 3; ++v)
+            {
+                // +X scaled by 2 then rotated onto -Z.
+                const Vector3 p = Vector3Transform({full.vertices[v * 3], 0, full.vertices[v * 3 + 2]}, transform);
+                CHECK(near(merged.vertices[v * 3], p.x));
+                CHECK(near(merged.vertices[v * 3 + 2], p.z));
+
+                // The tangent follows the surface: +X rotated onto -Z, unit length, sign kept.
+                CHECK(near(merged.tangents[v * 4], 0));
+                CHECK(near(merged.tangents[v * 4 + 2], -1));
+                CHECK(near(merged.tangents[v * 4 + 3], -1));
+                CHECK(near(merged.normals[v * 3 + 1], 1));
+
+                CHECK(near(merged.texcoords[v * 2], 0.25f * v));
+                CHECK(near(merged.texcoords2[v * 2], 0.5f));
+                CHECK(near(merged.texcoords2[v * 2 + 1], 0.1f * v));
+                CHECK(merged.colors[v * 4] == 10);
+            }
+            // The source without them gets defaults: +X tangent, zero second UVs, white.
+            for (int v = 3; v < 6; ++v)
+            {
+                CHECK(near(merged.tangents[v * 4], 1));
+                CHECK(near(merged.tangents[v * 4 + 3], 1));
+                CHECK(near(merged.texcoords2[v * 2], 0));
+                CHECK(merged.colors[v * 4] == 255);
+            }
+            for (int i = 0; i < 6; ++i)
+            {
+                CHECK(merged.indices[i] == i);
+            }
+        }
+
+        // A mirroring transform flips the bitangent sign.
+        Mesh mirrored = MergeMeshes({{&full, MatrixScale(-1, 1, 1)}});
+        if (mirrored.tangents) CHECK(near(mirrored.tangents[3], 1));
+
+        // No source has them: no buffers.
+        Mesh plain = MergeMeshes({{&bare, MatrixIdentity()}});
+        CHECK(plain.tangents == nullptr);
+        CHECK(plain.texcoords2 == nullptr);
+        CHECK(plain.colors == nullptr);
+
+        freeMesh(full);
+        freeMesh(bare);
+        freeMesh(merged);
+        freeMesh(mirrored);
+        freeMesh(plain);
+    }
+} // namespace
+
+int main()
+{
+    sortOrdersByKeyStably();
+    keyLayout();
+    materialIdentity();
+    mergeCarriesEveryAttribute();
+    return sage::test::Result("render_queue_test");
+}
@@ -0,0 +1,657 @@
+//
+// ScriptCompiler over every shipped script: it compiles cleanly, comes back from the asset archive
+// byte-identical, and describes the same conversations, quests and contextual dialogs the text loaders
+// built before the compiler. Broken scripts are reported at the line at fault.
+//
+
+#include "ScriptCompiler.hpp"
+#include "ScriptIR.hpp"
+
+#include "engine/AssetArchive.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "cereal/archives/binary.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace lq::script;
+namespace fs = std::filesystem;
+
+namespace
+{
+    // The loaders DialogFactory, QuestManager and ContextualDialogSystem ran on the text at scene load,
+    // writing what they would have built as a dump instead of creating entities.
+    namespace reference
+    {
+        using lq::parsing::getFunctionNameAndArgs;
+        using lq::parsing::trim;
+
+        std::string removeCommentsFromFile(const std::string& fileContents)
+        {
+            std::stringstream ss(fileContents);
+            std::string out;
+            std::string buff;
+            while (std::getline(ss, buff, '\n'))
+            {
+                buff = trim(buff);
+                if (buff.starts_with("//")) continue;
+                const auto commentPos = buff.find("//");
+                out.append((commentPos != std::string::npos ? buff.substr(0, commentPos) : buff) + '\n');
+            }
+            return out;
+        }
+
+        std::string trimWhiteSpaceFromFile(const std::string& fileContents)
+        {
+            std::stringstream ss(fileContents);
+            std::string out;
+            std::string buff;
+            while (std::getline(ss, buff, '\n'))
+            {
+                out.append(trim(buff) + "\n");
+            }
+            return out;
+        }
+
+        std::string normalizeLineEndings(const std::string& content)
+        {
+            std::string normalized = std::regex_replace(content, std::regex("\r\n"), "\n");
+            return std::regex_replace(normalized, std::regex("\r"), "\n");
+        }
+
+        std::string replaceVariables(const std::string& content)
+        {
+            std::unordered_map<std::string, std::string> variables;
+            std::istringstream stream(content);
+            std::string line;
+            bool inVariables = false;
+            while (std::getline(stream, line, '\n'))
+            {
+                line = trim(line);
+                if (line == "<variables>" || line == "</variables>")
+                {
+                    inVariables = line == "<variables>";
+                    continue;
+                }
+                const auto colon = line.find(':');
+                if (inVariables && colon != std::string::npos)
+                {
+                    variables[trim(line.substr(0, colon))] = trim(line.substr(colon + 1));
+                }
+            }
+            std::string out = content;
+            for (const auto& [name, value] : variables)
+            {
+                out = std::regex_replace(out, std::regex(R"(\$)" + name), value);
+            }
+            return out;
+        }
+
+        std::string call(const std::string& text)
+        {
+            const auto func = getFunctionNameAndArgs(text);
+            return func.name + "(" + func.params + ")";
+        }
+
+        std::string condition(const std::string& line)
+        {
+            std::string out;
+            bool positive = true;
+            std::string join = "F";
+            std::stringstream words(trim(line.substr(line.find("if") + 2)));
+            std::string word;
+            while (std::getline(words, word, ' '))
+            {
+                if (word == "not")
+                {
+                    positive = false;
+                    continue;
+                }
+                if (word == "and" || word == "or")
+                {
+                    join = word == "and" ? "&" : "|";
+                    continue;
+                }
+                out += join + (positive ? "" : "!") + call(word);
+                positive = true;
+                join = "?";
+            }
+            return out;
+        }
+
+        std::string vector3(const std::string& text)
+        {
+            std::istringstream in(text);
+            float x = 0, y = 0, z = 0;
+            in >> x >> y >> z;
+            std::ostringstream out;
+            out << x << "," << y << "," << z;
+            return out.str();
+        }
+
+        std::string readFile(const fs::path& path)
+        {
+            std::ifstream file(path);
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        }
+
+        std::vector<fs::path> scripts(const fs::path& directory)
+        {
+            std::vector<fs::path> out;
+            for (const auto& entry : fs::directory_iterator(directory))
+            {
+                if (entry.path().extension() == ".txt") out.push_back(entry.path());
+            }
+            std::ranges::sort(out);
+            return out;
+        }
+
+        void node(
+            std::ostream& out, const std::string& title, const std::string& content, const std::string& options)
+        {
+            out << "NODE " << title << "\nCONTENT " << content << "|END\n";
+            std::optional<std::string> current;
+            std::stringstream lines(options);
+            std::string line;
+            while (std::getline(lines, line, '\n'))
+            {
+                if (line.starts_with("if"))
+                {
+                    current = condition(line);
+                    continue;
+                }
+                if (line == "end")
+                {
+                    current.reset();
+                    continue;
+                }
+                if (!line.starts_with("[[")) continue;
+
+                std::stringstream ss(line.substr(2));
+                std::vector<std::string> parts;
+                std::string part;
+                while (std::getline(ss, part, '|'))
+                {
+                    parts.push_back(trim(part));
+                }
+                parts.back() = parts.back().substr(0, parts.back().find_first_of("]]"));
+                if (parts.size() != 2 && parts.size() != 3) continue;
+
+                const std::string action = parts.size() == 3 ? call(parts[0]) : "-";
+                std::string next = parts.back();
+                if (next.empty() || next == "exit") next = "-";
+                out << "OPT desc=" << parts[parts.size() - 2] << " next=" << next << " action=" << action
+                    << " cond=" << current.value_or("-") << "\n";
+            }
+        }
+
+        void dialogs(std::ostream& out, const fs::path& directory)
+        {
+            for (const auto& path : scripts(directory))
+            {
+                std::stringstream lines(trimWhiteSpaceFromFile(
+                    replaceVariables(removeCommentsFromFile(normalizeLineEndings(readFile(path))))));
+                std::string owner, speaker = "-", conversationPos = "-", cameraPos = "-";
+                std::string title, content, options, line;
+                std::ostringstream nodes;
+                bool open = false;
+                auto finish = [&] {
+                    if (!open) return;
+                    out << "CONV owner=" << owner << " speaker=" << speaker << " cpos=" << conversationPos
+                        << " cam=" << cameraPos << "\n"
+                        << nodes.str();
+                    open = false;
+                    nodes.str("");
+                    speaker = conversationPos = cameraPos = "-";
+                };
+
+                while (std::getline(lines, line))
+                {
+                    if (line == "<meta>" || line == "<node>")
+                    {
+                        if (line == "<meta>") finish();
+                        title.clear();
+                        content.clear();
+                        options.clear();
+                    }
+                    else if (line.starts_with("owner:"))
+                    {
+                        finish();
+                        open = true;
+                        owner = trim(line.substr(6));
+                    }
+                    else if (line.starts_with("speaker_name:"))
+                    {
+                        speaker = trim(line.substr(13));
+                    }
+                    else if (line.starts_with("conversation_pos:"))
+                    {
+                        conversationPos = vector3(line.substr(17));
+                    }
+                    else if (line.starts_with("camera_pos:"))
+                    {
+                        cameraPos = vector3(line.substr(11));
+                    }
+                    else if (line.starts_with("title:"))
+                    {
+                        title = trim(line.substr(6));
+                    }
+                    else if (line == "---")
+                    {
+                        content.clear();
+                        std::string text;
+                        while (std::getline(lines, text) && text != "---")
+                        {
+                            content += text + "\n";
+                        }
+                    }
+                    else if (line.starts_with("if") || line == "end" || line.starts_with("[["))
+                    {
+                        options += trim(line) + "\n";
+                    }
+                    else if (line == "</node>" && !title.empty())
+                    {
+                        node(nodes, title, content, options);
+                    }
+                }
+                finish();
+            }
+        }
+
+        // The lines up to (not including) the one containing close.
+        std::vector<std::string> block(std::stringstream& lines, const std::string& close)
+        {
+            std::vector<std::string> out;
+            std::string line;
+            while (std::getline(lines, line) && line.find(close) == std::string::npos)
+            {
+                out.push_back(line);
+            }
+            return out;
+        }
+
+        void quests(std::ostream& out, const fs::path& directory)
+        {
+            constexpr auto npos = std::string::npos;
+            for (const auto& path : scripts(directory))
+            {
+                std::stringstream lines(
+                    removeCommentsFromFile(trimWhiteSpaceFromFile(normalizeLineEndings(readFile(path)))));
+                std::string title = "-", description = "-", line;
+                std::ostringstream body;
+                while (std::getline(lines, line, '\n'))
+                {
+                    if (line.find("<meta>") != std::string::npos)
+                    {
+                        for (const auto& meta : block(lines, "</meta>"))
+                        {
+                            if (meta.find("title: ") != std::string::npos) title = meta.substr(7);
+                        }
+                    }
+                    else if (line.find("<description>") != std::string::npos)
+                    {
+                        description.clear();
+                        for (const auto& text : block(lines, "</description>"))
+                        {
+                            description += text + "\n";
+                        }
+                    }
+                    else if (line.find("<tasks>") != std::string::npos)
+                    {
+                        for (const auto& task : block(lines, "</tasks>"))
+                        {
+                            const auto semicolon = task.find_first_of(';');
+                            const bool dialog = task.find("dialog: ") != std::string::npos;
+                            const std::size_t start = dialog ? 8 : 6;
+                            const auto target = semicolon != std::string::npos
+                                                    ? task.substr(start, semicolon - start)
+                                                    : task.substr(start);
+                            body << "TASK " << (dialog ? "dialog" : "item") << " " << target << " cmds=";
+                            if (semicolon != std::string::npos)
+                            {
+                                std::string commands = task.substr(semicolon + 1);
+                                std::erase_if(commands, [](const unsigned char c) { return std::isspace(c); });
+                                std::stringstream ss(commands);
+                                std::string command;
+                                while (std::getline(ss, command, ';'))
+                                {
+                                    body << call(command) << ";";
+                                }
+                            }
+                            body << "\n";
+                        }
+                    }
+                    else if (line.find("<onStart>") != npos || line.find("<onComplete>") != npos)
+                    {
+                        const bool start = line.find("<onStart>") != npos;
+                        body << (start ? "START " : "COMPLETE ");
+                        for (const auto& command : block(lines, start ? "</onStart>" : "</onComplete>"))
+                        {
+                            body << call(command) << ";";
+                        }
+                        body << "\n";
+                    }
+                }
+                out << "QUEST " << path.stem().string() << " title=" << title << " desc=" << description
+                    << "|END\n"
+                    << body.str();
+            }
+        }
+
+        void contextualDialogs(std::ostream& out, const fs::path& directory)
+        {
+            for (const auto& path : scripts(directory))
+            {
+                std::stringstream lines(
+                    removeCommentsFromFile(trimWhiteSpaceFromFile(normalizeLineEndings(readFile(path)))));
+                std::string owner, speaker = "-", distance = "-", line;
+                bool loop = false, retrigger = false;
+                std::ostringstream body;
+                while (std::getline(lines, line, '\n'))
+                {
+                    if (line.find("<meta>") != std::string::npos)
+                    {
+                        for (const auto& meta : block(lines, "</meta>"))
+                        {
+                            if (meta.find("owner: ") != std::string::npos)
+                            {
+                                owner = meta.substr(7);
+                            }
+                            else if (meta.find("distance: ") != std::string::npos)
+                            {
+                                std::ostringstream value;
+                                value << std::stof(meta.substr(10));
+                                distance = value.str();
+                            }
+                            else if (meta.find("speaker: ") != std::string::npos)
+                            {
+                                speaker = meta.substr(9);
+                            }
+                            else if (meta.find("loop: ") != std::string::npos)
+                            {
+                                loop = loop || meta.find("true") != std::string::npos;
+                            }
+                            else if (meta.find("should_retrigger: ") != std::string::npos)
+                            {
+                                retrigger = retrigger || meta.find("true") != std::string::npos;
+                            }
+                        }
+                    }
+                    else if (line.find("<dialog>") != std::string::npos)
+                    {
+                        std::optional<std::string> current;
+                        for (const auto& text : block(lines, "</dialog>"))
+                        {
+                            if (text.starts_with("if"))
+                            {
+                                current = condition(text);
+                            }
+                            else if (text.starts_with("end"))
+                            {
+                                current.reset();
+                            }
+                            else
+                            {
+                                body << "LINE " << text << " cond=" << current.value_or("-") << "\n";
+                            }
+                        }
+                    }
+                    else if (line.find("<onTrigger>") != std::string::npos)
+                    {
+                        body << "TRIG ";
+                        for (const auto& command : block(lines, "</onTrigger>"))
+                        {
+                            body << call(command) << ";";
+                        }
+                        body << "\n";
+                    }
+                }
+                out << "CTX owner=" << owner << " speaker=" << speaker << " dist=" << distance << " loop=" << loop
+                    << " re=" << retrigger << "\n"
+                    << body.str();
+            }
+        }
+
+        std::string dump(const fs::path& resources)
+        {
+            std::ostringstream out;
+            dialogs(out, resources / "dialog");
+            contextualDialogs(out, resources / "dialog" / "contextual");
+            quests(out, resources / "quests");
+            return out.str();
+        }
+    } // namespace reference
+
+    // The compiled module, in the reference dump's format.
+    namespace compiled
+    {
+        std::string call(const ScriptModule& module, const Call& call)
+        {
+            return std::string(GetFunctionInfo(call.function).name) + "(" +
+                   (call.arg == NONE ? "" : module.String(call.arg)) + ")";
+        }
+
+        std::string calls(const ScriptModule& module, const std::vector<Call>& list)
+        {
+            std::string out;
+            for (const auto& c : list)
+            {
+                out += call(module, c) + ";";
+            }
+            return out;
+        }
+
+        std::string condition(const ScriptModule& module, const std::uint32_t index)
+        {
+            if (index == NONE) return "-";
+            std::string out;
+            for (const auto& term : module.conditions.at(index).terms)
+            {
+                out += term.join == Join::First ? "F" : term.join == Join::And ? "&" : "|";
+                if (term.negate) out += "!";
+                out += call(module, term.call);
+            }
+            return out;
+        }
+
+        std::string string(const ScriptModule& module, const std::uint32_t index)
+        {
+            return index == NONE ? "-" : module.String(index);
+        }
+
+        std::string vector3(const std::optional<Vector3>& v)
+        {
+            if (!v) return "-";
+            std::ostringstream out;
+            out << v->x << "," << v->y << "," << v->z;
+            return out.str();
+        }
+
+        std::string dump(const ScriptModule& module)
+        {
+            std::ostringstream out;
+            for (const auto& conversation : module.conversations)
+            {
+                out << "CONV owner=" << module.String(conversation.owner)
+                    << " speaker=" << string(module, conversation.speaker)
+                    << " cpos=" << vector3(conversation.conversationPos)
+                    << " cam=" << vector3(conversation.cameraPos) << "\n";
+                for (const auto& node : conversation.nodes)
+                {
+                    out << "NODE " << module.String(node.title) << "\nCONTENT " << module.String(node.content)
+                        << "|END\n";
+                    for (const auto& option : node.options)
+                    {
+                        const auto next =
+                            option.next == NONE ? "-" : module.String(conversation.nodes.at(option.next).title);
+                        out << "OPT desc=" << module.String(option.description) << " next=" << next
+                            << " action=" << (option.action ? call(module, *option.action) : "-")
+                            << " cond=" << condition(module, option.condition) << "\n";
+                    }
+                }
+            }
+            for (const auto& dialog : module.contextualDialogs)
+            {
+                std::ostringstream distance;
+                if (dialog.distance)
+                {
+                    distance << *dialog.distance;
+                }
+                else
+                {
+                    distance << "-";
+                }
+                out << "CTX owner=" << module.String(dialog.owner) << " speaker=" << string(module, dialog.speaker)
+                    << " dist=" << distance.str() << " loop=" << dialog.loop << " re=" << dialog.shouldRetrigger
+                    << "\n";
+                for (const auto& line : dialog.lines)
+                {
+                    out << "LINE " << module.String(line.text) << " cond=" << condition(module, line.condition)
+                        << "\n";
+                }
+                out << "TRIG " << calls(module, dialog.onTrigger) << "\n";
+            }
+            for (const auto& quest : module.quests)
+            {
+                out << "QUEST " << module.String(quest.key) << " title=" << string(module, quest.title)
+                    << " desc=" << string(module, quest.description) << "|END\n";
+                for (const auto& task : quest.tasks)
+                {
+                    out << "TASK " << (task.kind == TaskKind::Dialog ? "dialog" : "item") << " "
+                        << module.String(task.target) << " cmds=" << calls(module, task.onCompleted) << "\n";
+                }
+                out << "START " << calls(module, quest.onStart) << "\nCOMPLETE " << calls(module, quest.onComplete)
+                    << "\n";
+            }
+            return out.str();
+        }
+    } // namespace compiled
+
+    std::vector<std::string> lines(const std::string& dump)
+    {
+        std::vector<std::string> out;
+        std::istringstream in(dump);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            // The old loaders only wrote these sections when the script had them.
+            if (line == "START " || line == "COMPLETE " || line == "TRIG ") continue;
+            out.push_back(line);
+        }
+        return out;
+    }
+
+    std::string bytes(const ScriptModule& module)
+    {
+        std::ostringstream stream(std::ios::binary);
+        {
+            cereal::BinaryOutputArchive archive(stream);
+            archive(module);
+        }
+        return stream.str();
+    }
+
+    void shippedScripts()
+    {
+        ScriptCompiler compiler;
+        compiler.CompileDirectory("resources");
+        for (const auto& [file, line, message] : compiler.GetErrors())
+        {
+            std::fprintf(stderr, "  %s:%d: %s\n", file.c_str(), line, message.c_str());
+        }
+        CHECK(!compiler.HasErrors());
+        const auto& module = compiler.GetModule();
+        CHECK(!module.conversations.empty());
+        CHECK(!module.quests.empty());
+        CHECK(!module.contextualDialogs.empty());
+
+        // Through the archive, as the packer writes it and scenes read it.
+        const auto path = (fs::temp_directory_path() / "script_compiler_test.bin").string();
+        {
+            sage::AssetArchiveWriter writer(path.c_str());
+            CHECK(writer.IsOpen());
+            writer.Add(sage::AssetType::Script, MODULE_KEY, module);
+            writer.Finish();
+        }
+        ScriptModule loaded;
+        {
+            sage::AssetArchiveReader reader;
+            CHECK(reader.Open(path.c_str()));
+            CHECK(reader.Read(sage::AssetType::Script, MODULE_KEY, loaded));
+        }
+        fs::remove(path);
+        CHECK(bytes(loaded) == bytes(module));
+
+        const auto expected = lines(reference::dump("resources"));
+        const auto actual = lines(compiled::dump(loaded));
+        CHECK(expected.size() > 100);
+        if (!CHECK(actual == expected))
+        {
+            const auto [e, a] = std::ranges::mismatch(expected, actual);
+            std::fprintf(stderr, "  expected: %s\n", e != expected.end() ? e->c_str() : "(end)");
+            std::fprintf(stderr, "  compiled: %s\n", a != actual.end() ? a->c_str() : "(end)");
+        }
+    }
+
+    bool reportsLine(const ScriptCompiler& compiler, const int line)
+    {
+        return std::ranges::any_of(compiler.GetErrors(), [line](const CompileError& e) { return e.line == line; });
+    }
+
+    void brokenScripts()
+    {
+        const std::string meta = "<meta>\nowner: Someone\n</meta>\n";
+        {
+            ScriptCompiler compiler;
+            compiler.CompileDialog(
+                "d.txt",
+                meta + "<node>\ntitle: start\n---\nHello\n---\n[[Bye | nowhere]]\n</node>\n"
+                       "<node>\ntitle: other\n---\nHi\n---\nif quest_complete(Q) and\n"
+                       "[[summon_dragon() | Go | start]]\nend\n</node>\n");
+            CHECK(reportsLine(compiler, 9));  // Leads to an unknown node
+            CHECK(reportsLine(compiler, 16)); // Condition ends with a join
+            CHECK(reportsLine(compiler, 17)); // Unknown option action
+            CHECK(compiler.GetErrors().size() == 3);
+            CHECK(compiler.GetErrors().front().file == "d.txt");
+        }
+        {
+            ScriptCompiler compiler;
+            compiler.CompileDialog(
+                "d.txt", meta + "<node>\ntitle: start\n---\nHello\n---\nif has_item(Key)\n</node>\n");
+            CHECK(reportsLine(compiler, 9)); // 'if' without 'end'
+        }
+        {
+            ScriptCompiler compiler;
+            compiler.CompileQuest(
+                "q.txt", "<tasks>\nchat: Arissa\n</tasks>\n<onStart>\nopen_door()\n</onStart>\n");
+            CHECK(reportsLine(compiler, 2)); // Not a dialog or item task
+            CHECK(reportsLine(compiler, 5)); // Missing its argument
+        }
+        {
+            ScriptCompiler compiler;
+            compiler.CompileContextualDialog("c.txt", "<meta>\ndistance: far\n</meta>\n<dialog>\nHello\n");
+            CHECK(reportsLine(compiler, 2)); // Not a number
+            CHECK(reportsLine(compiler, 4)); // Never closed
+            CHECK(reportsLine(compiler, 0)); // No owner
+        }
+    }
+} // namespace
+
+int main()
+{
+    shippedScripts();
+    brokenScripts();
+    return sage::test::Result("script_compiler_test");
+}
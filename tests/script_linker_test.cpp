@@ -0,0 +1,472 @@
+//
+// ScriptLinker, BindFunctionToEvent and BindOptionAction against a mock ScriptHost: each predicate a
+// linked condition calls, each command a bound event runs and each dialog option action reaches the host
+// with the resolved entity or string, and names the scene lacks are reported at link time and leave
+// nothing bound.
+//
+
+#include "ScriptCompiler.hpp"
+#include "ScriptHost.hpp"
+#include "ScriptIR.hpp"
+#include "ScriptLinker.hpp"
+#include "TextToRealFunction.hpp"
+
+#include "engine/Event.hpp"
+
+#include "TestHelpers.hpp"
+
+#include "entt/entt.hpp"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace lq::script;
+
+namespace
+{
+    // Scene names resolve to fixed entities; every predicate and command is recorded as "name(arg)".
+    class MockHost final : public ScriptHost
+    {
+        static std::string arg(const entt::entity entity)
+        {
+            return std::to_string(static_cast<std::uint32_t>(entity));
+        }
+
+        static entt::entity find(
+            const std::unordered_map<std::string, entt::entity>& names, const std::string& name)
+        {
+            const auto it = names.find(name);
+            return it != names.end() ? it->second : entt::null;
+        }
+
+        bool predicate(const std::string& call)
+        {
+            calls.push_back(call);
+            return truths.contains(call);
+        }
+
+      public:
+        std::unordered_map<std::string, entt::entity> renderables;
+        std::unordered_map<std::string, entt::entity> doors;
+        std::unordered_map<std::string, entt::entity> quests;
+        std::unordered_set<entt::entity> questTasks;
+        std::unordered_set<std::string> truths; // Predicate calls that return true
+        std::vector<std::string> calls;
+
+        entt::entity FindRenderable(const std::string& name) override
+        {
+            return find(renderables, name);
+        }
+
+        entt::entity FindDoor(const std::string& name) override
+        {
+            return find(doors, name);
+        }
+
+        entt::entity FindQuest(const std::string& key) override
+        {
+            return find(quests, key);
+        }
+
+        bool IsQuestTask(const entt::entity entity) override
+        {
+            return questTasks.contains(entity);
+        }
+
+        bool QuestComplete(const entt::entity quest) override
+        {
+            return predicate("quest_complete(" + arg(quest) + ")");
+        }
+
+        bool QuestInProgress(const entt::entity quest) override
+        {
+            return predicate("quest_in_progress(" + arg(quest) + ")");
+        }
+
+        bool QuestAllTasksComplete(const entt::entity quest) override
+        {
+            return predicate("quest_all_tasks_complete(" + arg(quest) + ")");
+        }
+
+        bool QuestTaskComplete(const entt::entity task) override
+        {
+            return predicate("quest_task_complete(" + arg(task) + ")");
+        }
+
+        bool HasItem(const std::string& item) override
+        {
+            return predicate("has_item(" + item + ")");
+        }
+
+        void OpenDoor(const entt::entity door) override
+        {
+            calls.push_back("OpenDoor(" + arg(door) + ")");
+        }
+
+        void JoinParty(const entt::entity npc) override
+        {
+            calls.push_back("JoinParty(" + arg(npc) + ")");
+        }
+
+        void RemoveItem(const std::string& item) override
+        {
+            calls.push_back("RemoveItem(" + item + ")");
+        }
+
+        void GiveItem(const std::string& item) override
+        {
+            calls.push_back("GiveItem(" + item + ")");
+        }
+
+        void PlaySFX(const std::string& name) override
+        {
+            calls.push_back("PlaySFX(" + name + ")");
+        }
+
+        void PlayMusic(const std::string& name) override
+        {
+            calls.push_back("PlayMusic(" + name + ")");
+        }
+
+        void DisableWorldItem(const entt::entity item) override
+        {
+            calls.push_back("DisableWorldItem(" + arg(item) + ")");
+        }
+
+        void EndGame() override
+        {
+            calls.push_back("EndGame()");
+        }
+
+        void StartQuest(const entt::entity quest) override
+        {
+            calls.push_back("start_quest(" + arg(quest) + ")");
+        }
+
+        void CompleteQuest(const entt::entity quest) override
+        {
+            calls.push_back("complete_quest(" + arg(quest) + ")");
+        }
+
+        void CompleteQuestTask(const entt::entity quest, const entt::entity owner) override
+        {
+            calls.push_back("complete_quest_task(" + arg(quest) + ", " + arg(owner) + ")");
+        }
+
+        MockHost()
+        {
+            renderables = {{"Arissa", entt::entity{10}}, {"Lever", entt::entity{11}}, {"Sword", entt::entity{12}}};
+            doors = {{"Gate", entt::entity{20}}};
+            quests = {{"ArissaQuest", entt::entity{30}}};
+            questTasks = {entt::entity{11}};
+        }
+    };
+
+    // A contextual dialog with one line behind "if <condition>" and <onTrigger> running commands.
+    ScriptModule compile(const std::string& condition, const std::vector<std::string>& commands = {})
+    {
+        std::string source = "<meta>\nowner: Arissa\n</meta>\n";
+        source += "<dialog>\nif " + condition + "\nHello\nend\n</dialog>\n<onTrigger>\n";
+        for (const auto& command : commands)
+        {
+            source += command + "\n";
+        }
+        source += "</onTrigger>\n";
+
+        ScriptCompiler compiler;
+        compiler.CompileContextualDialog("test.txt", source);
+        CHECK(!compiler.HasErrors());
+        return compiler.GetModule();
+    }
+
+    // Links the condition, evaluates it once and returns what the host saw; result holds the outcome.
+    std::vector<std::string> evaluate(MockHost& host, const std::string& condition, bool& result)
+    {
+        const auto module = compile(condition);
+        ScriptLinker linker(module, &host);
+        const auto linked = linker.LinkCondition(module.contextualDialogs.front().lines.front().condition);
+        CHECK(!linker.HasErrors());
+        host.calls.clear();
+        result = linked();
+        return host.calls;
+    }
+
+    // The predicate is called once with the resolved argument, and its answer is the condition's.
+    bool checkPredicate(const std::string& condition, const std::string& expectedCall)
+    {
+        MockHost host;
+        bool result = true;
+        const bool called = evaluate(host, condition, result) == std::vector{expectedCall};
+        const bool falseWhenFalse = !result;
+
+        host.truths = {expectedCall};
+        const bool calledAgain = evaluate(host, condition, result) == std::vector{expectedCall};
+        return called && falseWhenFalse && calledAgain && result;
+    }
+
+    void questComplete()
+    {
+        CHECK(checkPredicate("quest_complete(ArissaQuest)", "quest_complete(30)"));
+    }
+
+    void questInProgress()
+    {
+        CHECK(checkPredicate("quest_in_progress(ArissaQuest)", "quest_in_progress(30)"));
+    }
+
+    void questAllTasksComplete()
+    {
+        CHECK(checkPredicate("quest_all_tasks_complete(ArissaQuest)", "quest_all_tasks_complete(30)"));
+    }
+
+    void questTaskComplete()
+    {
+        CHECK(checkPredicate("quest_task_complete(Lever)", "quest_task_complete(11)"));
+
+        // The renderable must carry a quest task.
+        MockHost host;
+        const auto module = compile("quest_task_complete(Arissa)");
+        ScriptLinker linker(module, &host);
+        const auto linked = linker.LinkCondition(0);
+        CHECK(linker.GetErrors().size() == 1);
+        CHECK(!linked());
+        CHECK(host.calls.empty());
+    }
+
+    void hasItem()
+    {
+        // Items are not resolved to entities; the name is passed through.
+        CHECK(checkPredicate("has_item(Key)", "has_item(Key)"));
+    }
+
+    void negationAndJoins()
+    {
+        MockHost host;
+        bool result = false;
+        evaluate(host, "not has_item(Key)", result);
+        CHECK(result);
+
+        host.truths = {"has_item(Key)"};
+        evaluate(host, "has_item(Key) and quest_complete(ArissaQuest)", result);
+        CHECK(!result);
+        evaluate(host, "has_item(Key) and not quest_complete(ArissaQuest)", result);
+        CHECK(result);
+        evaluate(host, "quest_complete(ArissaQuest) or has_item(Key)", result);
+        CHECK(result);
+        // Folded left to right: (true or false) and false.
+        evaluate(host, "has_item(Key) or quest_complete(ArissaQuest) and has_item(Axe)", result);
+        CHECK(!result);
+    }
+
+    void unresolvedNames()
+    {
+        for (const auto* condition :
+             {"quest_complete(NoQuest)",
+              "quest_in_progress(NoQuest)",
+              "quest_all_tasks_complete(NoQuest)",
+              "quest_task_complete(Nobody)",
+              "has_item(Key) or quest_complete(NoQuest)"})
+        {
+            MockHost host;
+            host.truths = {"has_item(Key)"};
+            const auto module = compile(condition);
+            ScriptLinker linker(module, &host);
+            const auto linked = linker.LinkCondition(0);
+            CHECK(linker.GetErrors().size() == 1);
+            CHECK(!linked()); // Fails closed
+            CHECK(host.calls.empty());
+        }
+    }
+
+    void notAPredicate()
+    {
+        // The compiler rejects this; a module built some other way must not link it either.
+        ScriptModule module;
+        module.strings = {"Gate"};
+        module.conditions.push_back({{Term{Call{Function::OpenDoor, 0}}}});
+        MockHost host;
+        ScriptLinker linker(module, &host);
+        const auto linked = linker.LinkCondition(0);
+        CHECK(linker.HasErrors());
+        CHECK(!linked());
+        CHECK(host.calls.empty());
+    }
+
+    // Binds the command to an event, which runs it once per Publish and not before.
+    bool checkCommand(const std::string& command, const std::string& expectedCall)
+    {
+        const auto module = compile("has_item(Key)", {command});
+        MockHost host;
+        ScriptLinker linker(module, &host);
+        sage::Event<> event;
+        lq::parsing::BindFunctionToEvent<sage::Event<>>(
+            linker, module.contextualDialogs.front().onTrigger.front(), &event);
+        const bool bound = !linker.HasErrors() && host.calls.empty();
+
+        event.Publish();
+        const bool once = host.calls == std::vector{expectedCall};
+        event.Publish();
+        return bound && once && host.calls.size() == 2;
+    }
+
+    void openDoor()
+    {
+        CHECK(checkCommand("OpenDoor(Gate)", "OpenDoor(20)"));
+    }
+
+    void joinParty()
+    {
+        CHECK(checkCommand("JoinParty(Arissa)", "JoinParty(10)"));
+    }
+
+    void removeItem()
+    {
+        CHECK(checkCommand("RemoveItem(Key)", "RemoveItem(Key)"));
+    }
+
+    void giveItem()
+    {
+        CHECK(checkCommand("GiveItem(Key)", "GiveItem(Key)"));
+    }
+
+    void playSFX()
+    {
+        CHECK(checkCommand("PlaySFX(Creak)", "PlaySFX(Creak)"));
+    }
+
+    void playMusic()
+    {
+        CHECK(checkCommand("PlayMusic(Theme)", "PlayMusic(Theme)"));
+    }
+
+    void disableWorldItem()
+    {
+        CHECK(checkCommand("DisableWorldItem(Sword)", "DisableWorldItem(12)"));
+    }
+
+    void endGame()
+    {
+        CHECK(checkCommand("EndGame()", "EndGame()"));
+    }
+
+    // A conversation with one option that runs action.
+    ScriptModule compileOption(const std::string& action)
+    {
+        ScriptCompiler compiler;
+        compiler.CompileDialog(
+            "test.txt",
+            "<meta>\nowner: Lever\n</meta>\n<node>\ntitle: start\n---\nHello\n---\n[[" + action +
+                " | Go | exit]]\n</node>\n");
+        CHECK(!compiler.HasErrors());
+        return compiler.GetModule();
+    }
+
+    // Binds the option's action for owner, which runs it once per selection and not before.
+    bool checkOptionAction(const std::string& action, const entt::entity owner, const std::string& expectedCall)
+    {
+        const auto module = compileOption(action);
+        MockHost host;
+        ScriptLinker linker(module, &host);
+        const auto& option = module.conversations.front().nodes.front().options.front();
+        const auto bound = lq::parsing::BindOptionAction(linker, option.action.value(), owner);
+        if (!bound || linker.HasErrors() || !host.calls.empty()) return false;
+
+        bound();
+        const bool once = host.calls == std::vector{expectedCall};
+        bound();
+        return once && host.calls.size() == 2;
+    }
+
+    void startQuest()
+    {
+        CHECK(checkOptionAction("start_quest(ArissaQuest)", entt::entity{11}, "start_quest(30)"));
+    }
+
+    void completeQuest()
+    {
+        CHECK(checkOptionAction("complete_quest(ArissaQuest)", entt::entity{11}, "complete_quest(30)"));
+    }
+
+    void completeQuestTask()
+    {
+        CHECK(checkOptionAction(
+            "complete_quest_task(ArissaQuest)", entt::entity{11}, "complete_quest_task(30, 11)"));
+
+        // The conversation's owner must carry a quest task.
+        const auto module = compileOption("complete_quest_task(ArissaQuest)");
+        MockHost host;
+        ScriptLinker linker(module, &host);
+        const auto& option = module.conversations.front().nodes.front().options.front();
+        CHECK(!lq::parsing::BindOptionAction(linker, option.action.value(), entt::entity{10}));
+        CHECK(linker.GetErrors().size() == 1);
+    }
+
+    void unboundOptionActions()
+    {
+        // A quest the scene lacks, and a command where an option action belongs.
+        for (const auto& call :
+             {Call{Function::StartQuest, 0}, Call{Function::CompleteQuest, 0}, Call{Function::GiveItem, 1}})
+        {
+            ScriptModule module;
+            module.strings = {"NoQuest", "Key"};
+            MockHost host;
+            ScriptLinker linker(module, &host);
+            CHECK(!lq::parsing::BindOptionAction(linker, call, entt::entity{11}));
+            CHECK(linker.GetErrors().size() == 1);
+            CHECK(host.calls.empty());
+        }
+    }
+
+    void unboundCommands()
+    {
+        // A door that is only a renderable, and renderables the scene lacks.
+        const auto module =
+            compile("has_item(Key)", {"OpenDoor(Arissa)", "JoinParty(Nobody)", "DisableWorldItem(Nobody)"});
+        MockHost host;
+        ScriptLinker linker(module, &host);
+        sage::Event<> event;
+        for (const auto& call : module.contextualDialogs.front().onTrigger)
+        {
+            lq::parsing::BindFunctionToEvent<sage::Event<>>(linker, call, &event);
+        }
+        CHECK(linker.GetErrors().size() == 3);
+        event.Publish();
+        CHECK(host.calls.empty());
+
+        // A predicate is not a command.
+        ScriptLinker other(module, &host);
+        lq::parsing::BindFunctionToEvent<sage::Event<>>(other, Call{Function::HasItem, 0}, &event);
+        CHECK(other.GetErrors().size() == 1);
+        event.Publish();
+        CHECK(host.calls.empty());
+    }
+} // namespace
+
+int main()
+{
+    questComplete();
+    questInProgress();
+    questAllTasksComplete();
+    questTaskComplete();
+    hasItem();
+    negationAndJoins();
+    unresolvedNames();
+    notAPredicate();
+    openDoor();
+    joinParty();
+    removeItem();
+    giveItem();
+    playSFX();
+    playMusic();
+    disableWorldItem();
+    endGame();
+    unboundCommands();
+    startQuest();
+    completeQuest();
+    completeQuestTask();
+    unboundOptionActions();
+    return sage::test::Result("script_linker_test");
+}
@@ -0,0 +1,93 @@
+//
+// Radius queries over growing numbers of combatants at a fixed density (the world grows with the count):
+// SpatialGrid against scanning every entity, as the ability and wavemob code did before SpatialQuery.
+// The grid's per-query cost should stay flat while the scan's grows with the total.
+//
+
+#include "engine/SpatialQuery.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace sage;
+
+int main()
+{
+    constexpr int QUERIES = 5000;
+    constexpr float RADIUS = 5.0f;
+    constexpr float AREA_PER_COMBATANT = 32.0f; // 400 x 400 for 5000
+
+    std::printf("%d queries of radius %.0f per total\n", QUERIES, RADIUS);
+    std::printf(
+        "%10s %16s %16s %22s\n", "combatants", "scan (us/query)", "grid (us/query)", "grid candidates/query");
+
+    std::vector<double> gridCandidates;
+    for (const int combatants : {1000, 5000, 20000, 50000})
+    {
+        const float half = std::sqrt(combatants * AREA_PER_COMBATANT) * 0.5f;
+        std::mt19937 rng(41);
+        std::uniform_real_distribution<float> pos(-half, half);
+
+        SpatialGrid grid(4.0f);
+        std::vector<BoundingBox> all(combatants);
+        for (int i = 0; i < combatants; ++i)
+        {
+            const float x = pos(rng), z = pos(rng);
+            all[i] = {{x - 0.5f, 0, z - 0.5f}, {x + 0.5f, 2, z + 0.5f}};
+            grid.Insert(static_cast<entt::entity>(i), all[i]);
+        }
+
+        std::vector<Vector3> centres(QUERIES);
+        for (auto& centre : centres)
+        {
+            centre = {pos(rng), 1, pos(rng)};
+        }
+
+        long scanHits = 0;
+        const double scan = test::TimeMs(
+            [&] {
+                scanHits = 0;
+                for (const auto& centre : centres)
+                {
+                    for (const auto& bounds : all)
+                    {
+                        scanHits += CheckCollisionBoxSphere(bounds, centre, RADIUS);
+                    }
+                }
+            },
+            1);
+
+        long gridHits = 0;
+        grid.stats = {};
+        const double indexed = test::TimeMs([&] {
+            gridHits = 0;
+            for (const auto& centre : centres)
+            {
+                const BoundingBox area{
+                    {centre.x - RADIUS, centre.y - RADIUS, centre.z - RADIUS},
+                    {centre.x + RADIUS, centre.y + RADIUS, centre.z + RADIUS}};
+                grid.Gather(area, [&](entt::entity, const BoundingBox& bounds) {
+                    gridHits += CheckCollisionBoxSphere(bounds, centre, RADIUS);
+                });
+            }
+        });
+
+        const double candidates = static_cast<double>(grid.stats.candidatesTested) / grid.stats.queries;
+        std::printf(
+            "%10d %16.3f %16.3f %22.1f\n",
+            combatants,
+            scan * 1000 / QUERIES,
+            indexed * 1000 / QUERIES,
+            candidates);
+        gridCandidates.push_back(candidates);
+        CHECK(gridHits == scanHits);
+    }
+
+    // The work per query is set by the density, not the total (timings also carry cache effects).
+    CHECK(gridCandidates.back() < gridCandidates.front() * 1.5);
+    return test::Result("spatial_query_benchmark");
+}
@@ -0,0 +1,208 @@
+//
+// SpatialGrid against a brute-force scan: 5000 combatants moving, leaving and rejoining between queries,
+// plus terrain-sized bounds that are too large to bucket. SpatialQuery over a registry: collideables
+// that predate it, bounds filled in after the emplace, moves and removals.
+//
+
+#include "engine/components/Collideable.hpp"
+#include "engine/components/sgTransform.hpp"
+#include "engine/SpatialQuery.hpp"
+#include "engine/systems/CollisionSystem.hpp"
+#include "engine/systems/NavigationGridSystem.hpp"
+#include "engine/systems/TransformSystem.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    constexpr int COMBATANTS = 5000;
+    const auto TERRAIN = static_cast<entt::entity>(COMBATANTS);
+
+    // What the grid should report for a query: every live entity whose bounds pass test.
+    template <typename Test>
+    std::set<entt::entity> reference(const std::map<entt::entity, BoundingBox>& live, Test&& test)
+    {
+        std::set<entt::entity> out;
+        for (const auto& [entity, bounds] : live)
+        {
+            if (test(bounds)) out.insert(entity);
+        }
+        return out;
+    }
+
+    template <typename Test>
+    std::set<entt::entity> gather(const SpatialGrid& grid, const BoundingBox& area, Test&& test)
+    {
+        std::set<entt::entity> out;
+        bool duplicate = false;
+        grid.Gather(area, [&](const entt::entity entity, const BoundingBox& bounds) {
+            if (!test(bounds)) return;
+            duplicate |= !out.insert(entity).second;
+        });
+        CHECK(!duplicate);
+        return out;
+    }
+
+    void matchesBruteForce()
+    {
+        std::mt19937 rng(41);
+        std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> size(0.3f, 1.5f);
+        std::uniform_real_distribution<float> radius(0.5f, 12.0f);
+
+        SpatialGrid grid(4.0f);
+        std::map<entt::entity, BoundingBox> live;
+        auto place = [&](const entt::entity entity) {
+            const float x = pos(rng), z = pos(rng), s = size(rng);
+            const BoundingBox bounds{{x - s, 0, z - s}, {x + s, 2, z + s}};
+            grid.Insert(entity, bounds);
+            live[entity] = bounds;
+        };
+
+        for (int i = 0; i < COMBATANTS; ++i)
+        {
+            place(static_cast<entt::entity>(i));
+        }
+        grid.Insert(TERRAIN, {{-300, -1, -300}, {300, 0, 300}});
+        live[TERRAIN] = {{-300, -1, -300}, {300, 0, 300}};
+        CHECK(grid.GetEntityCount() == COMBATANTS + 1);
+
+        for (int round = 0; round < 10; ++round)
+        {
+            // Small steps (mostly the same cells) and teleports.
+            for (int i = 0; i < COMBATANTS / 3; ++i)
+            {
+                const auto entity = static_cast<entt::entity>(rng() % COMBATANTS);
+                if (!live.contains(entity) || rng() % 4 == 0)
+                {
+                    place(entity);
+                    continue;
+                }
+                auto bounds = live[entity];
+                const float dx = (rng() % 100) * 0.01f, dz = (rng() % 100) * 0.01f;
+                bounds.min.x += dx, bounds.max.x += dx, bounds.min.z += dz, bounds.max.z += dz;
+                grid.Insert(entity, bounds);
+                live[entity] = bounds;
+            }
+            for (int i = 0; i < COMBATANTS / 20; ++i)
+            {
+                const auto entity = static_cast<entt::entity>(rng() % COMBATANTS);
+                grid.Remove(entity);
+                live.erase(entity);
+                CHECK(!grid.Contains(entity));
+            }
+            CHECK(grid.GetEntityCount() == live.size());
+
+            for (int query = 0; query < 200; ++query)
+            {
+                const Vector3 centre{pos(rng), 1, pos(rng)};
+                const float r = radius(rng);
+                const BoundingBox area{
+                    {centre.x - r, centre.y - r, centre.z - r}, {centre.x + r, centre.y + r, centre.z + r}};
+
+                auto inSphere = [&](const BoundingBox& b) { return CheckCollisionBoxSphere(b, centre, r); };
+                CHECK(gather(grid, area, inSphere) == reference(live, inSphere));
+
+                auto inBox = [&](const BoundingBox& b) { return CheckCollisionBoxes(b, area); };
+                CHECK(gather(grid, area, inBox) == reference(live, inBox));
+            }
+        }
+    }
+
+    void nearbyOnly()
+    {
+        // A small query over 5000 spread-out entities touches a handful of them, not all.
+        SpatialGrid grid(4.0f);
+        for (int i = 0; i < COMBATANTS; ++i)
+        {
+            const float x = static_cast<float>(i % 100) * 4 + 1, z = static_cast<float>(i / 100) * 4 + 1;
+            grid.Insert(static_cast<entt::entity>(i), {{x, 0, z}, {x + 1, 2, z + 1}});
+        }
+        grid.stats = {};
+        int hits = 0;
+        grid.Gather({{40, 0, 40}, {48, 2, 48}}, [&](entt::entity, const BoundingBox&) { ++hits; });
+        CHECK(hits == 9);
+        CHECK(grid.stats.candidatesTested == 9);
+        CHECK(grid.stats.cellsVisited == 9);
+    }
+
+    void stampsDoNotLeak()
+    {
+        // Each query's visited marks must be fresh, however many queries ran before.
+        SpatialGrid grid(1.0f);
+        grid.Insert(entt::entity{1}, {{-5, 0, -5}, {5, 1, 5}});
+        for (int i = 0; i < 10000; ++i)
+        {
+            int hits = 0;
+            grid.Gather({{-1, 0, -1}, {1, 1, 1}}, [&](entt::entity, const BoundingBox&) { ++hits; });
+            CHECK(hits == 1);
+        }
+        grid.Remove(entt::entity{1});
+        grid.Remove(entt::entity{1}); // No-op
+        CHECK(grid.GetEntityCount() == 0);
+        grid.Clear();
+        CHECK(grid.GetEntityCount() == 0);
+    }
+
+    void followsRegistry()
+    {
+        entt::registry registry;
+        TransformSystem transformSystem(&registry);
+        CollisionSystem collisionSystem(&registry);
+        NavigationGridSystem navigation(&registry, &collisionSystem);
+        navigation.Init(100, 1.0f); // As the scene does: four-unit cells, the same as the default
+
+        // Map geometry exists before the engine systems do.
+        const auto wall = registry.create();
+        registry.emplace<Collideable>(wall, BoundingBox{{10, 0, 10}, {12, 3, 12}}, MatrixIdentity());
+        registry.emplace<StaticCollideable>(wall);
+
+        SpatialQuery query(&registry, &transformSystem, &navigation);
+        CHECK(query.QueryRadius({11, 1, 11}, 2, {}) == std::vector{wall});
+
+        // As MapLoader does it: emplaced empty, bounds read in afterwards, then patched.
+        const auto loaded = registry.create();
+        auto& collideable = registry.emplace<Collideable>(loaded);
+        registry.emplace<StaticCollideable>(loaded);
+        CHECK(query.QueryRadius({-20, 1, -20}, 2, {}).empty());
+        collideable = Collideable({{-21, 0, -21}, {-19, 3, -19}}, MatrixIdentity());
+        registry.patch<Collideable>(loaded);
+        CHECK(query.QueryRadius({-20, 1, -20}, 2, {}) == std::vector{loaded});
+        CHECK(query.QueryRadius({0, 1, 0}, 0.5f, {}).empty()); // Not left at the empty box
+
+        // Actors follow their transform.
+        const auto actor = registry.create();
+        registry.emplace<sgTransform>(actor);
+        registry.emplace<Collideable>(actor, BoundingBox{{-0.5f, 0, -0.5f}, {0.5f, 2, 0.5f}}, MatrixIdentity());
+        transformSystem.SetPosition(actor, {30, 0, -30});
+        CHECK(query.QueryRadius({30, 1, -30}, 1, {}) == std::vector{actor});
+        transformSystem.SetPosition(actor, {-40, 0, 40});
+        CHECK(query.QueryRadius({30, 1, -30}, 1, {}).empty());
+        CHECK(query.QueryRadius({-40, 1, 40}, 1, {}) == std::vector{actor});
+        CHECK(query.QueryBox({{-41, 0, 39}, {-39, 2, 41}}, {}) == std::vector{actor});
+
+        // A rebuild keeps everything, and removal drops it.
+        query.Rebuild();
+        CHECK(query.QueryRadius({11, 1, 11}, 2, {}) == std::vector{wall});
+        CHECK(query.QueryRadius({-40, 1, 40}, 1, {}) == std::vector{actor});
+        registry.destroy(actor);
+        CHECK(query.QueryRadius({-40, 1, 40}, 1, {}).empty());
+        CHECK(query.QueryRadius({-20, 1, -20}, 2, {}) == std::vector{loaded});
+    }
+} // namespace
+
+int main()
+{
+    matchesBruteForce();
+    nearbyOnly();
+    stampsDoNotLeak();
+    followsRegistry();
+    return sage::test::Result("spatial_query_test");
+}
@@ -0,0 +1,245 @@
+//
+// TextLayoutCache against raylib: every line and node of the shipped dialog, wrapped at a spread of widths,
+// sizes and spacings, must wrap exactly as TextBox's istringstream/MeasureTextEx word wrap did, measure as
+// MeasureTextEx does, and place glyphs where DrawTextEx would.
+//
+
+#include "engine/ui/TextLayoutCache.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    // A CPU-only font (no texture, so no window needed) with uneven advances, some glyphs that advance by
+    // their rectangle instead, and a few non-ASCII codepoints; anything else falls back to '?'.
+    struct TestFont
+    {
+        std::vector<GlyphInfo> glyphs;
+        std::vector<Rectangle> recs;
+        Font font{};
+
+        TestFont()
+        {
+            std::vector<int> codepoints;
+            for (int c = 32; c < 127; ++c)
+            {
+                codepoints.push_back(c);
+            }
+            codepoints.insert(codepoints.end(), {0xE9, 0x2014, 0x2019});
+            for (int i = 0; i < static_cast<int>(codepoints.size()); ++i)
+            {
+                GlyphInfo glyph{};
+                glyph.value = codepoints[i];
+                glyph.offsetX = i % 3 - 1;
+                glyph.offsetY = i % 5;
+                glyph.advanceX = i % 7 == 0 ? 0 : 5 + (i * 37) % 11;
+                glyphs.push_back(glyph);
+                recs.push_back({static_cast<float>(i * 16), 0, 4.0f + static_cast<float>(i % 9), 20});
+            }
+            font.baseSize = 20;
+            font.glyphCount = static_cast<int>(glyphs.size());
+            font.glyphPadding = 1;
+            font.glyphs = glyphs.data();
+            font.recs = recs.data();
+        }
+    };
+
+    // TextBox's WORD_WRAP as it was before the cache.
+    std::string referenceWrap(
+        const Font& font, const std::string& text, const float fontSize, const float spacing, const float width)
+    {
+        std::string wrappedText;
+        std::string currentLine;
+        std::istringstream words(text);
+        std::string word;
+        while (words >> word)
+        {
+            std::string testLine = currentLine;
+            if (!testLine.empty()) testLine += " ";
+            testLine += word;
+
+            const Vector2 lineSize = MeasureTextEx(font, testLine.c_str(), fontSize, spacing);
+            if (lineSize.x <= width)
+            {
+                currentLine = testLine;
+            }
+            else
+            {
+                if (!wrappedText.empty()) wrappedText += "\n";
+                wrappedText += currentLine;
+                currentLine = word;
+            }
+        }
+        if (!currentLine.empty())
+        {
+            if (!wrappedText.empty()) wrappedText += "\n";
+            wrappedText += currentLine;
+        }
+        return wrappedText;
+    }
+
+    // DrawTextEx's pen, for every glyph it would draw.
+    std::vector<TextLayout::Glyph> referenceGlyphs(
+        const Font& font, const std::string& text, const float fontSize, const float spacing)
+    {
+        std::vector<TextLayout::Glyph> out;
+        const float scale = fontSize / static_cast<float>(font.baseSize);
+        Vector2 pen{0, 0};
+        for (int i = 0; i < static_cast<int>(text.size());)
+        {
+            int size = 0;
+            const int codepoint = GetCodepointNext(&text[i], &size);
+            const int index = GetGlyphIndex(font, codepoint);
+            i += size;
+            if (codepoint == '\n')
+            {
+                pen.y += fontSize + TextLayoutCache::LINE_SPACING;
+                pen.x = 0;
+                continue;
+            }
+            if (codepoint != ' ' && codepoint != '\t') out.push_back({index, pen});
+            const auto& glyph = font.glyphs[index];
+            const float advance =
+                glyph.advanceX == 0 ? font.recs[index].width : static_cast<float>(glyph.advanceX);
+            pen.x += advance * scale + spacing;
+        }
+        return out;
+    }
+
+    bool sameGlyphs(const std::vector<TextLayout::Glyph>& a, const std::vector<TextLayout::Glyph>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].index != b[i].index || a[i].position.x != b[i].position.x ||
+                a[i].position.y != b[i].position.y)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every non-empty line of every dialog file, each whole node body, and each whole file.
+    std::vector<std::string> dialogCorpus()
+    {
+        std::vector<std::string> corpus;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator("resources/dialog"))
+        {
+            if (!entry.is_regular_file()) continue;
+            std::ifstream file(entry.path());
+            std::stringstream whole;
+            whole << file.rdbuf();
+            corpus.push_back(whole.str());
+
+            std::istringstream lines(whole.str());
+            std::string line;
+            std::string node;
+            while (std::getline(lines, line))
+            {
+                if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+                corpus.push_back(line);
+                node += line + "\n";
+                if (line.find("</node>") != std::string::npos)
+                {
+                    corpus.push_back(node);
+                    node.clear();
+                }
+            }
+        }
+        // Codepoints the font lacks, multi-byte ones it has, and malformed UTF-8.
+        corpus.emplace_back("Caf\xC3\xA9 \xE2\x80\x94 it\xE2\x80\x99s \xE6\x97\xA5\xE6\x9C\xAC fine");
+        corpus.emplace_back("broken \xC3 and \xE2\x80 sequences \xF0\x9F");
+        corpus.emplace_back("Supercalifragilisticexpialidocious antidisestablishmentarianism");
+        corpus.emplace_back("  \t  ");
+        corpus.emplace_back("");
+        return corpus;
+    }
+
+    void dialogWrapsAsBefore()
+    {
+        const TestFont testFont;
+        const Font& font = testFont.font;
+        const auto corpus = dialogCorpus();
+        CHECK(corpus.size() > 100);
+
+        TextLayoutCache cache;
+        for (const auto& text : corpus)
+        {
+            for (const float fontSize : {12.0f, 16.0f, 20.0f, 27.5f})
+            {
+                for (const float spacing : {0.0f, 1.0f, 1.5f})
+                {
+                    for (const float width : {40.0f, 150.0f, 333.3f, 600.0f, 5000.0f})
+                    {
+                        const auto& layout = cache.Get(font, text, fontSize, spacing, width);
+                        const auto expected = referenceWrap(font, text, fontSize, spacing, width);
+                        if (!CHECK(layout.text == expected))
+                        {
+                            std::fprintf(stderr, "  wrapping \"%s\" at %.1f\n", text.c_str(), width);
+                        }
+                        const Vector2 size = MeasureTextEx(font, expected.c_str(), fontSize, spacing);
+                        CHECK(layout.size.x == size.x);
+                        CHECK(layout.size.y == size.y);
+                        CHECK(sameGlyphs(layout.glyphs, referenceGlyphs(font, expected, fontSize, spacing)));
+                    }
+
+                    // Unwrapped text is laid out as given, newlines included.
+                    const auto& raw = cache.Get(font, text, fontSize, spacing);
+                    CHECK(raw.text == text);
+                    const Vector2 size = MeasureTextEx(font, text.c_str(), fontSize, spacing);
+                    const Vector2 measured = cache.Measure(font, text, fontSize, spacing);
+                    CHECK(raw.size.x == size.x && measured.x == size.x);
+                    CHECK(raw.size.y == size.y && measured.y == size.y);
+                    CHECK(sameGlyphs(raw.glyphs, referenceGlyphs(font, text, fontSize, spacing)));
+                }
+            }
+        }
+    }
+
+    void cachesAndInvalidates()
+    {
+        TestFont testFont;
+        TextLayoutCache cache;
+        const std::string text = "You've got to help me get out of here.";
+        cache.Get(testFont.font, text, 16, 1, 100);
+        cache.Get(testFont.font, text, 16, 1, 100);
+        CHECK(cache.GetStats().misses == 1);
+        CHECK(cache.GetStats().hits == 1);
+
+        // Another width is another layout.
+        cache.Get(testFont.font, text, 16, 1, 200);
+        CHECK(cache.GetStats().misses == 2);
+        CHECK(cache.GetLayoutCount() == 2);
+
+        // A different font reusing the same glyph storage (reloaded) drops stale layouts.
+        testFont.font.glyphCount -= 1;
+        cache.Get(testFont.font, text, 16, 1, 100);
+        CHECK(cache.GetStats().misses == 3);
+        CHECK(cache.GetLayoutCount() == 1);
+
+        // Bounded.
+        for (std::size_t i = 0; i < TextLayoutCache::MAX_LAYOUTS + 10; ++i)
+        {
+            cache.Get(testFont.font, std::to_string(i), 16, 1);
+        }
+        CHECK(cache.GetLayoutCount() <= TextLayoutCache::MAX_LAYOUTS);
+        cache.Clear();
+        CHECK(cache.GetLayoutCount() == 0);
+    }
+} // namespace
+
+int main()
+{
+    dialogWrapsAsBefore();
+    cachesAndInvalidates();
+    return sage::test::Result("text_layout_test");
+}
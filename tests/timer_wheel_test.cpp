@@ -0,0 +1,211 @@
+//
+// TimerWheel firing order against a sorted reference, cancellation from inside callbacks, and large
+// clock jumps across every wheel level and past the wheel's range.
+//
+
+#include "engine/TimerWheel.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    // What the wheel should do with a timer: due on tick `expiry`, ties broken by schedule order.
+    struct Expected
+    {
+        std::uint64_t expiry;
+        int id;
+    };
+
+    std::uint64_t ticksFor(const float delay)
+    {
+        return static_cast<std::uint64_t>(
+            std::max<long long>(1, std::llround(static_cast<double>(delay) * TimerWheel::TICKS_PER_SECOND)));
+    }
+
+    void orderingMatchesReference()
+    {
+        std::mt19937 rng(46);
+        // Mostly cooldown-sized delays, with some spanning the upper levels and beyond the wheel.
+        std::uniform_real_distribution<float> shortDelay(0.0f, 5.0f);
+        std::uniform_real_distribution<float> longDelay(5.0f, 40000.0f);
+        std::uniform_real_distribution<float> frame(0.0f, 0.05f);
+
+        TimerWheel wheel;
+        double time = 0;
+        std::uint64_t now = 0;
+        std::vector<Expected> expected;
+        std::vector<int> fired;
+        bool lateOrEarly = false;
+        int nextId = 0;
+
+        auto schedule = [&] {
+            const float delay = rng() % 8 == 0 ? longDelay(rng) : shortDelay(rng);
+            const int id = nextId++;
+            const auto expiry = now + ticksFor(delay);
+            expected.push_back({expiry, id});
+            wheel.Schedule(delay, [&, id, expiry] {
+                fired.push_back(id);
+                // Callbacks see their own deadline as the time.
+                lateOrEarly |= std::llround(wheel.GetTime() * TimerWheel::TICKS_PER_SECOND) !=
+                               static_cast<long long>(expiry);
+            });
+        };
+
+        for (int step = 0; step < 20000; ++step)
+        {
+            const int count = static_cast<int>(rng() % 4);
+            for (int i = 0; i < count; ++i)
+            {
+                schedule();
+            }
+            // Mostly frames, occasionally a long hitch.
+            const float dt = step % 500 == 0 ? 3000.0f : frame(rng);
+            wheel.Update(dt);
+            time += static_cast<double>(dt);
+            now = static_cast<std::uint64_t>(std::floor(time * TimerWheel::TICKS_PER_SECOND));
+        }
+        wheel.Update(100000.0f);
+        time += 100000.0;
+        now = static_cast<std::uint64_t>(std::floor(time * TimerWheel::TICKS_PER_SECOND));
+
+        std::ranges::sort(expected, [](const Expected& a, const Expected& b) {
+            return std::tie(a.expiry, a.id) < std::tie(b.expiry, b.id);
+        });
+        std::vector<int> reference;
+        for (const auto& e : expected)
+        {
+            if (e.expiry <= now) reference.push_back(e.id);
+        }
+        CHECK(fired == reference);
+        CHECK(!lateOrEarly);
+        CHECK(wheel.GetPendingCount() == expected.size() - reference.size());
+    }
+
+    void cancelDuringFire()
+    {
+        TimerWheel wheel;
+        std::vector<int> fired;
+        TimerHandle b, c, self;
+
+        // Same tick: a (scheduled first) cancels b before it runs, and c on a later tick.
+        const auto a = wheel.Schedule(1.0f, [&] {
+            fired.push_back(1);
+            CHECK(wheel.Cancel(b));
+            CHECK(wheel.Cancel(c));
+            CHECK(!wheel.Cancel(self)); // Already firing: no longer pending
+        });
+        self = a;
+        b = wheel.Schedule(1.0f, [&] { fired.push_back(2); });
+        c = wheel.Schedule(1.5f, [&] { fired.push_back(3); });
+        // A callback scheduling a timer due within the same Update.
+        wheel.Schedule(1.0f, [&] {
+            fired.push_back(4);
+            wheel.Schedule(0.001f, [&] { fired.push_back(5); });
+        });
+
+        wheel.Update(2.0f);
+        CHECK((fired == std::vector<int>{1, 4, 5}));
+        CHECK(!wheel.IsPending(a));
+        CHECK(!wheel.IsPending(b));
+        CHECK(wheel.GetPendingCount() == 0);
+
+        // Handles stay safe once their slot is reused by a new timer.
+        const auto stale = wheel.Schedule(1.0f, [&] { fired.push_back(8); });
+        CHECK(wheel.Cancel(stale));
+        const auto reused = wheel.Schedule(1.0f, [&] { fired.push_back(6); });
+        CHECK(reused.index == stale.index);
+        CHECK(reused.generation != stale.generation);
+        CHECK(!wheel.IsPending(stale));
+        CHECK(!wheel.Cancel(stale));
+        CHECK(!wheel.Cancel(a));
+        CHECK(!wheel.Cancel(b));
+        CHECK(!wheel.Cancel(c));
+        CHECK(wheel.IsPending(reused));
+        CHECK(std::abs(wheel.GetRemaining(reused) - 1.0f) < 1e-3f);
+
+        // A timer that cancels every other pending timer, including ones on later ticks and levels.
+        std::vector<TimerHandle> others;
+        wheel.Schedule(0.5f, [&] {
+            for (const auto handle : others)
+            {
+                wheel.Cancel(handle);
+            }
+        });
+        for (int i = 0; i < 100; ++i)
+        {
+            others.push_back(wheel.Schedule(0.5f + static_cast<float>(i) * 37.0f, [&] { fired.push_back(7); }));
+        }
+        wheel.Update(5000.0f);
+        CHECK(std::ranges::count(fired, 7) == 0);
+        CHECK(std::ranges::count(fired, 6) == 1);
+        CHECK(std::ranges::count(fired, 8) == 0);
+        CHECK(wheel.GetPendingCount() == 0);
+    }
+
+    void largeJumps()
+    {
+        // One Update spanning every level boundary fires everything, in deadline order.
+        TimerWheel wheel;
+        std::vector<float> fired;
+        const std::vector<float> delays{
+            0.001f, 0.063f, 0.064f, 0.065f, 4.095f, 4.096f, 4.097f, 262.143f, 262.144f, 262.145f,
+            16777.0f, 16778.0f, 20000.0f, 36000.0f};
+        for (auto it = delays.rbegin(); it != delays.rend(); ++it)
+        {
+            const float delay = *it;
+            wheel.Schedule(delay, [&, delay] { fired.push_back(delay); });
+        }
+        wheel.Update(50000.0f);
+        CHECK(fired == delays);
+
+        // Past the wheel's range (about 4.6 hours): waits at the top and is refiled, not fired early.
+        TimerWheel far;
+        bool done = false;
+        const auto handle = far.Schedule(30000.0f, [&] { done = true; });
+        far.Update(16800.0f);
+        CHECK(!done);
+        CHECK(std::abs(far.GetRemaining(handle) - 13200.0f) < 0.01f);
+        far.Update(13199.9f);
+        CHECK(!done);
+        far.Update(0.2f);
+        CHECK(done);
+
+        // Pause and time scale.
+        TimerWheel scaled;
+        int count = 0;
+        scaled.Schedule(1.0f, [&] { ++count; });
+        scaled.SetPaused(true);
+        scaled.Update(10.0f);
+        CHECK(count == 0);
+        scaled.SetPaused(false);
+        scaled.SetTimeScale(0.5f);
+        scaled.Update(1.9f);
+        CHECK(count == 0);
+        scaled.Update(0.2f);
+        CHECK(count == 1);
+
+        // Clear drops pending timers without calling them.
+        scaled.Schedule(1.0f, [&] { ++count; });
+        scaled.Clear();
+        scaled.Update(10.0f);
+        CHECK(count == 1);
+        CHECK(scaled.GetPendingCount() == 0);
+    }
+} // namespace
+
+int main()
+{
+    orderingMatchesReference();
+    cancelDuringFire();
+    largeJumps();
+    return sage::test::Result("timer_wheel_test");
+}
@@ -0,0 +1,229 @@
+//
+// Retained UI windows against a mock cache backend: a static frame composites each window's cache and
+// draws no elements; a change in one element re-renders only its own window, once.
+//
+
+#include "engine/ui/UILayout.hpp"
+#include "engine/ui/UIWindow.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    // Records what windows ask of their caches, without a GPU.
+    class MockCacheBackend final : public WindowCacheBackend
+    {
+        unsigned int nextId = 1;
+
+      public:
+        bool failLoads = false;
+        int loads = 0;
+        int unloads = 0;
+        int renders = 0;
+        int composites = 0;
+        bool rendering = false;
+
+        RenderTexture Load(const int width, const int height) override
+        {
+            ++loads;
+            RenderTexture cache{};
+            if (failLoads) return cache;
+            cache.id = nextId++;
+            cache.texture.width = width;
+            cache.texture.height = height;
+            return cache;
+        }
+
+        void Unload(const RenderTexture&) override
+        {
+            ++unloads;
+        }
+
+        void Begin(const RenderTexture&, Vector2) override
+        {
+            CHECK(!rendering);
+            rendering = true;
+            ++renders;
+        }
+
+        void End() override
+        {
+            CHECK(rendering);
+            rendering = false;
+        }
+
+        void Composite(const RenderTexture&, Vector2) override
+        {
+            CHECK(!rendering);
+            ++composites;
+        }
+
+        void ResetCounts()
+        {
+            loads = unloads = renders = composites = 0;
+        }
+    };
+
+    // Draws from a provider the way AbilitySlot does: polls for a change, and draws what it stored.
+    class CountingElement final : public CellElement
+    {
+        int drawn = -1;
+
+      public:
+        int value = 0;
+        int* draws;
+
+        void PollChanges() override
+        {
+            if (value != drawn) MarkDirty();
+        }
+
+        void Draw2D() override
+        {
+            ++*draws;
+            drawn = value;
+        }
+
+        CountingElement(TableCell* _parent, int* _draws) : CellElement(nullptr, _parent), draws(_draws)
+        {
+        }
+    };
+
+    struct TestWindow
+    {
+        std::unique_ptr<Window> window;
+        std::vector<CountingElement*> elements;
+    };
+
+    TestWindow makeWindow(const float x, const int rows, const int cols, int* draws)
+    {
+        TestWindow out;
+        out.window = std::make_unique<Window>(nullptr, x, 100, 300, 200);
+        auto* grid = out.window->CreateTableGrid(rows, cols);
+        for (const auto& row : grid->children)
+        {
+            for (const auto& cell : row->children)
+            {
+                auto* tableCell = static_cast<TableCell*>(cell.get());
+                auto element = std::make_unique<CountingElement>(tableCell, draws);
+                out.elements.push_back(element.get());
+                tableCell->element = std::move(element);
+            }
+        }
+        out.window->InitLayout();
+        return out;
+    }
+
+    // One frame as GameUIEngine runs it: DrawOffscreen, then Draw2D.
+    void frame(const std::vector<TestWindow>& windows)
+    {
+        for (const auto& [window, elements] : windows)
+        {
+            if (window->IsHidden()) continue;
+            window->PollChanges();
+            window->RenderCache();
+        }
+        for (const auto& [window, elements] : windows)
+        {
+            if (window->IsHidden()) continue;
+            window->Draw2D();
+        }
+    }
+
+    void staticFramesDrawNoElements()
+    {
+        MockCacheBackend backend;
+        Window::SetCacheBackend(&backend);
+        int draws = 0;
+        {
+            std::vector<TestWindow> windows;
+            windows.push_back(makeWindow(0, 4, 6, &draws));
+            windows.push_back(makeWindow(400, 2, 3, &draws));
+            constexpr int ELEMENTS = 4 * 6 + 2 * 3;
+
+            frame(windows);
+            CHECK(draws == ELEMENTS);
+            CHECK(backend.renders == 2);
+            CHECK(backend.composites == 2);
+
+            // Static frames: no element draws, no re-renders, just the two composites.
+            draws = 0;
+            backend.ResetCounts();
+            for (int i = 0; i < 10; ++i)
+            {
+                frame(windows);
+            }
+            CHECK(draws == 0);
+            CHECK(backend.renders == 0);
+            CHECK(backend.loads == 0);
+            CHECK(backend.composites == 20);
+
+            // A provider change re-renders its window only, for one frame.
+            windows[1].elements[4]->value = 1;
+            draws = 0;
+            backend.ResetCounts();
+            frame(windows);
+            CHECK(draws == 2 * 3);
+            CHECK(backend.renders == 1);
+            frame(windows);
+            CHECK(draws == 2 * 3);
+            CHECK(backend.renders == 1);
+
+            // A window moved without anything marking it dirty still re-renders, into the same-sized cache.
+            draws = 0;
+            backend.ResetCounts();
+            windows[0].window->rec.x += 10;
+            frame(windows);
+            CHECK(draws == 4 * 6);
+            CHECK(backend.renders == 1);
+            CHECK(backend.loads == 0);
+
+            // Hidden windows are neither polled, rendered nor drawn; showing one again re-renders it.
+            draws = 0;
+            backend.ResetCounts();
+            windows[0].window->Hide();
+            windows[0].elements[0]->value = 5;
+            frame(windows);
+            CHECK(draws == 0);
+            CHECK(backend.composites == 1);
+            windows[0].window->Show();
+            frame(windows);
+            CHECK(draws == 4 * 6);
+            CHECK(backend.composites == 3);
+        }
+        // Destroyed windows release their caches.
+        CHECK(backend.unloads == 2);
+        Window::SetCacheBackend(nullptr);
+    }
+
+    void noCacheFallsBackToDrawingTheTree()
+    {
+        MockCacheBackend backend;
+        backend.failLoads = true;
+        Window::SetCacheBackend(&backend);
+        int draws = 0;
+        {
+            std::vector<TestWindow> windows;
+            windows.push_back(makeWindow(0, 2, 2, &draws));
+            frame(windows);
+            frame(windows);
+            CHECK(draws == 2 * 4);
+            CHECK(backend.renders == 0);
+            CHECK(backend.composites == 0);
+        }
+        CHECK(backend.unloads == 0);
+        Window::SetCacheBackend(nullptr);
+    }
+} // namespace
+
+int main()
+{
+    staticFramesDrawNoElements();
+    noCacheFallsBackToDrawingTheTree();
+    return sage::test::Result("ui_retained_test");
+}
@@ -0,0 +1,194 @@
+//
+// UpdateScheduler: with every interval at 1 (or scheduling disabled) a simulation stepped through the
+// scheduler matches stepping every entity every frame exactly. With the default intervals no frame
+// time is lost and ticks are spread evenly over the frames.
+//
+
+#include "engine/systems/states/UpdateScheduler.hpp"
+#include "engine/Settings.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    constexpr int ENTITIES = 3000;
+    constexpr int FRAMES = 600; // A multiple of every default interval
+
+    // A wandering mob: waits, walks for a while, waits again. Branches on its timers, so any
+    // difference in the dt it is handed shows up in its state.
+    struct Mob
+    {
+        bool walking = false;
+        float timer = 0;
+        float position = 0;
+        int transitions = 0;
+
+        void Update(const float dt)
+        {
+            timer -= dt;
+            if (walking) position += 3.5f * dt;
+            if (timer > 0) return;
+            walking = !walking;
+            timer += walking ? 1.7f : 0.9f;
+            ++transitions;
+        }
+
+        bool operator==(const Mob&) const = default;
+    };
+
+    std::vector<float> frameTimes()
+    {
+        std::mt19937 rng(43);
+        std::uniform_real_distribution<float> dt(1.0f / 144, 1.0f / 20);
+        std::vector<float> out(FRAMES);
+        for (auto& t : out)
+        {
+            t = dt(rng);
+        }
+        return out;
+    }
+
+    UpdateBucket bucketFor(const int entity, const int frame)
+    {
+        // Entities drift between buckets, as they would moving around the focus.
+        return static_cast<UpdateBucket>((entity * 7 + frame / 37) % UPDATE_BUCKET_COUNT);
+    }
+
+    std::vector<Mob> everyFrame(const std::vector<float>& dts)
+    {
+        std::vector<Mob> mobs(ENTITIES);
+        for (const float dt : dts)
+        {
+            for (auto& mob : mobs)
+            {
+                mob.Update(dt);
+            }
+        }
+        return mobs;
+    }
+
+    std::vector<Mob> scheduled(const std::vector<float>& dts, const AiUpdateSettings& settings)
+    {
+        std::vector<Mob> mobs(ENTITIES);
+        UpdateScheduler scheduler;
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            scheduler.BeginFrame(settings, dts[frame]);
+            for (int i = 0; i < ENTITIES; ++i)
+            {
+                float dt = 0;
+                if (scheduler.ShouldTick(static_cast<entt::entity>(i), bucketFor(i, frame), dt))
+                {
+                    mobs[i].Update(dt);
+                }
+            }
+        }
+        return mobs;
+    }
+
+    void intervalOneMatchesEveryFrame()
+    {
+        const auto dts = frameTimes();
+        const auto expected = everyFrame(dts);
+
+        AiUpdateSettings allOnes;
+        allOnes.intervals = {1, 1, 1, 1};
+        CHECK(scheduled(dts, allOnes) == expected);
+
+        AiUpdateSettings disabled;
+        disabled.enabled = false;
+        CHECK(scheduled(dts, disabled) == expected);
+
+        // Intervals below 1 are treated as 1.
+        AiUpdateSettings zeros;
+        zeros.intervals = {0, 0, -3, 1};
+        CHECK(scheduled(dts, zeros) == expected);
+    }
+
+    void skippedTimeIsHandedOver()
+    {
+        constexpr int BLOCK = ENTITIES / UPDATE_BUCKET_COUNT;
+        const AiUpdateSettings settings;
+        UpdateScheduler scheduler;
+        std::vector<double> received(ENTITIES, 0);
+        std::vector<int> ticks(ENTITIES, 0);
+        double total = 0;
+        const auto dts = frameTimes();
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            scheduler.BeginFrame(settings, dts[frame]);
+            total += dts[frame];
+            for (int i = 0; i < ENTITIES; ++i)
+            {
+                const auto bucket = static_cast<UpdateBucket>(i / BLOCK);
+                float dt = 0;
+                if (scheduler.ShouldTick(static_cast<entt::entity>(i), bucket, dt))
+                {
+                    received[i] += dt;
+                    ++ticks[i];
+                }
+            }
+
+            // Phases follow first-seen order, so each bucket's block of entities is spread evenly over
+            // the frames of its interval.
+            const auto& stats = scheduler.GetFrameStats();
+            for (std::size_t b = 0; b < UPDATE_BUCKET_COUNT; ++b)
+            {
+                const unsigned int interval = settings.intervals[b];
+                CHECK(stats[b].considered == BLOCK);
+                CHECK(stats[b].ticked >= stats[b].considered / interval);
+                CHECK(stats[b].ticked <= (stats[b].considered + interval - 1) / interval);
+            }
+        }
+
+        for (int i = 0; i < ENTITIES; ++i)
+        {
+            const int interval = settings.intervals[i / BLOCK];
+            CHECK(ticks[i] == FRAMES / interval);
+            // Everything up to the entity's last tick; at most interval - 1 frames still pending.
+            CHECK(received[i] <= total + 1e-3);
+            CHECK(received[i] >= total - (interval - 1) * (1.0 / 20) - 1e-3);
+        }
+    }
+
+    void forgetStartsOver()
+    {
+        AiUpdateSettings settings;
+        settings.intervals = {4, 4, 4, 4};
+        UpdateScheduler scheduler;
+        const auto entity = static_cast<entt::entity>(1);
+        float dt = 0;
+        int ticks = 0;
+        for (int frame = 0; frame < 8; ++frame)
+        {
+            scheduler.BeginFrame(settings, 0.25f);
+            ticks += scheduler.ShouldTick(entity, UpdateBucket::Near, dt);
+        }
+        CHECK(ticks == 2);
+
+        // Time pending from before Forget is dropped.
+        scheduler.Forget(entity);
+        float first = -1;
+        for (int frame = 0; frame < 4 && first < 0; ++frame)
+        {
+            scheduler.BeginFrame(settings, 0.25f);
+            if (scheduler.ShouldTick(entity, UpdateBucket::Near, dt)) first = dt;
+        }
+        CHECK(first > 0);
+        CHECK(first <= 1.0f);
+    }
+} // namespace
+
+int main()
+{
+    intervalOneMatchesEveryFrame();
+    skippedTimeIsHandedOver();
+    forgetStartsOver();
+    return sage::test::Result("update_scheduler_test");
+}
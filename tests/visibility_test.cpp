@@ -0,0 +1,255 @@
+//
+// GridLineOfSight on synthetic maps against a reference that samples each centre-to-centre segment
+// densely, in both directions, and VisibilitySystem's mask kept up to date as a door in a wall toggles.
+//
+
+#include "engine/CollisionLayers.hpp"
+#include "engine/components/Collideable.hpp"
+#include "engine/systems/CollisionSystem.hpp"
+#include "engine/systems/NavigationGridSystem.hpp"
+#include "engine/systems/VisibilitySystem.hpp"
+
+#include "TestHelpers.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace sage;
+
+namespace
+{
+    struct Map
+    {
+        int rows = 0;
+        int cols = 0;
+        std::vector<std::uint8_t> blocked;
+
+        [[nodiscard]] bool IsBlocked(const int row, const int col) const
+        {
+            return blocked[row * cols + col] != 0;
+        }
+
+        Map(const int _rows, const int _cols) : rows(_rows), cols(_cols), blocked(_rows * _cols, 0)
+        {
+        }
+    };
+
+    bool trace(const Map& map, const GridSquare from, const GridSquare to)
+    {
+        return GridLineOfSight(from, to, [&](const int row, const int col) {
+            CHECK(row >= 0 && row < map.rows && col >= 0 && col < map.cols);
+            return map.IsBlocked(row, col);
+        });
+    }
+
+    // Samples the segment (and every exact x-boundary crossing); a sample on a square edge or corner
+    // counts every square it touches. End squares are never tested.
+    bool reference(const Map& map, const GridSquare from, const GridSquare to)
+    {
+        const double x0 = from.col + 0.5, y0 = from.row + 0.5;
+        const double x1 = to.col + 0.5, y1 = to.row + 0.5;
+        const int dx = std::abs(to.col - from.col);
+        const int samples = 4000 * (dx + std::abs(to.row - from.row) + 1);
+
+        std::vector<double> ts;
+        for (int i = 0; i <= samples; ++i)
+        {
+            ts.push_back(static_cast<double>(i) / samples);
+        }
+        for (int m = 0; m < dx; ++m)
+        {
+            ts.push_back((2.0 * m + 1) / (2.0 * dx));
+        }
+
+        constexpr double EPS = 1e-9;
+        for (const double t : ts)
+        {
+            const double x = x0 + (x1 - x0) * t;
+            const double y = y0 + (y1 - y0) * t;
+            const bool onColumnEdge = std::abs(x - std::round(x)) < 1e-7;
+            const bool onRowEdge = std::abs(y - std::round(y)) < 1e-7;
+            for (const double ox : {-EPS, EPS})
+            {
+                for (const double oy : {-EPS, EPS})
+                {
+                    if ((ox > 0 && !onColumnEdge) || (oy > 0 && !onRowEdge)) continue;
+                    const int col = static_cast<int>(std::floor(x + ox));
+                    const int row = static_cast<int>(std::floor(y + oy));
+                    if (row < 0 || col < 0 || row >= map.rows || col >= map.cols) continue;
+                    if ((row == from.row && col == from.col) || (row == to.row && col == to.col)) continue;
+                    if (map.IsBlocked(row, col)) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void syntheticMaps()
+    {
+        std::mt19937 rng(42);
+        int visible = 0;
+        for (int m = 0; m < 40; ++m)
+        {
+            const int size = 24 + m % 8;
+            Map map(size, size);
+            // Scattered blockers plus a few straight walls.
+            const unsigned int density = 20 + 10 * (m % 10);
+            for (auto& square : map.blocked)
+            {
+                square = rng() % 1000 < density;
+            }
+            for (int wall = 0; wall < 3; ++wall)
+            {
+                const int row = static_cast<int>(rng() % size);
+                const int start = static_cast<int>(rng() % size);
+                for (int col = start; col < std::min(size, start + 10); ++col)
+                {
+                    map.blocked[row * size + col] = 1;
+                }
+            }
+
+            for (int query = 0; query < 400; ++query)
+            {
+                const GridSquare a{static_cast<int>(rng() % size), static_cast<int>(rng() % size)};
+                const GridSquare b{static_cast<int>(rng() % size), static_cast<int>(rng() % size)};
+                const bool expected = reference(map, a, b);
+                visible += expected;
+                CHECK(trace(map, a, b) == expected);
+                CHECK(trace(map, b, a) == expected);
+            }
+        }
+        // The maps should exercise both outcomes.
+        CHECK(visible > 1000);
+        CHECK(visible < 15000);
+    }
+
+    void cases()
+    {
+        Map map(5, 5);
+        CHECK(trace(map, {2, 2}, {2, 2}));
+        map.blocked[2 * 5 + 2] = 1;
+        CHECK(trace(map, {2, 2}, {2, 3})); // End squares are not tested
+        CHECK(!trace(map, {2, 1}, {2, 3}));
+        CHECK(!trace(map, {0, 0}, {4, 4})); // Straight through the centre
+
+        // A diagonal through a corner is blocked by either square beside it.
+        Map corner(2, 2);
+        CHECK(trace(corner, {0, 0}, {1, 1}));
+        corner.blocked[1] = 1;
+        CHECK(!trace(corner, {0, 0}, {1, 1}));
+        CHECK(!trace(corner, {1, 1}, {0, 0}));
+
+        // A shallow line passes beside a blocker without touching it.
+        Map shallow(3, 7);
+        shallow.blocked[2 * 7 + 1] = 1;
+        CHECK(trace(shallow, {0, 0}, {1, 6}));
+    }
+
+    constexpr int SLICES = 20; // One unit squares; square (row, col) covers z, x in [-10 + row/col, +1)
+
+    Vector3 centreOf(const GridSquare square)
+    {
+        return {square.col - SLICES / 2 + 0.5f, 0, square.row - SLICES / 2 + 0.5f};
+    }
+
+    entt::entity addBlocker(entt::registry& registry, const BoundingBox& bounds)
+    {
+        const auto entity = registry.create();
+        auto& collideable = registry.emplace<Collideable>(entity, bounds, MatrixIdentity());
+        collideable.SetCollisionLayer(collision_layers::Obstacle);
+        collideable.blocksNavigation = true;
+        return entity;
+    }
+
+    // As DoorSystem toggles a door: an open door neither blocks navigation nor is an obstacle.
+    void setDoor(entt::registry& registry, VisibilitySystem& visibility, const entt::entity door, const bool open)
+    {
+        auto& collideable = registry.get<Collideable>(door);
+        collideable.SetCollisionLayer(open ? collision_layers::Background : collision_layers::Obstacle);
+        collideable.blocksNavigation = !open;
+        visibility.RefreshArea(collideable.worldBoundingBox);
+    }
+
+    // The refreshed mask equals one rebuilt from scratch, and every line of sight over the walled area
+    // matches the sampling reference over that geometry.
+    void matchesGeometry(entt::registry& registry, NavigationGridSystem& navigation, VisibilitySystem& visibility)
+    {
+        VisibilitySystem fresh(&registry, &navigation);
+        fresh.Rebuild();
+        Map map(SLICES, SLICES);
+        for (int row = 0; row < SLICES; ++row)
+        {
+            for (int col = 0; col < SLICES; ++col)
+            {
+                CHECK(visibility.BlocksSight({row, col}) == fresh.BlocksSight({row, col}));
+                map.blocked[row * SLICES + col] = fresh.BlocksSight({row, col});
+            }
+        }
+
+        std::vector<GridSquare> squares;
+        for (int row = 6; row <= 14; row += 2)
+        {
+            for (int col = 3; col <= 16; ++col)
+            {
+                squares.push_back({row, col});
+            }
+        }
+        for (const auto a : squares)
+        {
+            for (const auto b : squares)
+            {
+                CHECK(visibility.HasLineOfSight(centreOf(a), centreOf(b)) == reference(map, a, b));
+            }
+        }
+    }
+
+    void doorBesideWall()
+    {
+        entt::registry registry;
+        CollisionSystem collision(&registry);
+        NavigationGridSystem navigation(&registry, &collision);
+        navigation.Init(SLICES, 1.0f);
+
+        // An east-west wall along row 10 with a two-square door in columns 9-10. The left wall reaches
+        // into the door's square (10, 9); the door is two rows deep.
+        addBlocker(registry, {{-6.0f, 0, 0.1f}, {-0.5f, 3, 0.9f}});
+        addBlocker(registry, {{1.05f, 0, 0.1f}, {6.0f, 3, 0.9f}});
+        const auto door = addBlocker(registry, {{-0.95f, 0, 0.1f}, {0.95f, 3, 1.9f}});
+
+        VisibilitySystem visibility(&registry, &navigation);
+        visibility.Rebuild();
+        const Vector3 south = centreOf({5, 10}), north = centreOf({15, 10});
+        const Vector3 southWall = centreOf({5, 7}), northWall = centreOf({15, 7});
+        CHECK(!visibility.HasLineOfSight(south, north));
+        matchesGeometry(registry, navigation, visibility);
+
+        for (int cycle = 0; cycle < 2; ++cycle)
+        {
+            setDoor(registry, visibility, door, true);
+            CHECK(visibility.HasLineOfSight(south, north));
+            CHECK(!visibility.HasLineOfSight(southWall, northWall));
+            CHECK(visibility.BlocksSight({10, 9})); // Still under the wall
+            CHECK(!visibility.BlocksSight({10, 10}));
+            CHECK(!visibility.BlocksSight({11, 9}));
+            CHECK(visibility.BlocksSight({10, 8}));
+            CHECK(visibility.BlocksSight({10, 11}));
+            matchesGeometry(registry, navigation, visibility);
+
+            setDoor(registry, visibility, door, false);
+            CHECK(!visibility.HasLineOfSight(south, north));
+            CHECK(visibility.BlocksSight({10, 10}));
+            CHECK(visibility.BlocksSight({11, 10}));
+            matchesGeometry(registry, navigation, visibility);
+        }
+    }
+} // namespace
+
+int main()
+{
+    syntheticMaps();
+    cases();
+    doorBesideWall();
+    return sage::test::Result("visibility_test");
+}